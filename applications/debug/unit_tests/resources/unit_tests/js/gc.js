@@ -0,0 +1,58 @@
+let tests = require("tests");
+
+// Values are moved between objects while collection is in progress, so that
+// the only reference is in an object that may be already marked
+let a = [];
+let b = [];
+for(let i = 0; i < 100; i++) {
+    a.push({ id: i, child: { id: i } });
+    b.push({ id: -1, child: null });
+}
+
+let cycles = gcStats().cycles;
+for(let round = 0; round < 20; round++) {
+    for(let i = 0; i < 100; i++) {
+        if(round % 2 === 0) {
+            b[i].child = a[i].child;
+            a[i].child = null;
+        } else {
+            a[i].child = b[i].child;
+            b[i].child = null;
+        }
+        // garbage to keep collector busy
+        let junk = { x: { y: { z: i } } };
+        junk.x.y.z = round;
+    }
+}
+
+for(let i = 0; i < 100; i++) {
+    let child = a[i].child === null ? b[i].child : a[i].child;
+    tests.assert_eq(i, child.id);
+}
+
+// Strings that don't fit into a value fill string buffer, it is compacted by
+// incremental collections without stopping the program for a whole one
+let names = [];
+for(let i = 0; i < 100; i++) {
+    names.push("name number " + i.toString());
+}
+for(let round = 0; round < 50; round++) {
+    for(let i = 0; i < 100; i++) {
+        let junk = "garbage string " + (round * 100 + i).toString();
+        names[i] = "name number " + (round * 100 + i).toString();
+    }
+}
+for(let i = 0; i < 100; i++) {
+    tests.assert_eq("name number " + (4900 + i).toString(), names[i]);
+}
+
+let stats = gcStats();
+tests.assert_eq(true, stats.cycles > cycles);
+tests.assert_eq(true, stats.pauses >= stats.cycles);
+tests.assert_eq(true, stats.maxPauseUs <= stats.totalPauseUs);
+tests.assert_eq(0, stats.fullCycles);
+// Steps are bounded by work, not by heap size
+tests.assert_eq(true, stats.maxPauseUs < 20000);
+
+gc(true);
+tests.assert_eq(true, gcStats().fullCycles > stats.fullCycles);
@@ -0,0 +1,154 @@
+#include "test_bench.h"
+
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/strint.h>
+
+#define TAG "TestBench"
+
+#define TEST_BENCH_HEADER \
+    "suite,bench,iterations,cycles_avg,cycles_min,cycles_max,heap_peak,allocations\n"
+
+struct TestBench {
+    Stream* results;
+    Stream* baseline;
+    uint32_t threshold;
+    size_t regressions;
+    FuriString* line;
+};
+
+TestBench* test_bench_alloc(Storage* storage, bool append, bool compare, uint32_t threshold) {
+    furi_check(storage);
+
+    TestBench* instance = malloc(sizeof(TestBench));
+    instance->threshold = threshold;
+    instance->line = furi_string_alloc();
+
+    instance->results = file_stream_alloc(storage);
+    FS_OpenMode open_mode = append ? FSOM_OPEN_APPEND : FSOM_CREATE_ALWAYS;
+    if(file_stream_open(instance->results, TEST_BENCH_RESULTS_PATH, FSAM_WRITE, open_mode)) {
+        if(stream_size(instance->results) == 0) {
+            stream_write_cstring(instance->results, TEST_BENCH_HEADER);
+        }
+    } else {
+        FURI_LOG_E(TAG, "Failed to open %s", TEST_BENCH_RESULTS_PATH);
+        file_stream_close(instance->results);
+        stream_free(instance->results);
+        instance->results = NULL;
+    }
+
+    if(compare) {
+        instance->baseline = file_stream_alloc(storage);
+        if(!file_stream_open(
+               instance->baseline, TEST_BENCH_BASELINE_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            printf("No baseline at %s, nothing to compare\r\n", TEST_BENCH_BASELINE_PATH);
+            file_stream_close(instance->baseline);
+            stream_free(instance->baseline);
+            instance->baseline = NULL;
+        }
+    }
+
+    return instance;
+}
+
+void test_bench_free(TestBench* instance) {
+    furi_check(instance);
+
+    if(instance->results) {
+        file_stream_close(instance->results);
+        stream_free(instance->results);
+    }
+
+    if(instance->baseline) {
+        file_stream_close(instance->baseline);
+        stream_free(instance->baseline);
+    }
+
+    furi_string_free(instance->line);
+    free(instance);
+}
+
+static bool test_bench_find_baseline(
+    TestBench* instance,
+    const char* suite,
+    const char* name,
+    uint32_t* cycles_avg) {
+    if(!instance->baseline) return false;
+
+    FuriString* key = furi_string_alloc_printf("%s,%s,", suite, name);
+    bool found = false;
+
+    // Baseline is small, linear scan keeps runner free of containers
+    stream_rewind(instance->baseline);
+    while(!found && stream_read_line(instance->baseline, instance->line)) {
+        if(!furi_string_start_with(instance->line, key)) continue;
+
+        const char* fields = furi_string_get_cstr(instance->line) + furi_string_size(key);
+        char* end = NULL;
+        uint32_t iterations = 0;
+        if(strint_to_uint32(fields, &end, &iterations, 10) != StrintParseNoError) break;
+        if(*end != ',') break;
+        if(strint_to_uint32(end + 1, &end, cycles_avg, 10) != StrintParseNoError) break;
+        found = true;
+    }
+
+    furi_string_free(key);
+    return found;
+}
+
+bool test_bench_add(TestBench* instance, const char* suite, const MuBenchResult* result) {
+    furi_check(instance);
+    furi_check(suite);
+    furi_check(result);
+
+    printf(
+        "%s: %lu cycles (min %lu, max %lu), heap peak %lu, allocations %lu\r\n",
+        result->name,
+        result->cycles_avg,
+        result->cycles_min,
+        result->cycles_max,
+        result->heap_peak,
+        result->allocations);
+
+    if(instance->results) {
+        stream_write_format(
+            instance->results,
+            "%s,%s,%lu,%lu,%lu,%lu,%lu,%lu\n",
+            suite,
+            result->name,
+            result->iterations,
+            result->cycles_avg,
+            result->cycles_min,
+            result->cycles_max,
+            result->heap_peak,
+            result->allocations);
+    }
+
+    bool passed = true;
+    uint32_t baseline_cycles = 0;
+    if(test_bench_find_baseline(instance, suite, result->name, &baseline_cycles) &&
+       baseline_cycles) {
+        // 64-bit math: cycle counts times 100 do not fit 32 bits
+        uint64_t limit = (uint64_t)baseline_cycles * (100 + instance->threshold) / 100;
+        int32_t change =
+            (int32_t)(((int64_t)result->cycles_avg - baseline_cycles) * 100 / baseline_cycles);
+        if(result->cycles_avg > limit) {
+            instance->regressions++;
+            passed = false;
+            printf(
+                _FURI_LOG_CLR_E "%s: regression %+ld%% against baseline %lu\r\n",
+                result->name,
+                change,
+                baseline_cycles);
+            printf(_FURI_LOG_CLR_RESET);
+        } else {
+            printf("%s: %+ld%% against baseline\r\n", result->name, change);
+        }
+    }
+
+    return passed;
+}
+
+size_t test_bench_get_regressions(TestBench* instance) {
+    furi_check(instance);
+    return instance->regressions;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "tests/test_api.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#define TEST_BENCH_RESULTS_PATH  EXT_PATH("unit_tests/bench.csv")
+#define TEST_BENCH_BASELINE_PATH EXT_PATH("unit_tests/bench_baseline.csv")
+
+#define TEST_BENCH_THRESHOLD_DEFAULT (10u)
+
+typedef struct TestBench TestBench;
+
+/** Allocate benchmark collector
+ *
+ * Results are written to TEST_BENCH_RESULTS_PATH.
+ *
+ * @param      storage    Storage instance
+ * @param      append     append to existing results instead of overwriting
+ * @param      compare    compare results against TEST_BENCH_BASELINE_PATH
+ * @param      threshold  allowed slowdown against baseline, percent
+ *
+ * @return     TestBench instance
+ */
+TestBench* test_bench_alloc(Storage* storage, bool append, bool compare, uint32_t threshold);
+
+void test_bench_free(TestBench* instance);
+
+/** Report, record and compare benchmark result
+ *
+ * @param      instance  TestBench instance
+ * @param      suite     test suite name
+ * @param      result    benchmark result
+ *
+ * @return     false if result regressed against baseline
+ */
+bool test_bench_add(TestBench* instance, const char* suite, const MuBenchResult* result);
+
+/** Get amount of results that regressed against baseline */
+size_t test_bench_get_regressions(TestBench* instance);
@@ -1,7 +1,9 @@
 #include "test_runner.h"
+#include "test_bench.h"
 
 #include "tests/test_api.h"
 
+#include <toolbox/args.h>
 #include <toolbox/cli/cli_command.h>
 #include <toolbox/path.h>
 #include <toolbox/pipe.h>
@@ -28,6 +30,14 @@ struct TestRunner {
     // Temporary used things
     PipeSide* pipe;
     FuriString* args;
+    FuriString* filter;
+
+    // Benchmark mode
+    bool bench;
+    bool bench_compare;
+    uint32_t bench_threshold;
+    TestBench* test_bench;
+    size_t bench_regressions;
 
     // ELF related stuff
     CompositeApiResolver* composite_resolver;
@@ -48,6 +58,8 @@ TestRunner* test_runner_alloc(PipeSide* pipe, FuriString* args) {
 
     instance->pipe = pipe;
     instance->args = args;
+    instance->filter = furi_string_alloc();
+    instance->bench_threshold = TEST_BENCH_THRESHOLD_DEFAULT;
 
     instance->composite_resolver = composite_api_resolver_alloc();
     composite_api_resolver_add(instance->composite_resolver, firmware_api_interface);
@@ -61,6 +73,8 @@ void test_runner_free(TestRunner* instance) {
 
     composite_api_resolver_free(instance->composite_resolver);
 
+    furi_string_free(instance->filter);
+
     furi_record_close(RECORD_NOTIFICATION);
     instance->notification = NULL;
 
@@ -76,7 +90,50 @@ void test_runner_free(TestRunner* instance) {
 #define TEST_RUNNER_TMP_DIR            EXT_PATH(".tmp")
 #define TEST_RUNNER_TMP_UNIT_TESTS_DIR TEST_RUNNER_TMP_DIR "/unit_tests"
 
-static bool test_runner_run_plugin(TestRunner* instance, const char* path) {
+// unit_tests [--bench [--compare] [--threshold <percent>]] [test_name]
+static bool test_runner_parse_args(TestRunner* instance) {
+    FuriString* word = furi_string_alloc();
+    bool result = true;
+
+    while(args_read_string_and_trim(instance->args, word)) {
+        if(furi_string_cmp_str(word, "--bench") == 0) {
+            instance->bench = true;
+        } else if(furi_string_cmp_str(word, "--compare") == 0) {
+            instance->bench_compare = true;
+        } else if(furi_string_cmp_str(word, "--threshold") == 0) {
+            int threshold = 0;
+            if(!args_read_int_and_trim(instance->args, &threshold) || threshold < 0) {
+                printf("Invalid threshold\r\n");
+                result = false;
+                break;
+            }
+            instance->bench_threshold = threshold;
+        } else if(furi_string_empty(instance->filter)) {
+            furi_string_set(instance->filter, word);
+        } else {
+            printf("Unexpected argument: %s\r\n", furi_string_get_cstr(word));
+            result = false;
+            break;
+        }
+    }
+
+    if(result && instance->bench_compare && !instance->bench) {
+        printf("--compare requires --bench\r\n");
+        result = false;
+    }
+
+    furi_string_free(word);
+    return result;
+}
+
+static void
+    test_runner_collect_bench(TestRunner* instance, const TestApi* test, const char* name) {
+    for(size_t i = 0; i < test->get_bench_count(); i++) {
+        test_bench_add(instance->test_bench, name, test->get_bench_result(i));
+    }
+}
+
+static bool test_runner_run_plugin(TestRunner* instance, const char* path, const char* name) {
     furi_assert(instance);
 
     FURI_LOG_D(TAG, "Loading %s", path);
@@ -107,9 +164,18 @@ static bool test_runner_run_plugin(TestRunner* instance, const char* path) {
         const FlipperAppPluginDescriptor* app_descriptor =
             flipper_application_plugin_get_descriptor(lib);
 
+        if(app_descriptor->ep_api_version != API_VERSION) {
+            FURI_LOG_E(TAG, "API version mismatch %s", path);
+            break;
+        }
+
         const TestApi* test = app_descriptor->entry_point;
 
+        test->set_bench_mode(instance->bench);
         instance->minunit_fail = test->run();
+        if(instance->bench) {
+            test_runner_collect_bench(instance, test, name);
+        }
 
         instance->minunit_run += test->get_minunit_run();
         instance->minunit_assert += test->get_minunit_assert();
@@ -167,14 +233,16 @@ static void test_runner_run_internal(TestRunner* instance) {
             const char* file_basename_cstr = furi_string_get_cstr(file_basename);
 
             bool result = true;
-            if(furi_string_size(instance->args)) {
-                if(furi_string_cmp_str(instance->args, file_basename_cstr) == 0) {
-                    result = test_runner_run_plugin(instance, furi_string_get_cstr(file_name));
+            if(furi_string_size(instance->filter)) {
+                if(furi_string_cmp_str(instance->filter, file_basename_cstr) == 0) {
+                    result = test_runner_run_plugin(
+                        instance, furi_string_get_cstr(file_name), file_basename_cstr);
                 } else {
                     printf("Skipping %s\r\n", file_basename_cstr);
                 }
             } else {
-                result = test_runner_run_plugin(instance, furi_string_get_cstr(file_name));
+                result = test_runner_run_plugin(
+                    instance, furi_string_get_cstr(file_name), file_basename_cstr);
             }
 
             if(!result) {
@@ -193,6 +261,10 @@ static void test_runner_run_internal(TestRunner* instance) {
 void test_runner_run(TestRunner* instance) {
     furi_assert(instance);
 
+    if(!test_runner_parse_args(instance)) {
+        return;
+    }
+
     // TODO FL-3491: lock device while test running
     if(loader_is_locked(instance->loader)) {
         printf("RPC: stop all applications to run tests\r\n");
@@ -200,11 +272,28 @@ void test_runner_run(TestRunner* instance) {
     } else {
         notification_message_block(instance->notification, &sequence_set_only_blue_255);
 
+        // Objects cached by pools are not leaks
+        furi_object_pool_trim_all();
         uint32_t heap_before = memmgr_get_free_heap();
         uint32_t cycle_counter = furi_get_tick();
 
+        if(instance->bench) {
+            instance->test_bench = test_bench_alloc(
+                instance->storage, false, instance->bench_compare, instance->bench_threshold);
+        }
+
         test_runner_run_internal(instance);
 
+        if(instance->test_bench) {
+            instance->bench_regressions = test_bench_get_regressions(instance->test_bench);
+            test_bench_free(instance->test_bench);
+            instance->test_bench = NULL;
+            if(instance->bench_regressions) {
+                printf("\r\nBenchmark regressions: %zu\r\n", instance->bench_regressions);
+            }
+            printf("Benchmark results: %s\r\n", TEST_BENCH_RESULTS_PATH);
+        }
+
         if(instance->minunit_run != 0) {
             printf("\r\nFailed tests: %d\r\n", instance->minunit_fail);
 
@@ -214,11 +303,12 @@ void test_runner_run(TestRunner* instance) {
 
             // Wait for tested services and apps to deallocate memory
             furi_delay_ms(200);
+            furi_object_pool_trim_all();
             uint32_t heap_after = memmgr_get_free_heap();
             printf("Leaked: %ld\r\n", heap_before - heap_after);
 
             // Final Report
-            if(instance->minunit_fail == 0) {
+            if(instance->minunit_fail == 0 && instance->bench_regressions == 0) {
                 notification_message(instance->notification, &sequence_success);
                 printf("Status: PASSED\r\n");
             } else {
@@ -0,0 +1,219 @@
+#include "../test.h" // IWYU pragma: keep
+
+#include <furi.h>
+#include <applications/main/bad_usb/helpers/ducky_script_i.h>
+
+// Way more than any test script takes, guards against endless REPEAT loops
+#define BAD_USB_TEST_STEPS_MAX (1000U)
+
+#define BAD_USB_TEST_PAYLOAD_LINES    (40U)
+#define BAD_USB_TEST_PAYLOAD_LINE_LEN (1500U)
+#define BAD_USB_TEST_PAYLOAD_LONG_LEN (20000U)
+
+typedef struct {
+    DuckyOpType type;
+    uint32_t value; // Keys for STRING, count for REPEAT
+} BadUsbTestLine;
+
+static void bad_usb_test_push_op(DuckyOpArray_t ops, DuckyOpType type, uint32_t line) {
+    DuckyOp op = {.type = type, .line = line};
+    DuckyOpArray_push_back(ops, op);
+}
+
+static void bad_usb_test_push_repeat(DuckyOpArray_t ops, uint32_t count, uint32_t line) {
+    DuckyOp op = {.line = line};
+    mu_check(ducky_op_repeat_compile(ops, count, &op));
+    DuckyOpArray_push_back(ops, op);
+}
+
+// Same walk as the worker, counts executions of every line
+static void bad_usb_test_run(DuckyOpArray_t ops, uint32_t* executed, size_t lines) {
+    size_t pos = 0;
+    uint32_t repeat_cnt = 0;
+
+    for(size_t step = 0; pos < DuckyOpArray_size(ops); step++) {
+        mu_assert(step < BAD_USB_TEST_STEPS_MAX, "script never ends");
+
+        const DuckyOp* op = DuckyOpArray_cget(ops, pos);
+        if(op->type == DuckyOpTypeRepeat) {
+            pos = ducky_op_repeat_step(op, pos, &repeat_cnt);
+        } else {
+            mu_assert(op->line < lines, "unexpected line");
+            executed[op->line]++;
+            pos++;
+        }
+    }
+}
+
+MU_TEST(test_bad_usb_repeat) {
+    DuckyOpArray_t ops;
+    DuckyOpArray_init(ops);
+    uint32_t executed[4] = {};
+
+    // STRING a, REPEAT 2, STRING b
+    bad_usb_test_push_op(ops, DuckyOpTypeString, 1);
+    bad_usb_test_push_repeat(ops, 2, 2);
+    bad_usb_test_push_op(ops, DuckyOpTypeString, 3);
+    bad_usb_test_run(ops, executed, COUNT_OF(executed));
+
+    mu_assert_int_eq(3, executed[1]);
+    mu_assert_int_eq(1, executed[3]);
+
+    DuckyOpArray_clear(ops);
+}
+
+MU_TEST(test_bad_usb_repeat_back_to_back) {
+    DuckyOpArray_t ops;
+    DuckyOpArray_init(ops);
+    uint32_t executed[6] = {};
+
+    // STRING a, REPEAT 2, REPEAT 3, REPEAT 1, STRING b
+    bad_usb_test_push_op(ops, DuckyOpTypeString, 1);
+    bad_usb_test_push_repeat(ops, 2, 2);
+    bad_usb_test_push_repeat(ops, 3, 3);
+    bad_usb_test_push_repeat(ops, 1, 4);
+    bad_usb_test_push_op(ops, DuckyOpTypeString, 5);
+    bad_usb_test_run(ops, executed, COUNT_OF(executed));
+
+    // Every REPEAT repeats the last command
+    mu_assert_int_eq(1 + 2 + 3 + 1, executed[1]);
+    mu_assert_int_eq(1, executed[5]);
+
+    DuckyOpArray_clear(ops);
+}
+
+MU_TEST(test_bad_usb_repeat_first_line) {
+    DuckyOpArray_t ops;
+    DuckyOpArray_init(ops);
+    uint32_t executed[4] = {};
+
+    // REPEAT 2, REPEAT 2, STRING a
+    bad_usb_test_push_repeat(ops, 2, 1);
+    bad_usb_test_push_repeat(ops, 2, 2);
+    bad_usb_test_push_op(ops, DuckyOpTypeString, 3);
+    bad_usb_test_run(ops, executed, COUNT_OF(executed));
+
+    mu_assert_int_eq(1, executed[3]);
+
+    DuckyOpArray_clear(ops);
+}
+
+MU_TEST(test_bad_usb_repeat_overflow) {
+    DuckyOpArray_t ops;
+    DuckyOpArray_init(ops);
+
+    bad_usb_test_push_op(ops, DuckyOpTypeString, 1);
+    bad_usb_test_push_repeat(ops, UINT32_MAX - 2, 2);
+
+    DuckyOp op = {};
+    mu_check(!ducky_op_repeat_compile(ops, 2, &op));
+
+    DuckyOpArray_clear(ops);
+}
+
+// Same windowing as the compiler, next is set to the first line of the next window
+static void bad_usb_test_compile_window(
+    DuckyOpArray_t ops,
+    DuckyKeyArray_t keys,
+    const BadUsbTestLine* lines,
+    size_t lines_nb,
+    size_t start,
+    size_t* next) {
+    DuckyOpArray_reset(ops);
+    DuckyKeyArray_reset(keys);
+
+    *next = lines_nb;
+    for(size_t i = start; i < lines_nb; i++) {
+        size_t keys_nb = DuckyKeyArray_size(keys);
+        DuckyOp op = {.line = i};
+        if(lines[i].type == DuckyOpTypeRepeat) {
+            mu_check(ducky_op_repeat_compile(ops, lines[i].value, &op));
+        } else {
+            op.type = lines[i].type;
+            op.keys.offset = keys_nb;
+            op.keys.len = lines[i].value;
+            for(size_t k = 0; k < lines[i].value; k++) {
+                DuckyKeyArray_push_back(keys, HID_KEYBOARD_A);
+            }
+        }
+
+        if(!ducky_window_accepts(ops, keys_nb, &op)) {
+            DuckyKeyArray_resize(keys, keys_nb);
+            *next = i;
+            break;
+        }
+        DuckyOpArray_push_back(ops, op);
+    }
+}
+
+MU_TEST(test_bad_usb_window_payload) {
+    DuckyOpArray_t ops;
+    DuckyOpArray_init(ops);
+    DuckyKeyArray_t keys;
+    DuckyKeyArray_init(keys);
+
+    // STRING of 1500 chars, REPEAT 2, REPEAT 1, 40 times, then STRING of 20000 chars
+    const size_t lines_nb = BAD_USB_TEST_PAYLOAD_LINES * 3 + 1;
+    BadUsbTestLine* lines = malloc(sizeof(BadUsbTestLine) * lines_nb);
+    uint32_t* executed = malloc(sizeof(uint32_t) * lines_nb);
+    size_t payload = 0;
+    for(size_t i = 0; i < BAD_USB_TEST_PAYLOAD_LINES; i++) {
+        lines[i * 3] = (BadUsbTestLine){DuckyOpTypeString, BAD_USB_TEST_PAYLOAD_LINE_LEN};
+        lines[i * 3 + 1] = (BadUsbTestLine){DuckyOpTypeRepeat, 2};
+        lines[i * 3 + 2] = (BadUsbTestLine){DuckyOpTypeRepeat, 1};
+        payload += BAD_USB_TEST_PAYLOAD_LINE_LEN * 4;
+    }
+    lines[lines_nb - 1] = (BadUsbTestLine){DuckyOpTypeString, BAD_USB_TEST_PAYLOAD_LONG_LEN};
+    payload += BAD_USB_TEST_PAYLOAD_LONG_LEN;
+    mu_check(payload * sizeof(uint16_t) > DUCKY_SCRIPT_WINDOW_SIZE);
+
+    size_t windows = 0;
+    size_t typed = 0;
+    for(size_t start = 0; start < lines_nb; windows++) {
+        size_t next = start;
+        bad_usb_test_compile_window(ops, keys, lines, lines_nb, start, &next);
+        mu_assert(next > start, "empty window");
+
+        // Window only grows past the limit by its last STRING
+        size_t last = next - 1;
+        while(lines[last].type == DuckyOpTypeRepeat) last--;
+        size_t last_keys = lines[last].value;
+        mu_assert(
+            (DuckyKeyArray_size(keys) - last_keys) * sizeof(uint16_t) <= DUCKY_SCRIPT_WINDOW_SIZE,
+            "window too large");
+
+        bad_usb_test_run(ops, executed, next);
+        for(size_t i = start; i < next; i++) {
+            if(lines[i].type == DuckyOpTypeString) {
+                typed += executed[i] * lines[i].value;
+            }
+        }
+        start = next;
+    }
+
+    mu_check(windows > 1);
+    mu_assert_int_eq(payload, typed);
+    for(size_t i = 0; i < BAD_USB_TEST_PAYLOAD_LINES; i++) {
+        mu_assert_int_eq(1 + 2 + 1, executed[i * 3]);
+    }
+
+    free(executed);
+    free(lines);
+    DuckyKeyArray_clear(keys);
+    DuckyOpArray_clear(ops);
+}
+
+MU_TEST_SUITE(test_bad_usb_suite) {
+    MU_RUN_TEST(test_bad_usb_repeat);
+    MU_RUN_TEST(test_bad_usb_repeat_back_to_back);
+    MU_RUN_TEST(test_bad_usb_repeat_first_line);
+    MU_RUN_TEST(test_bad_usb_repeat_overflow);
+    MU_RUN_TEST(test_bad_usb_window_payload);
+}
+
+int run_minunit_test_bad_usb(void) {
+    MU_RUN_SUITE(test_bad_usb_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_bad_usb)
@@ -708,6 +708,28 @@ MU_TEST(test_bit_lib_bytes_to_num_bcd) {
     mu_assert_int_eq(false, is_bcd_res);
 }
 
+MU_BENCH(bench_bit_lib_crc16) {
+    uint8_t data[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    for(size_t i = 0; i < 64; i++) {
+        mu_assert_int_eq(
+            0x29B1, bit_lib_crc16(data, sizeof(data), 0x1021, 0xFFFF, false, false, 0x0000));
+    }
+}
+
+MU_BENCH(bench_bit_lib_get_bits_32) {
+    uint8_t data[32];
+    for(size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+
+    // Every bit offset, covers aligned and unaligned reads
+    uint32_t checksum = 0;
+    for(size_t position = 0; position <= (sizeof(data) - 4) * 8; position++) {
+        checksum ^= bit_lib_get_bits_32(data, position, 32);
+    }
+    mu_check(checksum != 0);
+}
+
 MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_increment_index);
     MU_RUN_TEST(test_bit_lib_is_set);
@@ -732,6 +754,9 @@ MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_bytes_to_num_be);
     MU_RUN_TEST(test_bit_lib_bytes_to_num_le);
     MU_RUN_TEST(test_bit_lib_bytes_to_num_bcd);
+
+    MU_RUN_BENCH(bench_bit_lib_crc16, 200);
+    MU_RUN_BENCH(bench_bit_lib_get_bits_32, 200);
 }
 
 int run_minunit_test_bit_lib(void) {
@@ -2,6 +2,13 @@
 #include "../minunit_vars.h"
 
 #include <furi.h>
+#include <furi_hal.h>
+
+#define MU_BENCH_RESULTS_MAX (32)
+
+static bool minunit_bench_enabled = false;
+static MuBenchResult minunit_bench_results[MU_BENCH_RESULTS_MAX];
+static size_t minunit_bench_count = 0;
 
 void minunit_print_progress(void) {
     static const char progress[] = {'\\', '|', '/', '-'};
@@ -40,3 +47,96 @@ int get_minunit_assert(void) {
 int get_minunit_status(void) {
     return minunit_status;
 }
+
+void set_bench_mode(bool enabled) {
+    minunit_bench_enabled = enabled;
+}
+
+size_t get_bench_count(void) {
+    return minunit_bench_count;
+}
+
+const MuBenchResult* get_bench_result(size_t index) {
+    furi_check(index < minunit_bench_count);
+    return &minunit_bench_results[index];
+}
+
+static void minunit_bench_measure(const char* name, void (*bench)(void), uint32_t iterations) {
+    // Warm up caches and lazily allocated state
+    uint32_t warmup = iterations / 10 + 1;
+    for(uint32_t i = 0; i < warmup && !minunit_status; i++) {
+        bench();
+    }
+    if(minunit_status) return;
+
+    // Per iteration timing: whole loop could overflow 32-bit cycle counter
+    uint64_t cycles_total = 0;
+    uint32_t cycles_min = UINT32_MAX;
+    uint32_t cycles_max = 0;
+    for(uint32_t i = 0; i < iterations; i++) {
+        uint32_t start = DWT->CYCCNT;
+        bench();
+        uint32_t cycles = DWT->CYCCNT - start;
+        if(minunit_status) return;
+
+        cycles_total += cycles;
+        cycles_min = MIN(cycles_min, cycles);
+        cycles_max = MAX(cycles_max, cycles);
+    }
+
+    // Separate pass, heap tracing slows allocator down
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    bool trace_owned = memmgr_heap_get_thread_memory(thread_id) == MEMMGR_HEAP_UNKNOWN;
+    if(trace_owned) memmgr_heap_enable_thread_trace(thread_id);
+
+    MemmgrHeapThreadStats stats_before = {0};
+    MemmgrHeapThreadStats stats_after = {0};
+    memmgr_heap_reset_thread_stats(thread_id);
+    bool heap_traced = memmgr_heap_get_thread_stats(thread_id, &stats_before);
+    bench();
+    heap_traced &= memmgr_heap_get_thread_stats(thread_id, &stats_after);
+
+    if(trace_owned) memmgr_heap_disable_thread_trace(thread_id);
+    if(minunit_status) return;
+
+    if(minunit_bench_count >= MU_BENCH_RESULTS_MAX) {
+        minunit_printf_warning("Too many benchmarks, %s is not recorded", name);
+        return;
+    }
+
+    MuBenchResult* result = &minunit_bench_results[minunit_bench_count++];
+    result->name = name;
+    result->iterations = iterations;
+    result->cycles_avg = cycles_total / iterations;
+    result->cycles_min = cycles_min;
+    result->cycles_max = cycles_max;
+    result->heap_peak = heap_traced ? stats_after.peak - stats_before.current : 0;
+    result->allocations = heap_traced ? stats_after.allocations : 0;
+}
+
+void minunit_bench_run(
+    const char* name,
+    void (*bench)(void),
+    uint32_t iterations,
+    void (*setup)(void),
+    void (*teardown)(void)) {
+    furi_check(iterations);
+
+    if(setup) setup();
+    minunit_status = 0;
+
+    if(minunit_bench_enabled) {
+        minunit_bench_measure(name, bench, iterations);
+    } else {
+        bench();
+    }
+
+    minunit_run++;
+    if(minunit_status) {
+        minunit_fail++;
+        minunit_print_fail(minunit_last_message);
+        minunit_status = 0;
+    }
+
+    if(teardown) teardown();
+}
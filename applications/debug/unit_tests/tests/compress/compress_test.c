@@ -338,11 +338,40 @@ static void compress_test_heatshrink_tar() {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_BENCH(compress_bench_heatshrink_comp_decomp) {
+    static const size_t data_size = 1024;
+
+    // Compressible data: repeated text with a counter
+    uint8_t* src_buff = malloc(data_size);
+    for(size_t i = 0; i < data_size; i++) {
+        src_buff[i] = (i % 64 < 48) ? "Flipper Zero benchmark "[i % 23] : (uint8_t)(i / 64);
+    }
+
+    Compress* comp = compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+    uint8_t* encoded_buff = malloc(data_size);
+    uint8_t* decoded_buff = malloc(data_size);
+
+    size_t encoded_size = 0;
+    size_t decoded_size = 0;
+    mu_check(compress_encode(comp, src_buff, data_size, encoded_buff, data_size, &encoded_size));
+    mu_check(
+        compress_decode(comp, encoded_buff, encoded_size, decoded_buff, data_size, &decoded_size));
+    mu_assert_int_eq(data_size, decoded_size);
+    mu_assert_mem_eq(src_buff, decoded_buff, data_size);
+
+    free(decoded_buff);
+    free(encoded_buff);
+    compress_free(comp);
+    free(src_buff);
+}
+
 MU_TEST_SUITE(test_compress) {
     MU_RUN_TEST(compress_test_random_comp_decomp);
     MU_RUN_TEST(compress_test_reference_comp_decomp);
     MU_RUN_TEST(compress_test_heatshrink_stream);
     MU_RUN_TEST(compress_test_heatshrink_tar);
+
+    MU_RUN_BENCH(compress_bench_heatshrink_comp_decomp, 50);
 }
 
 int run_minunit_test_compress(void) {
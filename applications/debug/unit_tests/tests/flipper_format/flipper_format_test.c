@@ -529,6 +529,11 @@ MU_TEST(flipper_format_oddities_test) {
     mu_assert(test_read(test_file_linux), "Read test error [Oddities]");
 }
 
+MU_BENCH(flipper_format_bench_write_read) {
+    mu_assert(test_write(TEST_DIR "ff_bench.test"), "Bench write error");
+    mu_assert(test_read(TEST_DIR "ff_bench.test"), "Bench read error");
+}
+
 MU_TEST_SUITE(flipper_format) {
     tests_setup();
     MU_RUN_TEST(flipper_format_write_test);
@@ -543,6 +548,7 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
     MU_RUN_TEST(flipper_format_oddities_test);
+    MU_RUN_BENCH(flipper_format_bench_write_read, 20);
     tests_teardown();
 }
 
@@ -0,0 +1,56 @@
+#include <furi.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define ARENA_CHUNK_SIZE (64U)
+
+void test_furi_arena(void) {
+    FuriArena* arena = furi_arena_alloc(ARENA_CHUNK_SIZE);
+    FuriArenaStats stats;
+
+    uint8_t* first = furi_arena_malloc(arena, 10);
+    mu_assert_int_eq(0, (uintptr_t)first % 8);
+    memset(first, 0xFF, 10);
+
+    FuriArenaScope outer;
+    furi_arena_scope_enter(arena, &outer);
+
+    // Fill several chunks and make one oversized allocation
+    for(size_t i = 0; i < 16; i++) {
+        uint8_t* data = furi_arena_malloc(arena, 20);
+        mu_assert_int_eq(0, data[0]);
+        mu_assert_int_eq(0, data[19]);
+        memset(data, 0xFF, 20);
+    }
+    furi_arena_malloc(arena, ARENA_CHUNK_SIZE * 4);
+
+    FuriArenaScope inner;
+    furi_arena_scope_enter(arena, &inner);
+    char* copy = furi_arena_strdup(arena, "arena");
+    mu_assert_string_eq("arena", copy);
+    furi_arena_scope_exit(arena, &inner);
+
+    furi_arena_get_stats(arena, &stats);
+    mu_assert(stats.chunk_count > 1, "Arena must grow");
+    size_t peak_used = stats.peak_used;
+
+    // Outer scope releases everything but the first allocation
+    furi_arena_scope_exit(arena, &outer);
+    furi_arena_get_stats(arena, &stats);
+    mu_assert_int_eq(16, stats.used);
+    mu_assert_int_eq(1, stats.chunk_count);
+    mu_assert_int_eq(ARENA_CHUNK_SIZE, stats.reserved);
+    mu_assert_int_eq(peak_used, stats.peak_used);
+    mu_assert_int_eq(0xFF, first[9]);
+
+    // Reset keeps first chunk, memory is handed out zeroed again
+    furi_arena_reset(arena);
+    furi_arena_get_stats(arena, &stats);
+    mu_assert_int_eq(0, stats.used);
+    mu_assert_int_eq(1, stats.chunk_count);
+
+    uint8_t* again = furi_arena_malloc(arena, 10);
+    mu_assert(again == first, "First chunk must be reused");
+    mu_assert_int_eq(0, again[9]);
+
+    furi_arena_free(arena);
+}
@@ -12,6 +12,10 @@
 #define PRIMITIVE_COUNT  (4UL)
 #define RUN_COUNT        (2UL)
 
+#define TIMER_STRESS_COUNT         (1000UL)
+#define TIMER_STRESS_PERIODIC_RUNS (3UL)
+#define TIMER_STRESS_TIMEOUT       (5000UL)
+
 typedef struct {
     FuriEventLoop* event_loop;
     uint32_t message_queue_count;
@@ -495,6 +499,101 @@ void test_furi_event_loop_self_unsubscribe(void) {
     furi_event_loop_free(event_loop);
 }
 
+typedef struct {
+    FuriEventLoop* event_loop;
+    size_t fired;
+    size_t expected;
+    size_t early;
+} TestFuriEventLoopTimerStress;
+
+typedef struct {
+    TestFuriEventLoopTimerStress* stress;
+    FuriEventLoopTimer* timer;
+    uint32_t deadline;
+    uint32_t interval;
+    uint32_t fire_count;
+} TestFuriEventLoopTimerStressItem;
+
+static void test_furi_event_loop_timer_stress_callback(void* context) {
+    TestFuriEventLoopTimerStressItem* item = context;
+    TestFuriEventLoopTimerStress* stress = item->stress;
+
+    if((int32_t)(furi_get_tick() - item->deadline) < 0) {
+        stress->early++;
+    }
+
+    item->fire_count++;
+    item->deadline += item->interval;
+    if(furi_event_loop_timer_is_running(item->timer) &&
+       item->fire_count == TIMER_STRESS_PERIODIC_RUNS) {
+        furi_event_loop_timer_stop(item->timer);
+    }
+
+    if(++stress->fired == stress->expected) {
+        furi_event_loop_stop(stress->event_loop);
+    }
+}
+
+static void test_furi_event_loop_timer_stress_timeout_callback(void* context) {
+    furi_event_loop_stop(context);
+}
+
+void test_furi_event_loop_timer_stress(void) {
+    TestFuriEventLoopTimerStress stress = {
+        .event_loop = furi_event_loop_alloc(),
+    };
+    TestFuriEventLoopTimerStressItem* items =
+        malloc(sizeof(TestFuriEventLoopTimerStressItem) * TIMER_STRESS_COUNT);
+
+    FuriEventLoopTimer* timeout = furi_event_loop_timer_alloc(
+        stress.event_loop,
+        test_furi_event_loop_timer_stress_timeout_callback,
+        FuriEventLoopTimerTypeOnce,
+        stress.event_loop);
+    furi_event_loop_timer_start(timeout, TIMER_STRESS_TIMEOUT);
+
+    // Mix of short periodic timers and one shot timers spread over a few wheel levels
+    for(size_t i = 0; i < TIMER_STRESS_COUNT; i++) {
+        TestFuriEventLoopTimerStressItem* item = &items[i];
+        bool periodic = (i % 4) == 0;
+
+        item->stress = &stress;
+        item->interval = periodic ? 10 + (i % 50) : 1 + (i * 37) % 300;
+        item->timer = furi_event_loop_timer_alloc(
+            stress.event_loop,
+            test_furi_event_loop_timer_stress_callback,
+            periodic ? FuriEventLoopTimerTypePeriodic : FuriEventLoopTimerTypeOnce,
+            item);
+        item->deadline = furi_get_tick() + item->interval;
+        furi_event_loop_timer_start(item->timer, item->interval);
+
+        if(periodic) {
+            stress.expected += TIMER_STRESS_PERIODIC_RUNS;
+        } else if((i % 10) == 5) {
+            furi_event_loop_timer_stop(item->timer);
+        } else {
+            stress.expected++;
+        }
+    }
+
+    furi_event_loop_run(stress.event_loop);
+
+    mu_assert_int_eq(stress.expected, stress.fired);
+    mu_assert_int_eq(0, stress.early);
+
+    for(size_t i = 0; i < TIMER_STRESS_COUNT; i++) {
+        uint32_t fire_count = (i % 4) == 0  ? TIMER_STRESS_PERIODIC_RUNS :
+                              (i % 10) == 5 ? 0 :
+                                              1;
+        mu_assert_int_eq(fire_count, items[i].fire_count);
+        furi_event_loop_timer_free(items[i].timer);
+    }
+
+    furi_event_loop_timer_free(timeout);
+    furi_event_loop_free(stress.event_loop);
+    free(items);
+}
+
 void test_furi_event_loop(void) {
     TestFuriEventLoopData data = {};
 
@@ -0,0 +1,62 @@
+#include <furi.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define OBJECT_POOL_OBJECT_SIZE (24U)
+#define OBJECT_POOL_CACHE_LIMIT (2U)
+
+static void test_furi_object_pool_is_zero(const uint8_t* object) {
+    for(size_t i = 0; i < OBJECT_POOL_OBJECT_SIZE; i++) {
+        mu_assert_int_eq(0, object[i]);
+    }
+}
+
+void test_furi_object_pool(void) {
+    FuriObjectPool* pool =
+        furi_object_pool_alloc("Test", OBJECT_POOL_OBJECT_SIZE, OBJECT_POOL_CACHE_LIMIT);
+    FuriObjectPoolStats stats;
+
+    uint8_t* objects[OBJECT_POOL_CACHE_LIMIT + 1];
+    for(size_t i = 0; i < COUNT_OF(objects); i++) {
+        objects[i] = furi_object_pool_get(pool);
+        test_furi_object_pool_is_zero(objects[i]);
+        memset(objects[i], 0xA5, OBJECT_POOL_OBJECT_SIZE);
+    }
+
+    furi_object_pool_get_stats(pool, &stats);
+    mu_assert_int_eq(COUNT_OF(objects), stats.in_use);
+    mu_assert_int_eq(COUNT_OF(objects), stats.misses);
+    mu_assert_int_eq(0, stats.cached);
+
+    // Only cache limit is kept, the rest goes back to heap
+    for(size_t i = 0; i < COUNT_OF(objects); i++) {
+        furi_object_pool_put(pool, objects[i]);
+    }
+
+    furi_object_pool_get_stats(pool, &stats);
+    mu_assert_int_eq(0, stats.in_use);
+    mu_assert_int_eq(COUNT_OF(objects), stats.peak);
+    mu_assert_int_eq(OBJECT_POOL_CACHE_LIMIT, stats.cached);
+
+    // Cached objects are reused and zeroed
+    for(size_t i = 0; i < OBJECT_POOL_CACHE_LIMIT; i++) {
+        uint8_t* object = furi_object_pool_get(pool);
+        test_furi_object_pool_is_zero(object);
+        furi_object_pool_put(pool, object);
+    }
+
+    furi_object_pool_get_stats(pool, &stats);
+    mu_assert_int_eq(OBJECT_POOL_CACHE_LIMIT, stats.hits);
+
+    // New pool is listed
+    bool listed = false;
+    for(size_t i = 0; furi_object_pool_get_stats_by_index(i, &stats); i++) {
+        listed |= strcmp(stats.name, "Test") == 0;
+    }
+    mu_assert(listed, "Pool is not listed");
+
+    furi_object_pool_trim(pool);
+    furi_object_pool_get_stats(pool, &stats);
+    mu_assert_int_eq(0, stats.cached);
+
+    furi_object_pool_free(pool);
+}
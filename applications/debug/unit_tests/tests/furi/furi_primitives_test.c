@@ -49,6 +49,37 @@ static void test_furi_message_queue(TestFuriPrimitivesData* data) {
     mu_assert_int_eq(MESSAGE_QUEUE_CAPACITY, furi_message_queue_get_space(message_queue));
 }
 
+static void test_furi_message_queue_batch(TestFuriPrimitivesData* data) {
+    FuriMessageQueue* message_queue = data->message_queue;
+
+    uint32_t values[MESSAGE_QUEUE_CAPACITY];
+    uint32_t count = COUNT_OF(values);
+    mu_assert_int_eq(
+        FuriStatusErrorResource,
+        furi_message_queue_get_batch(message_queue, values, &count, 0));
+    mu_assert_int_eq(0, count);
+
+    for(uint32_t i = 0; i < MESSAGE_QUEUE_CAPACITY; ++i) {
+        mu_assert_int_eq(FuriStatusOk, furi_message_queue_put(message_queue, &i, 0));
+    }
+
+    count = 3;
+    mu_assert_int_eq(FuriStatusOk, furi_message_queue_get_batch(message_queue, values, &count, 0));
+    mu_assert_int_eq(3, count);
+    for(uint32_t i = 0; i < count; ++i) {
+        mu_assert_int_eq(i, values[i]);
+    }
+
+    count = COUNT_OF(values);
+    mu_assert_int_eq(FuriStatusOk, furi_message_queue_get_batch(message_queue, values, &count, 0));
+    mu_assert_int_eq(MESSAGE_QUEUE_CAPACITY - 3, count);
+    for(uint32_t i = 0; i < count; ++i) {
+        mu_assert_int_eq(i + 3, values[i]);
+    }
+
+    mu_assert_int_eq(0, furi_message_queue_get_count(message_queue));
+}
+
 static void test_furi_stream_buffer(TestFuriPrimitivesData* data) {
     FuriStreamBuffer* stream_buffer = data->stream_buffer;
 
@@ -96,6 +127,7 @@ void test_furi_primitives(void) {
     };
 
     test_furi_message_queue(&data);
+    test_furi_message_queue_batch(&data);
     test_furi_stream_buffer(&data);
 
     furi_message_queue_free(data.message_queue);
@@ -43,3 +43,179 @@ void test_furi_pubsub(void) {
     // delete pubsub case
     furi_pubsub_free(test_pubsub);
 }
+
+typedef struct {
+    FuriPubSub* pubsub;
+    FuriPubSubSubscription* subscription;
+    FuriPubSubSubscription* next_subscription;
+    uint32_t count;
+} TestPubSubReentrant;
+
+void test_pubsub_reentrant_next_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    TestPubSubReentrant* context = ctx;
+    context->count += 100;
+}
+
+void test_pubsub_reentrant_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    TestPubSubReentrant* context = ctx;
+    context->count++;
+
+    // Would deadlock if lock was held during delivery
+    furi_pubsub_unsubscribe(context->pubsub, context->subscription);
+    context->next_subscription =
+        furi_pubsub_subscribe(context->pubsub, test_pubsub_reentrant_next_handler, context);
+}
+
+void test_furi_pubsub_reentrant(void) {
+    TestPubSubReentrant context = {
+        .pubsub = furi_pubsub_alloc(),
+    };
+
+    context.subscription =
+        furi_pubsub_subscribe(context.pubsub, test_pubsub_reentrant_handler, &context);
+
+    // Snapshot taken at publish time does not contain the new subscription
+    furi_pubsub_publish(context.pubsub, (void*)&notify_value_0);
+    mu_assert_int_eq(1, context.count);
+
+    furi_pubsub_publish(context.pubsub, (void*)&notify_value_1);
+    mu_assert_int_eq(101, context.count);
+
+    furi_pubsub_unsubscribe(context.pubsub, context.next_subscription);
+    furi_pubsub_free(context.pubsub);
+}
+
+void test_furi_pubsub_queue(void) {
+    FuriPubSub* test_pubsub = furi_pubsub_alloc();
+    FuriMessageQueue* queue = furi_message_queue_alloc(2, sizeof(uint32_t));
+
+    FuriPubSubSubscription* test_pubsub_subscription =
+        furi_pubsub_subscribe_queue(test_pubsub, queue);
+    mu_assert_pointers_not_eq(test_pubsub_subscription, NULL);
+
+    // Publisher never waits for the consumer
+    furi_pubsub_publish(test_pubsub, (void*)&notify_value_0);
+    furi_pubsub_publish(test_pubsub, (void*)&notify_value_1);
+    furi_pubsub_publish(test_pubsub, (void*)&notify_value_1);
+    mu_assert_int_eq(1, furi_pubsub_subscription_get_dropped_count(test_pubsub_subscription));
+
+    uint32_t value = 0;
+    mu_assert_int_eq(FuriStatusOk, furi_message_queue_get(queue, &value, 0));
+    mu_assert_int_eq(notify_value_0, value);
+    mu_assert_int_eq(FuriStatusOk, furi_message_queue_get(queue, &value, 0));
+    mu_assert_int_eq(notify_value_1, value);
+    mu_assert_int_eq(0, furi_message_queue_get_count(queue));
+
+    furi_pubsub_unsubscribe(test_pubsub, test_pubsub_subscription);
+
+    furi_pubsub_publish(test_pubsub, (void*)&notify_value_0);
+    mu_assert_int_eq(0, furi_message_queue_get_count(queue));
+
+    furi_message_queue_free(queue);
+    furi_pubsub_free(test_pubsub);
+}
+
+typedef struct {
+    FuriPubSub* pubsub;
+    FuriPubSubSubscription* subscription;
+    FuriThreadId unsubscriber;
+    FuriSemaphore* entered;
+    FuriSemaphore* other_done;
+    FuriSemaphore* unsubscribed;
+    uint32_t count;
+} TestPubSubConcurrent;
+
+void test_pubsub_concurrent_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    TestPubSubConcurrent* context = ctx;
+    __atomic_add_fetch(&context->count, 1, __ATOMIC_SEQ_CST);
+
+    if(furi_thread_get_current_id() != context->unsubscriber) return;
+
+    // Let the other thread deliver to the same subscription and leave
+    furi_semaphore_release(context->entered);
+    furi_check(furi_semaphore_acquire(context->other_done, FuriWaitForever) == FuriStatusOk);
+
+    furi_pubsub_unsubscribe(context->pubsub, context->subscription);
+    furi_semaphore_release(context->unsubscribed);
+}
+
+static int32_t test_pubsub_concurrent_publisher(void* ctx) {
+    TestPubSubConcurrent* context = ctx;
+    context->unsubscriber = furi_thread_get_current_id();
+    furi_pubsub_publish(context->pubsub, (void*)&notify_value_0);
+    return 0;
+}
+
+void test_furi_pubsub_concurrent(void) {
+    TestPubSubConcurrent context = {
+        .pubsub = furi_pubsub_alloc(),
+        .entered = furi_semaphore_alloc(1, 0),
+        .other_done = furi_semaphore_alloc(1, 0),
+        .unsubscribed = furi_semaphore_alloc(1, 0),
+    };
+    context.subscription =
+        furi_pubsub_subscribe(context.pubsub, test_pubsub_concurrent_handler, &context);
+
+    FuriThread* thread = furi_thread_alloc_ex(
+        "PubSubPublisher", 1024, test_pubsub_concurrent_publisher, &context);
+    furi_thread_start(thread);
+
+    // Both threads deliver to the subscription, ours leaves first
+    mu_assert_int_eq(
+        FuriStatusOk, furi_semaphore_acquire(context.entered, furi_ms_to_ticks(1000)));
+    furi_pubsub_publish(context.pubsub, (void*)&notify_value_1);
+    furi_semaphore_release(context.other_done);
+
+    // Unsubscribe from the callback only waits for deliveries of other threads
+    mu_assert_int_eq(
+        FuriStatusOk, furi_semaphore_acquire(context.unsubscribed, furi_ms_to_ticks(1000)));
+    furi_thread_join(thread);
+    mu_assert_int_eq(2, context.count);
+
+    furi_thread_free(thread);
+    furi_semaphore_free(context.unsubscribed);
+    furi_semaphore_free(context.other_done);
+    furi_semaphore_free(context.entered);
+    furi_pubsub_free(context.pubsub);
+}
+
+typedef struct {
+    FuriPubSub* pubsub;
+    FuriPubSubSubscription* subscription;
+    uint32_t depth;
+    uint32_t count;
+} TestPubSubNested;
+
+void test_pubsub_nested_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    TestPubSubNested* context = ctx;
+    context->count++;
+
+    // Publish into the same pubsub from the callback, unsubscribe from the inner delivery
+    if(context->depth++ == 0) {
+        furi_pubsub_publish(context->pubsub, (void*)&notify_value_1);
+    } else {
+        furi_pubsub_unsubscribe(context->pubsub, context->subscription);
+    }
+    context->depth--;
+}
+
+void test_furi_pubsub_nested(void) {
+    TestPubSubNested context = {
+        .pubsub = furi_pubsub_alloc(),
+    };
+    context.subscription =
+        furi_pubsub_subscribe(context.pubsub, test_pubsub_nested_handler, &context);
+
+    furi_pubsub_publish(context.pubsub, (void*)&notify_value_0);
+    mu_assert_int_eq(2, context.count);
+
+    // Subscription is gone
+    furi_pubsub_publish(context.pubsub, (void*)&notify_value_0);
+    mu_assert_int_eq(2, context.count);
+
+    furi_pubsub_free(context.pubsub);
+}
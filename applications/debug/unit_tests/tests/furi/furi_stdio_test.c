@@ -106,6 +106,27 @@ void test_stdout(void) {
     fflush(stdout);
     assert_and_clear_mock_out("Hello!");
 
+    // block buffering holds complete lines, output longer than buffer wraps around
+    furi_thread_set_stdout_buffering(FuriThreadStdoutBufferingBlock);
+    puts("Hello, World!");
+    mu_assert_int_eq(0, furi_string_size(mock_out));
+    FuriString* expected = furi_string_alloc();
+    for(unsigned i = 0; i < 100; i++) {
+        printf("%03u,", i);
+        furi_string_cat_printf(expected, "%03u,", i);
+    }
+    fflush(stdout);
+    furi_string_replace_at(expected, 0, 0, "Hello, World!\n");
+    assert_and_clear_mock_out(furi_string_get_cstr(expected));
+    furi_string_free(expected);
+
+    // no buffering passes data through immediately
+    furi_thread_set_stdout_buffering(FuriThreadStdoutBufferingNone);
+    printf("He");
+    assert_and_clear_mock_out("He");
+
+    furi_thread_set_stdout_buffering(FuriThreadStdoutBufferingLine);
+
     furi_string_free(mock_out);
     furi_thread_set_stdout_callback(original_out_cb, original_out_ctx);
 }
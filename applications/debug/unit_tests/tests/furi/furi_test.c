@@ -6,9 +6,16 @@
 void test_furi_create_open(void);
 void test_furi_concurrent_access(void);
 void test_furi_pubsub(void);
+void test_furi_pubsub_reentrant(void);
+void test_furi_pubsub_queue(void);
+void test_furi_pubsub_concurrent(void);
+void test_furi_pubsub_nested(void);
 void test_furi_memmgr(void);
+void test_furi_object_pool(void);
+void test_furi_arena(void);
 void test_furi_event_loop(void);
 void test_furi_event_loop_self_unsubscribe(void);
+void test_furi_event_loop_timer_stress(void);
 void test_errno_saving(void);
 void test_furi_primitives(void);
 void test_stdin(void);
@@ -37,12 +44,36 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_pubsub_reentrant) {
+    test_furi_pubsub_reentrant();
+}
+
+MU_TEST(mu_test_furi_pubsub_queue) {
+    test_furi_pubsub_queue();
+}
+
+MU_TEST(mu_test_furi_pubsub_concurrent) {
+    test_furi_pubsub_concurrent();
+}
+
+MU_TEST(mu_test_furi_pubsub_nested) {
+    test_furi_pubsub_nested();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_object_pool) {
+    test_furi_object_pool();
+}
+
+MU_TEST(mu_test_furi_arena) {
+    test_furi_arena();
+}
+
 MU_TEST(mu_test_furi_event_loop) {
     test_furi_event_loop();
 }
@@ -51,6 +82,14 @@ MU_TEST(mu_test_furi_event_loop_self_unsubscribe) {
     test_furi_event_loop_self_unsubscribe();
 }
 
+MU_TEST(mu_test_furi_event_loop_timer_stress) {
+    test_furi_event_loop_timer_stress();
+}
+
+MU_BENCH(bench_furi_event_loop_timers) {
+    test_furi_event_loop_timer_stress();
+}
+
 MU_TEST(mu_test_errno_saving) {
     test_errno_saving();
 }
@@ -71,12 +110,21 @@ MU_TEST_SUITE(test_suite) {
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_pubsub_reentrant);
+    MU_RUN_TEST(mu_test_furi_pubsub_queue);
+    MU_RUN_TEST(mu_test_furi_pubsub_concurrent);
+    MU_RUN_TEST(mu_test_furi_pubsub_nested);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_object_pool);
+    MU_RUN_TEST(mu_test_furi_arena);
     MU_RUN_TEST(mu_test_furi_event_loop);
     MU_RUN_TEST(mu_test_furi_event_loop_self_unsubscribe);
+    MU_RUN_TEST(mu_test_furi_event_loop_timer_stress);
     MU_RUN_TEST(mu_test_stdio);
     MU_RUN_TEST(mu_test_errno_saving);
     MU_RUN_TEST(mu_test_furi_primitives);
+
+    MU_RUN_BENCH(bench_furi_event_loop_timers, 3);
 }
 
 int run_minunit_test_furi(void) {
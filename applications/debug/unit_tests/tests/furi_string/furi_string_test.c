@@ -445,6 +445,17 @@ MU_TEST(mu_test_furi_string_utf8) {
     furi_string_free(utf8_string);
 }
 
+MU_BENCH(mu_bench_furi_string_printf_search) {
+    FuriString* string = furi_string_alloc();
+    for(size_t i = 0; i < 32; i++) {
+        furi_string_cat_printf(string, "%zu:%s;", i, "value");
+    }
+    mu_check(furi_string_search_str(string, "31:value", 0) != FURI_STRING_FAILURE);
+    furi_string_replace_all_str(string, "value", "v");
+    mu_assert_int_eq(32 * 4 + 22, furi_string_size(string));
+    furi_string_free(string);
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -460,6 +471,8 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_string_start_end);
     MU_RUN_TEST(mu_test_furi_string_trim);
     MU_RUN_TEST(mu_test_furi_string_utf8);
+
+    MU_RUN_BENCH(mu_bench_furi_string_printf_search, 1000);
 }
 
 int run_minunit_test_furi_string(void) {
@@ -75,6 +75,9 @@ MU_TEST(js_test_event_loop) {
 MU_TEST(js_test_storage) {
     js_test_run(JS_SCRIPT_PATH("storage"));
 }
+MU_TEST(js_test_gc) {
+    js_test_run(JS_SCRIPT_PATH("gc"));
+}
 
 static void js_value_test_compatibility_matrix(struct mjs* mjs) {
     static const JsValueType types[] = {
@@ -385,6 +388,7 @@ MU_TEST_SUITE(test_js) {
     MU_RUN_TEST(js_test_math);
     MU_RUN_TEST(js_test_event_loop);
     MU_RUN_TEST(js_test_storage);
+    MU_RUN_TEST(js_test_gc);
 }
 
 int run_minunit_test_js(void) {
@@ -0,0 +1,26 @@
+#pragma once
+#include "minunit.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*  Benchmarks
+ *
+ *  MU_BENCH body is an ordinary test body: mu_assert and friends work as
+ *  usual. In normal mode it runs once as a test, in benchmark mode it is
+ *  warmed up, timed over given number of iterations and run once more with
+ *  heap tracing to collect allocation statistics. State that must survive
+ *  between iterations belongs to suite setup/teardown.
+ */
+
+void minunit_bench_run(
+    const char* name,
+    void (*bench)(void),
+    uint32_t iterations,
+    void (*setup)(void),
+    void (*teardown)(void));
+
+#define MU_BENCH(method_name) static void method_name(void)
+
+#define MU_RUN_BENCH(bench, iterations) \
+    MU__SAFE_BLOCK(minunit_bench_run(#bench, bench, iterations, minunit_setup, minunit_teardown);)
@@ -4,6 +4,10 @@
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/crypto1_recovery.h>
+#include <nfc/helpers/nfc_trace.h>
+#include <nfc/helpers/nfc_trace_replay.h>
 #include <nfc/nfc_poller.h>
 #include <nfc/nfc_listener.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a.h>
@@ -32,9 +36,18 @@
 
 #define NFC_TEST_NFC_DEV_PATH                  EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_TEST_TRACE_PATH                    EXT_PATH("unit_tests/nfc/nfc_trace_test.trace")
+
+#define NFC_TEST_TRACE_SIZE (8 * 1024)
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
+#define NFC_TEST_CRYPTO1_BATCH_SIZE     (256)
+#define NFC_TEST_CRYPTO1_BATCH_ROUNDS   (16)
+#define NFC_TEST_CRYPTO1_KNOWN_KEY_SLOT (100)
+// Partition holding the nested test vector state for 8 partition bits
+#define NFC_TEST_CRYPTO1_RECOVERY_PARTITION (52776)
+
 typedef enum {
     NfcTestMfClassicSendFrameTestStateAuth,
     NfcTestMfClassicSendFrameTestStateReadBlock,
@@ -298,6 +311,82 @@ MU_TEST(ntag_216_reader) {
     mf_ultralight_reader_test(EXT_PATH("unit_tests/nfc/Ntag216.nfc"));
 }
 
+MU_TEST(nfc_trace_replay_test) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Ultralight_11.nfc")),
+        "nfc_device_load() failed\r\n");
+
+    NfcListener* mfu_listener = nfc_listener_alloc(
+        listener,
+        NfcProtocolMfUltralight,
+        nfc_device_get_data(nfc_device, NfcProtocolMfUltralight));
+    nfc_listener_start(mfu_listener, NULL, NULL);
+
+    // Record reader side of the card read
+    NfcTrace* trace = nfc_trace_alloc(NFC_TEST_TRACE_SIZE);
+    nfc_set_trace(poller, trace);
+    MfUltralightData* mfu_data = mf_ultralight_alloc();
+    MfUltralightError error = mf_ultralight_poller_sync_read_card(poller, mfu_data, NULL);
+    mu_assert(error == MfUltralightErrorNone, "mf_ultralight_poller_sync_read_card() failed");
+    nfc_set_trace(poller, NULL);
+
+    mu_assert(nfc_trace_get_frame_count(trace) > 0, "No frames recorded");
+    mu_assert(nfc_trace_get_dropped_count(trace) == 0, "Frames dropped");
+
+    // Same card must answer recorded reader frames the same way
+    NfcTraceReplay* replay = nfc_trace_replay_alloc(poller, trace);
+    nfc_trace_replay_start(replay, NfcModePoller);
+    nfc_trace_replay_stop(replay);
+    mu_assert(nfc_trace_replay_is_complete(replay), "Reader replay not complete");
+    mu_assert(nfc_trace_replay_get_mismatch_count(replay) == 0, "Reader replay mismatch");
+    nfc_trace_replay_free(replay);
+
+    nfc_listener_stop(mfu_listener);
+    nfc_listener_free(mfu_listener);
+
+    NfcTrace* trace_loaded = nfc_trace_alloc(NFC_TEST_TRACE_SIZE);
+    mu_assert(
+        nfc_trace_save(trace, nfc_test->storage, NFC_TEST_TRACE_PATH),
+        "nfc_trace_save() failed");
+    mu_assert(
+        nfc_trace_load(trace_loaded, nfc_test->storage, NFC_TEST_TRACE_PATH),
+        "nfc_trace_load() failed");
+    mu_assert(
+        storage_simply_remove(nfc_test->storage, NFC_TEST_TRACE_PATH),
+        "storage_simply_remove() failed\r\n");
+    mu_assert(
+        nfc_trace_get_frame_count(trace_loaded) == nfc_trace_get_frame_count(trace),
+        "Frame count mismatch");
+
+    // Loaded trace acting as the card must be read the same as the original card
+    Nfc* replay_listener = nfc_alloc();
+    replay = nfc_trace_replay_alloc(replay_listener, trace_loaded);
+    nfc_trace_replay_start(replay, NfcModeListener);
+
+    MfUltralightData* mfu_replay_data = mf_ultralight_alloc();
+    error = mf_ultralight_poller_sync_read_card(poller, mfu_replay_data, NULL);
+    nfc_trace_replay_stop(replay);
+
+    mu_assert(error == MfUltralightErrorNone, "mf_ultralight_poller_sync_read_card() failed");
+    mu_assert(nfc_trace_replay_is_complete(replay), "Card replay not complete");
+    mu_assert(nfc_trace_replay_get_mismatch_count(replay) == 0, "Card replay mismatch");
+    mu_assert(mf_ultralight_is_equal(mfu_data, mfu_replay_data), "Data mismatch");
+
+    nfc_trace_replay_free(replay);
+    mf_ultralight_free(mfu_replay_data);
+    mf_ultralight_free(mfu_data);
+    nfc_trace_free(trace_loaded);
+    nfc_trace_free(trace);
+    nfc_device_free(nfc_device);
+    nfc_free(replay_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+}
+
 MU_TEST(ntag_213_locked_reader) {
     FURI_LOG_I(TAG, "Testing Ntag215 locked file");
     Nfc* poller = nfc_alloc();
@@ -583,6 +672,158 @@ MU_TEST(mf_classic_send_frame_test) {
     nfc_free(poller);
 }
 
+MU_TEST(crypto1_kat_test) {
+    Crypto1* crypto = crypto1_alloc();
+
+    crypto1_init(crypto, 0xA0A1A2A3A4A5);
+    mu_assert(crypto->odd == 0x0033bb33 && crypto->even == 0x0008084c, "Wrong init state");
+
+    uint32_t ks_word = crypto1_word(crypto, 0x01020304 ^ 0xDEADBEEF, 0);
+    mu_assert(ks_word == 0x3aedd800, "Wrong word keystream");
+
+    const uint8_t ks_expected[] = {0x90, 0xD8, 0xE5, 0x21, 0x34, 0x65, 0x74, 0xB9};
+    uint8_t ks[sizeof(ks_expected)];
+    uint8_t parity[sizeof(ks_expected)];
+    Crypto1 crypto_copy = *crypto;
+    crypto1_keystream(crypto, ks, parity, sizeof(ks));
+    mu_assert(memcmp(ks, ks_expected, sizeof(ks)) == 0, "Wrong bulk keystream");
+    mu_assert(crypto->odd == 0x65efab36 && crypto->even == 0x24445abc, "Wrong keystream state");
+    for(size_t i = 0; i < sizeof(ks_expected); i++) {
+        mu_assert(crypto1_byte(&crypto_copy, 0, 0) == ks_expected[i], "Wrong byte keystream");
+        // Parity keystream is the output of the next clock, peek at it on a copy
+        Crypto1 crypto_peek = crypto_copy;
+        mu_assert(crypto1_bit(&crypto_peek, 0, 0) == parity[i], "Wrong parity keystream");
+    }
+
+    mu_assert(crypto1_lfsr_rollback_word(crypto, 0, 0) == 0x346574b9, "Wrong rollback keystream");
+
+    MfClassicKey key = {.data = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+    mu_assert(
+        crypto1_decrypt_nt_enc(0xDEADBEEF, 0x01020304, key) == 0xfe7df37d, "Wrong decrypted nt");
+
+    crypto1_free(crypto);
+}
+
+MU_TEST(crypto1_batch_test) {
+    const uint32_t cuid = 0xDEADBEEF;
+    const uint32_t nt_enc = 0x01020304;
+    const uint8_t nt_par_enc = 0x02;
+
+    MfClassicKey* keys = malloc(sizeof(MfClassicKey) * NFC_TEST_CRYPTO1_BATCH_SIZE);
+    uint32_t seed = 0x12345678;
+    size_t expected_count = 0;
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_BATCH_SIZE; i++) {
+        for(size_t j = 0; j < sizeof(MfClassicKey); j++) {
+            seed = seed * 1103515245 + 12345;
+            keys[i].data[j] = seed >> 16;
+        }
+        if(i == NFC_TEST_CRYPTO1_KNOWN_KEY_SLOT) {
+            memset(keys[i].data, 0xFF, sizeof(MfClassicKey));
+        }
+        uint32_t nt = crypto1_decrypt_nt_enc(cuid, nt_enc, keys[i]);
+        if(crypto1_nonce_matches_encrypted_parity_bits(nt, nt ^ nt_enc, nt_par_enc)) {
+            expected_count++;
+        }
+    }
+
+    MfClassicKey* batch = malloc(sizeof(MfClassicKey) * NFC_TEST_CRYPTO1_BATCH_SIZE);
+    memcpy(batch, keys, sizeof(MfClassicKey) * NFC_TEST_CRYPTO1_BATCH_SIZE);
+    size_t matched = crypto1_nt_enc_filter_keys(
+        cuid, nt_enc, nt_par_enc, false, batch, NFC_TEST_CRYPTO1_BATCH_SIZE);
+    mu_assert(matched == expected_count, "Batch and scalar key checks disagree");
+
+    bool known_key_found = false;
+    for(size_t i = 0; i < matched; i++) {
+        if(memcmp(&batch[i], &keys[NFC_TEST_CRYPTO1_KNOWN_KEY_SLOT], sizeof(MfClassicKey)) ==
+           0) {
+            known_key_found = true;
+        }
+    }
+    mu_assert(known_key_found, "Known key was filtered out");
+
+    // Throughput
+    uint32_t cycles = DWT->CYCCNT;
+    for(size_t round = 0; round < NFC_TEST_CRYPTO1_BATCH_ROUNDS; round++) {
+        memcpy(batch, keys, sizeof(MfClassicKey) * NFC_TEST_CRYPTO1_BATCH_SIZE);
+        crypto1_nt_enc_filter_keys(
+            cuid, nt_enc, nt_par_enc, false, batch, NFC_TEST_CRYPTO1_BATCH_SIZE);
+    }
+    cycles = DWT->CYCCNT - cycles;
+    const uint32_t keys_tested = NFC_TEST_CRYPTO1_BATCH_SIZE * NFC_TEST_CRYPTO1_BATCH_ROUNDS;
+    const uint32_t us = cycles / furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 batch: %lu keys in %lu us, %lu keys/s",
+        keys_tested,
+        us,
+        us ? (uint32_t)((uint64_t)keys_tested * 1000000 / us) : 0);
+
+    free(batch);
+    free(keys);
+}
+
+typedef struct {
+    uint32_t cuid;
+    uint32_t nt0;
+    uint32_t nt1;
+    uint32_t ks1;
+    uint64_t key;
+    bool key_found;
+} NfcTestCrypto1RecoveryContext;
+
+static bool nfc_test_crypto1_recovery_callback(const Crypto1* state, void* context) {
+    NfcTestCrypto1RecoveryContext* ctx = context;
+
+    Crypto1 crypto = *state;
+    crypto1_lfsr_rollback_word(&crypto, ctx->cuid ^ ctx->nt0, 0);
+    const uint64_t key = crypto1_recovery_get_key(&crypto);
+
+    crypto1_init(&crypto, key);
+    if(crypto1_word(&crypto, ctx->cuid ^ ctx->nt1, 0) == ctx->ks1) {
+        ctx->key = key;
+        ctx->key_found = true;
+    }
+
+    return !ctx->key_found;
+}
+
+MU_TEST(crypto1_recovery_test) {
+    Crypto1 crypto = {};
+    crypto1_init(&crypto, 0xA0A1A2A3A4A5);
+    mu_assert(crypto1_recovery_get_key(&crypto) == 0xA0A1A2A3A4A5, "Wrong key from state");
+
+    // Nested authentication with key 1234567890AB
+    NfcTestCrypto1RecoveryContext ctx = {
+        .cuid = 0xDEADBEEF,
+        .nt0 = 0x11223344,
+        .nt1 = 0x55667788,
+        .ks1 = 0xFFECC68F,
+    };
+    const uint32_t ks0 = 0xFFE47EA5;
+
+    Crypto1Recovery* recovery = crypto1_recovery_alloc(8);
+    mu_assert(crypto1_recovery_get_partition_count(recovery) == 65536, "Wrong partition count");
+
+    uint32_t cycles = DWT->CYCCNT;
+    bool completed = crypto1_recovery_run_partition(
+        recovery,
+        ks0,
+        ctx.cuid ^ ctx.nt0,
+        NFC_TEST_CRYPTO1_RECOVERY_PARTITION,
+        nfc_test_crypto1_recovery_callback,
+        &ctx);
+    cycles = DWT->CYCCNT - cycles;
+    crypto1_recovery_free(recovery);
+
+    mu_assert(!completed, "Enumeration was not aborted by callback");
+    mu_assert(ctx.key_found, "Key not recovered");
+    mu_assert(ctx.key == 0x1234567890AB, "Wrong key recovered");
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 recovery: partition in %lu us",
+        cycles / furi_hal_cortex_instructions_per_microsecond());
+}
+
 MU_TEST(mf_classic_dict_test) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     if(storage_common_stat(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) == FSE_OK) {
@@ -833,6 +1074,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(ntag_216_reader);
     MU_RUN_TEST(ntag_213_locked_reader);
     MU_RUN_TEST(mf_ultralight_c_reader);
+    MU_RUN_TEST(nfc_trace_replay_test);
 
     MU_RUN_TEST(mf_ultralight_write);
 
@@ -864,6 +1106,9 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(crypto1_kat_test);
+    MU_RUN_TEST(crypto1_batch_test);
+    MU_RUN_TEST(crypto1_recovery_test);
     MU_RUN_TEST(felica_read);
     MU_RUN_TEST(felica_read_auth);
 
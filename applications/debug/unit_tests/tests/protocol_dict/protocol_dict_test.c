@@ -212,8 +212,25 @@ MU_TEST(test_protocol_dict) {
     free(data);
 }
 
+MU_BENCH(bench_protocol_dict_decoders_feed) {
+    ProtocolDict* dict = protocol_dict_alloc(test_protocols_base, TestDictProtocolMax);
+    protocol_dict_decoders_start(dict);
+
+    // Noise that no decoder accepts, then a valid frame
+    ProtocolId protocol_id = PROTOCOL_NO;
+    for(size_t i = 0; i < 1000; i++) {
+        protocol_id = protocol_dict_decoders_feed(dict, i % 2, 100);
+        mu_assert_int_eq(PROTOCOL_NO, protocol_id);
+    }
+    protocol_id = protocol_dict_decoders_feed(dict, true, 543);
+    mu_assert_int_eq(TestDictProtocol1, protocol_id);
+
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_protocol_dict_suite) {
     MU_RUN_TEST(test_protocol_dict);
+    MU_RUN_BENCH(bench_protocol_dict_decoders_feed, 100);
 }
 
 int run_minunit_test_protocol_dict(void) {
@@ -187,6 +187,148 @@ MU_TEST_SUITE(storage_file_64k) {
     MU_RUN_TEST(storage_file_read_write_64k);
 }
 
+#define STORAGE_SEEK_FILE        UNIT_TESTS_PATH("seek.test")
+#define STORAGE_SEEK_FILLER_FILE UNIT_TESTS_PATH("seek_filler.test")
+#define STORAGE_SEEK_FILE_SIZE   (512 * 1024)
+#define STORAGE_SEEK_CHUNK_SIZE  (4 * 1024)
+#define STORAGE_SEEK_COUNT       (64)
+
+static void storage_seek_fill_chunk(uint32_t* chunk, size_t offset) {
+    for(size_t i = 0; i < STORAGE_SEEK_CHUNK_SIZE / sizeof(uint32_t); i++) {
+        chunk[i] = offset / sizeof(uint32_t) + i;
+    }
+}
+
+// Chunks of two files are interleaved, so that clusters of each file are not contiguous
+static bool storage_seek_create_fragmented(Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    File* filler = storage_file_alloc(storage);
+    uint32_t* chunk = malloc(STORAGE_SEEK_CHUNK_SIZE);
+    bool result = false;
+
+    do {
+        if(!storage_file_open(file, STORAGE_SEEK_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        if(!storage_file_open(filler, STORAGE_SEEK_FILLER_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+
+        size_t offset = 0;
+        for(; offset < STORAGE_SEEK_FILE_SIZE; offset += STORAGE_SEEK_CHUNK_SIZE) {
+            storage_seek_fill_chunk(chunk, offset);
+            if(storage_file_write(file, chunk, STORAGE_SEEK_CHUNK_SIZE) !=
+               STORAGE_SEEK_CHUNK_SIZE) {
+                break;
+            }
+            if(storage_file_write(filler, chunk, STORAGE_SEEK_CHUNK_SIZE) !=
+               STORAGE_SEEK_CHUNK_SIZE) {
+                break;
+            }
+        }
+        result = offset == STORAGE_SEEK_FILE_SIZE;
+    } while(false);
+
+    free(chunk);
+    storage_file_free(filler);
+    storage_file_free(file);
+
+    return result;
+}
+
+static uint32_t storage_seek_next_offset(uint32_t* state) {
+    // LCG from Numerical Recipes, keeps runs comparable
+    *state = *state * 1664525u + 1013904223u;
+    return (*state % (STORAGE_SEEK_FILE_SIZE / sizeof(uint32_t))) * sizeof(uint32_t);
+}
+
+static bool storage_seek_check_random(File* file, uint32_t* state, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        uint32_t offset = storage_seek_next_offset(state);
+        uint32_t value = 0;
+        if(!storage_file_seek(file, offset, true)) return false;
+        if(storage_file_read(file, &value, sizeof(value)) != sizeof(value)) return false;
+        if(value != offset / sizeof(uint32_t)) return false;
+    }
+    return true;
+}
+
+MU_TEST(storage_file_seek_random) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    File* other = storage_file_alloc(storage);
+    uint32_t state = 1;
+
+    mu_check(storage_file_open(file, STORAGE_SEEK_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_check(storage_seek_check_random(file, &state, STORAGE_SEEK_COUNT));
+
+    // Relative seeks and reads across cluster boundaries
+    mu_check(storage_file_seek(file, STORAGE_SEEK_FILE_SIZE - 8, true));
+    mu_check(storage_file_seek(file, 4, false));
+    uint32_t value = 0;
+    mu_assert_int_eq(sizeof(value), storage_file_read(file, &value, sizeof(value)));
+    mu_assert_int_eq((STORAGE_SEEK_FILE_SIZE - 4) / sizeof(uint32_t), value);
+    mu_assert_int_eq(0, storage_file_read(file, &value, sizeof(value)));
+
+    // Writes elsewhere must not break the file that is already open
+    mu_check(storage_file_create(storage, UNIT_TESTS_PATH("seek_other.test"), "data"));
+    mu_check(storage_seek_check_random(file, &state, STORAGE_SEEK_COUNT));
+
+    // Reopened file reuses the pooled map
+    storage_file_close(file);
+    mu_check(storage_file_open(other, STORAGE_SEEK_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_check(storage_seek_check_random(other, &state, STORAGE_SEEK_COUNT));
+    storage_file_close(other);
+
+    mu_check(storage_simply_remove(storage, UNIT_TESTS_PATH("seek_other.test")));
+
+    storage_file_free(other);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_BENCH(bench_storage_file_seek_random) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint32_t state = 1;
+
+    mu_check(storage_file_open(file, STORAGE_SEEK_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_check(storage_seek_check_random(file, &state, STORAGE_SEEK_COUNT));
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_BENCH(bench_storage_file_seek_backward) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    // Worst case without link map: every seek walks the chain almost to the end
+    mu_check(storage_file_open(file, STORAGE_SEEK_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    for(size_t i = STORAGE_SEEK_COUNT; i > 0; i--) {
+        uint32_t offset = STORAGE_SEEK_FILE_SIZE - i * sizeof(uint32_t);
+        uint32_t value = 0;
+        mu_check(storage_file_seek(file, offset, true));
+        mu_assert_int_eq(sizeof(value), storage_file_read(file, &value, sizeof(value)));
+        mu_assert_int_eq(offset / sizeof(uint32_t), value);
+        mu_check(storage_file_seek(file, 0, true));
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_seek) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_check(storage_seek_create_fragmented(storage));
+
+    MU_RUN_TEST(storage_file_seek_random);
+    MU_RUN_BENCH(bench_storage_file_seek_random, 20);
+    MU_RUN_BENCH(bench_storage_file_seek_backward, 20);
+
+    storage_simply_remove(storage, STORAGE_SEEK_FILE);
+    storage_simply_remove(storage, STORAGE_SEEK_FILLER_FILE);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(storage_dir_open_close) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* file;
@@ -259,10 +401,103 @@ MU_TEST(storage_dir_exists_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define STORAGE_SNAPSHOT_FILES_COUNT (16)
+
+MU_TEST(storage_dir_snapshot_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    StorageDirSnapshot* snapshot = storage_dir_snapshot_alloc(storage, 1024);
+    FileInfo fileinfo;
+    const char* name;
+
+    storage_simply_remove_recursive(storage, STORAGE_TEST_DIR);
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/b.txt", "b"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/.hidden.txt", "hidden"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/c.bin", "c"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/A.SUB", "a"));
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR "/zdir"));
+
+    mu_check(!storage_dir_snapshot_is_valid(snapshot));
+    mu_assert_int_eq(
+        FSE_OK,
+        storage_dir_snapshot_load(
+            snapshot,
+            STORAGE_TEST_DIR,
+            ".txt|.sub",
+            StorageDirSnapshotFlagSkipHidden | StorageDirSnapshotFlagSort));
+    mu_check(storage_dir_snapshot_is_valid(snapshot));
+
+    // Directories first, then files by name regardless of case
+    mu_assert_int_eq(3, storage_dir_snapshot_get_count(snapshot));
+    mu_check(storage_dir_snapshot_get(snapshot, 0, &fileinfo, &name));
+    mu_assert_string_eq("zdir", name);
+    mu_check(file_info_is_dir(&fileinfo));
+    mu_check(storage_dir_snapshot_get(snapshot, 1, &fileinfo, &name));
+    mu_assert_string_eq("A.SUB", name);
+    mu_check(storage_dir_snapshot_get(snapshot, 2, &fileinfo, &name));
+    mu_assert_string_eq("b.txt", name);
+    mu_assert_int_eq(1, fileinfo.size);
+    mu_check(!storage_dir_snapshot_get(snapshot, 3, &fileinfo, &name));
+
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/d.txt", "d"));
+    mu_check(!storage_dir_snapshot_is_valid(snapshot));
+
+    mu_assert_int_eq(FSE_OK, storage_dir_snapshot_load(snapshot, STORAGE_TEST_DIR, NULL, 0));
+    mu_assert_int_eq(6, storage_dir_snapshot_get_count(snapshot));
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_TEST_DIR "/c.bin"));
+    mu_check(!storage_dir_snapshot_is_valid(snapshot));
+
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_TEST_DIR));
+    mu_check(storage_dir_snapshot_load(snapshot, STORAGE_TEST_DIR, NULL, 0) != FSE_OK);
+    mu_check(!storage_dir_snapshot_is_valid(snapshot));
+
+    storage_dir_snapshot_free(snapshot);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_dir_snapshot_window_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    // Only a few entries fit, the rest is read on access
+    StorageDirSnapshot* snapshot = storage_dir_snapshot_alloc(storage, 320);
+    FuriString* path = furi_string_alloc();
+    const char* name;
+    uint32_t seen = 0;
+
+    storage_simply_remove_recursive(storage, STORAGE_TEST_DIR);
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR));
+    for(size_t i = 0; i < STORAGE_SNAPSHOT_FILES_COUNT; i++) {
+        furi_string_printf(path, "%s/file_%02zu", STORAGE_TEST_DIR, i);
+        mu_check(storage_file_create(storage, furi_string_get_cstr(path), "data"));
+    }
+
+    mu_assert_int_eq(
+        FSE_OK,
+        storage_dir_snapshot_load(snapshot, STORAGE_TEST_DIR, NULL, StorageDirSnapshotFlagSort));
+    mu_assert_int_eq(STORAGE_SNAPSHOT_FILES_COUNT, storage_dir_snapshot_get_count(snapshot));
+
+    // Backwards, so that every window is reloaded
+    for(size_t i = STORAGE_SNAPSHOT_FILES_COUNT; i > 0; i--) {
+        mu_check(storage_dir_snapshot_get(snapshot, i - 1, NULL, &name));
+        unsigned index = 0;
+        mu_check(sscanf(name, "file_%u", &index) == 1);
+        mu_check(index < STORAGE_SNAPSHOT_FILES_COUNT);
+        mu_check(!(seen & (1UL << index)));
+        seen |= 1UL << index;
+    }
+    mu_assert_int_eq((1UL << STORAGE_SNAPSHOT_FILES_COUNT) - 1, seen);
+
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_TEST_DIR));
+    furi_string_free(path);
+    storage_dir_snapshot_free(snapshot);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_dir) {
     MU_RUN_TEST(storage_dir_open_close);
     MU_RUN_TEST(storage_dir_open_lock);
     MU_RUN_TEST(storage_dir_exists_test);
+    MU_RUN_TEST(storage_dir_snapshot_test);
+    MU_RUN_TEST(storage_dir_snapshot_window_test);
 }
 
 static const char* const storage_copy_test_paths[] = {
@@ -733,6 +968,85 @@ MU_TEST(test_md5_calc) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#include <lib/toolbox/crc32_calc.h>
+
+static bool storage_test_write_text(Storage* storage, const char* path, const char* text) {
+    File* file = storage_file_alloc(storage);
+    bool result = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                  storage_file_write(file, text, strlen(text)) == strlen(text);
+    storage_file_free(file);
+    return result;
+}
+
+static void storage_test_check_digest(Storage* storage, const char* path, const char* text) {
+    File* file = storage_file_alloc(storage);
+    uint8_t md5[MD5_HASH_SIZE];
+    mu_check(md5_calc_file(file, path, md5, NULL));
+    storage_file_free(file);
+
+    StorageDigest digest;
+    mu_assert_int_eq(FSE_OK, storage_common_digest(storage, path, &digest));
+    mu_assert_mem_eq(md5, digest.md5, MD5_HASH_SIZE);
+    mu_assert_int_eq(crc32_calc_buffer(0, text, strlen(text)), digest.crc32);
+
+    // Second request is served from cache
+    memset(&digest, 0, sizeof(digest));
+    mu_assert_int_eq(FSE_OK, storage_common_digest(storage, path, &digest));
+    mu_assert_mem_eq(md5, digest.md5, MD5_HASH_SIZE);
+}
+
+MU_TEST(test_storage_digest) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const char* path = UNIT_TESTS_PATH("digest.test");
+    const char* path_new = UNIT_TESTS_PATH("digest.new");
+    StorageDigest digest;
+
+    mu_check(storage_test_write_text(storage, path, "Hello"));
+    storage_test_check_digest(storage, path, "Hello");
+
+    // Same size, new content: write invalidates cached digest
+    mu_check(storage_test_write_text(storage, path, "World"));
+    storage_test_check_digest(storage, path, "World");
+
+    mu_assert_int_eq(FSE_OK, storage_common_rename(storage, path, path_new));
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_common_digest(storage, path, &digest));
+    storage_test_check_digest(storage, path_new, "World");
+
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, path_new));
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_common_digest(storage, path_new, &digest));
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(test_storage_stat_timestamp) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const char* path = UNIT_TESTS_PATH("stat_a.test");
+    const char* path_other = UNIT_TESTS_PATH("stat_b.test");
+    FileInfo fileinfo;
+    uint32_t timestamp = 0;
+    uint32_t timestamp_other = 0;
+
+    mu_check(storage_test_write_text(storage, path, "Hello"));
+    mu_assert_int_eq(FSE_OK, storage_common_stat_timestamp(storage, path, &fileinfo, &timestamp));
+    mu_assert_int_eq(5, fileinfo.size);
+
+    // Writing another file must not affect this file's own timestamp
+    furi_delay_ms(2100);
+    mu_check(storage_test_write_text(storage, path_other, "World!"));
+    mu_assert_int_eq(
+        FSE_OK, storage_common_stat_timestamp(storage, path, &fileinfo, &timestamp_other));
+    mu_assert_int_eq(timestamp, timestamp_other);
+    mu_assert_int_eq(5, fileinfo.size);
+
+    const char* path_missing = UNIT_TESTS_PATH("stat_c.test");
+    mu_assert_int_eq(
+        FSE_NOT_EXIST, storage_common_stat_timestamp(storage, path_missing, &fileinfo, &timestamp));
+
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, path));
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, path_other));
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_data_path) {
     MU_RUN_TEST(test_storage_data_path);
     MU_RUN_TEST(test_storage_data_path_apps);
@@ -740,15 +1054,18 @@ MU_TEST_SUITE(test_data_path) {
 
 MU_TEST_SUITE(test_storage_common) {
     MU_RUN_TEST(test_storage_common_migrate);
+    MU_RUN_TEST(test_storage_stat_timestamp);
 }
 
 MU_TEST_SUITE(test_md5_calc_suite) {
     MU_RUN_TEST(test_md5_calc);
+    MU_RUN_TEST(test_storage_digest);
 }
 
 int run_minunit_test_storage(void) {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_file_64k);
+    MU_RUN_SUITE(storage_seek);
     MU_RUN_SUITE(storage_dir);
     MU_RUN_SUITE(storage_rename);
     MU_RUN_SUITE(test_data_path);
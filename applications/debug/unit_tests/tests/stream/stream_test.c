@@ -517,12 +517,49 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+#define STREAM_BENCH_LINES (64)
+
+static size_t stream_bench_write_read_lines(Stream* stream) {
+    for(size_t i = 0; i < STREAM_BENCH_LINES; i++) {
+        stream_write_format(stream, "%zu %s\n", i, stream_test_data);
+    }
+
+    size_t lines = 0;
+    FuriString* line = furi_string_alloc();
+    stream_rewind(stream);
+    while(stream_read_line(stream, line)) {
+        lines++;
+    }
+    furi_string_free(line);
+
+    return lines;
+}
+
+MU_BENCH(stream_bench_string_lines) {
+    Stream* stream = string_stream_alloc();
+    mu_assert_int_eq(STREAM_BENCH_LINES, stream_bench_write_read_lines(stream));
+    stream_free(stream);
+}
+
+MU_BENCH(stream_bench_buffered_file_lines) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(
+        buffered_file_stream_open(stream, FILESTREAM_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(STREAM_BENCH_LINES, stream_bench_write_read_lines(stream));
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+
+    MU_RUN_BENCH(stream_bench_string_lines, 200);
+    MU_RUN_BENCH(stream_bench_buffered_file_lines, 20);
 }
 
 int run_minunit_test_stream(void) {
@@ -9,6 +9,8 @@
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/strint.h>
 
 #define TAG "SubGhzTest"
 
@@ -20,6 +22,9 @@
 #define TEST_RANDOM_COUNT_PARSE 328
 #define TEST_TIMEOUT            10000
 
+#define BENCH_RAW_PATH        EXT_PATH("unit_tests/subghz/came_raw.sub")
+#define BENCH_RAW_SAMPLES_MAX 4096
+
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
 //static SubGhzTransmitter* transmitter_handler;
@@ -217,6 +222,39 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+MU_TEST(subghz_keystore_shared_test) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    mu_assert(
+        subghz_environment_load_keystore(environment, KEYSTORE_DIR_NAME), "Test keystore error");
+
+    SubGhzKeyArray_t* data =
+        subghz_keystore_get_data(subghz_environment_get_keystore(environment));
+    SubGhzKeyArray_t* shared =
+        subghz_keystore_get_data(subghz_environment_get_keystore(environment_handler));
+    mu_assert(SubGhzKeyArray_size(*data) > 0, "Keystore is empty");
+    mu_assert(data == shared, "Keystore is not shared");
+
+    // Second file is merged into keystore own array
+    mu_assert(
+        subghz_environment_load_keystore(environment, KEYSTORE_DIR_NAME), "Test keystore error");
+    data = subghz_keystore_get_data(subghz_environment_get_keystore(environment));
+    mu_assert_int_eq(SubGhzKeyArray_size(*shared) * 2, SubGhzKeyArray_size(*data));
+    mu_assert_string_eq(
+        SubGhzKeyArray_cget(*shared, 0)->name,
+        SubGhzKeyArray_cget(*data, SubGhzKeyArray_size(*shared))->name);
+
+    subghz_environment_free(environment);
+}
+
+MU_BENCH(subghz_bench_keystore_load) {
+    // Drop shared table so that the file is decrypted every time
+    subghz_keystore_cache_trim();
+
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+    mu_assert(subghz_keystore_load(keystore, KEYSTORE_DIR_NAME), "Test keystore error");
+    subghz_keystore_free(keystore);
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -937,9 +975,60 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+static int32_t* subghz_bench_samples = NULL;
+static size_t subghz_bench_samples_count = 0;
+
+// Preload RAW samples: file worker and its delays must stay out of timing
+static void subghz_bench_load_raw(const char* path) {
+    subghz_bench_samples = malloc(sizeof(int32_t) * BENCH_RAW_SAMPLES_MAX);
+    subghz_bench_samples_count = 0;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+
+    if(file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(subghz_bench_samples_count < BENCH_RAW_SAMPLES_MAX &&
+              stream_read_line(stream, line)) {
+            if(!furi_string_start_with_str(line, "RAW_Data: ")) continue;
+
+            char* str = (char*)furi_string_get_cstr(line) + strlen("RAW_Data: ");
+            int32_t duration = 0;
+            while(subghz_bench_samples_count < BENCH_RAW_SAMPLES_MAX &&
+                  strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
+                subghz_bench_samples[subghz_bench_samples_count++] = duration;
+            }
+        }
+    }
+
+    furi_string_free(line);
+    file_stream_close(stream);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void subghz_bench_free_raw(void) {
+    free(subghz_bench_samples);
+    subghz_bench_samples = NULL;
+    subghz_bench_samples_count = 0;
+}
+
+MU_BENCH(subghz_bench_receiver_decode) {
+    subghz_test_decoder_count = 0;
+    subghz_receiver_reset(receiver_handler);
+
+    for(size_t i = 0; i < subghz_bench_samples_count; i++) {
+        int32_t sample = subghz_bench_samples[i];
+        subghz_receiver_decode(receiver_handler, sample > 0, (uint32_t)abs(sample));
+    }
+
+    mu_assert(subghz_test_decoder_count > 0, "Bench decoder error\r\n");
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_shared_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -1030,7 +1119,15 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_legrand_test);
 
     MU_RUN_TEST(subghz_random_test);
+
+    subghz_bench_load_raw(BENCH_RAW_PATH);
+    MU_RUN_BENCH(subghz_bench_receiver_decode, 20);
+    subghz_bench_free_raw();
+
     subghz_test_deinit();
+
+    MU_RUN_BENCH(subghz_bench_keystore_load, 10);
+    subghz_keystore_cache_trim();
 }
 
 int run_minunit_test_subghz(void) {
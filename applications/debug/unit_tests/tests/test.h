@@ -2,6 +2,7 @@
 
 // Framework
 #include "minunit.h"
+#include "minunit_bench.h"
 
 #include "test_api.h"
 
@@ -10,3 +11,9 @@ int get_minunit_run(void);
 int get_minunit_assert(void);
 
 int get_minunit_status(void);
+
+void set_bench_mode(bool enabled);
+
+size_t get_bench_count(void);
+
+const MuBenchResult* get_bench_result(size_t index);
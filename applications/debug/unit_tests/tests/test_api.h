@@ -3,13 +3,27 @@
 #include <flipper_application/flipper_application.h>
 
 #define APPID       "UnitTest"
-#define API_VERSION (0u)
+#define API_VERSION (1u)
+
+/** Result of a single MU_BENCH case */
+typedef struct {
+    const char* name; /**< Benchmark name, owned by test plugin */
+    uint32_t iterations; /**< Measured iterations, warm-up excluded */
+    uint32_t cycles_avg; /**< Average CPU cycles per iteration */
+    uint32_t cycles_min; /**< Fastest iteration, CPU cycles */
+    uint32_t cycles_max; /**< Slowest iteration, CPU cycles */
+    uint32_t heap_peak; /**< Heap high-water of one iteration, bytes */
+    uint32_t allocations; /**< Allocation count of one iteration */
+} MuBenchResult;
 
 typedef struct {
     int (*run)(void);
     int (*get_minunit_run)(void);
     int (*get_minunit_assert)(void);
     int (*get_minunit_status)(void);
+    void (*set_bench_mode)(bool enabled);
+    size_t (*get_bench_count)(void);
+    const MuBenchResult* (*get_bench_result)(size_t index);
 } TestApi;
 
 #define TEST_API_DEFINE(entrypoint)                     \
@@ -18,6 +32,9 @@ typedef struct {
         .get_minunit_run = get_minunit_run,             \
         .get_minunit_assert = get_minunit_assert,       \
         .get_minunit_status = get_minunit_status,       \
+        .set_bench_mode = set_bench_mode,               \
+        .get_bench_count = get_bench_count,             \
+        .get_bench_result = get_bench_result,           \
     };                                                  \
     const FlipperAppPluginDescriptor app_descriptor = { \
         .appid = APPID,                                 \
@@ -0,0 +1,90 @@
+/* Host runner: every suite is linked into its own executable instead of being
+ * loaded as a plugin, report mirrors test_runner.c. */
+
+#include "tests/test_api.h"
+#include "test_bench.h"
+
+#include <furi.h>
+#include <host_app.h>
+#include <toolbox/path.h>
+#include <toolbox/strint.h>
+
+#include <string.h>
+
+const FlipperAppPluginDescriptor* get_api(void);
+
+int32_t host_app_main(int argc, char** argv) {
+    bool bench = false;
+    bool bench_compare = false;
+    uint32_t bench_threshold = TEST_BENCH_THRESHOLD_DEFAULT;
+
+    // [--bench [--compare] [--threshold <percent>]], same as CLI runner
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if(strcmp(argv[i], "--compare") == 0) {
+            bench_compare = true;
+        } else if(
+            strcmp(argv[i], "--threshold") == 0 && i + 1 < argc &&
+            strint_to_uint32(argv[i + 1], NULL, &bench_threshold, 10) == StrintParseNoError) {
+            i++;
+        } else {
+            printf("Unexpected argument: %s\r\n", argv[i]);
+            return 1;
+        }
+    }
+
+    const TestApi* test = get_api()->entry_point;
+
+    // Objects cached by pools are not leaks
+    furi_object_pool_trim_all();
+    uint32_t heap_before = memmgr_get_free_heap();
+    uint32_t cycle_counter = furi_get_tick();
+
+    test->set_bench_mode(bench);
+    int minunit_fail = test->run();
+
+    printf("\r\nFailed tests: %d\r\n", minunit_fail);
+
+    size_t bench_regressions = 0;
+    if(bench) {
+        // Suite executables share results file, names match plugin names
+        FuriString* suite = furi_string_alloc();
+        path_extract_filename_no_ext(argv[0], suite);
+        furi_string_replace_at(suite, 0, 0, "test_");
+
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        TestBench* test_bench = test_bench_alloc(storage, true, bench_compare, bench_threshold);
+        for(size_t i = 0; i < test->get_bench_count(); i++) {
+            test_bench_add(test_bench, furi_string_get_cstr(suite), test->get_bench_result(i));
+        }
+        bench_regressions = test_bench_get_regressions(test_bench);
+        test_bench_free(test_bench);
+        furi_record_close(RECORD_STORAGE);
+        furi_string_free(suite);
+
+        if(bench_regressions) {
+            printf("Benchmark regressions: %zu\r\n", bench_regressions);
+        }
+    }
+
+    // Time report
+    cycle_counter = (furi_get_tick() - cycle_counter);
+    printf("Consumed: %lu ms\r\n", cycle_counter);
+
+    // Wait for tested services and apps to deallocate memory
+    furi_delay_ms(200);
+    furi_object_pool_trim_all();
+    uint32_t heap_after = memmgr_get_free_heap();
+    printf("Leaked: %ld\r\n", heap_before - heap_after);
+
+    // Final Report
+    if(minunit_fail == 0 && bench_regressions == 0) {
+        printf("Status: PASSED\r\n");
+    } else {
+        printf("Status: FAILED\r\n");
+    }
+    fflush(stdout);
+
+    return minunit_fail == 0 && bench_regressions == 0 ? 0 : 1;
+}
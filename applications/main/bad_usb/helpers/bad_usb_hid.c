@@ -7,6 +7,9 @@
 
 #define HID_BT_KEYS_STORAGE_NAME ".bt_hid.keys"
 
+#define HID_KB_BATCH_WINDOW_INIT 2
+#define HID_KB_BATCH_GROW_STREAK 16
+
 void* hid_usb_init(FuriHalUsbHidConfig* hid_cfg) {
     furi_check(furi_hal_usb_set_config(&usb_hid, hid_cfg));
     return NULL;
@@ -37,6 +40,16 @@ bool hid_usb_kb_release(void* inst, uint16_t button) {
     return furi_hal_hid_kb_release(button);
 }
 
+bool hid_usb_kb_press_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    UNUSED(inst);
+    return furi_hal_hid_kb_press_multiple(buttons, count);
+}
+
+bool hid_usb_kb_release_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    UNUSED(inst);
+    return furi_hal_hid_kb_release_multiple(buttons, count);
+}
+
 bool hid_usb_mouse_press(void* inst, uint8_t button) {
     UNUSED(inst);
     return furi_hal_hid_mouse_press(button);
@@ -93,6 +106,8 @@ static const BadUsbHidApi hid_api_usb = {
 
     .kb_press = hid_usb_kb_press,
     .kb_release = hid_usb_kb_release,
+    .kb_press_multiple = hid_usb_kb_press_multiple,
+    .kb_release_multiple = hid_usb_kb_release_multiple,
     .mouse_press = hid_usb_mouse_press,
     .mouse_release = hid_usb_mouse_release,
     .mouse_scroll = hid_usb_mouse_scroll,
@@ -187,6 +202,18 @@ bool hid_ble_kb_release(void* inst, uint16_t button) {
     return ble_profile_hid_kb_release(ble_hid->profile, button);
 }
 
+bool hid_ble_kb_press_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    BleHidInstance* ble_hid = inst;
+    furi_assert(ble_hid);
+    return ble_profile_hid_kb_press_multiple(ble_hid->profile, buttons, count);
+}
+
+bool hid_ble_kb_release_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    BleHidInstance* ble_hid = inst;
+    furi_assert(ble_hid);
+    return ble_profile_hid_kb_release_multiple(ble_hid->profile, buttons, count);
+}
+
 bool hid_ble_mouse_press(void* inst, uint8_t button) {
     BleHidInstance* ble_hid = inst;
     furi_assert(ble_hid);
@@ -243,6 +270,8 @@ static const BadUsbHidApi hid_api_ble = {
 
     .kb_press = hid_ble_kb_press,
     .kb_release = hid_ble_kb_release,
+    .kb_press_multiple = hid_ble_kb_press_multiple,
+    .kb_release_multiple = hid_ble_kb_release_multiple,
     .mouse_press = hid_ble_mouse_press,
     .mouse_release = hid_ble_mouse_release,
     .mouse_scroll = hid_ble_mouse_scroll,
@@ -261,6 +290,71 @@ const BadUsbHidApi* bad_usb_hid_get_interface(BadUsbHidInterface interface) {
     }
 }
 
+void bad_usb_hid_kb_batch_reset(BadUsbHidKbBatch* batch) {
+    furi_assert(batch);
+    batch->window = HID_KB_BATCH_WINDOW_INIT;
+    batch->streak = 0;
+}
+
+static size_t bad_usb_hid_kb_batch_len(const uint16_t* keys, size_t count, size_t limit) {
+    // Keys sent in one report must be distinct and share modifiers, modifier-only keys go alone
+    if((keys[0] & 0xFF) == HID_KEYBOARD_NONE) return 1;
+
+    size_t len = 1;
+    while(len < MIN(count, limit)) {
+        uint16_t key = keys[len];
+        if(((key & 0xFF00) != (keys[0] & 0xFF00)) || ((key & 0xFF) == HID_KEYBOARD_NONE)) break;
+
+        bool repeated = false;
+        for(size_t i = 0; i < len; i++) {
+            if((keys[i] & 0xFF) == (key & 0xFF)) {
+                repeated = true;
+                break;
+            }
+        }
+        if(repeated) break;
+        len++;
+    }
+
+    return len;
+}
+
+size_t bad_usb_hid_kb_type(
+    const BadUsbHidApi* hid,
+    void* inst,
+    BadUsbHidKbBatch* batch,
+    size_t slots,
+    const uint16_t* keys,
+    size_t count) {
+    furi_assert(hid);
+    furi_assert(batch);
+    if(count == 0) return 0;
+
+    size_t limit = (batch->size == BAD_USB_HID_KB_BATCH_AUTO) ? batch->window : batch->size;
+    limit = MAX(MIN(limit, slots), 1U);
+    size_t len = bad_usb_hid_kb_batch_len(keys, count, limit);
+
+    // Host sees all keys going down in report order, then all of them going up
+    bool state = hid->kb_press_multiple(inst, keys, len);
+    state &= hid->kb_release_multiple(inst, keys, len);
+
+    if(batch->size == BAD_USB_HID_KB_BATCH_AUTO) {
+        if(!state) {
+            // Report was not polled in time, host is falling behind
+            batch->window = MAX(batch->window / 2, 1);
+            batch->streak = 0;
+            FURI_LOG_D(TAG, "Batch window down to %u", batch->window);
+        } else if((len == limit) && (batch->window < HID_KB_MAX_KEYS)) {
+            if(++batch->streak >= HID_KB_BATCH_GROW_STREAK) {
+                batch->window++;
+                batch->streak = 0;
+            }
+        }
+    }
+
+    return len;
+}
+
 void bad_usb_hid_ble_remove_pairing(void) {
     Bt* bt = furi_record_open(RECORD_BT);
     bt_disconnect(bt);
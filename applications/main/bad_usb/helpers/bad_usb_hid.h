@@ -20,6 +20,8 @@ typedef struct {
 
     bool (*kb_press)(void* inst, uint16_t button);
     bool (*kb_release)(void* inst, uint16_t button);
+    bool (*kb_press_multiple)(void* inst, const uint16_t* buttons, size_t count);
+    bool (*kb_release_multiple)(void* inst, const uint16_t* buttons, size_t count);
     bool (*mouse_press)(void* inst, uint8_t button);
     bool (*mouse_release)(void* inst, uint8_t button);
     bool (*mouse_scroll)(void* inst, int8_t delta);
@@ -30,8 +32,27 @@ typedef struct {
     uint8_t (*get_led_state)(void* inst);
 } BadUsbHidApi;
 
+/** Batch size for adaptive typing, grows while host accepts reports in time */
+#define BAD_USB_HID_KB_BATCH_AUTO (0xFFU)
+
+typedef struct {
+    uint8_t size; // Keys per report, 1 to HID_KB_MAX_KEYS or BAD_USB_HID_KB_BATCH_AUTO
+    uint8_t window; // Current adaptive batch size
+    uint8_t streak; // Full batches sent since last window change
+} BadUsbHidKbBatch;
+
 const BadUsbHidApi* bad_usb_hid_get_interface(BadUsbHidInterface interface);
 
+void bad_usb_hid_kb_batch_reset(BadUsbHidKbBatch* batch);
+
+size_t bad_usb_hid_kb_type(
+    const BadUsbHidApi* hid,
+    void* inst,
+    BadUsbHidKbBatch* batch,
+    size_t slots,
+    const uint16_t* keys,
+    size_t count);
+
 void bad_usb_hid_ble_remove_pairing(void);
 
 #ifdef __cplusplus
@@ -62,11 +62,18 @@ uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept
     }
 
     if(strlen(param) > 0) {
-        return BADUSB_ASCII_TO_KEY(bad_usb, param[0]) & 0xFF;
+        return ducky_get_ascii_keycode(bad_usb, param[0]) & 0xFF;
     }
     return 0;
 }
 
+uint16_t ducky_get_ascii_keycode(BadUsbScript* bad_usb, const char chr) {
+    if(chr == '\n') {
+        return HID_KEYBOARD_RETURN;
+    }
+    return BADUSB_ASCII_TO_KEY(bad_usb, chr);
+}
+
 bool ducky_get_number(const char* param, uint32_t* val) {
     uint32_t value = 0;
     if(strint_to_uint32(param, NULL, &value, 10) == StrintParseNoError) {
@@ -83,50 +90,30 @@ void ducky_numlock_on(BadUsbScript* bad_usb) {
     }
 }
 
-bool ducky_numpad_press(BadUsbScript* bad_usb, const char num) {
-    if((num < '0') || (num > '9')) return false;
-
-    uint16_t key = numpad_keys[num - '0'];
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+uint16_t ducky_get_numpad_keycode(const char num) {
+    if((num < '0') || (num > '9')) return HID_KEYBOARD_NONE;
 
-    return true;
+    return numpad_keys[num - '0'];
 }
 
-bool ducky_altchar(BadUsbScript* bad_usb, const char* charcode) {
-    uint8_t i = 0;
-    bool state = false;
-
-    bad_usb->hid->kb_press(bad_usb->hid_inst, KEY_MOD_LEFT_ALT);
+void ducky_altstring(BadUsbScript* bad_usb, const DuckyOp* op) {
+    bool alt_pressed = false;
 
-    while(!ducky_is_line_end(charcode[i])) {
-        state = ducky_numpad_press(bad_usb, charcode[i]);
-        if(state == false) break;
-        i++;
-    }
-
-    bad_usb->hid->kb_release(bad_usb->hid_inst, KEY_MOD_LEFT_ALT);
-    return state;
-}
-
-bool ducky_altstring(BadUsbScript* bad_usb, const char* param) {
-    uint32_t i = 0;
-    bool state = false;
-
-    while(param[i] != '\0') {
-        if((param[i] < ' ') || (param[i] > '~')) {
-            i++;
-            continue; // Skip non-printable chars
+    for(size_t i = 0; i < op->keys.len; i++) {
+        uint16_t key = *DuckyKeyArray_cget(bad_usb->keys, op->keys.offset + i);
+        if(key == HID_KEYBOARD_NONE) { // End of char code
+            bad_usb->hid->kb_release(bad_usb->hid_inst, KEY_MOD_LEFT_ALT);
+            alt_pressed = false;
+            continue;
         }
 
-        char temp_str[4];
-        snprintf(temp_str, 4, "%u", param[i]);
-
-        state = ducky_altchar(bad_usb, temp_str);
-        if(state == false) break;
-        i++;
+        if(!alt_pressed) {
+            bad_usb->hid->kb_press(bad_usb->hid_inst, KEY_MOD_LEFT_ALT);
+            alt_pressed = true;
+        }
+        bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+        bad_usb->hid->kb_release(bad_usb->hid_inst, key);
     }
-    return state;
 }
 
 int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...) {
@@ -139,60 +126,42 @@ int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...) {
     return SCRIPT_STATE_ERROR;
 }
 
-bool ducky_string(BadUsbScript* bad_usb, const char* param) {
-    uint32_t i = 0;
+static size_t ducky_string_type(BadUsbScript* bad_usb, const DuckyOp* op, size_t pos) {
+    return bad_usb_hid_kb_type(
+        bad_usb->hid,
+        bad_usb->hid_inst,
+        &bad_usb->kb_batch,
+        HID_KB_MAX_KEYS - bad_usb->key_hold_nb,
+        DuckyKeyArray_cget(bad_usb->keys, op->keys.offset + pos),
+        op->keys.len - pos);
+}
 
-    while(param[i] != '\0') {
-        if(param[i] != '\n') {
-            uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, param[i]);
-            if(keycode != HID_KEYBOARD_NONE) {
-                bad_usb->hid->kb_press(bad_usb->hid_inst, keycode);
-                bad_usb->hid->kb_release(bad_usb->hid_inst, keycode);
-            }
-        } else {
-            bad_usb->hid->kb_press(bad_usb->hid_inst, HID_KEYBOARD_RETURN);
-            bad_usb->hid->kb_release(bad_usb->hid_inst, HID_KEYBOARD_RETURN);
-        }
-        i++;
+void ducky_string(BadUsbScript* bad_usb, const DuckyOp* op) {
+    size_t pos = 0;
+    while(pos < op->keys.len) {
+        pos += ducky_string_type(bad_usb, op, pos);
     }
     bad_usb->stringdelay = 0;
-    return true;
+    bad_usb->stringbatch = 0;
 }
 
 static bool ducky_string_next(BadUsbScript* bad_usb) {
-    if(bad_usb->string_print_pos >= furi_string_size(bad_usb->string_print)) {
+    const DuckyOp* op = bad_usb->string_print;
+    if(bad_usb->string_print_pos >= op->keys.len) {
         return true;
     }
 
-    char print_char = furi_string_get_char(bad_usb->string_print, bad_usb->string_print_pos);
-
-    if(print_char != '\n') {
-        uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, print_char);
-        if(keycode != HID_KEYBOARD_NONE) {
-            bad_usb->hid->kb_press(bad_usb->hid_inst, keycode);
-            bad_usb->hid->kb_release(bad_usb->hid_inst, keycode);
-        }
-    } else {
-        bad_usb->hid->kb_press(bad_usb->hid_inst, HID_KEYBOARD_RETURN);
-        bad_usb->hid->kb_release(bad_usb->hid_inst, HID_KEYBOARD_RETURN);
-    }
-
-    bad_usb->string_print_pos++;
+    bad_usb->string_print_pos += ducky_string_type(bad_usb, op, bad_usb->string_print_pos);
 
     return false;
 }
 
-static int32_t ducky_parse_line(BadUsbScript* bad_usb, FuriString* line) {
-    uint32_t line_len = furi_string_size(line);
+static int32_t ducky_compile_line(BadUsbScript* bad_usb, FuriString* line, DuckyOp* op) {
     const char* line_cstr = furi_string_get_cstr(line);
-
-    if(line_len == 0) {
-        return SCRIPT_STATE_NEXT_LINE; // Skip empty lines
-    }
     FURI_LOG_D(WORKER_TAG, "line:%s", line_cstr);
 
     // Ducky Lang Functions
-    int32_t cmd_result = ducky_execute_cmd(bad_usb, line_cstr);
+    int32_t cmd_result = ducky_compile_cmd(bad_usb, line_cstr, op);
     if(cmd_result != SCRIPT_STATE_CMD_UNKNOWN) {
         return cmd_result;
     }
@@ -200,8 +169,8 @@ static int32_t ducky_parse_line(BadUsbScript* bad_usb, FuriString* line) {
     // Mouse Keys
     uint16_t key = ducky_get_mouse_keycode_by_name(line_cstr);
     if(key != HID_MOUSE_INVALID) {
-        bad_usb->hid->mouse_press(bad_usb->hid_inst, key);
-        bad_usb->hid->mouse_release(bad_usb->hid_inst, key);
+        op->type = DuckyOpTypeMouseClick;
+        op->value = key;
         return 0;
     }
 
@@ -220,10 +189,12 @@ static int32_t ducky_parse_line(BadUsbScript* bad_usb, FuriString* line) {
     char next_char = *line_cstr;
     key = modifiers | ducky_get_keycode(bad_usb, line_cstr, false);
 
-    if(key == 0 && next_char) ducky_error(bad_usb, "No keycode defined for %s", line_cstr);
+    if(key == 0 && next_char) {
+        return ducky_error(bad_usb, "No keycode defined for %s", line_cstr);
+    }
 
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+    op->type = DuckyOpTypeKey;
+    op->value = key;
     return 0;
 }
 
@@ -263,38 +234,143 @@ static void bad_usb_hid_state_callback(bool state, void* context) {
     }
 }
 
-static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
-    uint8_t ret = 0;
-    uint32_t line_len = 0;
+static bool ducky_script_compile_line(BadUsbScript* bad_usb, FuriString* id_line) {
+    size_t line_nb = bad_usb->compile_line_nb;
+    if(id_line && line_nb == 1) { // Save first line
+        furi_string_set(id_line, bad_usb->line);
+    }
+
+    furi_string_trim(bad_usb->line);
+    if(furi_string_empty(bad_usb->line)) {
+        return true; // Skip empty lines
+    }
+
+    size_t keys_nb = DuckyKeyArray_size(bad_usb->keys);
+    DuckyOp op = {.line = line_nb};
+    if(ducky_compile_line(bad_usb, bad_usb->line, &op) < 0) {
+        bad_usb->st.error_line = line_nb;
+        FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", line_nb);
+        return false;
+    }
 
+    if(ducky_window_accepts(bad_usb->ops, keys_nb, &op)) {
+        DuckyOpArray_push_back(bad_usb->ops, op);
+    } else { // Line goes to the next window
+        DuckyKeyArray_resize(bad_usb->keys, keys_nb);
+        bad_usb->window_last = false;
+        bad_usb->window_next_line = line_nb - 1;
+    }
+
+    return true;
+}
+
+/** Compile window of lines starting at given file offset
+ *
+ * Keeps ops and keys bounded, so long scripts and STRING payloads run from
+ * consecutive windows, the next one is compiled when execution reaches the end.
+ */
+static bool ducky_script_compile_window(
+    BadUsbScript* bad_usb,
+    File* script_file,
+    size_t offset,
+    size_t line_nb,
+    FuriString* id_line) {
+    uint16_t ret = 0;
+    bool success = true;
+    size_t line_offset = offset;
+
+    DuckyOpArray_reset(bad_usb->ops);
+    DuckyKeyArray_reset(bad_usb->keys);
+    bad_usb->compile_line_nb = line_nb;
+    bad_usb->window_offset = offset;
+    bad_usb->window_last = true;
+    bad_usb->st.error[0] = '\0';
     furi_string_reset(bad_usb->line);
+    if(!storage_file_seek(script_file, offset, true)) {
+        ducky_error(bad_usb, "File read error");
+        success = false;
+    }
 
-    do {
+    while(success && bad_usb->window_last) {
         ret = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-        for(uint16_t i = 0; i < ret; i++) {
-            if(bad_usb->file_buf[i] == '\n' && line_len > 0) {
-                bad_usb->st.line_nb++;
-                line_len = 0;
-            } else {
-                if(bad_usb->st.line_nb == 0) { // Save first line
-                    furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
+        if(ret == 0) break;
+
+        for(uint16_t i = 0; (i < ret) && success && bad_usb->window_last; i++) {
+            if(furi_string_empty(bad_usb->line)) {
+                line_offset = offset + i;
+            }
+            if(bad_usb->file_buf[i] == '\n' && !furi_string_empty(bad_usb->line)) {
+                bad_usb->compile_line_nb++;
+                success = ducky_script_compile_line(bad_usb, id_line);
+                if(!bad_usb->window_last) {
+                    bad_usb->window_next_offset = line_offset;
                 }
-                line_len++;
+                furi_string_reset(bad_usb->line);
+            } else {
+                furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
             }
         }
-        if(storage_file_eof(script_file)) {
-            if(line_len > 0) {
-                bad_usb->st.line_nb++;
-                break;
-            }
+        offset += ret;
+    }
+
+    if(success && bad_usb->window_last &&
+       !furi_string_empty(bad_usb->line)) { // Last line without line feed
+        bad_usb->compile_line_nb++;
+        success = ducky_script_compile_line(bad_usb, id_line);
+        if(!bad_usb->window_last) {
+            bad_usb->window_next_offset = line_offset;
         }
-    } while(ret > 0);
+    }
+    furi_string_reset(bad_usb->line);
 
-    const char* line_tmp = furi_string_get_cstr(bad_usb->line);
+    if(!success) { // Give memory back, script won't run
+        DuckyOpArray_clear(bad_usb->ops);
+        DuckyOpArray_init(bad_usb->ops);
+        DuckyKeyArray_clear(bad_usb->keys);
+        DuckyKeyArray_init(bad_usb->keys);
+    }
+
+    FURI_LOG_D(
+        WORKER_TAG,
+        "compiled lines %zu-%zu: %zu ops, %zu keys",
+        line_nb + 1,
+        bad_usb->window_last ? bad_usb->compile_line_nb : bad_usb->window_next_line,
+        DuckyOpArray_size(bad_usb->ops),
+        DuckyKeyArray_size(bad_usb->keys));
+
+    return success;
+}
+
+/** Compile the whole script window by window, first window stays compiled */
+static bool ducky_script_compile(BadUsbScript* bad_usb, File* script_file, FuriString* id_line) {
+    bool success = ducky_script_compile_window(bad_usb, script_file, 0, 0, id_line);
+
+    // Check and count the rest of lines ahead of time, as a single script would
+    while(success && !bad_usb->window_last) {
+        success = ducky_script_compile_window(
+            bad_usb, script_file, bad_usb->window_next_offset, bad_usb->window_next_line, NULL);
+    }
+    bad_usb->st.line_nb = bad_usb->compile_line_nb;
+
+    if(success && bad_usb->window_offset != 0) {
+        success = ducky_script_compile_window(bad_usb, script_file, 0, 0, NULL);
+    }
+
+    return success;
+}
+
+static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
+    FuriString* id_line = furi_string_alloc();
+
+    bad_usb->layout_changed = false;
+    bool success = ducky_script_compile(bad_usb, script_file, id_line);
+
+    const char* line_tmp = furi_string_get_cstr(id_line);
     bool id_set = false; // Looking for ID command at first line
     if(strncmp(line_tmp, ducky_cmd_id, strlen(ducky_cmd_id)) == 0) {
         id_set = ducky_set_usb_id(bad_usb, &line_tmp[strlen(ducky_cmd_id) + 1]);
     }
+    furi_string_free(id_line);
 
     if(id_set) {
         bad_usb->hid_inst = bad_usb->hid->init(&bad_usb->hid_cfg);
@@ -303,79 +379,75 @@ static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
     }
     bad_usb->hid->set_state_callback(bad_usb->hid_inst, bad_usb_hid_state_callback, bad_usb);
 
-    storage_file_seek(script_file, 0, true);
-    furi_string_reset(bad_usb->line);
+    return success;
+}
+
+static bool ducky_script_rewind(BadUsbScript* bad_usb, File* script_file) {
+    bad_usb->op_pos = 0;
+    bad_usb->st.line_cur = 0;
+    bad_usb->defdelay = 0;
+    bad_usb->stringdelay = 0;
+    bad_usb->defstringdelay = 0;
+    bad_usb->stringbatch = 0;
+    bad_usb->defstringbatch = 1;
+    bad_usb->repeat_cnt = 0;
+    bad_usb->key_hold_nb = 0;
+    bad_usb_hid_kb_batch_reset(&bad_usb->kb_batch);
+
+    // Keycodes were resolved against previous layout, or script ran past the first window
+    if(bad_usb->layout_changed || (bad_usb->window_offset != 0)) {
+        bad_usb->layout_changed = false;
+        return ducky_script_compile_window(bad_usb, script_file, 0, 0, NULL);
+    }
 
     return true;
 }
 
 static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, File* script_file) {
-    int32_t delay_val = 0;
+    while(true) {
+        if(bad_usb->op_pos >= DuckyOpArray_size(bad_usb->ops)) {
+            if(bad_usb->window_last) break;
+
+            if(!ducky_script_compile_window(
+                   bad_usb,
+                   script_file,
+                   bad_usb->window_next_offset,
+                   bad_usb->window_next_line,
+                   NULL)) {
+                FURI_LOG_E(WORKER_TAG, "Script load error");
+                return SCRIPT_STATE_ERROR;
+            }
+            bad_usb->op_pos = 0;
+            continue;
+        }
 
-    if(bad_usb->repeat_cnt > 0) {
-        bad_usb->repeat_cnt--;
-        delay_val = ducky_parse_line(bad_usb, bad_usb->line_prev);
-        if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-            return 0;
-        } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
+        const DuckyOp* op = DuckyOpArray_cget(bad_usb->ops, bad_usb->op_pos);
+        // Repeated lines do not move progress back
+        if(op->line > bad_usb->st.line_cur) {
+            bad_usb->st.line_cur = op->line;
+        }
+
+        if(op->type == DuckyOpTypeRepeat) {
+            bad_usb->op_pos = ducky_op_repeat_step(op, bad_usb->op_pos, &bad_usb->repeat_cnt);
+            continue;
+        }
+
+        bad_usb->op_pos++;
+        int32_t delay_val = ducky_execute_op(bad_usb, op);
+        if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
             return delay_val;
         } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
             return delay_val;
         } else if(delay_val < 0) { // Script error
-            bad_usb->st.error_line = bad_usb->st.line_cur - 1;
-            FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur - 1U);
+            bad_usb->st.error_line = op->line;
+            FURI_LOG_E(WORKER_TAG, "Script error at line %lu", op->line);
             return SCRIPT_STATE_ERROR;
         } else {
             return delay_val + bad_usb->defdelay;
         }
     }
 
-    furi_string_set(bad_usb->line_prev, bad_usb->line);
-    furi_string_reset(bad_usb->line);
-
-    while(1) {
-        if(bad_usb->buf_len == 0) {
-            bad_usb->buf_len = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-            if(storage_file_eof(script_file)) {
-                if((bad_usb->buf_len < FILE_BUFFER_LEN) && (bad_usb->file_end == false)) {
-                    bad_usb->file_buf[bad_usb->buf_len] = '\n';
-                    bad_usb->buf_len++;
-                    bad_usb->file_end = true;
-                }
-            }
-
-            bad_usb->buf_start = 0;
-            if(bad_usb->buf_len == 0) return SCRIPT_STATE_END;
-        }
-        for(uint8_t i = bad_usb->buf_start; i < (bad_usb->buf_start + bad_usb->buf_len); i++) {
-            if(bad_usb->file_buf[i] == '\n' && furi_string_size(bad_usb->line) > 0) {
-                bad_usb->st.line_cur++;
-                bad_usb->buf_len = bad_usb->buf_len + bad_usb->buf_start - (i + 1);
-                bad_usb->buf_start = i + 1;
-                furi_string_trim(bad_usb->line);
-                delay_val = ducky_parse_line(bad_usb, bad_usb->line);
-                if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-                    return 0;
-                } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-                    return delay_val;
-                } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-                    return delay_val;
-                } else if(delay_val < 0) {
-                    bad_usb->st.error_line = bad_usb->st.line_cur;
-                    FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur);
-                    return SCRIPT_STATE_ERROR;
-                } else {
-                    return delay_val + bad_usb->defdelay;
-                }
-            } else {
-                furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
-            }
-        }
-        bad_usb->buf_len = 0;
-        if(bad_usb->file_end) return SCRIPT_STATE_END;
-    }
-
-    return 0;
+    return SCRIPT_STATE_END;
 }
 
 static uint32_t bad_usb_flags_get(uint32_t flags_mask, uint32_t timeout) {
@@ -401,8 +473,8 @@ static int32_t bad_usb_worker(void* context) {
     FURI_LOG_I(WORKER_TAG, "Init");
     File* script_file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
     bad_usb->line = furi_string_alloc();
-    bad_usb->line_prev = furi_string_alloc();
-    bad_usb->string_print = furi_string_alloc();
+    DuckyOpArray_init(bad_usb->ops);
+    DuckyKeyArray_init(bad_usb->keys);
 
     while(1) {
         if(worker_state == BadUsbStateInit) { // State: initialization
@@ -449,16 +521,11 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtStartStop) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
-                bad_usb->st.line_cur = 0;
-                bad_usb->defdelay = 0;
-                bad_usb->stringdelay = 0;
-                bad_usb->defstringdelay = 0;
-                bad_usb->repeat_cnt = 0;
-                bad_usb->key_hold_nb = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
-                worker_state = BadUsbStateRunning;
+                if(ducky_script_rewind(bad_usb, script_file)) {
+                    worker_state = BadUsbStateRunning;
+                } else {
+                    worker_state = BadUsbStateScriptError; // Script compile error
+                }
             } else if(flags & WorkerEvtDisconnect) {
                 worker_state = BadUsbStateNotConnected; // USB disconnected
             }
@@ -473,14 +540,11 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtConnect) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
-                bad_usb->st.line_cur = 0;
-                bad_usb->defdelay = 0;
-                bad_usb->stringdelay = 0;
-                bad_usb->defstringdelay = 0;
-                bad_usb->repeat_cnt = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
+                if(!ducky_script_rewind(bad_usb, script_file)) {
+                    worker_state = BadUsbStateScriptError; // Script compile error
+                    bad_usb->st.state = worker_state;
+                    continue;
+                }
                 // extra time for PC to recognize Flipper as keyboard
                 flags = furi_thread_flags_wait(
                     WorkerEvtEnd | WorkerEvtDisconnect | WorkerEvtStartStop,
@@ -632,6 +696,7 @@ static int32_t bad_usb_worker(void* context) {
                 bool string_end = ducky_string_next(bad_usb);
                 if(string_end) {
                     bad_usb->stringdelay = 0;
+                    bad_usb->stringbatch = 0;
                     worker_state = BadUsbStateRunning;
                 }
             } else {
@@ -655,8 +720,8 @@ static int32_t bad_usb_worker(void* context) {
     storage_file_close(script_file);
     storage_file_free(script_file);
     furi_string_free(bad_usb->line);
-    furi_string_free(bad_usb->line_prev);
-    furi_string_free(bad_usb->string_print);
+    DuckyOpArray_clear(bad_usb->ops);
+    DuckyKeyArray_clear(bad_usb->keys);
 
     FURI_LOG_I(WORKER_TAG, "End");
 
@@ -710,11 +775,13 @@ void bad_usb_script_set_keyboard_layout(BadUsbScript* bad_usb, FuriString* layou
             uint16_t layout[128];
             if(storage_file_read(layout_file, layout, sizeof(layout)) == sizeof(layout)) {
                 memcpy(bad_usb->layout, layout, sizeof(layout));
+                bad_usb->layout_changed = true;
             }
         }
         storage_file_close(layout_file);
     } else {
         bad_usb_script_set_default_keyboard_layout(bad_usb);
+        bad_usb->layout_changed = true;
     }
     storage_file_free(layout_file);
 }
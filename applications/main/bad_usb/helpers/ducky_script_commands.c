@@ -3,7 +3,11 @@
 #include "ducky_script.h"
 #include "ducky_script_i.h"
 
-typedef int32_t (*DuckyCmdCallback)(BadUsbScript* bad_usb, const char* line, int32_t param);
+typedef int32_t (*DuckyCmdCallback)(
+    BadUsbScript* bad_usb,
+    const char* line,
+    int32_t param,
+    DuckyOp* op);
 
 typedef struct {
     char* name;
@@ -11,139 +15,168 @@ typedef struct {
     int32_t param;
 } DuckyCmd;
 
-static int32_t ducky_fnc_delay(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_delay(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
     uint32_t delay_val = 0;
     bool state = ducky_get_number(line, &delay_val);
     if((state) && (delay_val > 0)) {
-        return (int32_t)delay_val;
+        op->type = DuckyOpTypeDelay;
+        op->value = delay_val;
+        return 0;
     }
 
     return ducky_error(bad_usb, "Invalid number %s", line);
 }
 
-static int32_t ducky_fnc_defdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
+static int32_t
+    ducky_fnc_setdelay(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->defdelay);
+    bool state = ducky_get_number(line, &op->value);
     if(!state) {
         return ducky_error(bad_usb, "Invalid number %s", line);
     }
+    op->type = param;
     return 0;
 }
 
-static int32_t ducky_fnc_strdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
+static int32_t
+    ducky_fnc_setbatch(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->stringdelay);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid number %s", line);
-    }
-    return 0;
-}
-
-static int32_t ducky_fnc_defstrdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->defstringdelay);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid number %s", line);
+    if(strncmp(line, "AUTO", strlen("AUTO")) == 0 && ducky_is_line_end(line[strlen("AUTO")])) {
+        op->value = BAD_USB_HID_KB_BATCH_AUTO;
+    } else {
+        bool state = ducky_get_number(line, &op->value);
+        if((!state) || (op->value == 0) || (op->value > HID_KB_MAX_KEYS)) {
+            return ducky_error(bad_usb, "Invalid batch size %s", line);
+        }
     }
+    op->type = param;
     return 0;
 }
 
-static int32_t ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     line = &line[ducky_get_command_len(line) + 1];
-    furi_string_set_str(bad_usb->string_print, line);
-    if(param == 1) {
-        furi_string_cat(bad_usb->string_print, "\n");
-    }
 
-    if(bad_usb->stringdelay == 0 &&
-       bad_usb->defstringdelay == 0) { // stringdelay not set - run command immediately
-        bool state = ducky_string(bad_usb, furi_string_get_cstr(bad_usb->string_print));
-        if(!state) {
-            return ducky_error(bad_usb, "Invalid string %s", line);
+    op->type = DuckyOpTypeString;
+    op->keys.offset = DuckyKeyArray_size(bad_usb->keys);
+    for(size_t i = 0; line[i] != '\0'; i++) {
+        uint16_t keycode = ducky_get_ascii_keycode(bad_usb, line[i]);
+        if(keycode != HID_KEYBOARD_NONE) {
+            DuckyKeyArray_push_back(bad_usb->keys, keycode);
         }
-    } else { // stringdelay is set - run command in thread to keep handling external events
-        return SCRIPT_STATE_STRING_START;
     }
+    if(param == 1) {
+        DuckyKeyArray_push_back(bad_usb->keys, HID_KEYBOARD_RETURN);
+    }
+    op->keys.len = DuckyKeyArray_size(bad_usb->keys) - op->keys.offset;
 
     return 0;
 }
 
-static int32_t ducky_fnc_repeat(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_repeat(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->repeat_cnt);
-    if((!state) || (bad_usb->repeat_cnt == 0)) {
+    uint32_t count = 0;
+    bool state = ducky_get_number(line, &count);
+    if((!state) || (count == 0) || !ducky_op_repeat_compile(bad_usb->ops, count, op)) {
         return ducky_error(bad_usb, "Invalid number %s", line);
     }
     return 0;
 }
 
-static int32_t ducky_fnc_sysrq(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_sysrq(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    uint16_t key = ducky_get_keycode(bad_usb, line, false);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->release_all(bad_usb->hid_inst);
+    op->type = DuckyOpTypeSysrq;
+    op->value = ducky_get_keycode(bad_usb, line, false);
     return 0;
 }
 
-static int32_t ducky_fnc_altchar(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static bool ducky_push_altchar(BadUsbScript* bad_usb, const char* charcode) {
+    uint8_t i = 0;
+    bool state = false;
+
+    while(!ducky_is_line_end(charcode[i])) {
+        uint16_t key = ducky_get_numpad_keycode(charcode[i]);
+        state = (key != HID_KEYBOARD_NONE);
+        if(state == false) break;
+        DuckyKeyArray_push_back(bad_usb->keys, key);
+        i++;
+    }
+
+    DuckyKeyArray_push_back(bad_usb->keys, HID_KEYBOARD_NONE);
+    return state;
+}
+
+static int32_t
+    ducky_fnc_altchar(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    ducky_numlock_on(bad_usb);
-    bool state = ducky_altchar(bad_usb, line);
+    op->type = DuckyOpTypeAltString;
+    op->keys.offset = DuckyKeyArray_size(bad_usb->keys);
+    bool state = ducky_push_altchar(bad_usb, line);
+    op->keys.len = DuckyKeyArray_size(bad_usb->keys) - op->keys.offset;
     if(!state) {
         return ducky_error(bad_usb, "Invalid altchar %s", line);
     }
     return 0;
 }
 
-static int32_t ducky_fnc_altstring(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_altstring(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    ducky_numlock_on(bad_usb);
-    bool state = ducky_altstring(bad_usb, line);
+    op->type = DuckyOpTypeAltString;
+    op->keys.offset = DuckyKeyArray_size(bad_usb->keys);
+
+    bool state = false;
+    for(size_t i = 0; line[i] != '\0'; i++) {
+        if((line[i] < ' ') || (line[i] > '~')) {
+            continue; // Skip non-printable chars
+        }
+
+        char temp_str[4];
+        snprintf(temp_str, 4, "%u", line[i]);
+
+        state = ducky_push_altchar(bad_usb, temp_str);
+        if(state == false) break;
+    }
+    op->keys.len = DuckyKeyArray_size(bad_usb->keys) - op->keys.offset;
+
     if(!state) {
         return ducky_error(bad_usb, "Invalid altstring %s", line);
     }
     return 0;
 }
 
-static int32_t ducky_fnc_hold(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_hold(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
     line = &line[ducky_get_command_len(line) + 1];
 
-    if(bad_usb->key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
-        return ducky_error(bad_usb, "Too many keys are held");
-    }
-
     // Handle Mouse Keys here
     uint16_t key = ducky_get_mouse_keycode_by_name(line);
     if(key != HID_MOUSE_NONE) {
-        bad_usb->key_hold_nb++;
-        bad_usb->hid->mouse_press(bad_usb->hid_inst, key);
+        op->type = DuckyOpTypeMouseHold;
+        op->value = key;
         return 0;
     }
 
     // Handle Keyboard keys here
     key = ducky_get_keycode(bad_usb, line, true);
     if(key != HID_KEYBOARD_NONE) {
-        bad_usb->key_hold_nb++;
-        bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+        op->type = DuckyOpTypeKeyHold;
+        op->value = key;
         return 0;
     }
 
@@ -151,27 +184,24 @@ static int32_t ducky_fnc_hold(BadUsbScript* bad_usb, const char* line, int32_t p
     return ducky_error(bad_usb, "Unknown keycode for %s", line);
 }
 
-static int32_t ducky_fnc_release(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_release(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
     line = &line[ducky_get_command_len(line) + 1];
 
-    if(bad_usb->key_hold_nb == 0) {
-        return ducky_error(bad_usb, "No keys are held");
-    }
-
     // Handle Mouse Keys here
     uint16_t key = ducky_get_mouse_keycode_by_name(line);
     if(key != HID_MOUSE_NONE) {
-        bad_usb->key_hold_nb--;
-        bad_usb->hid->mouse_release(bad_usb->hid_inst, key);
+        op->type = DuckyOpTypeMouseRelease;
+        op->value = key;
         return 0;
     }
 
     //Handle Keyboard Keys here
     key = ducky_get_keycode(bad_usb, line, true);
     if(key != HID_KEYBOARD_NONE) {
-        bad_usb->key_hold_nb--;
-        bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+        op->type = DuckyOpTypeKeyRelease;
+        op->value = key;
         return 0;
     }
 
@@ -179,7 +209,8 @@ static int32_t ducky_fnc_release(BadUsbScript* bad_usb, const char* line, int32_
     return ducky_error(bad_usb, "No keycode defined for %s", line);
 }
 
-static int32_t ducky_fnc_media(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_media(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
@@ -187,12 +218,13 @@ static int32_t ducky_fnc_media(BadUsbScript* bad_usb, const char* line, int32_t
     if(key == HID_CONSUMER_UNASSIGNED) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-    bad_usb->hid->consumer_press(bad_usb->hid_inst, key);
-    bad_usb->hid->consumer_release(bad_usb->hid_inst, key);
+    op->type = DuckyOpTypeMedia;
+    op->value = key;
     return 0;
 }
 
-static int32_t ducky_fnc_globe(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_globe(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
@@ -200,23 +232,23 @@ static int32_t ducky_fnc_globe(BadUsbScript* bad_usb, const char* line, int32_t
     if(key == HID_KEYBOARD_NONE) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-
-    bad_usb->hid->consumer_press(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
-    bad_usb->hid->consumer_release(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+    op->type = DuckyOpTypeGlobe;
+    op->value = key;
     return 0;
 }
 
-static int32_t ducky_fnc_waitforbutton(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_waitforbutton(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
     UNUSED(bad_usb);
     UNUSED(line);
 
-    return SCRIPT_STATE_WAIT_FOR_BTN;
+    op->type = DuckyOpTypeWaitForButton;
+    return 0;
 }
 
-static int32_t ducky_fnc_mouse_scroll(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_mouse_scroll(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[strcspn(line, " ") + 1];
@@ -226,12 +258,13 @@ static int32_t ducky_fnc_mouse_scroll(BadUsbScript* bad_usb, const char* line, i
         return ducky_error(bad_usb, "Invalid Number %s", line);
     }
 
-    bad_usb->hid->mouse_scroll(bad_usb->hid_inst, mouse_scroll_dist);
-
+    op->type = DuckyOpTypeMouseScroll;
+    op->mouse.y = mouse_scroll_dist;
     return 0;
 }
 
-static int32_t ducky_fnc_mouse_move(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t
+    ducky_fnc_mouse_move(BadUsbScript* bad_usb, const char* line, int32_t param, DuckyOp* op) {
     UNUSED(param);
 
     line = &line[strcspn(line, " ") + 1];
@@ -248,8 +281,9 @@ static int32_t ducky_fnc_mouse_move(BadUsbScript* bad_usb, const char* line, int
         return ducky_error(bad_usb, "Invalid Number %s", line);
     }
 
-    bad_usb->hid->mouse_move(bad_usb->hid_inst, mouse_move_x, mouse_move_y);
-
+    op->type = DuckyOpTypeMouseMove;
+    op->mouse.x = mouse_move_x;
+    op->mouse.y = mouse_move_y;
     return 0;
 }
 
@@ -259,12 +293,16 @@ static const DuckyCmd ducky_commands[] = {
     {"DELAY", ducky_fnc_delay, -1},
     {"STRING", ducky_fnc_string, 0},
     {"STRINGLN", ducky_fnc_string, 1},
-    {"DEFAULT_DELAY", ducky_fnc_defdelay, -1},
-    {"DEFAULTDELAY", ducky_fnc_defdelay, -1},
-    {"STRINGDELAY", ducky_fnc_strdelay, -1},
-    {"STRING_DELAY", ducky_fnc_strdelay, -1},
-    {"DEFAULT_STRING_DELAY", ducky_fnc_defstrdelay, -1},
-    {"DEFAULTSTRINGDELAY", ducky_fnc_defstrdelay, -1},
+    {"DEFAULT_DELAY", ducky_fnc_setdelay, DuckyOpTypeDefaultDelay},
+    {"DEFAULTDELAY", ducky_fnc_setdelay, DuckyOpTypeDefaultDelay},
+    {"STRINGDELAY", ducky_fnc_setdelay, DuckyOpTypeStringDelay},
+    {"STRING_DELAY", ducky_fnc_setdelay, DuckyOpTypeStringDelay},
+    {"DEFAULT_STRING_DELAY", ducky_fnc_setdelay, DuckyOpTypeDefaultStringDelay},
+    {"DEFAULTSTRINGDELAY", ducky_fnc_setdelay, DuckyOpTypeDefaultStringDelay},
+    {"STRINGBATCH", ducky_fnc_setbatch, DuckyOpTypeStringBatch},
+    {"STRING_BATCH", ducky_fnc_setbatch, DuckyOpTypeStringBatch},
+    {"DEFAULT_STRING_BATCH", ducky_fnc_setbatch, DuckyOpTypeDefaultStringBatch},
+    {"DEFAULTSTRINGBATCH", ducky_fnc_setbatch, DuckyOpTypeDefaultStringBatch},
     {"REPEAT", ducky_fnc_repeat, -1},
     {"SYSRQ", ducky_fnc_sysrq, -1},
     {"ALTCHAR", ducky_fnc_altchar, -1},
@@ -285,7 +323,7 @@ static const DuckyCmd ducky_commands[] = {
 
 #define WORKER_TAG TAG "Worker"
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
+int32_t ducky_compile_cmd(BadUsbScript* bad_usb, const char* line, DuckyOp* op) {
     size_t cmd_word_len = strcspn(line, " ");
     for(size_t i = 0; i < COUNT_OF(ducky_commands); i++) {
         size_t cmd_compare_len = strlen(ducky_commands[i].name);
@@ -296,12 +334,110 @@ int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
 
         if(strncmp(line, ducky_commands[i].name, cmd_compare_len) == 0) {
             if(ducky_commands[i].callback == NULL) {
+                op->type = DuckyOpTypeNop;
                 return 0;
             } else {
-                return (ducky_commands[i].callback)(bad_usb, line, ducky_commands[i].param);
+                return (ducky_commands[i].callback)(bad_usb, line, ducky_commands[i].param, op);
             }
         }
     }
 
     return SCRIPT_STATE_CMD_UNKNOWN;
 }
+
+int32_t ducky_execute_op(BadUsbScript* bad_usb, const DuckyOp* op) {
+    switch(op->type) {
+    case DuckyOpTypeNop:
+    case DuckyOpTypeRepeat: // Handled by worker
+        break;
+    case DuckyOpTypeDelay:
+        return op->value;
+    case DuckyOpTypeDefaultDelay:
+        bad_usb->defdelay = op->value;
+        break;
+    case DuckyOpTypeStringDelay:
+        bad_usb->stringdelay = op->value;
+        break;
+    case DuckyOpTypeDefaultStringDelay:
+        bad_usb->defstringdelay = op->value;
+        break;
+    case DuckyOpTypeStringBatch:
+        bad_usb->stringbatch = op->value;
+        break;
+    case DuckyOpTypeDefaultStringBatch:
+        bad_usb->defstringbatch = op->value;
+        break;
+    case DuckyOpTypeString:
+        bad_usb->kb_batch.size = (bad_usb->stringbatch == 0) ? bad_usb->defstringbatch :
+                                                               bad_usb->stringbatch;
+        if(bad_usb->stringdelay == 0 &&
+           bad_usb->defstringdelay == 0) { // stringdelay not set - run command immediately
+            ducky_string(bad_usb, op);
+        } else { // stringdelay is set - run command in thread to keep handling external events
+            bad_usb->string_print = op;
+            return SCRIPT_STATE_STRING_START;
+        }
+        break;
+    case DuckyOpTypeAltString:
+        ducky_numlock_on(bad_usb);
+        ducky_altstring(bad_usb, op);
+        break;
+    case DuckyOpTypeKey:
+        bad_usb->hid->kb_press(bad_usb->hid_inst, op->value);
+        bad_usb->hid->kb_release(bad_usb->hid_inst, op->value);
+        break;
+    case DuckyOpTypeKeyHold:
+    case DuckyOpTypeMouseHold:
+        if(bad_usb->key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
+            return ducky_error(bad_usb, "Too many keys are held");
+        }
+        bad_usb->key_hold_nb++;
+        if(op->type == DuckyOpTypeKeyHold) {
+            bad_usb->hid->kb_press(bad_usb->hid_inst, op->value);
+        } else {
+            bad_usb->hid->mouse_press(bad_usb->hid_inst, op->value);
+        }
+        break;
+    case DuckyOpTypeKeyRelease:
+    case DuckyOpTypeMouseRelease:
+        if(bad_usb->key_hold_nb == 0) {
+            return ducky_error(bad_usb, "No keys are held");
+        }
+        bad_usb->key_hold_nb--;
+        if(op->type == DuckyOpTypeKeyRelease) {
+            bad_usb->hid->kb_release(bad_usb->hid_inst, op->value);
+        } else {
+            bad_usb->hid->mouse_release(bad_usb->hid_inst, op->value);
+        }
+        break;
+    case DuckyOpTypeSysrq:
+        bad_usb->hid->kb_press(bad_usb->hid_inst, KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
+        bad_usb->hid->kb_press(bad_usb->hid_inst, op->value);
+        bad_usb->hid->release_all(bad_usb->hid_inst);
+        break;
+    case DuckyOpTypeGlobe:
+        bad_usb->hid->consumer_press(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+        bad_usb->hid->kb_press(bad_usb->hid_inst, op->value);
+        bad_usb->hid->kb_release(bad_usb->hid_inst, op->value);
+        bad_usb->hid->consumer_release(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+        break;
+    case DuckyOpTypeMedia:
+        bad_usb->hid->consumer_press(bad_usb->hid_inst, op->value);
+        bad_usb->hid->consumer_release(bad_usb->hid_inst, op->value);
+        break;
+    case DuckyOpTypeMouseClick:
+        bad_usb->hid->mouse_press(bad_usb->hid_inst, op->value);
+        bad_usb->hid->mouse_release(bad_usb->hid_inst, op->value);
+        break;
+    case DuckyOpTypeMouseMove:
+        bad_usb->hid->mouse_move(bad_usb->hid_inst, op->mouse.x, op->mouse.y);
+        break;
+    case DuckyOpTypeMouseScroll:
+        bad_usb->hid->mouse_scroll(bad_usb->hid_inst, op->mouse.y);
+        break;
+    case DuckyOpTypeWaitForButton:
+        return SCRIPT_STATE_WAIT_FOR_BTN;
+    }
+
+    return 0;
+}
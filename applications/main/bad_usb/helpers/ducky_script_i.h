@@ -6,6 +6,7 @@ extern "C" {
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <m-array.h>
 #include "ducky_script.h"
 #include "bad_usb_hid.h"
 
@@ -18,9 +19,127 @@ extern "C" {
 
 #define FILE_BUFFER_LEN 16
 
+// Script is compiled in windows of about that size, ops and keys together
+#define DUCKY_SCRIPT_WINDOW_SIZE (32 * 1024)
+
 #define HID_MOUSE_INVALID 0
 #define HID_MOUSE_NONE    0
 
+typedef enum {
+    DuckyOpTypeNop,
+    DuckyOpTypeDelay,
+    DuckyOpTypeDefaultDelay,
+    DuckyOpTypeStringDelay,
+    DuckyOpTypeDefaultStringDelay,
+    DuckyOpTypeStringBatch,
+    DuckyOpTypeDefaultStringBatch,
+    DuckyOpTypeString,
+    DuckyOpTypeAltString,
+    DuckyOpTypeRepeat,
+    DuckyOpTypeKey,
+    DuckyOpTypeKeyHold,
+    DuckyOpTypeKeyRelease,
+    DuckyOpTypeSysrq,
+    DuckyOpTypeGlobe,
+    DuckyOpTypeMedia,
+    DuckyOpTypeMouseClick,
+    DuckyOpTypeMouseHold,
+    DuckyOpTypeMouseRelease,
+    DuckyOpTypeMouseMove,
+    DuckyOpTypeMouseScroll,
+    DuckyOpTypeWaitForButton,
+} DuckyOpType;
+
+/** Compiled script line, one op per non-empty line */
+typedef struct {
+    DuckyOpType type;
+    uint32_t line;
+    union {
+        uint32_t value; // Delay, batch size, keycode or mouse button
+        struct {
+            uint32_t offset; // First keycode in BadUsbScript.keys
+            uint32_t len;
+        } keys; // String, keypad digits for AltString separated by HID_KEYBOARD_NONE
+        struct {
+            uint32_t target; // Op index to jump back to
+            uint32_t count;
+        } repeat;
+        struct {
+            int32_t x;
+            int32_t y;
+        } mouse;
+    };
+} DuckyOp;
+
+ARRAY_DEF(DuckyOpArray, DuckyOp, M_POD_OPLIST); //-V658
+ARRAY_DEF(DuckyKeyArray, uint16_t, M_POD_OPLIST); //-V658
+
+/** Compile REPEAT of the last op
+ *
+ * Back to back REPEATs add up to the first one, so jumps are never nested.
+ *
+ * @return false if total repeat count is too big
+ */
+static inline bool ducky_op_repeat_compile(DuckyOpArray_t ops, uint32_t count, DuckyOp* op) {
+    size_t op_nb = DuckyOpArray_size(ops);
+    if(op_nb == 0) { // Nothing to repeat
+        op->type = DuckyOpTypeNop;
+        return true;
+    }
+
+    const DuckyOp* prev = DuckyOpArray_cget(ops, op_nb - 1);
+    op->type = DuckyOpTypeRepeat;
+    if(prev->type == DuckyOpTypeRepeat) {
+        // First REPEAT always follows its target
+        DuckyOp* first = DuckyOpArray_get(ops, prev->repeat.target + 1);
+        if(count >= UINT32_MAX - first->repeat.count) return false;
+        first->repeat.count += count;
+        op->repeat.target = prev->repeat.target;
+        op->repeat.count = 0;
+    } else {
+        if(count == UINT32_MAX) return false;
+        op->repeat.target = op_nb - 1;
+        op->repeat.count = count;
+    }
+
+    return true;
+}
+
+/** Step over REPEAT op
+ *
+ * @param      op          REPEAT op
+ * @param[in]  pos         Index of the op
+ * @param      repeat_cnt  Repeats left, 0 when not repeating
+ *
+ * @return     index of the next op
+ */
+static inline size_t ducky_op_repeat_step(const DuckyOp* op, size_t pos, uint32_t* repeat_cnt) {
+    if(*repeat_cnt == 0) { // First pass
+        *repeat_cnt = op->repeat.count + 1;
+    }
+    (*repeat_cnt)--;
+    return (*repeat_cnt > 0) ? op->repeat.target : (pos + 1);
+}
+
+/** Check if compiled op goes to the current window
+ *
+ * Window is closed by the first op that is not a REPEAT once it holds
+ * DUCKY_SCRIPT_WINDOW_SIZE, so REPEAT always stays with the op it repeats.
+ * Empty window takes a line of any length.
+ *
+ * @param ops      ops of the window
+ * @param keys_nb  keys of the window, without keys of the op
+ * @param op       compiled op
+ *
+ * @return false if op starts the next window
+ */
+static inline bool ducky_window_accepts(DuckyOpArray_t ops, size_t keys_nb, const DuckyOp* op) {
+    if(op->type == DuckyOpTypeRepeat) return true;
+
+    size_t size = DuckyOpArray_size(ops) * sizeof(DuckyOp) + keys_nb * sizeof(uint16_t);
+    return size < DUCKY_SCRIPT_WINDOW_SIZE;
+}
+
 struct BadUsbScript {
     FuriHalUsbHidConfig hid_cfg;
     const BadUsbHidApi* hid;
@@ -30,26 +149,38 @@ struct BadUsbScript {
 
     FuriString* file_path;
     uint8_t file_buf[FILE_BUFFER_LEN + 1];
-    uint8_t buf_start;
-    uint8_t buf_len;
-    bool file_end;
+    bool layout_changed;
+
+    DuckyOpArray_t ops;
+    DuckyKeyArray_t keys;
+    size_t op_pos;
+
+    size_t compile_line_nb;
+    size_t window_offset; // File offset of the compiled window
+    bool window_last;
+    size_t window_next_offset;
+    size_t window_next_line;
 
     uint32_t defdelay;
     uint32_t stringdelay;
     uint32_t defstringdelay;
+    uint8_t stringbatch;
+    uint8_t defstringbatch;
+    BadUsbHidKbBatch kb_batch;
     uint16_t layout[128];
 
     FuriString* line;
-    FuriString* line_prev;
     uint32_t repeat_cnt;
     uint8_t key_hold_nb;
 
-    FuriString* string_print;
+    const DuckyOp* string_print;
     size_t string_print_pos;
 };
 
 uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_modifiers);
 
+uint16_t ducky_get_ascii_keycode(BadUsbScript* bad_usb, const char chr);
+
 uint32_t ducky_get_command_len(const char* line);
 
 bool ducky_is_line_end(const char chr);
@@ -66,17 +197,17 @@ uint8_t ducky_get_mouse_keycode_by_name(const char* param);
 
 bool ducky_get_number(const char* param, uint32_t* val);
 
-void ducky_numlock_on(BadUsbScript* bad_usb);
+uint16_t ducky_get_numpad_keycode(const char num);
 
-bool ducky_numpad_press(BadUsbScript* bad_usb, const char num);
+void ducky_numlock_on(BadUsbScript* bad_usb);
 
-bool ducky_altchar(BadUsbScript* bad_usb, const char* charcode);
+void ducky_altstring(BadUsbScript* bad_usb, const DuckyOp* op);
 
-bool ducky_altstring(BadUsbScript* bad_usb, const char* param);
+void ducky_string(BadUsbScript* bad_usb, const DuckyOp* op);
 
-bool ducky_string(BadUsbScript* bad_usb, const char* param);
+int32_t ducky_compile_cmd(BadUsbScript* bad_usb, const char* line, DuckyOp* op);
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line);
+int32_t ducky_execute_op(BadUsbScript* bad_usb, const DuckyOp* op);
 
 int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...);
 
@@ -3,16 +3,65 @@
 #include <furi/furi.h>
 #include <storage/storage.h>
 
-#define NFC_APP_KEYS_EXTENSION   ".keys"
-#define NFC_APP_KEY_CACHE_FOLDER "/ext/nfc/.cache"
+#define TAG "MfClassicKeyCache"
+
+#define NFC_APP_KEYS_EXTENSION       ".keys"
+#define NFC_APP_KEY_CACHE_FOLDER     "/ext/nfc/.cache"
+#define NFC_APP_KEY_CACHE_INDEX_PATH NFC_APP_KEY_CACHE_FOLDER "/mf_classic.idx"
+
+#define MF_CLASSIC_KEY_CACHE_INDEX_MAGIC    (0x584B434DUL) /* "MCKX" */
+#define MF_CLASSIC_KEY_CACHE_INDEX_VERSION  (1)
+#define MF_CLASSIC_KEY_CACHE_INDEX_KEYS_MAX (128)
+#define MF_CLASSIC_KEY_CACHE_INDEX_UIDS_MAX (64)
+#define MF_CLASSIC_KEY_CACHE_UID_LEN_MAX    (10)
 
 static const char* mf_classic_key_cache_file_header = "Flipper NFC keys";
 static const uint32_t mf_classic_key_cache_file_version = 1;
 
+/*
+ * Binary index shared by all cards: header, UID records, key records.
+ * UID records drive LRU eviction of per UID key files, key records remember
+ * which sectors each key opened and on how many reads. Keys found on
+ * one badge are then tried first on other badges of the same site.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t uid_count;
+    uint16_t key_count;
+    uint16_t reserved;
+    uint32_t stamp;
+} MfClassicKeyCacheIndexHeader;
+
+typedef struct {
+    uint8_t uid[MF_CLASSIC_KEY_CACHE_UID_LEN_MAX];
+    uint8_t uid_len;
+    uint8_t reserved;
+    uint32_t last_used;
+} MfClassicKeyCacheIndexUid;
+
+typedef struct {
+    MfClassicKey key;
+    uint16_t reads;
+    uint32_t last_used;
+    uint32_t hits;
+    uint64_t sectors_a;
+    uint64_t sectors_b;
+} MfClassicKeyCacheIndexKey;
+
+typedef struct {
+    MfClassicKeyCacheIndexHeader header;
+    MfClassicKeyCacheIndexUid uids[MF_CLASSIC_KEY_CACHE_INDEX_UIDS_MAX];
+    MfClassicKeyCacheIndexKey keys[MF_CLASSIC_KEY_CACHE_INDEX_KEYS_MAX];
+} MfClassicKeyCacheIndex;
+
 struct MfClassicKeyCache {
     MfClassicDeviceKeys keys;
     MfClassicKeyType current_key_type;
     uint8_t current_sector;
+    MfClassicKey priority_keys[MF_CLASSIC_KEY_CACHE_PRIORITY_KEYS_MAX];
+    size_t priority_keys_num;
+    size_t priority_key_idx;
 };
 
 static void nfc_get_key_cache_file_path(const uint8_t* uid, size_t uid_len, FuriString* path) {
@@ -35,16 +84,181 @@ void mf_classic_key_cache_free(MfClassicKeyCache* instance) {
     free(instance);
 }
 
-bool mf_classic_key_cache_save(MfClassicKeyCache* instance, const MfClassicData* data) {
-    UNUSED(instance);
-    furi_assert(data);
+static MfClassicKeyCacheIndex* mf_classic_key_cache_index_load(Storage* storage) {
+    MfClassicKeyCacheIndex* index = malloc(sizeof(MfClassicKeyCacheIndex));
+    MfClassicKeyCacheIndexHeader* header = &index->header;
+    File* file = storage_file_alloc(storage);
+
+    bool load_success = false;
+    do {
+        if(!storage_file_open(file, NFC_APP_KEY_CACHE_INDEX_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(file, header, sizeof(*header)) != sizeof(*header)) break;
+        if(header->magic != MF_CLASSIC_KEY_CACHE_INDEX_MAGIC) break;
+        if(header->version != MF_CLASSIC_KEY_CACHE_INDEX_VERSION) break;
+        if(header->uid_count > MF_CLASSIC_KEY_CACHE_INDEX_UIDS_MAX) break;
+        if(header->key_count > MF_CLASSIC_KEY_CACHE_INDEX_KEYS_MAX) break;
+
+        size_t uids_size = header->uid_count * sizeof(MfClassicKeyCacheIndexUid);
+        if(storage_file_read(file, index->uids, uids_size) != uids_size) break;
+        size_t keys_size = header->key_count * sizeof(MfClassicKeyCacheIndexKey);
+        if(storage_file_read(file, index->keys, keys_size) != keys_size) break;
+
+        load_success = true;
+    } while(false);
+
+    storage_file_free(file);
+
+    if(!load_success) {
+        memset(header, 0, sizeof(*header));
+        header->magic = MF_CLASSIC_KEY_CACHE_INDEX_MAGIC;
+        header->version = MF_CLASSIC_KEY_CACHE_INDEX_VERSION;
+    }
+
+    return index;
+}
+
+static bool
+    mf_classic_key_cache_index_save(Storage* storage, const MfClassicKeyCacheIndex* index) {
+    const MfClassicKeyCacheIndexHeader* header = &index->header;
+    File* file = storage_file_alloc(storage);
+
+    bool save_success = false;
+    do {
+        if(!storage_file_open(file, NFC_APP_KEY_CACHE_INDEX_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, header, sizeof(*header)) != sizeof(*header)) break;
+        size_t uids_size = header->uid_count * sizeof(MfClassicKeyCacheIndexUid);
+        if(storage_file_write(file, index->uids, uids_size) != uids_size) break;
+        size_t keys_size = header->key_count * sizeof(MfClassicKeyCacheIndexKey);
+        if(storage_file_write(file, index->keys, keys_size) != keys_size) break;
+
+        save_success = true;
+    } while(false);
+
+    storage_file_free(file);
+
+    return save_success;
+}
+
+static void mf_classic_key_cache_index_touch_uid(
+    Storage* storage,
+    MfClassicKeyCacheIndex* index,
+    const uint8_t* uid,
+    size_t uid_len) {
+    MfClassicKeyCacheIndexHeader* header = &index->header;
+    uid_len = MIN(uid_len, (size_t)MF_CLASSIC_KEY_CACHE_UID_LEN_MAX);
+
+    size_t slot = header->uid_count;
+    size_t lru = 0;
+    for(size_t i = 0; i < header->uid_count; i++) {
+        MfClassicKeyCacheIndexUid* record = &index->uids[i];
+        if((record->uid_len == uid_len) && (memcmp(record->uid, uid, uid_len) == 0)) {
+            slot = i;
+            break;
+        }
+        if(record->last_used < index->uids[lru].last_used) lru = i;
+    }
+
+    if(slot == header->uid_count) {
+        if(header->uid_count < MF_CLASSIC_KEY_CACHE_INDEX_UIDS_MAX) {
+            header->uid_count++;
+        } else {
+            // Evict least recently used card together with its key file
+            slot = lru;
+            FuriString* file_path = furi_string_alloc();
+            nfc_get_key_cache_file_path(
+                index->uids[slot].uid, index->uids[slot].uid_len, file_path);
+            FURI_LOG_D(TAG, "Evicting %s", furi_string_get_cstr(file_path));
+            storage_simply_remove(storage, furi_string_get_cstr(file_path));
+            furi_string_free(file_path);
+        }
+        memset(&index->uids[slot], 0, sizeof(MfClassicKeyCacheIndexUid));
+        memcpy(index->uids[slot].uid, uid, uid_len);
+        index->uids[slot].uid_len = uid_len;
+    }
+
+    index->uids[slot].last_used = header->stamp;
+}
+
+static void mf_classic_key_cache_index_add_key(
+    MfClassicKeyCacheIndex* index,
+    const MfClassicKey* key,
+    MfClassicKeyType key_type,
+    uint8_t sector) {
+    MfClassicKeyCacheIndexHeader* header = &index->header;
+
+    size_t slot = header->key_count;
+    size_t lru = 0;
+    for(size_t i = 0; i < header->key_count; i++) {
+        MfClassicKeyCacheIndexKey* record = &index->keys[i];
+        if(memcmp(record->key.data, key->data, sizeof(MfClassicKey)) == 0) {
+            slot = i;
+            break;
+        }
+        if(record->last_used < index->keys[lru].last_used) lru = i;
+    }
+
+    if(slot == header->key_count) {
+        if(header->key_count < MF_CLASSIC_KEY_CACHE_INDEX_KEYS_MAX) {
+            header->key_count++;
+        } else {
+            slot = lru;
+        }
+        memset(&index->keys[slot], 0, sizeof(MfClassicKeyCacheIndexKey));
+        index->keys[slot].key = *key;
+    }
+
+    MfClassicKeyCacheIndexKey* record = &index->keys[slot];
+    if(record->last_used != header->stamp) {
+        record->reads++;
+        record->last_used = header->stamp;
+    }
+    record->hits++;
+    if(key_type == MfClassicKeyTypeA) {
+        record->sectors_a |= 1ULL << sector;
+    } else {
+        record->sectors_b |= 1ULL << sector;
+    }
+}
+
+static bool mf_classic_key_cache_update_index(
+    Storage* storage,
+    const MfClassicData* data,
+    bool record_keys) {
+    MfClassicKeyCacheIndex* index = mf_classic_key_cache_index_load(storage);
+
+    size_t uid_len = 0;
+    const uint8_t* uid = mf_classic_get_uid(data, &uid_len);
+
+    index->header.stamp++;
+    mf_classic_key_cache_index_touch_uid(storage, index, uid, uid_len);
+
+    if(record_keys) {
+        uint8_t sector_num = mf_classic_get_total_sectors_num(data->type);
+        for(uint8_t i = 0; i < sector_num; i++) {
+            MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(data, i);
+            if(FURI_BIT(data->key_a_mask, i)) {
+                mf_classic_key_cache_index_add_key(index, &sec_tr->key_a, MfClassicKeyTypeA, i);
+            }
+            if(FURI_BIT(data->key_b_mask, i)) {
+                mf_classic_key_cache_index_add_key(index, &sec_tr->key_b, MfClassicKeyTypeB, i);
+            }
+        }
+    }
+
+    bool update_success = mf_classic_key_cache_index_save(storage, index);
+    free(index);
+
+    return update_success;
+}
 
+static bool mf_classic_key_cache_save_file(Storage* storage, const MfClassicData* data) {
     size_t uid_len = 0;
     const uint8_t* uid = mf_classic_get_uid(data, &uid_len);
     FuriString* file_path = furi_string_alloc();
     nfc_get_key_cache_file_path(uid, uid_len, file_path);
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
 
     FuriString* temp_str = furi_string_alloc();
@@ -85,11 +299,91 @@ bool mf_classic_key_cache_save(MfClassicKeyCache* instance, const MfClassicData*
     flipper_format_free(ff);
     furi_string_free(temp_str);
     furi_string_free(file_path);
+
+    return save_success;
+}
+
+bool mf_classic_key_cache_save(MfClassicKeyCache* instance, const MfClassicData* data) {
+    UNUSED(instance);
+    furi_assert(data);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool save_success = mf_classic_key_cache_save_file(storage, data);
+    if(save_success) {
+        mf_classic_key_cache_update_index(storage, data, false);
+    }
     furi_record_close(RECORD_STORAGE);
 
     return save_success;
 }
 
+bool mf_classic_key_cache_record(MfClassicKeyCache* instance, const MfClassicData* data) {
+    UNUSED(instance);
+    furi_assert(data);
+
+    bool record_success = false;
+    if(data->key_a_mask || data->key_b_mask) {
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        record_success = mf_classic_key_cache_save_file(storage, data) &&
+                         mf_classic_key_cache_update_index(storage, data, true);
+        furi_record_close(RECORD_STORAGE);
+    }
+
+    return record_success;
+}
+
+static bool mf_classic_key_cache_index_key_is_better(
+    const MfClassicKeyCacheIndexKey* a,
+    const MfClassicKeyCacheIndexKey* b) {
+    if(a->reads != b->reads) return a->reads > b->reads;
+    return a->last_used > b->last_used;
+}
+
+size_t mf_classic_key_cache_load_priority_keys(MfClassicKeyCache* instance) {
+    furi_assert(instance);
+
+    instance->priority_keys_num = 0;
+    instance->priority_key_idx = 0;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    MfClassicKeyCacheIndex* index = mf_classic_key_cache_index_load(storage);
+    furi_record_close(RECORD_STORAGE);
+
+    // Partial selection sort: most used keys first, most recent on ties
+    size_t key_count = index->header.key_count;
+    while((instance->priority_keys_num < MF_CLASSIC_KEY_CACHE_PRIORITY_KEYS_MAX) &&
+          (instance->priority_keys_num < key_count)) {
+        size_t best = instance->priority_keys_num;
+        for(size_t i = best + 1; i < key_count; i++) {
+            if(mf_classic_key_cache_index_key_is_better(&index->keys[i], &index->keys[best])) {
+                best = i;
+            }
+        }
+        MfClassicKeyCacheIndexKey tmp = index->keys[best];
+        index->keys[best] = index->keys[instance->priority_keys_num];
+        index->keys[instance->priority_keys_num] = tmp;
+        instance->priority_keys[instance->priority_keys_num++] = tmp.key;
+    }
+
+    free(index);
+    FURI_LOG_D(TAG, "Priority keys: %zu", instance->priority_keys_num);
+
+    return instance->priority_keys_num;
+}
+
+bool mf_classic_key_cache_get_next_priority_key(MfClassicKeyCache* instance, MfClassicKey* key) {
+    furi_assert(instance);
+    furi_assert(key);
+
+    bool next_key_found = false;
+    if(instance->priority_key_idx < instance->priority_keys_num) {
+        *key = instance->priority_keys[instance->priority_key_idx++];
+        next_key_found = true;
+    }
+
+    return next_key_found;
+}
+
 bool mf_classic_key_cache_load(MfClassicKeyCache* instance, const uint8_t* uid, size_t uid_len) {
     furi_assert(instance);
     furi_assert(uid);
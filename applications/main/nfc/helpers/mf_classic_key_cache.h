@@ -6,6 +6,8 @@
 extern "C" {
 #endif
 
+#define MF_CLASSIC_KEY_CACHE_PRIORITY_KEYS_MAX (16)
+
 typedef struct MfClassicKeyCache MfClassicKeyCache;
 
 MfClassicKeyCache* mf_classic_key_cache_alloc(void);
@@ -24,6 +26,12 @@ bool mf_classic_key_cache_get_next_key(
 
 bool mf_classic_key_cache_save(MfClassicKeyCache* instance, const MfClassicData* data);
 
+bool mf_classic_key_cache_record(MfClassicKeyCache* instance, const MfClassicData* data);
+
+size_t mf_classic_key_cache_load_priority_keys(MfClassicKeyCache* instance);
+
+bool mf_classic_key_cache_get_next_priority_key(MfClassicKeyCache* instance, MfClassicKey* key);
+
 void mf_classic_key_cache_reset(MfClassicKeyCache* instance);
 
 #ifdef __cplusplus
@@ -9,6 +9,11 @@ typedef enum {
     NfcCustomEventDictAttackSkip,
     NfcCustomEventDictAttackDataUpdate,
 
+    // Mf classic key recovery events
+    NfcCustomEventKeyRecoveryUpdate,
+    NfcCustomEventKeyRecoveryDone,
+    NfcCustomEventKeyRecoveryFail,
+
     NfcCustomEventCardDetected,
     NfcCustomEventCardLost,
 
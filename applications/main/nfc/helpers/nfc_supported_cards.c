@@ -3,6 +3,9 @@
 
 #include "../plugins/supported_cards/nfc_supported_card_plugin.h"
 
+#include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
+#include <bit_lib/bit_lib.h>
+
 #include <flipper_application/flipper_application.h>
 #include <flipper_application/plugins/plugin_manager.h>
 #include <flipper_application/plugins/composite_resolver.h>
@@ -27,6 +30,9 @@ typedef struct {
     FuriString* name;
     NfcProtocol protocol;
     NfcSupportedCardsPluginFeature feature;
+    // Copied, plugin is unloaded after caching
+    NfcSupportedCardPluginMfClassicProbe* mf_classic_probes;
+    size_t mf_classic_probes_count;
 } NfcSupportedCardsPluginCache;
 
 ARRAY_DEF(NfcSupportedCardsPluginCache, NfcSupportedCardsPluginCache, M_POD_OPLIST); //-V658
@@ -73,6 +79,7 @@ void nfc_supported_cards_free(NfcSupportedCards* instance) {
         NfcSupportedCardsPluginCache_next(iter)) {
         NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
         furi_string_free(plugin_cache->name);
+        free(plugin_cache->mf_classic_probes);
     }
     NfcSupportedCardsPluginCache_clear(instance->plugins_cache_arr);
 
@@ -200,6 +207,13 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
             if(plugin->parse) {
                 plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
             }
+            if(plugin->protocol == NfcProtocolMfClassic && plugin->mf_classic_probes_count) {
+                size_t probes_size =
+                    sizeof(NfcSupportedCardPluginMfClassicProbe) * plugin->mf_classic_probes_count;
+                plugin_cache.mf_classic_probes = malloc(probes_size);
+                memcpy(plugin_cache.mf_classic_probes, plugin->mf_classic_probes, probes_size);
+                plugin_cache.mf_classic_probes_count = plugin->mf_classic_probes_count;
+            }
             NfcSupportedCardsPluginCache_push_back(instance->plugins_cache_arr, plugin_cache);
         }
 
@@ -217,6 +231,83 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
     } while(false);
 }
 
+static void nfc_supported_cards_mf_classic_probe_convert(
+    const NfcSupportedCardPluginMfClassicProbe* probe,
+    MfClassicAuthProbe* auth_probe) {
+    auth_probe->block_num = mf_classic_get_first_block_num_of_sector(probe->sector);
+    auth_probe->key_type = probe->key_type;
+    bit_lib_num_to_bytes_be(probe->key, COUNT_OF(auth_probe->key.data), auth_probe->key.data);
+}
+
+static MfClassicAuthProbe* nfc_supported_cards_mf_classic_probe_find(
+    MfClassicAuthProbe* auth_probes,
+    size_t auth_probes_num,
+    const NfcSupportedCardPluginMfClassicProbe* probe) {
+    MfClassicAuthProbe target = {};
+    nfc_supported_cards_mf_classic_probe_convert(probe, &target);
+
+    for(size_t i = 0; i < auth_probes_num; i++) {
+        if(auth_probes[i].block_num == target.block_num &&
+           auth_probes[i].key_type == target.key_type &&
+           memcmp(auth_probes[i].key.data, target.key.data, sizeof(target.key.data)) == 0) {
+            return &auth_probes[i];
+        }
+    }
+
+    return NULL;
+}
+
+// Run probes of all plugins in one poller session, same probes are tried once
+static MfClassicAuthProbe*
+    nfc_supported_cards_mf_classic_probe(NfcSupportedCards* instance, Nfc* nfc, size_t* count) {
+    size_t probes_total = 0;
+
+    NfcSupportedCardsPluginCache_it_t iter;
+    for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+        !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        const NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_cref(iter);
+        if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
+        probes_total += plugin_cache->mf_classic_probes_count;
+    }
+
+    *count = 0;
+    if(probes_total == 0) return NULL;
+
+    MfClassicAuthProbe* auth_probes = malloc(sizeof(MfClassicAuthProbe) * probes_total);
+    for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+        !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        const NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_cref(iter);
+        if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
+
+        for(size_t i = 0; i < plugin_cache->mf_classic_probes_count; i++) {
+            const NfcSupportedCardPluginMfClassicProbe* probe = &plugin_cache->mf_classic_probes[i];
+            if(nfc_supported_cards_mf_classic_probe_find(auth_probes, *count, probe)) continue;
+            nfc_supported_cards_mf_classic_probe_convert(probe, &auth_probes[*count]);
+            (*count)++;
+        }
+    }
+
+    MfClassicError error = mf_classic_poller_sync_auth_batch(nfc, auth_probes, *count);
+    FURI_LOG_D(TAG, "Probed %zu of %zu keys: %d", *count, probes_total, error);
+
+    return auth_probes;
+}
+
+static bool nfc_supported_cards_mf_classic_probe_passed(
+    const NfcSupportedCardsPluginCache* plugin_cache,
+    MfClassicAuthProbe* auth_probes,
+    size_t auth_probes_num) {
+    for(size_t i = 0; i < plugin_cache->mf_classic_probes_count; i++) {
+        MfClassicAuthProbe* auth_probe = nfc_supported_cards_mf_classic_probe_find(
+            auth_probes, auth_probes_num, &plugin_cache->mf_classic_probes[i]);
+        if(auth_probe && auth_probe->authenticated) return true;
+    }
+
+    return false;
+}
+
 bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nfc* nfc) {
     furi_assert(instance);
     furi_assert(device);
@@ -224,10 +315,16 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
 
     bool card_read = false;
     NfcProtocol protocol = nfc_device_get_protocol(device);
+    MfClassicAuthProbe* auth_probes = NULL;
+    size_t auth_probes_num = 0;
 
     do {
         if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
 
+        if(protocol == NfcProtocolMfClassic) {
+            auth_probes = nfc_supported_cards_mf_classic_probe(instance, nfc, &auth_probes_num);
+        }
+
         instance->load_context = nfc_supported_cards_load_context_alloc();
 
         NfcSupportedCardsPluginCache_it_t iter;
@@ -237,6 +334,11 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
             NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
+            // Skip loading plugins that do not match the card
+            if(plugin_cache->mf_classic_probes_count &&
+               !nfc_supported_cards_mf_classic_probe_passed(
+                   plugin_cache, auth_probes, auth_probes_num))
+                continue;
 
             const ElfApiInterface* api_interface =
                 composite_api_resolver_get(instance->api_resolver);
@@ -259,6 +361,8 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
         nfc_supported_cards_load_context_free(instance->load_context);
     } while(false);
 
+    free(auth_probes);
+
     return card_read;
 }
 
@@ -56,6 +56,7 @@
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/protocols/mf_classic/mf_classic_key_recovery.h>
 #include <toolbox/keys_dict.h>
 
 #include <gui/modules/validators.h>
@@ -74,6 +75,8 @@
 
 #define NFC_APP_MFKEY32_LOGS_FILE_NAME ".mfkey32.log"
 #define NFC_APP_MFKEY32_LOGS_FILE_PATH (NFC_APP_FOLDER "/" NFC_APP_MFKEY32_LOGS_FILE_NAME)
+#define NFC_APP_NESTED_LOGS_FILE_NAME  ".nested.log"
+#define NFC_APP_NESTED_LOGS_FILE_PATH  (NFC_APP_FOLDER "/" NFC_APP_NESTED_LOGS_FILE_NAME)
 
 #define NFC_APP_MF_CLASSIC_DICT_USER_PATH (NFC_APP_FOLDER "/assets/mf_classic_dict_user.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_USER_NESTED_PATH \
@@ -81,6 +84,8 @@
 #define NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH (NFC_APP_FOLDER "/assets/mf_classic_dict.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_SYSTEM_NESTED_PATH \
     (NFC_APP_FOLDER "/assets/mf_classic_dict_nested.nfc")
+#define NFC_APP_MF_CLASSIC_DICT_CANDIDATES_PATH \
+    (NFC_APP_FOLDER "/assets/mf_classic_dict_candidates.nfc")
 #define NFC_APP_MF_ULTRALIGHT_C_DICT_USER_PATH \
     (NFC_APP_FOLDER "/assets/mf_ultralight_c_dict_user.nfc")
 #define NFC_APP_MF_ULTRALIGHT_C_DICT_SYSTEM_PATH \
@@ -160,6 +165,8 @@ struct NfcApp {
     NfcMfClassicDictAttackContext nfc_dict_context;
     NfcMfUltralightCDictContext mf_ultralight_c_dict_context;
     Mfkey32Logger* mfkey32_logger;
+    MfClassicKeyRecovery* mfc_key_recovery;
+    MfClassicKeyRecoveryEvent mfc_key_recovery_event;
     MfUserDict* mf_user_dict;
     MfClassicKeyCache* mfc_key_cache;
     NfcSupportedCards* nfc_supported_cards;
@@ -10,32 +10,6 @@
 
 static const uint64_t aime_key = 0x574343467632;
 
-bool aime_verify(Nfc* nfc) {
-    bool verified = false;
-
-    do {
-        const uint8_t verify_sector = 0;
-        uint8_t block_num = mf_classic_get_first_block_num_of_sector(verify_sector);
-        FURI_LOG_D(TAG, "Verifying sector %u", verify_sector);
-
-        MfClassicKey key = {};
-        bit_lib_num_to_bytes_be(aime_key, COUNT_OF(key.data), key.data);
-
-        MfClassicAuthContext auth_ctx = {};
-        MfClassicError error =
-            mf_classic_poller_sync_auth(nfc, block_num, &key, MfClassicKeyTypeA, &auth_ctx);
-
-        if(error != MfClassicErrorNone) {
-            FURI_LOG_D(TAG, "Failed to read block %u: %d", block_num, error);
-            break;
-        }
-
-        verified = true;
-    } while(false);
-
-    return verified;
-}
-
 static bool aime_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -148,12 +122,17 @@ static bool aime_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe aime_probes[] = {
+    {.sector = 0, .key_type = MfClassicKeyTypeA, .key = aime_key},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin aime_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = aime_verify,
     .read = aime_read,
     .parse = aime_parse,
+    .mf_classic_probes = aime_probes,
+    .mf_classic_probes_count = COUNT_OF(aime_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -53,29 +53,6 @@ static MfClassicKeyPair banapass_keys_if_access_code[] = {
     {.a = 0x7B304F2A12A6, .b = 0xFC9418BF788B},
 };
 
-static bool banapass_verify(Nfc* nfc) {
-    bool verified = true;
-
-    const uint8_t verify_sector = 0;
-    uint8_t block_num = mf_classic_get_first_block_num_of_sector(verify_sector);
-    FURI_LOG_D(TAG, "Verifying sector %u", verify_sector);
-
-    MfClassicKey key_a_0 = {};
-    bit_lib_num_to_bytes_be(
-        banapass_keys_if_value_block[0].a, COUNT_OF(key_a_0.data), key_a_0.data);
-
-    MfClassicAuthContext auth_ctx = {};
-    MfClassicError error =
-        mf_classic_poller_sync_auth(nfc, block_num, &key_a_0, MfClassicKeyTypeA, &auth_ctx);
-
-    if(error != MfClassicErrorNone) {
-        FURI_LOG_D(TAG, "Failed to read block %u: %d", block_num, error);
-        verified = false;
-    }
-
-    return verified;
-}
-
 static bool banapass_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -263,12 +240,17 @@ static bool banapass_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe banapass_probes[] = {
+    {.sector = 0, .key_type = MfClassicKeyTypeA, .key = 0x6090D00632F5},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin banapass_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = banapass_verify,
     .read = banapass_read,
     .parse = banapass_parse,
+    .mf_classic_probes = banapass_probes,
+    .mf_classic_probes_count = COUNT_OF(banapass_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -47,28 +47,6 @@ static const uint64_t bip_keys_b[] = {
     0x6a470d54127c,
 };
 
-bool bip_verify(Nfc* nfc) {
-    bool verified = true;
-
-    const uint8_t verify_sector = 0;
-    uint8_t block_num = mf_classic_get_first_block_num_of_sector(verify_sector);
-    FURI_LOG_D(TAG, "Verifying sector %u", verify_sector);
-
-    MfClassicKey key_a_0 = {};
-    bit_lib_num_to_bytes_be(bip_keys_a[0], COUNT_OF(key_a_0.data), key_a_0.data);
-
-    MfClassicAuthContext auth_ctx = {};
-    MfClassicError error =
-        mf_classic_poller_sync_auth(nfc, block_num, &key_a_0, MfClassicKeyTypeA, &auth_ctx);
-
-    if(error != MfClassicErrorNone) {
-        FURI_LOG_D(TAG, "Failed to read block %u: %d", block_num, error);
-        verified = false;
-    }
-
-    return verified;
-}
-
 static bool bip_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -348,12 +326,17 @@ static bool bip_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe bip_probes[] = {
+    {.sector = 0, .key_type = MfClassicKeyTypeA, .key = 0x3a42f33af429},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin bip_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = bip_verify,
     .read = bip_read,
     .parse = bip_parse,
+    .mf_classic_probes = bip_probes,
+    .mf_classic_probes_count = COUNT_OF(bip_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -10,32 +10,6 @@
 
 static const uint64_t hid_key = 0x484944204953;
 
-bool hid_verify(Nfc* nfc) {
-    bool verified = false;
-
-    do {
-        const uint8_t verify_sector = 1;
-        uint8_t block_num = mf_classic_get_first_block_num_of_sector(verify_sector);
-        FURI_LOG_D(TAG, "Verifying sector %u", verify_sector);
-
-        MfClassicKey key = {};
-        bit_lib_num_to_bytes_be(hid_key, COUNT_OF(key.data), key.data);
-
-        MfClassicAuthContext auth_ctx = {};
-        MfClassicError error =
-            mf_classic_poller_sync_auth(nfc, block_num, &key, MfClassicKeyTypeA, &auth_ctx);
-
-        if(error != MfClassicErrorNone) {
-            FURI_LOG_D(TAG, "Failed to read block %u: %d", block_num, error);
-            break;
-        }
-
-        verified = true;
-    } while(false);
-
-    return verified;
-}
-
 static bool hid_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -132,12 +106,17 @@ static bool hid_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe hid_probes[] = {
+    {.sector = 1, .key_type = MfClassicKeyTypeA, .key = hid_key},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin hid_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = hid_verify,
     .read = hid_read,
     .parse = hid_parse,
+    .mf_classic_probes = hid_probes,
+    .mf_classic_probes_count = COUNT_OF(hid_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -61,44 +61,6 @@ static MfClassicKeyPair hworld_vip_keys[] = {
     {.a = 0xFFFFFFFFFFFF, .b = 0xFFFFFFFFFFFF}, // 015
 };
 
-static bool hworld_verify(Nfc* nfc) {
-    bool verified = false;
-
-    do {
-        const uint8_t block_num = mf_classic_get_first_block_num_of_sector(ROOM_SECTOR);
-
-        MfClassicKey standard_key = {0};
-        bit_lib_num_to_bytes_be(
-            hworld_standard_keys[ROOM_SECTOR].a, COUNT_OF(standard_key.data), standard_key.data);
-
-        MfClassicAuthContext auth_context;
-        MfClassicError standard_error = mf_classic_poller_sync_auth(
-            nfc, block_num, &standard_key, MfClassicKeyTypeA, &auth_context);
-
-        if(standard_error != MfClassicErrorNone) {
-            FURI_LOG_D(TAG, "Failed static key check for block %u", block_num);
-            break;
-        }
-
-        MfClassicKey vip_key = {0};
-        bit_lib_num_to_bytes_be(
-            hworld_vip_keys[VIP_SECTOR].b, COUNT_OF(vip_key.data), vip_key.data);
-
-        MfClassicError vip_error = mf_classic_poller_sync_auth(
-            nfc, block_num, &vip_key, MfClassicKeyTypeB, &auth_context);
-
-        if(vip_error == MfClassicErrorNone) {
-            FURI_LOG_D(TAG, "VIP card detected");
-        } else {
-            FURI_LOG_D(TAG, "Standard card detected");
-        }
-
-        verified = true;
-    } while(false);
-
-    return verified;
-}
-
 static bool hworld_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -222,12 +184,17 @@ bool hworld_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe hworld_probes[] = {
+    {.sector = ROOM_SECTOR, .key_type = MfClassicKeyTypeA, .key = 0x543071543071},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin hworld_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = hworld_verify,
     .read = hworld_read,
     .parse = hworld_parse,
+    .mf_classic_probes = hworld_probes,
+    .mf_classic_probes_count = COUNT_OF(hworld_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -13,6 +13,8 @@
  *
  * To add a new plugin, create a uniquely-named .c file in the `supported_cards` directory
  * and implement at least the parse() function in the NfcSupportedCardsPlugin structure.
+ * MIFARE Classic plugins that recognise the card by a single authentication should describe
+ * it with a probe table instead of a verify() function, see NfcSupportedCardPluginMfClassicProbe.
  * Then, register the plugin in the `application.fam` file in the `nfc` directory. Use the existing
  * entries as an example. After being registered, the plugin will be automatically deployed with the application.
  *
@@ -27,6 +29,7 @@
 
 #include <nfc/nfc.h>
 #include <nfc/nfc_device.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
 
 /**
  * @brief Unique string identifier for supported card plugins.
@@ -36,7 +39,7 @@
 /**
  * @brief Currently supported plugin API version.
  */
-#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 1
+#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 2
 
 /**
  * @brief Verify that the card is of a supported type.
@@ -81,6 +84,19 @@ typedef bool (*NfcSupportedCardPluginRead)(Nfc* nfc, NfcDevice* device);
  */
 typedef bool (*NfcSupportedCardPluginParse)(const NfcDevice* device, FuriString* parsed_data);
 
+/**
+ * @brief Declarative MIFARE Classic verification step.
+ *
+ * The card is considered verified if authentication to the first block of the sector
+ * with the given key succeeds. Probes of all plugins are tried in a single poller
+ * session, so that plugins not matching the card are never loaded.
+ */
+typedef struct {
+    uint8_t sector; /**< Sector to authenticate to. */
+    MfClassicKeyType key_type; /**< Key type to authenticate with. */
+    uint64_t key; /**< Key value, most significant byte first. */
+} NfcSupportedCardPluginMfClassicProbe;
+
 /**
  * @brief Supported card plugin interface.
  *
@@ -91,4 +107,7 @@ typedef struct {
     NfcSupportedCardPluginVerify verify; /**< Pointer to the verify() function. */
     NfcSupportedCardPluginRead read; /**< Pointer to the read() function. */
     NfcSupportedCardPluginParse parse; /**< Pointer to the parse() function. */
+    /** MIFARE Classic probes, any of them must succeed before verify() and read() are called. */
+    const NfcSupportedCardPluginMfClassicProbe* mf_classic_probes;
+    size_t mf_classic_probes_count; /**< Number of elements in mf_classic_probes. */
 } NfcSupportedCardsPlugin;
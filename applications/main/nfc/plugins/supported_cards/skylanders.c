@@ -76,32 +76,6 @@ bool skylanders_get_name(Storage* storage, uint16_t id, FuriString* name) {
     return parsed;
 }
 
-bool skylanders_verify(Nfc* nfc) {
-    bool verified = false;
-
-    do {
-        const uint8_t verify_sector = 0;
-        uint8_t block_num = mf_classic_get_first_block_num_of_sector(verify_sector);
-        FURI_LOG_D(TAG, "Verifying sector %u", verify_sector);
-
-        MfClassicKey key = {};
-        bit_lib_num_to_bytes_be(skylanders_key, COUNT_OF(key.data), key.data);
-
-        MfClassicAuthContext auth_ctx = {};
-        MfClassicError error =
-            mf_classic_poller_sync_auth(nfc, block_num, &key, MfClassicKeyTypeA, &auth_ctx);
-
-        if(error != MfClassicErrorNone) {
-            FURI_LOG_D(TAG, "Failed to read block %u: %d", block_num, error);
-            break;
-        }
-
-        verified = true;
-    } while(false);
-
-    return verified;
-}
-
 static bool skylanders_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -192,12 +166,17 @@ static bool skylanders_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe skylanders_probes[] = {
+    {.sector = 0, .key_type = MfClassicKeyTypeA, .key = skylanders_key},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin skylanders_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = skylanders_verify,
     .read = skylanders_read,
     .parse = skylanders_parse,
+    .mf_classic_probes = skylanders_probes,
+    .mf_classic_probes_count = COUNT_OF(skylanders_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -98,37 +98,6 @@ static bool troika_get_card_config(TroikaCardConfig* config, MfClassicType type)
     return success;
 }
 
-static bool troika_verify_type(Nfc* nfc, MfClassicType type) {
-    bool verified = false;
-
-    do {
-        TroikaCardConfig cfg = {};
-        if(!troika_get_card_config(&cfg, type)) break;
-
-        const uint8_t block_num = mf_classic_get_first_block_num_of_sector(cfg.data_sector);
-        FURI_LOG_D(TAG, "Verifying sector %lu", cfg.data_sector);
-
-        MfClassicKey key = {0};
-        bit_lib_num_to_bytes_be(cfg.keys[cfg.data_sector].a, COUNT_OF(key.data), key.data);
-
-        MfClassicAuthContext auth_context;
-        MfClassicError error =
-            mf_classic_poller_sync_auth(nfc, block_num, &key, MfClassicKeyTypeA, &auth_context);
-        if(error != MfClassicErrorNone) {
-            FURI_LOG_D(TAG, "Failed to read block %u: %d", block_num, error);
-            break;
-        }
-        FURI_LOG_D(TAG, "Verify success!");
-        verified = true;
-    } while(false);
-
-    return verified;
-}
-
-static bool troika_verify(Nfc* nfc) {
-    return troika_verify_type(nfc, MfClassicType1k) || troika_verify_type(nfc, MfClassicType4k);
-}
-
 static bool troika_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -230,12 +199,18 @@ static bool troika_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe troika_probes[] = {
+    {.sector = 11, .key_type = MfClassicKeyTypeA, .key = 0x08b386463229}, // 1K
+    {.sector = 8, .key_type = MfClassicKeyTypeA, .key = 0xA73F5DC1D333}, // 4K
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin troika_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = troika_verify,
     .read = troika_read,
     .parse = troika_parse,
+    .mf_classic_probes = troika_probes,
+    .mf_classic_probes_count = COUNT_OF(troika_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -36,31 +36,6 @@ static const MfClassicKeyPair two_cities_4k_keys[] = {
     {.a = 0xb27addfb64b0, .b = 0x152fd0c420a7}, {.a = 0x7259fa0197c6, .b = 0x5583698df085},
 };
 
-bool two_cities_verify(Nfc* nfc) {
-    bool verified = false;
-
-    do {
-        const uint8_t verify_sector = 4;
-        uint8_t block_num = mf_classic_get_first_block_num_of_sector(verify_sector);
-        FURI_LOG_D(TAG, "Verifying sector %u", verify_sector);
-
-        MfClassicKey key = {};
-        bit_lib_num_to_bytes_be(two_cities_4k_keys[verify_sector].a, COUNT_OF(key.data), key.data);
-
-        MfClassicAuthContext auth_ctx = {};
-        MfClassicError error =
-            mf_classic_poller_sync_auth(nfc, block_num, &key, MfClassicKeyTypeA, &auth_ctx);
-        if(error != MfClassicErrorNone) {
-            FURI_LOG_D(TAG, "Failed to read block %u: %d", block_num, error);
-            break;
-        }
-
-        verified = true;
-    } while(false);
-
-    return verified;
-}
-
 static bool two_cities_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -170,12 +145,17 @@ static bool two_cities_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe two_cities_probes[] = {
+    {.sector = 4, .key_type = MfClassicKeyTypeA, .key = 0xe56ac127dd45},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin two_cities_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = two_cities_verify,
     .read = two_cities_read,
     .parse = two_cities_parse,
+    .mf_classic_probes = two_cities_probes,
+    .mf_classic_probes_count = COUNT_OF(two_cities_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
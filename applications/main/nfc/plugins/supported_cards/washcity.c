@@ -53,33 +53,6 @@ static const MfClassicKeyPair washcity_1k_keys[] = {
     {.a = 0x010155010100, .b = 0xFFFFFFFFFFFF}, // Sector 15
 };
 
-static bool washcity_verify(Nfc* nfc) {
-    bool verified = false;
-
-    do {
-        const uint8_t verify_sector_number = 1;
-        const uint8_t verify_block_number =
-            mf_classic_get_first_block_num_of_sector(verify_sector_number);
-        FURI_LOG_D(TAG, "Verifying sector %u", verify_sector_number);
-
-        MfClassicKey key = {0};
-        bit_lib_num_to_bytes_be(
-            washcity_1k_keys[verify_sector_number].a, COUNT_OF(key.data), key.data);
-
-        MfClassicAuthContext auth_context;
-        MfClassicError error = mf_classic_poller_sync_auth(
-            nfc, verify_block_number, &key, MfClassicKeyTypeA, &auth_context);
-        if(error != MfClassicErrorNone) {
-            FURI_LOG_D(TAG, "Failed to read block %u: %d", verify_block_number, error);
-            break;
-        }
-
-        verified = true;
-    } while(false);
-
-    return verified;
-}
-
 static bool washcity_read(Nfc* nfc, NfcDevice* device) {
     furi_assert(nfc);
     furi_assert(device);
@@ -176,12 +149,17 @@ static bool washcity_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+static const NfcSupportedCardPluginMfClassicProbe washcity_probes[] = {
+    {.sector = 1, .key_type = MfClassicKeyTypeA, .key = 0xC78A3D0E1BCD},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin washcity_plugin = {
     .protocol = NfcProtocolMfClassic,
-    .verify = washcity_verify,
     .read = washcity_read,
     .parse = washcity_parse,
+    .mf_classic_probes = washcity_probes,
+    .mf_classic_probes_count = COUNT_OF(washcity_probes),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -3,6 +3,7 @@
 enum SubmenuIndex {
     SubmenuIndexReadCardType,
     SubmenuIndexMfClassicKeys,
+    SubmenuIndexMfClassicKeyRecovery,
     SubmenuIndexMfUltralightCKeys,
     SubmenuIndexMfUltralightUnlock,
     SubmenuIndexSlixUnlock,
@@ -30,6 +31,12 @@ void nfc_scene_extra_actions_on_enter(void* context) {
         SubmenuIndexMfClassicKeys,
         nfc_scene_extra_actions_submenu_callback,
         instance);
+    submenu_add_item(
+        submenu,
+        "Recover MIFARE Classic Keys",
+        SubmenuIndexMfClassicKeyRecovery,
+        nfc_scene_extra_actions_submenu_callback,
+        instance);
     submenu_add_item(
         submenu,
         "MIFARE Ultralight C Keys",
@@ -61,6 +68,9 @@ bool nfc_scene_extra_actions_on_event(void* context, SceneManagerEvent event) {
         if(event.event == SubmenuIndexMfClassicKeys) {
             scene_manager_next_scene(instance->scene_manager, NfcSceneMfClassicKeys);
             consumed = true;
+        } else if(event.event == SubmenuIndexMfClassicKeyRecovery) {
+            scene_manager_next_scene(instance->scene_manager, NfcSceneMfClassicMfkeyRecovery);
+            consumed = true;
         } else if(event.event == SubmenuIndexMfUltralightCKeys) {
             scene_manager_next_scene(instance->scene_manager, NfcSceneMfUltralightCKeys);
             consumed = true;
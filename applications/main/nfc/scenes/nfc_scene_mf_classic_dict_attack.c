@@ -47,8 +47,12 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
         MfClassicKey key = {};
-        if(keys_dict_get_next_key(
-               instance->nfc_dict_context.dict, key.data, sizeof(MfClassicKey))) {
+        if(mf_classic_key_cache_get_next_priority_key(instance->mfc_key_cache, &key)) {
+            mfc_event->data->key_request_data.key = key;
+            mfc_event->data->key_request_data.key_provided = true;
+            mfc_event->data->key_request_data.all_sectors = true;
+        } else if(keys_dict_get_next_key(
+                      instance->nfc_dict_context.dict, key.data, sizeof(MfClassicKey))) {
             mfc_event->data->key_request_data.key = key;
             mfc_event->data->key_request_data.key_provided = true;
             instance->nfc_dict_context.dict_keys_current++;
@@ -238,6 +242,9 @@ void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
     nfc_blink_read_start(instance);
     notification_message(instance->notifications, &sequence_display_backlight_enforce_on);
 
+    // Keys that opened other cards go first, only for the first dictionary
+    mf_classic_key_cache_load_priority_keys(instance->mfc_key_cache);
+
     instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
     nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
 }
@@ -252,6 +259,14 @@ static void nfc_scene_mf_classic_dict_attack_notify_read(NfcApp* instance) {
     }
 }
 
+static void nfc_scene_mf_classic_dict_attack_finish(NfcApp* instance) {
+    mf_classic_key_cache_record(
+        instance->mfc_key_cache, nfc_device_get_data(instance->nfc_device, NfcProtocolMfClassic));
+    nfc_scene_mf_classic_dict_attack_notify_read(instance);
+    scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
+    dolphin_deed(DolphinDeedNfcReadSuccess);
+}
+
 bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent event) {
     NfcApp* instance = context;
     bool consumed = false;
@@ -287,9 +302,7 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
                 nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
                 consumed = true;
             } else {
-                nfc_scene_mf_classic_dict_attack_notify_read(instance);
-                scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
-                dolphin_deed(DolphinDeedNfcReadSuccess);
+                nfc_scene_mf_classic_dict_attack_finish(instance);
                 consumed = true;
             }
         } else if(event.event == NfcCustomEventCardDetected) {
@@ -318,9 +331,7 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
                     instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
                     nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
                 } else {
-                    nfc_scene_mf_classic_dict_attack_notify_read(instance);
-                    scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
-                    dolphin_deed(DolphinDeedNfcReadSuccess);
+                    nfc_scene_mf_classic_dict_attack_finish(instance);
                 }
                 consumed = true;
             } else if(state == DictAttackStateUserDictInProgress && !(ran_nested_dict)) {
@@ -336,15 +347,11 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
                     instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
                     nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
                 } else {
-                    nfc_scene_mf_classic_dict_attack_notify_read(instance);
-                    scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
-                    dolphin_deed(DolphinDeedNfcReadSuccess);
+                    nfc_scene_mf_classic_dict_attack_finish(instance);
                 }
                 consumed = true;
             } else {
-                nfc_scene_mf_classic_dict_attack_notify_read(instance);
-                scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
-                dolphin_deed(DolphinDeedNfcReadSuccess);
+                nfc_scene_mf_classic_dict_attack_finish(instance);
                 consumed = true;
             }
         }
@@ -0,0 +1,195 @@
+#include "../nfc_app_i.h"
+
+#include <bit_lib/bit_lib.h>
+
+typedef enum {
+    NfcSceneMfClassicMfkeyRecoveryStateRunning,
+    NfcSceneMfClassicMfkeyRecoveryStateDone,
+} NfcSceneMfClassicMfkeyRecoveryState;
+
+static void nfc_scene_mf_classic_mfkey_recovery_worker_callback(
+    const MfClassicKeyRecoveryEvent* event,
+    void* context) {
+    NfcApp* instance = context;
+
+    // Runs on the recovery thread, event data is fetched on the GUI thread
+    uint32_t custom_event = NfcCustomEventKeyRecoveryUpdate;
+    if(event->type == MfClassicKeyRecoveryEventTypeFinished) {
+        custom_event = NfcCustomEventKeyRecoveryDone;
+    } else if(event->type == MfClassicKeyRecoveryEventTypeFail) {
+        custom_event = NfcCustomEventKeyRecoveryFail;
+    }
+    view_dispatcher_send_custom_event(instance->view_dispatcher, custom_event);
+}
+
+static void nfc_scene_mf_classic_mfkey_recovery_widget_callback(
+    GuiButtonType result,
+    InputType type,
+    void* context) {
+    NfcApp* instance = context;
+
+    if(type == InputTypeShort) {
+        view_dispatcher_send_custom_event(instance->view_dispatcher, result);
+    }
+}
+
+static void nfc_scene_mf_classic_mfkey_recovery_update_view(NfcApp* instance) {
+    const MfClassicKeyRecoveryEvent* event = &instance->mfc_key_recovery_event;
+    NfcSceneMfClassicMfkeyRecoveryState state =
+        scene_manager_get_scene_state(instance->scene_manager, NfcSceneMfClassicMfkeyRecovery);
+    FuriString* temp_str = furi_string_alloc();
+
+    widget_reset(instance->widget);
+
+    if(state == NfcSceneMfClassicMfkeyRecoveryStateRunning) {
+        widget_add_string_element(
+            instance->widget, 64, 0, AlignCenter, AlignTop, FontPrimary, "Recovering Keys");
+        if(event->entries_total) {
+            furi_string_printf(
+                temp_str,
+                "Nonce %zu/%zu: %u%%",
+                event->entry_index + 1,
+                event->entries_total,
+                event->progress);
+            // Single nonce takes minutes on device, show how long the current one has left
+            if(event->eta_s >= 60) {
+                furi_string_cat_printf(temp_str, ", ~%lum left", event->eta_s / 60);
+            } else if(event->eta_s) {
+                furi_string_cat_printf(temp_str, ", ~%lus left", event->eta_s);
+            }
+        } else {
+            furi_string_set(temp_str, "Loading nonces...");
+        }
+        widget_add_string_element(
+            instance->widget,
+            64,
+            20,
+            AlignCenter,
+            AlignTop,
+            FontSecondary,
+            furi_string_get_cstr(temp_str));
+    } else {
+        widget_add_string_element(
+            instance->widget, 64, 0, AlignCenter, AlignTop, FontPrimary, "Completed!");
+        furi_string_printf(temp_str, "Nonces processed: %zu", event->entries_total);
+        widget_add_string_element(
+            instance->widget,
+            64,
+            20,
+            AlignCenter,
+            AlignTop,
+            FontSecondary,
+            furi_string_get_cstr(temp_str));
+        widget_add_button_element(
+            instance->widget,
+            GuiButtonTypeRight,
+            "Finish",
+            nfc_scene_mf_classic_mfkey_recovery_widget_callback,
+            instance);
+    }
+
+    furi_string_printf(temp_str, "Keys found: %zu (new: %zu)", event->keys_found, event->keys_new);
+    widget_add_string_element(
+        instance->widget,
+        64,
+        32,
+        AlignCenter,
+        AlignTop,
+        FontSecondary,
+        furi_string_get_cstr(temp_str));
+
+    if(event->keys_found) {
+        furi_string_printf(
+            temp_str,
+            "Sec %u%c: %012llX",
+            event->sector,
+            (event->key_type == MfClassicKeyTypeA) ? 'A' : 'B',
+            bit_lib_bytes_to_num_be(event->key.data, sizeof(MfClassicKey)));
+        widget_add_string_element(
+            instance->widget,
+            64,
+            44,
+            AlignCenter,
+            AlignTop,
+            FontSecondary,
+            furi_string_get_cstr(temp_str));
+    }
+
+    furi_string_free(temp_str);
+}
+
+void nfc_scene_mf_classic_mfkey_recovery_on_enter(void* context) {
+    NfcApp* instance = context;
+
+    memset(&instance->mfc_key_recovery_event, 0, sizeof(MfClassicKeyRecoveryEvent));
+    scene_manager_set_scene_state(
+        instance->scene_manager,
+        NfcSceneMfClassicMfkeyRecovery,
+        NfcSceneMfClassicMfkeyRecoveryStateRunning);
+    nfc_scene_mf_classic_mfkey_recovery_update_view(instance);
+    view_dispatcher_switch_to_view(instance->view_dispatcher, NfcViewWidget);
+
+    const MfClassicKeyRecoveryConfig config = {
+        .mfkey32_log_path = NFC_APP_MFKEY32_LOGS_FILE_PATH,
+        .nested_log_path = NFC_APP_NESTED_LOGS_FILE_PATH,
+        .user_dict_path = NFC_APP_MF_CLASSIC_DICT_USER_PATH,
+        .candidates_dict_path = NFC_APP_MF_CLASSIC_DICT_CANDIDATES_PATH,
+    };
+    instance->mfc_key_recovery = mf_classic_key_recovery_alloc();
+    mf_classic_key_recovery_start(
+        instance->mfc_key_recovery,
+        &config,
+        nfc_scene_mf_classic_mfkey_recovery_worker_callback,
+        instance);
+}
+
+bool nfc_scene_mf_classic_mfkey_recovery_on_event(void* context, SceneManagerEvent event) {
+    NfcApp* instance = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == NfcCustomEventKeyRecoveryUpdate) {
+            mf_classic_key_recovery_get_event(
+                instance->mfc_key_recovery, &instance->mfc_key_recovery_event);
+            nfc_scene_mf_classic_mfkey_recovery_update_view(instance);
+            consumed = true;
+        } else if(event.event == NfcCustomEventKeyRecoveryDone) {
+            scene_manager_set_scene_state(
+                instance->scene_manager,
+                NfcSceneMfClassicMfkeyRecovery,
+                NfcSceneMfClassicMfkeyRecoveryStateDone);
+            mf_classic_key_recovery_get_event(
+                instance->mfc_key_recovery, &instance->mfc_key_recovery_event);
+            notification_message(instance->notifications, &sequence_success);
+            nfc_scene_mf_classic_mfkey_recovery_update_view(instance);
+            consumed = true;
+        } else if(event.event == NfcCustomEventKeyRecoveryFail) {
+            popup_set_header(instance->popup, "No Nonces Found", 64, 22, AlignCenter, AlignTop);
+            popup_set_icon(instance->popup, 0, 0, NULL);
+            view_dispatcher_switch_to_view(instance->view_dispatcher, NfcViewPopup);
+            consumed = true;
+        } else if(event.event == GuiButtonTypeRight) {
+            const uint32_t prev_scenes[] = {NfcSceneExtraActions, NfcSceneStart};
+            consumed = scene_manager_search_and_switch_to_previous_scene_one_of(
+                instance->scene_manager, prev_scenes, COUNT_OF(prev_scenes));
+        }
+    } else if(event.type == SceneManagerEventTypeBack) {
+        // Keys recovered so far are already in the user dictionary
+        const uint32_t prev_scenes[] = {NfcSceneExtraActions, NfcSceneStart};
+        consumed = scene_manager_search_and_switch_to_previous_scene_one_of(
+            instance->scene_manager, prev_scenes, COUNT_OF(prev_scenes));
+    }
+
+    return consumed;
+}
+
+void nfc_scene_mf_classic_mfkey_recovery_on_exit(void* context) {
+    NfcApp* instance = context;
+
+    mf_classic_key_recovery_stop(instance->mfc_key_recovery);
+    mf_classic_key_recovery_free(instance->mfc_key_recovery);
+    instance->mfc_key_recovery = NULL;
+
+    widget_reset(instance->widget);
+    popup_reset(instance->popup);
+}
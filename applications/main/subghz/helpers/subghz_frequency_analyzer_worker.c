@@ -18,14 +18,48 @@ static const uint8_t subghz_preset_ook_650khz[][2] = {
     {0, 0},
 };
 
+// Coarse sweep scheduling
+#define SUBGHZ_FREQUENCY_ANALYZER_COLD_CHUNK       16
+#define SUBGHZ_FREQUENCY_ANALYZER_HOT_MAX          4
+#define SUBGHZ_FREQUENCY_ANALYZER_ACTIVITY_HIT     4
+#define SUBGHZ_FREQUENCY_ANALYZER_ACTIVITY_MAX     16
+#define SUBGHZ_FREQUENCY_ANALYZER_CYCLE_YIELD_MS   5
+// PLL calibration stays valid while we stay within this span of the calibration point
+#define SUBGHZ_FREQUENCY_ANALYZER_CALIBRATION_SPAN 1000000
+#define SUBGHZ_FREQUENCY_ANALYZER_SETTLE_CAL_US    2000
+#define SUBGHZ_FREQUENCY_ANALYZER_SETTLE_US        1000
+// Fine search
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN        300000
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP        20000
+// Sample hold is counted in fixed time steps, not in scan cycles
+#define SUBGHZ_FREQUENCY_ANALYZER_HOLD_STEP_MS     170
+#define SUBGHZ_FREQUENCY_ANALYZER_STATS_PERIOD_MS  1000
+
+typedef struct {
+    uint32_t frequency;
+    uint8_t activity;
+} SubGhzFrequencyAnalyzerChannel;
+
 struct SubGhzFrequencyAnalyzerWorker {
     FuriThread* thread;
 
     volatile bool worker_running;
     uint8_t sample_hold_counter;
+    uint32_t sample_hold_tick;
     FrequencyRSSI frequency_rssi_buf;
     SubGhzSetting* setting;
 
+    SubGhzFrequencyAnalyzerChannel* channels;
+    size_t channels_count;
+    size_t cold_cursor;
+    uint32_t calibrated_frequency;
+
+    uint32_t stats_tick;
+    uint32_t stats_sweeps;
+    uint32_t stats_probes;
+    uint32_t stats_dwell_cycles[SubGhzFrequencyAnalyzerDwellNum];
+    SubGhzFrequencyAnalyzerWorkerStats stats;
+
     float filVal;
 
     SubGhzFrequencyAnalyzerWorkerPairCallback pair_callback;
@@ -58,6 +92,275 @@ static uint32_t subghz_frequency_analyzer_worker_expRunningAverageAdaptive(
     return (uint32_t)instance->filVal;
 }
 
+/** Build channel table from settings
+ *
+ * Channels are kept in ascending order, so consecutive coarse steps mostly
+ * stay inside of one PLL calibration span.
+ */
+static void
+    subghz_frequency_analyzer_worker_channels_load(SubGhzFrequencyAnalyzerWorker* instance) {
+    const size_t frequency_count = subghz_setting_get_frequency_count(instance->setting);
+    instance->channels = malloc(sizeof(SubGhzFrequencyAnalyzerChannel) * frequency_count);
+    instance->channels_count = 0;
+    instance->cold_cursor = 0;
+
+    for(size_t i = 0; i < frequency_count; i++) {
+        uint32_t frequency = subghz_setting_get_frequency(instance->setting, i);
+        if(!furi_hal_subghz_is_frequency_valid(frequency)) continue;
+
+        // Insertion sort, the table is short and mostly ordered already
+        size_t position = instance->channels_count;
+        while(position > 0 && instance->channels[position - 1].frequency > frequency) {
+            instance->channels[position] = instance->channels[position - 1];
+            position--;
+        }
+        instance->channels[position].frequency = frequency;
+        instance->channels[position].activity = 0;
+        instance->channels_count++;
+    }
+}
+
+static void
+    subghz_frequency_analyzer_worker_channels_free(SubGhzFrequencyAnalyzerWorker* instance) {
+    free(instance->channels);
+    instance->channels = NULL;
+    instance->channels_count = 0;
+}
+
+/** Tune to frequency and sample RSSI
+ *
+ * PLL calibration and its settle time are skipped when the previous
+ * calibration point is close enough for the VCO to stay locked.
+ *
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @param value requested frequency
+ * @param frequency actual tuned frequency, may be NULL
+ * @param dwell dwell category for statistics
+ * @return RSSI, -127 if frequency is not valid
+ */
+static float subghz_frequency_analyzer_worker_probe(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    uint32_t value,
+    uint32_t* frequency,
+    SubGhzFrequencyAnalyzerDwell dwell) {
+    if(!furi_hal_subghz_is_frequency_valid(value)) {
+        return -127.0f;
+    }
+
+    const uint32_t start = DWT->CYCCNT;
+    const uint32_t distance = (value > instance->calibrated_frequency) ?
+                                  (value - instance->calibrated_frequency) :
+                                  (instance->calibrated_frequency - value);
+    const bool need_calibration = (instance->calibrated_frequency == 0) ||
+                                  (distance > SUBGHZ_FREQUENCY_ANALYZER_CALIBRATION_SPAN);
+
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+    cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
+    uint32_t tuned = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, value);
+
+    if(need_calibration) {
+        cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
+        furi_check(
+            cc1101_wait_status_state(&furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
+        instance->calibrated_frequency = tuned;
+    }
+
+    cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+
+    furi_delay_us(
+        need_calibration ? SUBGHZ_FREQUENCY_ANALYZER_SETTLE_CAL_US :
+                           SUBGHZ_FREQUENCY_ANALYZER_SETTLE_US);
+
+    float rssi = furi_hal_subghz_get_rssi();
+
+    instance->stats_probes++;
+    instance->stats_dwell_cycles[dwell] += DWT->CYCCNT - start;
+
+    if(frequency) *frequency = tuned;
+    return rssi;
+}
+
+/** Coarse probe of one channel with activity accounting */
+static float subghz_frequency_analyzer_worker_probe_channel(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerChannel* channel,
+    FrequencyRSSI* frequency_rssi,
+    SubGhzFrequencyAnalyzerDwell dwell) {
+    uint32_t frequency = 0;
+    float rssi = subghz_frequency_analyzer_worker_probe(
+        instance, channel->frequency, &frequency, dwell);
+
+    if(rssi > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
+        channel->activity += SUBGHZ_FREQUENCY_ANALYZER_ACTIVITY_HIT;
+        if(channel->activity > SUBGHZ_FREQUENCY_ANALYZER_ACTIVITY_MAX) {
+            channel->activity = SUBGHZ_FREQUENCY_ANALYZER_ACTIVITY_MAX;
+        }
+    }
+
+    if(frequency_rssi->rssi_coarse < rssi) {
+        frequency_rssi->rssi_coarse = rssi;
+        frequency_rssi->frequency_coarse = frequency;
+    }
+
+    return rssi;
+}
+
+/** First stage: scheduled coarse scan
+ *
+ * Every cycle revisits the most active channels and then continues the
+ * round-robin sweep over the rest of the table. The sweep part exits early
+ * as soon as a channel rises above the threshold.
+ */
+static void subghz_frequency_analyzer_worker_coarse_scan(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    FrequencyRSSI* frequency_rssi) {
+    size_t hot[SUBGHZ_FREQUENCY_ANALYZER_HOT_MAX];
+    size_t hot_count = 0;
+
+    // Pick hottest channels, kept in ascending frequency order
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        if(!instance->channels[i].activity) continue;
+        if(hot_count < SUBGHZ_FREQUENCY_ANALYZER_HOT_MAX) {
+            hot[hot_count++] = i;
+        } else {
+            size_t coldest = 0;
+            for(size_t j = 1; j < hot_count; j++) {
+                if(instance->channels[hot[j]].activity <
+                   instance->channels[hot[coldest]].activity) {
+                    coldest = j;
+                }
+            }
+            if(instance->channels[i].activity > instance->channels[hot[coldest]].activity) {
+                memmove(
+                    &hot[coldest],
+                    &hot[coldest + 1],
+                    (hot_count - coldest - 1) * sizeof(size_t));
+                hot[hot_count - 1] = i;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < hot_count; i++) {
+        subghz_frequency_analyzer_worker_probe_channel(
+            instance,
+            &instance->channels[hot[i]],
+            frequency_rssi,
+            SubGhzFrequencyAnalyzerDwellHot);
+    }
+
+    for(size_t i = 0; i < SUBGHZ_FREQUENCY_ANALYZER_COLD_CHUNK && instance->channels_count; i++) {
+        const size_t index = instance->cold_cursor;
+        instance->cold_cursor++;
+        if(instance->cold_cursor >= instance->channels_count) {
+            instance->cold_cursor = 0;
+            instance->stats_sweeps++;
+            // Activity decays once per full sweep
+            for(size_t j = 0; j < instance->channels_count; j++) {
+                if(instance->channels[j].activity) instance->channels[j].activity--;
+            }
+        }
+
+        bool already_probed = false;
+        for(size_t j = 0; j < hot_count; j++) {
+            if(hot[j] == index) already_probed = true;
+        }
+        if(already_probed) continue;
+
+        float rssi = subghz_frequency_analyzer_worker_probe_channel(
+            instance,
+            &instance->channels[index],
+            frequency_rssi,
+            SubGhzFrequencyAnalyzerDwellCold);
+        if(rssi > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) break;
+    }
+}
+
+/** Second stage: ternary search for the peak around coarse frequency
+ *
+ * RSSI around a carrier is unimodal within the fine span, so the search
+ * range shrinks by a third on every iteration. The remainder is swept in
+ * fine steps.
+ */
+static void subghz_frequency_analyzer_worker_fine_scan(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    FrequencyRSSI* frequency_rssi) {
+    uint32_t low = frequency_rssi->frequency_coarse - SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN;
+    uint32_t high = frequency_rssi->frequency_coarse + SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN;
+    uint32_t frequency = 0;
+    float rssi = 0;
+
+    while(high - low > 3 * SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP) {
+        const uint32_t third = (high - low) / 3;
+        const uint32_t middle_low = low + third;
+        const uint32_t middle_high = high - third;
+
+        float rssi_low = subghz_frequency_analyzer_worker_probe(
+            instance, middle_low, &frequency, SubGhzFrequencyAnalyzerDwellFine);
+        if(frequency_rssi->rssi_fine < rssi_low) {
+            frequency_rssi->rssi_fine = rssi_low;
+            frequency_rssi->frequency_fine = frequency;
+        }
+
+        float rssi_high = subghz_frequency_analyzer_worker_probe(
+            instance, middle_high, &frequency, SubGhzFrequencyAnalyzerDwellFine);
+        if(frequency_rssi->rssi_fine < rssi_high) {
+            frequency_rssi->rssi_fine = rssi_high;
+            frequency_rssi->frequency_fine = frequency;
+        }
+
+        if(rssi_low < rssi_high) {
+            low = middle_low;
+        } else {
+            high = middle_high;
+        }
+    }
+
+    for(uint32_t i = low; i <= high; i += SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP) {
+        rssi = subghz_frequency_analyzer_worker_probe(
+            instance, i, &frequency, SubGhzFrequencyAnalyzerDwellFine);
+
+        FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
+
+        if(frequency_rssi->rssi_fine < rssi) {
+            frequency_rssi->rssi_fine = rssi;
+            frequency_rssi->frequency_fine = frequency;
+        }
+    }
+}
+
+static void
+    subghz_frequency_analyzer_worker_stats_update(SubGhzFrequencyAnalyzerWorker* instance) {
+    const uint32_t elapsed = furi_get_tick() - instance->stats_tick;
+    if(elapsed < SUBGHZ_FREQUENCY_ANALYZER_STATS_PERIOD_MS) return;
+
+    SubGhzFrequencyAnalyzerWorkerStats stats = {0};
+    stats.sweep_rate = (float)instance->stats_sweeps * 1000.0f / (float)elapsed;
+    stats.probe_rate = instance->stats_probes * 1000 / elapsed;
+
+    uint64_t dwell_total = 0;
+    for(size_t i = 0; i < SubGhzFrequencyAnalyzerDwellNum; i++) {
+        dwell_total += instance->stats_dwell_cycles[i];
+    }
+    for(size_t i = 0; i < SubGhzFrequencyAnalyzerDwellNum; i++) {
+        if(dwell_total) {
+            stats.dwell[i] = (uint64_t)instance->stats_dwell_cycles[i] * 100 / dwell_total;
+        }
+        instance->stats_dwell_cycles[i] = 0;
+    }
+    for(size_t i = 0; i < instance->channels_count; i++) {
+        if(instance->channels[i].activity) stats.hot_channels++;
+    }
+
+    FURI_CRITICAL_ENTER();
+    instance->stats = stats;
+    FURI_CRITICAL_EXIT();
+
+    instance->stats_tick = furi_get_tick();
+    instance->stats_sweeps = 0;
+    instance->stats_probes = 0;
+}
+
 /** Worker thread
  * 
  * @param context 
@@ -68,11 +371,13 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
 
     FrequencyRSSI frequency_rssi = {
         .frequency_coarse = 0, .rssi_coarse = 0, .frequency_fine = 0, .rssi_fine = 0};
-    float rssi = 0;
-    uint32_t frequency = 0;
     float rssi_temp = -127.0f;
     uint32_t frequency_temp = 0;
 
+    subghz_frequency_analyzer_worker_channels_load(instance);
+    instance->calibrated_frequency = 0;
+    instance->stats_tick = furi_get_tick();
+
     //Start CC1101
     furi_hal_subghz_reset();
 
@@ -100,11 +405,7 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     furi_hal_subghz_set_path(FuriHalSubGhzPathIsolate);
 
     while(instance->worker_running) {
-        furi_delay_ms(10);
-
-        float rssi_min = 26.0f;
-        float rssi_avg = 0;
-        size_t rssi_avg_samples = 0;
+        furi_delay_ms(SUBGHZ_FREQUENCY_ANALYZER_CYCLE_YIELD_MS);
 
         frequency_rssi.rssi_coarse = -127.0f;
         frequency_rssi.rssi_fine = -127.0f;
@@ -112,88 +413,30 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
         subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_650khz);
 
         // First stage: coarse scan
-        for(size_t i = 0; i < subghz_setting_get_frequency_count(instance->setting); i++) {
-            if(furi_hal_subghz_is_frequency_valid(
-                   subghz_setting_get_frequency(instance->setting, i))) {
-                furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-                cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-                frequency = cc1101_set_frequency(
-                    &furi_hal_spi_bus_handle_subghz,
-                    subghz_setting_get_frequency(instance->setting, i));
-
-                cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
-
-                furi_check(cc1101_wait_status_state(
-                    &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
-
-                cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
-                furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
-
-                furi_delay_ms(2);
-
-                rssi = furi_hal_subghz_get_rssi();
-
-                rssi_avg += rssi;
-                rssi_avg_samples++;
-
-                if(rssi < rssi_min) rssi_min = rssi;
-
-                if(frequency_rssi.rssi_coarse < rssi) {
-                    frequency_rssi.rssi_coarse = rssi;
-                    frequency_rssi.frequency_coarse = frequency;
-                }
-            }
-        }
+        subghz_frequency_analyzer_worker_coarse_scan(instance, &frequency_rssi);
 
         FURI_LOG_T(
             TAG,
-            "RSSI: avg %f, max %f at %lu, min %f",
-            (double)(rssi_avg / rssi_avg_samples),
+            "RSSI: max %f at %lu",
             (double)frequency_rssi.rssi_coarse,
-            frequency_rssi.frequency_coarse,
-            (double)rssi_min);
+            frequency_rssi.frequency_coarse);
 
         // Second stage: fine scan
         if(frequency_rssi.rssi_coarse > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
             furi_hal_subghz_idle();
             subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_58khz);
-            //for example -0.3 ... 433.92 ... +0.3 step 20KHz
-            for(uint32_t i = frequency_rssi.frequency_coarse - 300000;
-                i < frequency_rssi.frequency_coarse + 300000;
-                i += 20000) {
-                if(furi_hal_subghz_is_frequency_valid(i)) {
-                    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-                    cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-                    frequency = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, i);
-
-                    cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
-
-                    furi_check(cc1101_wait_status_state(
-                        &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
-
-                    cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
-                    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
-
-                    furi_delay_ms(2);
-
-                    rssi = furi_hal_subghz_get_rssi();
-
-                    FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
-
-                    if(frequency_rssi.rssi_fine < rssi) {
-                        frequency_rssi.rssi_fine = rssi;
-                        frequency_rssi.frequency_fine = frequency;
-                    }
-                }
-            }
+            subghz_frequency_analyzer_worker_fine_scan(instance, &frequency_rssi);
         }
 
+        subghz_frequency_analyzer_worker_stats_update(instance);
+
         // Deliver results fine
         if(frequency_rssi.rssi_fine > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
             FURI_LOG_D(
                 TAG, "=:%lu:%f", frequency_rssi.frequency_fine, (double)frequency_rssi.rssi_fine);
 
             instance->sample_hold_counter = 20;
+            instance->sample_hold_tick = furi_get_tick();
             rssi_temp = (rssi_temp + frequency_rssi.rssi_fine) / 2;
             frequency_temp = frequency_rssi.frequency_fine;
 
@@ -217,6 +460,7 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
                 (double)frequency_rssi.rssi_coarse);
 
             instance->sample_hold_counter = 20;
+            instance->sample_hold_tick = furi_get_tick();
             rssi_temp = (rssi_temp + frequency_rssi.rssi_coarse) / 2;
             frequency_temp = frequency_rssi.frequency_coarse;
             if(!float_is_equal(instance->filVal, 0.f)) {
@@ -231,11 +475,15 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
             }
         } else {
             if(instance->sample_hold_counter > 0) {
-                instance->sample_hold_counter--;
-                if(instance->sample_hold_counter == 15) {
-                    if(instance->pair_callback) {
-                        instance->pair_callback(
-                            instance->context, frequency_temp, rssi_temp, false);
+                if(furi_get_tick() - instance->sample_hold_tick >=
+                   SUBGHZ_FREQUENCY_ANALYZER_HOLD_STEP_MS) {
+                    instance->sample_hold_tick = furi_get_tick();
+                    instance->sample_hold_counter--;
+                    if(instance->sample_hold_counter == 15) {
+                        if(instance->pair_callback) {
+                            instance->pair_callback(
+                                instance->context, frequency_temp, rssi_temp, false);
+                        }
                     }
                 }
             } else {
@@ -250,6 +498,8 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     furi_hal_subghz_idle();
     furi_hal_subghz_sleep();
 
+    subghz_frequency_analyzer_worker_channels_free(instance);
+
     return 0;
 }
 
@@ -303,3 +553,14 @@ bool subghz_frequency_analyzer_worker_is_running(SubGhzFrequencyAnalyzerWorker*
     furi_assert(instance);
     return instance->worker_running;
 }
+
+void subghz_frequency_analyzer_worker_get_stats(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerWorkerStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = instance->stats;
+    FURI_CRITICAL_EXIT();
+}
@@ -20,6 +20,21 @@ typedef struct {
     float rssi_fine;
 } FrequencyRSSI;
 
+typedef enum {
+    SubGhzFrequencyAnalyzerDwellHot, /**< Revisits of recently active channels */
+    SubGhzFrequencyAnalyzerDwellCold, /**< Round-robin sweep over all channels */
+    SubGhzFrequencyAnalyzerDwellFine, /**< Peak search around coarse frequency */
+
+    SubGhzFrequencyAnalyzerDwellNum,
+} SubGhzFrequencyAnalyzerDwell;
+
+typedef struct {
+    float sweep_rate; /**< Full coarse sweeps per second */
+    uint32_t probe_rate; /**< RSSI probes per second */
+    uint8_t dwell[SubGhzFrequencyAnalyzerDwellNum]; /**< Share of probe time, percent */
+    uint8_t hot_channels; /**< Channels with recent activity */
+} SubGhzFrequencyAnalyzerWorkerStats;
+
 /** Allocate SubGhzFrequencyAnalyzerWorker
  * 
  * @param context SubGhz* context
@@ -61,3 +76,14 @@ void subghz_frequency_analyzer_worker_stop(SubGhzFrequencyAnalyzerWorker* instan
  * @return bool - true if running
  */
 bool subghz_frequency_analyzer_worker_is_running(SubGhzFrequencyAnalyzerWorker* instance);
+
+/** Get scan scheduler statistics
+ *
+ * Statistics are refreshed by the worker about once per second.
+ *
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @param stats pointer to SubGhzFrequencyAnalyzerWorkerStats to fill
+ */
+void subghz_frequency_analyzer_worker_get_stats(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerWorkerStats* stats);
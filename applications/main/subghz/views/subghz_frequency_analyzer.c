@@ -23,6 +23,7 @@ typedef enum {
 typedef enum {
     SubGhzFrequencyAnalyzerFragmentBottomTypeMain,
     SubGhzFrequencyAnalyzerFragmentBottomTypeLog,
+    SubGhzFrequencyAnalyzerFragmentBottomTypeStats,
 } SubGhzFrequencyAnalyzerFragmentBottomType;
 
 struct SubGhzFrequencyAnalyzer {
@@ -43,6 +44,7 @@ typedef struct {
     SubGhzFrequencyAnalyzerFragmentBottomType fragment_bottom_type;
     SubGhzFrequencyAnalyzerLogOrderBy log_frequency_order_by;
     uint8_t log_frequency_scroll_offset;
+    SubGhzFrequencyAnalyzerWorkerStats stats;
 } SubGhzFrequencyAnalyzerModel;
 
 static inline uint8_t rssi_sanitize(float rssi) {
@@ -153,6 +155,37 @@ static void subghz_frequency_analyzer_history_frequency_draw(
     canvas_set_font(canvas, FontSecondary);
 }
 
+static void subghz_frequency_analyzer_stats_draw(
+    Canvas* canvas,
+    SubGhzFrequencyAnalyzerModel* model) {
+    char buffer[64];
+    const uint8_t offset_y = 43;
+    canvas_set_font(canvas, FontKeyboard);
+
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "Sweep %2lu.%01lu/s %4lu p/s",
+        (uint32_t)model->stats.sweep_rate,
+        (uint32_t)(model->stats.sweep_rate * 10) % 10,
+        model->stats.probe_rate);
+    canvas_draw_str(canvas, 0, offset_y, buffer);
+
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "Dwell H%u%% C%u%% F%u%%",
+        model->stats.dwell[SubGhzFrequencyAnalyzerDwellHot],
+        model->stats.dwell[SubGhzFrequencyAnalyzerDwellCold],
+        model->stats.dwell[SubGhzFrequencyAnalyzerDwellFine]);
+    canvas_draw_str(canvas, 0, offset_y + 10, buffer);
+
+    snprintf(buffer, sizeof(buffer), "Hot channels %u", model->stats.hot_channels);
+    canvas_draw_str(canvas, 0, offset_y + 20, buffer);
+
+    canvas_set_font(canvas, FontSecondary);
+}
+
 void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel* model) {
     furi_assert(canvas);
     furi_assert(model);
@@ -173,6 +206,10 @@ void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel
             canvas_draw_str(canvas, 2, 8, buffer);
         }
         subghz_frequency_analyzer_log_frequency_draw(canvas, model);
+    } else if(model->fragment_bottom_type == SubGhzFrequencyAnalyzerFragmentBottomTypeStats) {
+        canvas_draw_str(canvas, 0, 8, "Frequency Analyzer");
+        canvas_draw_icon(canvas, 109, 0, &I_Internal_ant_1_9x11);
+        subghz_frequency_analyzer_stats_draw(canvas, model);
     } else {
         canvas_draw_str(canvas, 0, 8, "Frequency Analyzer");
         canvas_draw_icon(canvas, 109, 0, &I_Internal_ant_1_9x11);
@@ -216,13 +253,14 @@ bool subghz_frequency_analyzer_input(InputEvent* event, void* context) {
             {
                 if(event->key == InputKeyLeft) {
                     if(model->fragment_bottom_type == 0) {
-                        model->fragment_bottom_type = SubGhzFrequencyAnalyzerFragmentBottomTypeLog;
+                        model->fragment_bottom_type =
+                            SubGhzFrequencyAnalyzerFragmentBottomTypeStats;
                     } else {
                         --model->fragment_bottom_type;
                     }
                 } else if(event->key == InputKeyRight) {
                     if(model->fragment_bottom_type ==
-                       SubGhzFrequencyAnalyzerFragmentBottomTypeLog) {
+                       SubGhzFrequencyAnalyzerFragmentBottomTypeStats) {
                         model->fragment_bottom_type = 0;
                     } else {
                         ++model->fragment_bottom_type;
@@ -365,6 +403,7 @@ void subghz_frequency_analyzer_pair_callback(
             model->rssi = rssi_sanitize(rssi);
             model->frequency = frequency;
             model->signal = signal;
+            subghz_frequency_analyzer_worker_get_stats(instance->worker, &model->stats);
             if(frequency) {
                 subghz_frequency_analyzer_log_frequency_update(
                     model, frequency != instance->last_frequency);
@@ -399,6 +438,7 @@ void subghz_frequency_analyzer_enter(void* context) {
             model->log_frequency_scroll_offset = 0;
             model->history_frequency[0] = model->history_frequency[1] =
                 model->history_frequency[2] = 0;
+            model->stats = (SubGhzFrequencyAnalyzerWorkerStats){0};
             SubGhzFrequencyAnalyzerLogItemArray_init(model->log_frequency);
         },
         true);
@@ -435,6 +435,21 @@ void cli_command_free(PipeSide* pipe, FuriString* args, void* context) {
 
     printf("Pool free: %zu\r\n", memmgr_pool_get_free());
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
+
+    FuriObjectPoolStats stats;
+    for(size_t i = 0; furi_object_pool_get_stats_by_index(i, &stats); i++) {
+        if(i == 0) printf("Object pools:\r\n");
+        printf(
+            "  %s: size %zu, in use %zu (peak %zu), cached %zu/%zu, hits %zu, misses %zu\r\n",
+            stats.name,
+            stats.object_size,
+            stats.in_use,
+            stats.peak,
+            stats.cached,
+            stats.cache_limit,
+            stats.hits,
+            stats.misses);
+    }
 }
 
 void cli_command_free_blocks(PipeSide* pipe, FuriString* args, void* context) {
@@ -445,6 +460,227 @@ void cli_command_free_blocks(PipeSide* pipe, FuriString* args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+#define CLI_HEAP_MAP_PAGE_SIZE       (16U)
+#define CLI_HEAP_SAMPLE_INTERVAL_MS  (1000U)
+#define CLI_HEAP_SAMPLE_CAPACITY     (64U)
+#define CLI_HEAP_SAMPLE_CAPACITY_MAX (1024U)
+
+static void cli_command_heap_print_sample(const MemmgrHeapSample* sample) {
+    printf(
+        "%lu %lu %lu %lu %lu\r\n",
+        sample->tick,
+        sample->free,
+        sample->max_free_block,
+        sample->free_blocks,
+        sample->allocated_blocks);
+}
+
+static void cli_command_heap_map(void) {
+    printf(
+        "heap begin %zu %zu %d\r\n",
+        memmgr_get_total_heap(),
+        memmgr_get_free_heap(),
+        memmgr_heap_is_owner_trace_available());
+
+    // Names for owner thread ids
+    FuriThreadList* thread_list = furi_thread_list_alloc();
+    furi_thread_enumerate(thread_list);
+    for(size_t i = 0; i < furi_thread_list_size(thread_list); i++) {
+        const FuriThreadListItem* item = furi_thread_list_get_at(thread_list, i);
+        printf("task 0x%08lx %s\r\n", (uint32_t)item->thread, item->name);
+    }
+    furi_thread_list_free(thread_list);
+
+    // Heap can't be printed with scheduler suspended, so it is copied page by page
+    MemmgrHeapBlock blocks[CLI_HEAP_MAP_PAGE_SIZE];
+    uint32_t address = 0;
+    size_t count;
+    while((count = memmgr_heap_get_blocks(address, blocks, COUNT_OF(blocks))) > 0) {
+        for(size_t i = 0; i < count; i++) {
+            printf(
+                "%08lx %lu %c %08lx %08lx\r\n",
+                blocks[i].address,
+                blocks[i].size,
+                blocks[i].allocated ? 'A' : 'F',
+                (uint32_t)blocks[i].thread_id,
+                blocks[i].caller);
+        }
+        address = blocks[count - 1].address + 1;
+    }
+
+    printf("heap end\r\n");
+}
+
+static void cli_command_heap_sample(FuriString* args) {
+    FuriString* cmd = furi_string_alloc();
+
+    if(!args_read_string_and_trim(args, cmd)) {
+        furi_string_set(cmd, "dump");
+    }
+
+    if(furi_string_cmp_str(cmd, "start") == 0) {
+        uint32_t interval = CLI_HEAP_SAMPLE_INTERVAL_MS;
+        int capacity = CLI_HEAP_SAMPLE_CAPACITY;
+        if(args_length(args) && !args_read_duration(args, &interval, NULL)) {
+            printf("Invalid interval\r\n");
+        } else if(
+            args_length(args) &&
+            (!args_read_int_and_trim(args, &capacity) || capacity <= 0 ||
+             capacity > (int)CLI_HEAP_SAMPLE_CAPACITY_MAX)) {
+            printf("Invalid sample count, 1-%u\r\n", CLI_HEAP_SAMPLE_CAPACITY_MAX);
+        } else {
+            memmgr_heap_sampling_start(furi_ms_to_ticks(MAX(interval, 1UL)), capacity);
+        }
+    } else if(furi_string_cmp_str(cmd, "stop") == 0) {
+        memmgr_heap_sampling_stop();
+    } else {
+        printf("samples begin %lu\r\n", furi_kernel_get_tick_frequency());
+        MemmgrHeapSample sample;
+        for(size_t i = 0; memmgr_heap_sampling_get(i, &sample); i++) {
+            cli_command_heap_print_sample(&sample);
+        }
+        printf("samples end\r\n");
+    }
+
+    furi_string_free(cmd);
+}
+
+static void cli_command_heap_print_usage(void) {
+    printf("Usage:\r\n");
+    printf("heap <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+
+    printf("\tmap\t - Print all heap blocks, analyze with scripts/heapmap.py\r\n");
+    printf("\tsample start [interval] [count]\t - Sample heap state periodically\r\n");
+    printf("\tsample stop\t - Stop sampling, samples are kept\r\n");
+    printf("\tsample\t - Print collected samples\r\n");
+}
+
+static void cli_command_heap(PipeSide* pipe, FuriString* args, void* context) {
+    UNUSED(pipe);
+    UNUSED(context);
+
+    FuriString* cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            MemmgrHeapSample sample;
+            memmgr_heap_get_sample(&sample);
+            printf(
+                "Free %lu, max block %lu, free blocks %lu, allocated blocks %lu\r\n",
+                sample.free,
+                sample.max_free_block,
+                sample.free_blocks,
+                sample.allocated_blocks);
+            cli_command_heap_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "map") == 0) {
+            cli_command_heap_map();
+        } else if(furi_string_cmp_str(cmd, "sample") == 0) {
+            cli_command_heap_sample(args);
+        } else {
+            cli_command_heap_print_usage();
+        }
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
+static void cli_command_trace_dump_callback(
+    FuriThreadId owner,
+    const char* name,
+    const FuriTraceEvent* events,
+    size_t count,
+    void* context) {
+    UNUSED(context);
+
+    printf("buffer 0x%08lx %zu %s\r\n", (uint32_t)owner, count, name);
+    for(size_t i = 0; i < count; i++) {
+        printf(
+            "%08lx %u %u %08lx\r\n",
+            events[i].timestamp,
+            events[i].point,
+            events[i].type,
+            events[i].value);
+    }
+}
+
+static void cli_command_trace_dump(void) {
+    // Stop recording so snapshots are not torn by the dump itself
+    bool enabled = furi_trace_is_enabled();
+    furi_trace_set_enabled(false);
+
+    printf(
+        "trace begin %lu %08lx\r\n",
+        furi_hal_cortex_instructions_per_microsecond() * 1000000UL,
+        furi_trace_get_timestamp());
+
+    for(size_t i = 0; i < FuriTracePointNum; i++) {
+        printf("point %zu %s\r\n", i, furi_trace_get_point_name(i));
+    }
+
+    // Names for task handles recorded by scheduler hooks
+    FuriThreadList* thread_list = furi_thread_list_alloc();
+    furi_thread_enumerate(thread_list);
+    for(size_t i = 0; i < furi_thread_list_size(thread_list); i++) {
+        const FuriThreadListItem* item = furi_thread_list_get_at(thread_list, i);
+        printf("task 0x%08lx %s\r\n", (uint32_t)item->thread, item->name);
+    }
+    furi_thread_list_free(thread_list);
+
+    furi_trace_enumerate(cli_command_trace_dump_callback, NULL);
+    printf("trace end\r\n");
+
+    furi_trace_set_enabled(enabled);
+}
+
+static void cli_command_trace_print_usage(void) {
+    printf("Usage:\r\n");
+    printf("trace <cmd>\r\n");
+    printf("Cmd list:\r\n");
+
+    printf("\tstart\t - Start event recording\r\n");
+    printf("\tstop\t - Stop event recording\r\n");
+    printf("\treset\t - Drop recorded events\r\n");
+    printf("\tdump\t - Print recorded events, convert with scripts/trace2chrome.py\r\n");
+}
+
+static void cli_command_trace(PipeSide* pipe, FuriString* args, void* context) {
+    UNUSED(pipe);
+    UNUSED(context);
+
+    if(!furi_trace_is_available()) {
+        printf("Tracepoints are not compiled in, rebuild firmware with TRACE=1");
+        return;
+    }
+
+    FuriString* cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            printf("Recording: %s\r\n", furi_trace_is_enabled() ? "on" : "off");
+            cli_command_trace_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            furi_trace_set_enabled(true);
+        } else if(furi_string_cmp_str(cmd, "stop") == 0) {
+            furi_trace_set_enabled(false);
+        } else if(furi_string_cmp_str(cmd, "reset") == 0) {
+            furi_trace_reset();
+        } else if(furi_string_cmp_str(cmd, "dump") == 0) {
+            cli_command_trace_dump();
+        } else {
+            cli_command_trace_print_usage();
+        }
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
 void cli_command_i2c(PipeSide* pipe, FuriString* args, void* context) {
     UNUSED(pipe);
     UNUSED(args);
@@ -536,6 +772,9 @@ void cli_main_commands_init(CliRegistry* registry) {
     cli_registry_add_command(registry, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_registry_add_command(
         registry, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_registry_add_command(registry, "heap", CliCommandFlagParallelSafe, cli_command_heap, NULL);
+    cli_registry_add_command(
+        registry, "trace", CliCommandFlagParallelSafe, cli_command_trace, NULL);
     cli_registry_add_command(registry, "echo", CliCommandFlagParallelSafe, cli_command_echo, NULL);
     cli_registry_add_command(
         registry, "sleep", CliCommandFlagParallelSafe, cli_command_sleep, NULL);
@@ -26,6 +26,7 @@ Canvas* canvas_init(void) {
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
     canvas->orientation = CanvasOrientationHorizontal;
+    canvas->display_buffer = malloc(canvas_get_buffer_size(canvas));
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
@@ -43,6 +44,7 @@ void canvas_free(Canvas* canvas) {
     compress_icon_free(canvas->compress_icon);
     CanvasCallbackPairArray_clear(canvas->canvas_callback_pair);
     furi_mutex_free(canvas->mutex);
+    free(canvas->display_buffer);
     free(canvas);
 }
 
@@ -66,20 +68,58 @@ void canvas_reset(Canvas* canvas) {
     canvas_set_font_direction(canvas, CanvasDirectionLeftToRight);
 }
 
+static bool canvas_commit_display(Canvas* canvas) {
+    const uint8_t* buffer = canvas_get_buffer(canvas);
+    size_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    size_t page_size = tile_width * 8;
+    bool changed = false;
+
+    // Display is updated by 8 row pages, only span of changed 8x8 tiles is sent
+    for(size_t page = 0; page < u8g2_GetBufferTileHeight(&canvas->fb); page++) {
+        const uint8_t* data = &buffer[page * page_size];
+        uint8_t* sent = &canvas->display_buffer[page * page_size];
+        size_t first = 0;
+        size_t last = tile_width;
+
+        if(canvas->display_buffer_valid) {
+            while(first < last && memcmp(&data[first * 8], &sent[first * 8], 8) == 0) {
+                first++;
+            }
+            if(first == last) continue;
+            while(memcmp(&data[(last - 1) * 8], &sent[(last - 1) * 8], 8) == 0) {
+                last--;
+            }
+        }
+
+        u8g2_UpdateDisplayArea(&canvas->fb, first, page, last - first, 1);
+        memcpy(&sent[first * 8], &data[first * 8], (last - first) * 8);
+        changed = true;
+    }
+
+    if(changed) u8x8_RefreshDisplay(u8g2_GetU8x8(&canvas->fb));
+    canvas->display_buffer_valid = true;
+
+    return changed;
+}
+
 void canvas_commit(Canvas* canvas) {
     furi_check(canvas);
-    u8g2_SendBuffer(&canvas->fb);
 
-    // Iterate over callbacks
+    bool changed = canvas_commit_display(canvas);
+
+    // Iterate over callbacks, unchanged frame is not interesting for them
     canvas_lock(canvas);
-    for
-        M_EACH(p, canvas->canvas_callback_pair, CanvasCallbackPairArray_t) {
-            p->callback(
-                canvas_get_buffer(canvas),
-                canvas_get_buffer_size(canvas),
-                canvas_get_orientation(canvas),
-                p->context);
-        }
+    if(changed || canvas->callback_pending) {
+        canvas->callback_pending = false;
+        for
+            M_EACH(p, canvas->canvas_callback_pair, CanvasCallbackPairArray_t) {
+                p->callback(
+                    canvas_get_buffer(canvas),
+                    canvas_get_buffer_size(canvas),
+                    canvas_get_orientation(canvas),
+                    p->context);
+            }
+    }
     canvas_unlock(canvas);
 }
 
@@ -588,6 +628,8 @@ void canvas_add_framebuffer_callback(Canvas* canvas, CanvasCommitCallback callba
     canvas_lock(canvas);
     furi_check(!CanvasCallbackPairArray_count(canvas->canvas_callback_pair, p));
     CanvasCallbackPairArray_push_back(canvas->canvas_callback_pair, p);
+    // New callback gets current frame even if it did not change
+    canvas->callback_pending = true;
     canvas_unlock(canvas);
 }
 
@@ -47,6 +47,10 @@ struct Canvas {
     CompressIcon* compress_icon;
     CanvasCallbackPairArray_t canvas_callback_pair;
     FuriMutex* mutex;
+    // Copy of display contents, only changed tiles are sent on commit
+    uint8_t* display_buffer;
+    bool display_buffer_valid;
+    bool callback_pending;
 };
 
 /** Allocate memory and initialize canvas
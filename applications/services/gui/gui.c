@@ -39,6 +39,14 @@ size_t gui_active_view_port_count(Gui* gui, GuiLayer layer) {
 
 void gui_update(Gui* gui) {
     furi_assert(gui);
+    __atomic_or_fetch(&gui->dirty_layers, GUI_LAYER_MASK_ALL, __ATOMIC_SEQ_CST);
+    if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
+}
+
+void gui_update_layer(Gui* gui, GuiLayer layer) {
+    furi_assert(gui);
+    furi_check(layer < GuiLayerMAX);
+    __atomic_or_fetch(&gui->dirty_layers, GUI_LAYER_MASK(layer), __ATOMIC_SEQ_CST);
     if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
 }
 
@@ -217,6 +225,29 @@ static void gui_redraw_status_bar(Gui* gui, bool need_attention) {
     }
 }
 
+static void gui_redraw_status_bar_cached(Gui* gui, bool need_attention, bool dirty) {
+    GuiStatusBarCache* cache = &gui->status_bar_cache;
+    bool flip = furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient);
+
+    uint8_t* area = canvas_get_buffer(gui->canvas);
+    if(flip) area += canvas_get_buffer_size(gui->canvas) - GUI_STATUS_BAR_CACHE_SIZE;
+
+    // Status bar is drawn over other layers, so result depends on pixels below it
+    if(!dirty && cache->valid && cache->need_attention == need_attention && cache->flip == flip &&
+       memcmp(cache->background, area, GUI_STATUS_BAR_CACHE_SIZE) == 0) {
+        memcpy(area, cache->rendered, GUI_STATUS_BAR_CACHE_SIZE);
+        return;
+    }
+
+    memcpy(cache->background, area, GUI_STATUS_BAR_CACHE_SIZE);
+    gui_redraw_status_bar(gui, need_attention);
+    memcpy(cache->rendered, area, GUI_STATUS_BAR_CACHE_SIZE);
+
+    cache->valid = true;
+    cache->need_attention = need_attention;
+    cache->flip = flip;
+}
+
 static bool gui_redraw_window(Gui* gui) {
     canvas_set_orientation(gui->canvas, CanvasOrientationHorizontal);
     canvas_frame_set(gui->canvas, GUI_WINDOW_X, GUI_WINDOW_Y, GUI_WINDOW_WIDTH, GUI_WINDOW_HEIGHT);
@@ -240,13 +271,32 @@ static bool gui_redraw_desktop(Gui* gui) {
     return false;
 }
 
+static uint32_t gui_visible_layers(Gui* gui) {
+    uint32_t visible = GUI_LAYER_MASK(GuiLayerDesktop) | GUI_LAYER_MASK_STATUS_BAR;
+
+    if(!gui->lockdown) {
+        if(gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen])) {
+            visible = GUI_LAYER_MASK(GuiLayerFullscreen);
+        } else if(gui_view_port_find_enabled(gui->layers[GuiLayerWindow])) {
+            visible = GUI_LAYER_MASK(GuiLayerWindow) | GUI_LAYER_MASK_STATUS_BAR;
+        }
+    }
+
+    return visible;
+}
+
 static void gui_redraw(Gui* gui) {
     furi_assert(gui);
+    FURI_TRACE_BEGIN(GuiRedraw, 0);
     gui_lock(gui);
 
     do {
         if(gui->direct_draw) break;
 
+        uint32_t dirty = __atomic_exchange_n(&gui->dirty_layers, 0, __ATOMIC_SEQ_CST);
+        if(!(dirty & gui_visible_layers(gui))) break;
+        bool status_bar_dirty = dirty & GUI_LAYER_MASK_STATUS_BAR;
+
         canvas_reset(gui->canvas);
 
         if(gui->lockdown) {
@@ -254,13 +304,13 @@ static void gui_redraw(Gui* gui) {
             bool need_attention =
                 (gui_view_port_find_enabled(gui->layers[GuiLayerWindow]) != 0 ||
                  gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]) != 0);
-            gui_redraw_status_bar(gui, need_attention);
+            gui_redraw_status_bar_cached(gui, need_attention, status_bar_dirty);
         } else {
             if(!gui_redraw_fs(gui)) {
                 if(!gui_redraw_window(gui)) {
                     gui_redraw_desktop(gui);
                 }
-                gui_redraw_status_bar(gui, false);
+                gui_redraw_status_bar_cached(gui, false, status_bar_dirty);
             }
         }
 
@@ -268,6 +318,7 @@ static void gui_redraw(Gui* gui) {
     } while(false);
 
     gui_unlock(gui);
+    FURI_TRACE_END(GuiRedraw, 0);
 }
 
 static void gui_input(Gui* gui, InputEvent* input_event) {
@@ -372,7 +423,7 @@ void gui_add_view_port(Gui* gui, ViewPort* view_port, GuiLayer layer) {
     }
     // Add view port and link with gui
     ViewPortArray_push_back(gui->layers[layer], view_port);
-    view_port_gui_set(view_port, gui);
+    view_port_gui_set(view_port, gui, layer);
     gui_unlock(gui);
 
     // Request redraw
@@ -384,7 +435,7 @@ void gui_remove_view_port(Gui* gui, ViewPort* view_port) {
     furi_check(view_port);
 
     gui_lock(gui);
-    view_port_gui_set(view_port, NULL);
+    view_port_gui_set(view_port, NULL, GuiLayerMAX);
     ViewPortArray_it_t it;
     for(size_t i = 0; i < GuiLayerMAX; i++) {
         ViewPortArray_it(it, gui->layers[i]);
@@ -484,6 +535,14 @@ size_t gui_get_framebuffer_size(const Gui* gui) {
     return canvas_get_buffer_size(gui->canvas);
 }
 
+void gui_set_redraw_rate(Gui* gui, uint32_t rate) {
+    furi_check(gui);
+
+    gui_lock(gui);
+    gui->redraw_interval = rate ? furi_ms_to_ticks(1000) / rate : 0;
+    gui_unlock(gui);
+}
+
 void gui_set_lockdown(Gui* gui, bool lockdown) {
     furi_check(gui);
 
@@ -537,9 +596,10 @@ Gui* gui_alloc(void) {
 
     // Drawing canvas
     gui->canvas = canvas_init();
+    gui->redraw_interval = furi_ms_to_ticks(1000) / GUI_REDRAW_RATE_DEFAULT;
 
     // Input
-    gui->input_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
+    gui->input_queue = furi_message_queue_alloc(GUI_INPUT_QUEUE_SIZE, sizeof(InputEvent));
     gui->input_events = furi_record_open(RECORD_INPUT_EVENTS);
 
     furi_pubsub_subscribe(gui->input_events, gui_input_events_callback, gui);
@@ -554,20 +614,38 @@ int32_t gui_srv(void* p) {
     furi_record_create(RECORD_GUI, gui);
 
     while(1) {
-        uint32_t flags =
-            furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, FuriWaitForever);
+        // Pending redraw waits for the end of redraw interval
+        uint32_t timeout = FuriWaitForever;
+        if(gui->redraw_pending) {
+            uint32_t elapsed = furi_get_tick() - gui->redraw_tick;
+            timeout = elapsed < gui->redraw_interval ? gui->redraw_interval - elapsed : 0;
+        }
+
+        uint32_t flags = furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, timeout);
+        if(flags & FuriFlagError) flags = 0;
+
         // Process and dispatch input
         if(flags & GUI_THREAD_FLAG_INPUT) {
             // Process till queue become empty
-            InputEvent input_event;
-            while(furi_message_queue_get(gui->input_queue, &input_event, 0) == FuriStatusOk) {
-                gui_input(gui, &input_event);
+            InputEvent input_events[GUI_INPUT_QUEUE_SIZE];
+            uint32_t count = COUNT_OF(input_events);
+            while(furi_message_queue_get_batch(gui->input_queue, input_events, &count, 0) ==
+                  FuriStatusOk) {
+                for(uint32_t i = 0; i < count; i++) {
+                    gui_input(gui, &input_events[i]);
+                }
+                count = COUNT_OF(input_events);
             }
         }
-        // Process and dispatch draw call
+        // Coalesce draw calls that arrive faster than redraw rate
         if(flags & GUI_THREAD_FLAG_DRAW) {
+            gui->redraw_pending = true;
+        }
+        if(gui->redraw_pending && furi_get_tick() - gui->redraw_tick >= gui->redraw_interval) {
             // Clear flags that arrived on input step
             furi_thread_flags_clear(GUI_THREAD_FLAG_DRAW);
+            gui->redraw_pending = false;
+            gui->redraw_tick = furi_get_tick();
             gui_redraw(gui);
         }
     }
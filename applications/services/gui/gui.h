@@ -100,6 +100,16 @@ void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback,
  */
 size_t gui_get_framebuffer_size(const Gui* gui);
 
+/** Set redraw rate limit
+ *
+ * Redraw requests that come faster than this rate are coalesced into one
+ * redraw, display shows the state at the end of the interval.
+ *
+ * @param      gui   Gui instance
+ * @param      rate  redraws per second, 0 to redraw on every request
+ */
+void gui_set_redraw_rate(Gui* gui, uint32_t rate);
+
 /** Set lockdown mode
  *
  * When lockdown mode is enabled, only GuiLayerDesktop is shown.
@@ -37,12 +37,34 @@
 #define GUI_WINDOW_WIDTH  GUI_DISPLAY_WIDTH
 #define GUI_WINDOW_HEIGHT (GUI_DISPLAY_HEIGHT - GUI_WINDOW_Y)
 
+/* Status bar occupies first pages of display buffer, last ones if flipped */
+#define GUI_STATUS_BAR_CACHE_PAGES ((GUI_STATUS_BAR_HEIGHT + 7) / 8)
+#define GUI_STATUS_BAR_CACHE_SIZE  (GUI_STATUS_BAR_CACHE_PAGES * GUI_DISPLAY_WIDTH)
+
+#define GUI_REDRAW_RATE_DEFAULT 30
+
+#define GUI_LAYER_MASK(layer) (1UL << (layer))
+#define GUI_LAYER_MASK_ALL    (GUI_LAYER_MASK(GuiLayerMAX) - 1)
+#define GUI_LAYER_MASK_STATUS_BAR \
+    (GUI_LAYER_MASK(GuiLayerStatusBarLeft) | GUI_LAYER_MASK(GuiLayerStatusBarRight))
+
+#define GUI_INPUT_QUEUE_SIZE 8
+
 #define GUI_THREAD_FLAG_DRAW  (1 << 0)
 #define GUI_THREAD_FLAG_INPUT (1 << 1)
 #define GUI_THREAD_FLAG_ALL   (GUI_THREAD_FLAG_DRAW | GUI_THREAD_FLAG_INPUT)
 
 ARRAY_DEF(ViewPortArray, ViewPort*, M_PTR_OPLIST);
 
+/** Rendered status bar together with pixels it was drawn over */
+typedef struct {
+    bool valid;
+    bool need_attention;
+    bool flip;
+    uint8_t background[GUI_STATUS_BAR_CACHE_SIZE];
+    uint8_t rendered[GUI_STATUS_BAR_CACHE_SIZE];
+} GuiStatusBarCache;
+
 /** Gui structure */
 struct Gui {
     // Thread and lock
@@ -55,6 +77,13 @@ struct Gui {
     ViewPortArray_t layers[GuiLayerMAX];
     Canvas* canvas;
 
+    // Redraw
+    uint32_t dirty_layers;
+    uint32_t redraw_interval;
+    uint32_t redraw_tick;
+    bool redraw_pending;
+    GuiStatusBarCache status_bar_cache;
+
     // Input
     FuriMessageQueue* input_queue;
     FuriPubSub* input_events;
@@ -76,6 +105,16 @@ ViewPort* gui_view_port_find_enabled(ViewPortArray_t array);
  */
 void gui_update(Gui* gui);
 
+/** Update GUI layer, request redraw
+ *
+ * Redraw is skipped if layer is not visible. Changes of layer composition
+ * must use gui_update.
+ *
+ * @param      gui    Gui instance
+ * @param[in]  layer  GuiLayer that changed
+ */
+void gui_update_layer(Gui* gui, GuiLayer layer);
+
 /** Input event callback
  * 
  * Used to receive input from input service or to inject new input events
@@ -14,10 +14,10 @@
 
 #define TAG "BrowserWorker"
 
-#define ASSETS_DIR          "assets"
-#define BROWSER_ROOT        STORAGE_EXT_PATH_PREFIX
-#define FILE_NAME_LEN_MAX   256
-#define LONG_LOAD_THRESHOLD 100
+#define ASSETS_DIR           "assets"
+#define BROWSER_ROOT         STORAGE_EXT_PATH_PREFIX
+#define LONG_LOAD_THRESHOLD  100
+#define SNAPSHOT_BUFFER_SIZE (4 * 1024)
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -33,7 +33,6 @@ typedef enum {
      WorkerEvtFolderRefresh | WorkerEvtConfigChange)
 
 ARRAY_DEF(IdxLastArray, int32_t) //-V658
-ARRAY_DEF(ExtFilterArray, FuriString*, FURI_STRING_OPLIST) //-V658
 
 struct BrowserWorker {
     FuriThread* thread;
@@ -47,7 +46,10 @@ struct BrowserWorker {
     bool skip_assets;
     bool hide_dot_files;
     IdxLastArray_t idx_last;
-    ExtFilterArray_t ext_filter;
+    FuriString* ext_filter;
+
+    StorageDirSnapshot* snapshot;
+    int32_t assets_idx;
 
     void* cb_ctx;
     BrowserWorkerFolderOpenCallback folder_cb;
@@ -79,69 +81,6 @@ static bool browser_path_trim(FuriString* path) {
     }
     return is_root;
 }
-static void browser_parse_ext_filter(ExtFilterArray_t ext_filter, const char* filter_str) {
-    ExtFilterArray_reset(ext_filter);
-    if(!filter_str) {
-        return;
-    }
-
-    size_t len = strlen(filter_str);
-    if(len == 0) {
-        return;
-    }
-
-    size_t str_offset = 0;
-    FuriString* ext_temp = furi_string_alloc();
-    while(1) {
-        size_t ext_len = strcspn(&filter_str[str_offset], "|");
-
-        furi_string_set_strn(ext_temp, &filter_str[str_offset], ext_len);
-        ExtFilterArray_push_back(ext_filter, ext_temp);
-
-        str_offset += ext_len + 1;
-        if(str_offset >= len) {
-            break;
-        }
-    }
-    furi_string_free(ext_temp);
-}
-
-static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, bool is_folder) {
-    // Skip dot files if enabled
-    if(browser->hide_dot_files) {
-        if(furi_string_start_with_str(name, ".")) {
-            return false;
-        }
-    }
-
-    if(is_folder) {
-        // Skip assets folders (if enabled)
-        if(browser->skip_assets) {
-            return (furi_string_cmp_str(name, ASSETS_DIR) == 0) ? (false) : (true);
-        } else {
-            return true;
-        }
-    } else {
-        // Filter files by extension
-        if(ExtFilterArray_size(browser->ext_filter) == 0) {
-            return true;
-        }
-
-        ExtFilterArray_it_t it;
-        for(ExtFilterArray_it(it, browser->ext_filter); !ExtFilterArray_end_p(it);
-            ExtFilterArray_next(it)) {
-            FuriString* ext = *ExtFilterArray_cref(it);
-            if((furi_string_empty(ext)) || (furi_string_cmp_str(ext, "*") == 0)) {
-                return true;
-            }
-            if(furi_string_end_withi(name, ext)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 static bool browser_folder_check_and_switch(FuriString* path) {
     FileInfo file_info;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -167,96 +106,98 @@ static bool browser_folder_check_and_switch(FuriString* path) {
     return is_root;
 }
 
+static bool browser_folder_snapshot(BrowserWorker* browser, FuriString* path) {
+    uint32_t flags = browser->hide_dot_files ? StorageDirSnapshotFlagSkipHidden :
+                                               StorageDirSnapshotFlagNone;
+    FS_Error error = storage_dir_snapshot_load(
+        browser->snapshot,
+        furi_string_get_cstr(path),
+        furi_string_get_cstr(browser->ext_filter),
+        flags);
+    browser->assets_idx = -1;
+
+    if(browser->skip_assets) {
+        const char* name;
+        FileInfo file_info;
+        for(size_t i = 0; storage_dir_snapshot_get(browser->snapshot, i, &file_info, &name); i++) {
+            if(file_info_is_dir(&file_info) && (strcmp(name, ASSETS_DIR) == 0)) {
+                browser->assets_idx = i;
+                break;
+            }
+        }
+    }
+
+    return error == FSE_OK;
+}
+
+static uint32_t browser_folder_get_count(BrowserWorker* browser) {
+    uint32_t count = storage_dir_snapshot_get_count(browser->snapshot);
+    return (browser->assets_idx < 0) ? count : count - 1;
+}
+
+static bool browser_folder_get_item(
+    BrowserWorker* browser,
+    uint32_t idx,
+    FileInfo* file_info,
+    const char** name) {
+    // Hidden assets folder shifts the rest of items
+    if((browser->assets_idx >= 0) && (idx >= (uint32_t)browser->assets_idx)) {
+        idx++;
+    }
+    return storage_dir_snapshot_get(browser->snapshot, idx, file_info, name);
+}
+
 static bool browser_folder_init(
     BrowserWorker* browser,
     FuriString* path,
     FuriString* filename,
     uint32_t* item_cnt,
     int32_t* file_idx) {
-    bool state = false;
-    FileInfo file_info;
-    uint32_t total_files_cnt = 0;
-
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
-
-    char name_temp[FILE_NAME_LEN_MAX];
-    FuriString* name_str;
-    name_str = furi_string_alloc();
+    bool state = browser_folder_snapshot(browser, path);
 
-    *item_cnt = 0;
+    *item_cnt = browser_folder_get_count(browser);
     *file_idx = -1;
 
-    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
-        state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+    if(*item_cnt >= LONG_LOAD_THRESHOLD) {
+        // There are too many files in folder and searching them will take some time
+        // - send callback to app
+        if(browser->long_load_cb) {
+            browser->long_load_cb(browser->cb_ctx);
+        }
+    }
+
+    if(!furi_string_empty(filename)) {
+        const char* name;
+        for(uint32_t i = 0; browser_folder_get_item(browser, i, NULL, &name); i++) {
+            if(furi_string_cmp_str(filename, name) == 0) {
+                *file_idx = i;
                 break;
             }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
-                total_files_cnt++;
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    if(!furi_string_empty(filename)) {
-                        if(furi_string_cmp(name_str, filename) == 0) {
-                            *file_idx = *item_cnt;
-                        }
-                    }
-                    (*item_cnt)++;
-                }
-                if(total_files_cnt == LONG_LOAD_THRESHOLD) {
-                    // There are too many files in folder and counting them will take some time - send callback to app
-                    if(browser->long_load_cb) {
-                        browser->long_load_cb(browser->cb_ctx);
-                    }
-                }
-            }
         }
     }
 
-    furi_string_free(name_str);
-
-    storage_dir_close(directory);
-    storage_file_free(directory);
-
-    furi_record_close(RECORD_STORAGE);
-
     return state;
 }
 
 static bool
     browser_folder_load(BrowserWorker* browser, FuriString* path, uint32_t offset, uint32_t count) {
     FileInfo file_info;
+    const char* name;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
-
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
     uint32_t items_cnt = 0;
 
     do {
-        if(!storage_dir_open(directory, furi_string_get_cstr(path))) {
-            break;
-        }
-
-        items_cnt = 0;
-        while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
+        // Folder changed since it was entered: list its current state
+        if(!storage_dir_snapshot_is_valid(browser->snapshot)) {
+            if(!browser_folder_snapshot(browser, path)) {
                 break;
             }
         }
-        if(items_cnt != offset) {
+
+        if(offset > browser_folder_get_count(browser)) {
             break;
         }
 
@@ -264,24 +205,16 @@ static bool
             browser->list_load_cb(browser->cb_ctx, offset);
         }
 
-        items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(!browser_folder_get_item(browser, offset + items_cnt, &file_info, &name)) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx, name_str, file_info_is_dir(&file_info), false);
-                    }
-                    items_cnt++;
-                }
-            } else {
-                break;
+            furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name);
+            if(browser->list_item_cb) {
+                browser->list_item_cb(
+                    browser->cb_ctx, name_str, file_info_is_dir(&file_info), false);
             }
+            items_cnt++;
         }
         if(browser->list_item_cb) {
             browser->list_item_cb(browser->cb_ctx, NULL, false, true);
@@ -290,11 +223,6 @@ static bool
 
     furi_string_free(name_str);
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
-
-    furi_record_close(RECORD_STORAGE);
-
     return items_cnt == count;
 }
 
@@ -416,9 +344,7 @@ BrowserWorker* file_browser_worker_alloc(
     BrowserWorker* browser = malloc(sizeof(BrowserWorker));
 
     IdxLastArray_init(browser->idx_last);
-    ExtFilterArray_init(browser->ext_filter);
-
-    browser_parse_ext_filter(browser->ext_filter, ext_filter);
+    browser->ext_filter = furi_string_alloc_set(ext_filter ? ext_filter : "");
     browser->skip_assets = skip_assets;
     browser->hide_dot_files = hide_dot_files;
 
@@ -430,6 +356,10 @@ BrowserWorker* file_browser_worker_alloc(
         furi_string_set_str(browser->path_start, base_path);
     }
 
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    browser->snapshot = storage_dir_snapshot_alloc(storage, SNAPSHOT_BUFFER_SIZE);
+    browser->assets_idx = -1;
+
     browser->thread = furi_thread_alloc_ex("BrowserWorker", 2048, browser_worker, browser);
     furi_thread_start(browser->thread);
 
@@ -447,8 +377,11 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_string_free(browser->path_current);
     furi_string_free(browser->path_start);
 
+    storage_dir_snapshot_free(browser->snapshot);
+    furi_record_close(RECORD_STORAGE);
+
     IdxLastArray_clear(browser->idx_last);
-    ExtFilterArray_clear(browser->ext_filter);
+    furi_string_free(browser->ext_filter);
 
     free(browser);
 }
@@ -494,7 +427,7 @@ void file_browser_worker_set_config(
     bool hide_dot_files) {
     furi_check(browser);
     furi_string_set(browser->path_next, path);
-    browser_parse_ext_filter(browser->ext_filter, ext_filter);
+    furi_string_set(browser->ext_filter, ext_filter ? ext_filter : "");
     browser->skip_assets = skip_assets;
     browser->hide_dot_files = hide_dot_files;
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtConfigChange);
@@ -20,10 +20,21 @@ void scene_manager_free(SceneManager* scene_manager) {
 
     // Clear ScaneManager array
     SceneManagerIdStack_clear(scene_manager->scene_id_stack);
+    if(scene_manager->scene_arena) {
+        furi_arena_free(scene_manager->scene_arena);
+    }
     // Free SceneManager structure
     free(scene_manager);
 }
 
+static void scene_manager_exit_scene(SceneManager* scene_manager, uint32_t scene_id) {
+    scene_manager->scene_handlers->on_exit_handlers[scene_id](scene_manager->context);
+    // Scene is gone, so is everything it allocated from arena
+    if(scene_manager->scene_arena) {
+        furi_arena_reset(scene_manager->scene_arena);
+    }
+}
+
 void scene_manager_set_scene_state(SceneManager* scene_manager, uint32_t scene_id, uint32_t state) {
     furi_check(scene_manager);
     furi_check(scene_id < scene_manager->scene_handlers->scene_num);
@@ -99,7 +110,7 @@ void scene_manager_next_scene(SceneManager* scene_manager, uint32_t next_scene_i
     // Check if it is not the first scene
     if(SceneManagerIdStack_size(scene_manager->scene_id_stack) > 0) {
         uint32_t cur_scene_id = *SceneManagerIdStack_back(scene_manager->scene_id_stack);
-        scene_manager->scene_handlers->on_exit_handlers[cur_scene_id](scene_manager->context);
+        scene_manager_exit_scene(scene_manager, cur_scene_id);
     }
     // Add next scene and run on_enter
     SceneManagerIdStack_push_back(scene_manager->scene_id_stack, next_scene_id);
@@ -115,11 +126,11 @@ bool scene_manager_previous_scene(SceneManager* scene_manager) {
 
         // Handle exit from start scene separately
         if(SceneManagerIdStack_size(scene_manager->scene_id_stack) == 0) {
-            scene_manager->scene_handlers->on_exit_handlers[cur_scene_id](scene_manager->context);
+            scene_manager_exit_scene(scene_manager, cur_scene_id);
             return false;
         }
         uint32_t prev_scene_id = *SceneManagerIdStack_back(scene_manager->scene_id_stack);
-        scene_manager->scene_handlers->on_exit_handlers[cur_scene_id](scene_manager->context);
+        scene_manager_exit_scene(scene_manager, cur_scene_id);
         scene_manager->scene_handlers->on_enter_handlers[prev_scene_id](scene_manager->context);
         return true;
     } else {
@@ -153,7 +164,7 @@ bool scene_manager_search_and_switch_to_previous_scene(
         SceneManagerIdStack_next(scene_it);
         SceneManagerIdStack_pop_until(scene_manager->scene_id_stack, scene_it);
 
-        scene_manager->scene_handlers->on_exit_handlers[cur_scene_id](scene_manager->context);
+        scene_manager_exit_scene(scene_manager, cur_scene_id);
         scene_manager->scene_handlers->on_enter_handlers[prev_scene_id](scene_manager->context);
 
         return true;
@@ -221,7 +232,7 @@ bool scene_manager_search_and_switch_to_another_scene(
         // Add next scene
         SceneManagerIdStack_push_back(scene_manager->scene_id_stack, scene_id);
 
-        scene_manager->scene_handlers->on_exit_handlers[cur_scene_id](scene_manager->context);
+        scene_manager_exit_scene(scene_manager, cur_scene_id);
         scene_manager->scene_handlers->on_enter_handlers[scene_id](scene_manager->context);
 
         return true;
@@ -240,6 +251,16 @@ void scene_manager_stop(SceneManager* scene_manager) {
 
     if(SceneManagerIdStack_size(scene_manager->scene_id_stack) > 0) {
         uint32_t cur_scene_id = *SceneManagerIdStack_back(scene_manager->scene_id_stack);
-        scene_manager->scene_handlers->on_exit_handlers[cur_scene_id](scene_manager->context);
+        scene_manager_exit_scene(scene_manager, cur_scene_id);
+    }
+}
+
+FuriArena* scene_manager_get_scene_arena(SceneManager* scene_manager) {
+    furi_check(scene_manager);
+
+    if(!scene_manager->scene_arena) {
+        scene_manager->scene_arena = furi_arena_alloc(SCENE_MANAGER_ARENA_CHUNK_SIZE);
     }
+
+    return scene_manager->scene_arena;
 }
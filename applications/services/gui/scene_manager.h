@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <core/arena.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -184,6 +185,18 @@ uint32_t scene_manager_get_current_scene(SceneManager* scene_manager);
  */
 void scene_manager_stop(SceneManager* scene_manager);
 
+/** Get arena for allocations of current scene
+ *
+ * Memory allocated from the arena is released right after on_exit handler
+ * of the current scene returns, so scene doesn't have to free it piece by
+ * piece.
+ *
+ * @param      scene_manager  SceneManager instance
+ *
+ * @return     pointer to FuriArena instance
+ */
+FuriArena* scene_manager_get_scene_arena(SceneManager* scene_manager);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,8 @@
 #include "scene_manager.h"
 #include <m-array.h>
 
+#define SCENE_MANAGER_ARENA_CHUNK_SIZE (256U)
+
 ARRAY_DEF(SceneManagerIdStack, uint32_t, M_DEFAULT_OPLIST); //-V658
 
 typedef struct {
@@ -18,5 +20,6 @@ struct SceneManager {
     SceneManagerIdStack_t scene_id_stack;
     const SceneManagerHandlers* scene_handlers;
     void* context;
+    FuriArena* scene_arena;
     AppScene scene[];
 };
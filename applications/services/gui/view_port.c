@@ -188,14 +188,17 @@ void view_port_update(ViewPort* view_port) {
         FURI_LOG_W(TAG, "ViewPort lockup: see %s:%d", __FILE__, __LINE__ - 3);
     }
 
-    if(view_port->gui && view_port->is_enabled) gui_update(view_port->gui);
+    if(view_port->gui && view_port->is_enabled) {
+        gui_update_layer(view_port->gui, view_port->layer);
+    }
     furi_mutex_release(view_port->mutex);
 }
 
-void view_port_gui_set(ViewPort* view_port, Gui* gui) {
+void view_port_gui_set(ViewPort* view_port, Gui* gui, GuiLayer layer) {
     furi_check(view_port);
     furi_check(furi_mutex_acquire(view_port->mutex, FuriWaitForever) == FuriStatusOk);
     view_port->gui = gui;
+    view_port->layer = layer;
     furi_check(furi_mutex_release(view_port->mutex) == FuriStatusOk);
 }
 
@@ -10,6 +10,7 @@
 
 struct ViewPort {
     Gui* gui;
+    GuiLayer layer;
     FuriMutex* mutex;
     bool is_enabled;
     ViewPortOrientation orientation;
@@ -30,8 +31,9 @@ struct ViewPort {
  *
  * @param      view_port  ViewPort instance
  * @param      gui        gui instance pointer
+ * @param      layer      GuiLayer view_port is placed at
  */
-void view_port_gui_set(ViewPort* view_port, Gui* gui);
+void view_port_gui_set(ViewPort* view_port, Gui* gui, GuiLayer layer);
 
 /** Process draw call. Calls draw callback.
  *
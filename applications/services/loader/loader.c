@@ -774,6 +774,9 @@ static void loader_do_app_closed(Loader* loader) {
 
     furi_string_free(loader->app.launch_path);
 
+    // Objects cached in pools while app was running are not needed anymore
+    furi_object_pool_trim_all();
+
     FURI_LOG_I(TAG, "Application stopped. Free heap: %zu", memmgr_get_free_heap());
 
     LoaderEvent event;
@@ -5,7 +5,6 @@
 #include <rpc/rpc_i.h>
 #include <storage/filesystem_api_defines.h>
 #include <storage/storage.h>
-#include <lib/toolbox/md5_calc.h>
 #include <lib/toolbox/path.h>
 #include <update_util/int_backup.h>
 #include <toolbox/tar/tar_archive.h>
@@ -232,6 +231,12 @@ static void rpc_system_storage_list_root(const PB_Main* request, void* context)
     rpc_send_and_release(session, &response);
 }
 
+static void rpc_system_storage_md5_print(const StorageDigest* digest, char* md5sum, size_t size) {
+    for(size_t i = 0; i < sizeof(digest->md5) && i * 2 < size; i++) {
+        snprintf(md5sum + i * 2, size - i * 2, "%02x", digest->md5[i]);
+    }
+}
+
 static bool rpc_system_storage_list_filter(
     const PB_Storage_ListRequest* request,
     const FileInfo* fileinfo,
@@ -280,9 +285,7 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     PB_Storage_ListResponse* list = &response.content.storage_list_response;
 
     bool include_md5 = list_request->include_md5;
-    FuriString* md5 = furi_string_alloc();
     FuriString* md5_path = furi_string_alloc();
-    File* file = storage_file_alloc(rpc_storage->api);
 
     bool finish = false;
     int i = 0;
@@ -313,10 +316,13 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
                 if(include_md5 && !file_info_is_dir(&fileinfo)) {
                     furi_string_printf(md5_path, "%s/%s", list_request->path, name); //-V576
 
-                    if(md5_string_calc_file(file, furi_string_get_cstr(md5_path), md5, NULL)) {
-                        char* md5sum = list->file[i].md5sum;
-                        size_t md5sum_size = sizeof(list->file[i].md5sum);
-                        snprintf(md5sum, md5sum_size, "%s", furi_string_get_cstr(md5));
+                    // Cached digests spare rereading unchanged files on every sync
+                    StorageDigest digest;
+                    if(storage_common_digest(
+                           rpc_storage->api, furi_string_get_cstr(md5_path), &digest) ==
+                       FSE_OK) {
+                        rpc_system_storage_md5_print(
+                            &digest, list->file[i].md5sum, sizeof(list->file[i].md5sum));
                     }
                 }
 
@@ -334,11 +340,9 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     response.has_next = false;
     rpc_send_and_release(session, &response);
 
-    furi_string_free(md5);
     furi_string_free(md5_path);
     storage_dir_close(dir);
     storage_file_free(dir);
-    storage_file_free(file);
 }
 
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
@@ -588,11 +592,10 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
         return;
     }
 
-    File* file = storage_file_alloc(rpc_storage->api);
-    FuriString* md5 = furi_string_alloc();
-    FS_Error file_error;
+    StorageDigest digest;
+    FS_Error file_error = storage_common_digest(rpc_storage->api, filename, &digest);
 
-    if(md5_string_calc_file(file, filename, md5, &file_error)) {
+    if(file_error == FSE_OK) {
         PB_Main response = {
             .command_id = request->command_id,
             .command_status = PB_CommandStatus_OK,
@@ -602,16 +605,13 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
 
         char* md5sum = response.content.storage_md5sum_response.md5sum;
         size_t md5sum_size = sizeof(response.content.storage_md5sum_response.md5sum);
-        snprintf(md5sum, md5sum_size, "%s", furi_string_get_cstr(md5));
+        rpc_system_storage_md5_print(&digest, md5sum, md5sum_size);
 
         rpc_send_and_release(session, &response);
     } else {
         rpc_send_and_release_empty(
             session, request->command_id, rpc_system_storage_get_error(file_error));
     }
-
-    furi_string_free(md5);
-    storage_file_free(file);
 }
 
 static void rpc_system_storage_rename_process(const PB_Main* request, void* context) {
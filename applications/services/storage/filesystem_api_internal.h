@@ -145,6 +145,14 @@ typedef struct {
  *      @param name pointer to name buffer, can be NULL
  *      @param name_length name buffer length
  *      @return FS_Error error info
+ *
+ *  @var FS_Common_Api::stat_timestamp
+ *      @brief Same as stat, also gets last modification timestamp,
+ *          timestamps are only comparable within one filesystem
+ *      @param path path to file/directory
+ *      @param fileinfo pointer to file/directory info
+ *      @param timestamp pointer to modification timestamp
+ *      @return FS_Error error info
  * 
  *  @var FS_Common_Api::remove
  *      @brief Remove file/directory from storage, 
@@ -175,6 +183,11 @@ typedef struct {
  */
 typedef struct {
     FS_Error (*const stat)(void* context, const char* path, FileInfo* fileinfo);
+    FS_Error (*const stat_timestamp)(
+        void* context,
+        const char* path,
+        FileInfo* fileinfo,
+        uint32_t* timestamp);
     FS_Error (*const remove)(void* context, const char* path);
     FS_Error (*const mkdir)(void* context, const char* path);
     FS_Error (*const fs_info)(
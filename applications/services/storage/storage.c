@@ -8,6 +8,8 @@
 
 #define STORAGE_TICK 1000
 
+#define STORAGE_QUEUE_SIZE 8
+
 #define ICON_SD_MOUNTED &I_SDcardMounted_11x8
 #define ICON_SD_ERROR   &I_SDcardFail_11x8
 
@@ -33,8 +35,10 @@ static void storage_app_sd_icon_draw_callback(Canvas* canvas, void* context) {
 
 Storage* storage_app_alloc(void) {
     Storage* app = malloc(sizeof(Storage));
-    app->message_queue = furi_message_queue_alloc(8, sizeof(StorageMessage));
+    app->message_queue = furi_message_queue_alloc(STORAGE_QUEUE_SIZE, sizeof(StorageMessage));
     app->pubsub = furi_pubsub_alloc();
+    app->digest_cache = storage_digest_cache_alloc();
+    app->dir_tracker = storage_dir_tracker_alloc();
 
     for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
         storage_data_init(&app->storage[i]);
@@ -69,6 +73,8 @@ void storage_tick(Storage* app) {
     if(app->storage[ST_EXT].status == StorageStatusNotReady && app->sd_gui.enabled == true) {
         app->sd_gui.enabled = false;
         view_port_enabled_set(app->sd_gui.view_port, false);
+        storage_digest_cache_reset(app->digest_cache);
+        storage_dir_tracker_reset(app->dir_tracker);
 
         FURI_LOG_I(TAG, "SD card unmount");
         StorageEvent event = {.type = StorageEventTypeCardUnmount};
@@ -84,6 +90,8 @@ void storage_tick(Storage* app) {
        app->sd_gui.enabled == false) {
         app->sd_gui.enabled = true;
         view_port_enabled_set(app->sd_gui.view_port, true);
+        storage_digest_cache_reset(app->digest_cache);
+        storage_dir_tracker_reset(app->dir_tracker);
 
         if(app->storage[ST_EXT].status == StorageStatusOK) {
             FURI_LOG_I(TAG, "SD card mount");
@@ -102,12 +110,18 @@ int32_t storage_srv(void* p) {
     Storage* app = storage_app_alloc();
     furi_record_create(RECORD_STORAGE, app);
 
-    StorageMessage message;
+    StorageMessage messages[STORAGE_QUEUE_SIZE];
     while(1) {
-        if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
-            storage_process_message(app, &message);
+        uint32_t count = COUNT_OF(messages);
+        if(furi_message_queue_get_batch(app->message_queue, messages, &count, STORAGE_TICK) ==
+           FuriStatusOk) {
+            for(uint32_t i = 0; i < count; i++) {
+                storage_process_message(app, &messages[i]);
+            }
         } else {
             storage_tick(app);
+            // Idle: good time to persist digests
+            storage_digest_cache_save(app->digest_cache, &app->storage[ST_EXT]);
         }
     }
 
@@ -62,6 +62,14 @@ typedef struct {
     StorageEventType type; /**< Type of the event. */
 } StorageEvent;
 
+/**
+ * @brief Digest of file contents.
+ */
+typedef struct {
+    uint8_t md5[16]; /**< MD5 of file contents. */
+    uint32_t crc32; /**< CRC32 of file contents. */
+} StorageDigest;
+
 /**
  * @brief Get the storage pubsub instance.
  *
@@ -263,6 +271,110 @@ bool storage_dir_rewind(File* file);
  */
 bool storage_dir_exists(Storage* storage, const char* path);
 
+/**
+ * @brief Directory snapshot opaque type.
+ *
+ * A snapshot reads a whole directory with a single storage request and keeps the
+ * entries in a packed buffer, so that they can be accessed by index without
+ * reopening the directory.
+ */
+typedef struct StorageDirSnapshot StorageDirSnapshot;
+
+/**
+ * @brief Directory snapshot options.
+ */
+typedef enum {
+    StorageDirSnapshotFlagNone = 0, /**< List entries in directory order. */
+    StorageDirSnapshotFlagSkipHidden = (1 << 0), /**< Skip entries starting with a dot. */
+    StorageDirSnapshotFlagSort = (1 << 1), /**< Directories first, then by name. */
+} StorageDirSnapshotFlag;
+
+/**
+ * @brief Allocate a directory snapshot.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param buffer_size size of the entry buffer, in bytes.
+ * @return pointer to the created instance.
+ */
+StorageDirSnapshot* storage_dir_snapshot_alloc(Storage* storage, size_t buffer_size);
+
+/**
+ * @brief Free the directory snapshot.
+ *
+ * @param snapshot pointer to the snapshot instance to be freed.
+ */
+void storage_dir_snapshot_free(StorageDirSnapshot* snapshot);
+
+/**
+ * @brief Read the directory into the snapshot.
+ *
+ * Extension filter only applies to files, directories are always listed.
+ *
+ * If the directory does not fit into the buffer, the snapshot holds a window of
+ * entries and moves it on access, see storage_dir_snapshot_get(). Such a snapshot
+ * is never sorted. Every window move reads the whole directory again, so going
+ * through all N entries with a window of W entries costs about N * N / W entry
+ * reads. Size the buffer for the expected directory size where possible.
+ *
+ * @param snapshot pointer to the snapshot instance.
+ * @param path pointer to a zero-terminated string containing the directory path.
+ * @param extensions "|" separated list of file extensions, NULL or "*" to list all files.
+ * @param flags combination of StorageDirSnapshotFlag values.
+ * @return FSE_OK if the directory has been successfully read, any other error code on failure.
+ */
+FS_Error storage_dir_snapshot_load(
+    StorageDirSnapshot* snapshot,
+    const char* path,
+    const char* extensions,
+    uint32_t flags);
+
+/**
+ * @brief Check whether the directory has not changed since the snapshot was loaded.
+ *
+ * Writes to files in the directory, creation and removal of its entries, as well
+ * as storage (un)mounting make the snapshot invalid.
+ *
+ * @param snapshot pointer to the snapshot instance.
+ * @return true if the snapshot is loaded and up to date, false otherwise.
+ */
+bool storage_dir_snapshot_is_valid(StorageDirSnapshot* snapshot);
+
+/**
+ * @brief Get the number of entries in the snapshot.
+ *
+ * @param snapshot pointer to the snapshot instance.
+ * @return number of entries that passed the filters.
+ */
+size_t storage_dir_snapshot_get_count(StorageDirSnapshot* snapshot);
+
+/**
+ * @brief Get the snapshot entry.
+ *
+ * Accessing an entry outside of the window of a large directory reads the
+ * directory again, starting from that entry. If that read fails, false is
+ * returned and storage_dir_snapshot_get_error() tells the failure apart from
+ * the end of the directory.
+ *
+ * @param snapshot pointer to the snapshot instance.
+ * @param index entry index.
+ * @param fileinfo pointer to the FileInfo structure to contain the info (may be NULL).
+ * @param name pointer to the entry name, valid until the next snapshot call (may be NULL).
+ * @return true if the entry exists, false otherwise.
+ */
+bool storage_dir_snapshot_get(
+    StorageDirSnapshot* snapshot,
+    size_t index,
+    FileInfo* fileinfo,
+    const char** name);
+
+/**
+ * @brief Get the error of the last directory read done by the snapshot.
+ *
+ * @param snapshot pointer to the snapshot instance.
+ * @return FSE_OK if the last read succeeded, any other error code on failure.
+ */
+FS_Error storage_dir_snapshot_get_error(StorageDirSnapshot* snapshot);
+
 /******************* Common Functions *******************/
 
 /**
@@ -285,6 +397,24 @@ FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t*
  */
 FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo);
 
+/**
+ * @brief Get information about a file or a directory and its last modification timestamp.
+ *
+ * Unlike storage_common_timestamp(), the timestamp belongs to the item itself.
+ * Timestamps are only comparable within one filesystem.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path of the item in question.
+ * @param fileinfo pointer to the FileInfo structure to contain the info (may be NULL).
+ * @param timestamp pointer to a value to contain the modification timestamp.
+ * @return FSE_OK if the info has been successfully received, any other error code on failure.
+ */
+FS_Error storage_common_stat_timestamp(
+    Storage* storage,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp);
+
 /**
  * @brief Remove a file or a directory.
  *
@@ -359,6 +489,20 @@ FS_Error storage_common_fs_info(
     uint64_t* total_space,
     uint64_t* free_space);
 
+/**
+ * @brief Get the digest of a file.
+ *
+ * Digests of files on the external storage are cached by path, size and modification time
+ * and persist across reboots, so repeated requests do not read file contents.
+ * The file must NOT be open for writing at the time of calling this function.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path to the file.
+ * @param digest pointer to the StorageDigest structure to contain the digest.
+ * @return FSE_OK if the digest has been successfully received, any other error code on failure.
+ */
+FS_Error storage_common_digest(Storage* storage, const char* path, StorageDigest* digest);
+
 /**
  * @brief Parse aliases in a path and replace them with the real path.
  *
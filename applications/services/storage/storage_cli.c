@@ -6,7 +6,6 @@
 #include <cli/cli_main_commands.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/dir_walk.h>
-#include <lib/toolbox/md5_calc.h>
 #include <lib/toolbox/strint.h>
 #include <lib/toolbox/tar/tar_archive.h>
 #include <storage/storage.h>
@@ -193,12 +192,14 @@ static void storage_cli_read(PipeSide* pipe, FuriString* path, FuriString* args)
 
         printf("Size: %lu\r\n", (uint32_t)storage_file_size(file));
 
+        // Contents go out in full buffers instead of line by line
+        FuriThreadStdoutBuffering buffering = furi_thread_get_stdout_buffering();
+        furi_thread_set_stdout_buffering(FuriThreadStdoutBufferingBlock);
         do {
             read_size = storage_file_read(file, data, buffer_size);
-            for(size_t i = 0; i < read_size; i++) {
-                printf("%c", data[i]);
-            }
+            furi_thread_stdout_write((const char*)data, read_size);
         } while(read_size > 0);
+        furi_thread_set_stdout_buffering(buffering);
         printf("\r\n");
 
         free(data);
@@ -477,20 +478,18 @@ static void storage_cli_md5(PipeSide* pipe, FuriString* path, FuriString* args)
     UNUSED(pipe);
     UNUSED(args);
     Storage* api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(api);
-    FuriString* md5 = furi_string_alloc();
-    FS_Error file_error;
+    StorageDigest digest;
+    FS_Error file_error = storage_common_digest(api, furi_string_get_cstr(path), &digest);
 
-    if(md5_string_calc_file(file, furi_string_get_cstr(path), md5, &file_error)) {
-        printf("%s\r\n", furi_string_get_cstr(md5));
+    if(file_error == FSE_OK) {
+        for(size_t i = 0; i < sizeof(digest.md5); i++) {
+            printf("%02x", digest.md5[i]);
+        }
+        printf("\r\n");
     } else {
         storage_cli_print_error(file_error);
     }
 
-    furi_string_free(md5);
-    storage_file_close(file);
-    storage_file_free(file);
-
     furi_record_close(RECORD_STORAGE);
 }
 
@@ -0,0 +1,354 @@
+#include "storage_digest.h"
+
+#include <ctype.h>
+
+#define TAG "StorageDigest"
+
+#define STORAGE_DIGEST_CACHE_SIZE    (256u)
+#define STORAGE_DIGEST_CACHE_NAME    "/.digest_cache"
+#define STORAGE_DIGEST_CACHE_PATH    STORAGE_EXT_PATH_PREFIX STORAGE_DIGEST_CACHE_NAME
+#define STORAGE_DIGEST_CACHE_MAGIC   (0x54534744u) // "DGST"
+#define STORAGE_DIGEST_CACHE_VERSION (2u)
+
+/** Two independent hashes of the path, both must match */
+typedef struct {
+    uint32_t fnv;
+    uint32_t jenkins;
+} StorageDigestPathHash;
+
+typedef struct {
+    StorageDigestPathHash path_hash;
+    uint32_t timestamp;
+    uint64_t size;
+    StorageDigest digest;
+    uint32_t used; /**< last use, 0 while digest is being computed */
+} StorageDigestEntry;
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t count;
+} StorageDigestCacheHeader;
+
+struct StorageDigestCache {
+    StorageDigestEntry* entries;
+    size_t count;
+    uint32_t clock;
+    bool loaded;
+    bool dirty;
+};
+
+StorageDigestCache* storage_digest_cache_alloc(void) {
+    StorageDigestCache* cache = malloc(sizeof(StorageDigestCache));
+    return cache;
+}
+
+void storage_digest_cache_free(StorageDigestCache* cache) {
+    furi_check(cache);
+    free(cache->entries);
+    free(cache);
+}
+
+void storage_digest_cache_reset(StorageDigestCache* cache) {
+    furi_check(cache);
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->count = 0;
+    cache->clock = 0;
+    cache->loaded = false;
+    cache->dirty = false;
+}
+
+static const char* storage_digest_cache_fs_path(FuriString* path) {
+    // Only external storage is cached, see storage_digest_cache_is_usable
+    return furi_string_get_cstr(path) + strlen(STORAGE_EXT_PATH_PREFIX);
+}
+
+static bool storage_digest_cache_is_usable(StorageData* storage, FuriString* path) {
+    if(storage_data_status(storage) != StorageStatusOK) return false;
+    if(!furi_string_start_with(path, STORAGE_EXT_PATH_PREFIX "/")) return false;
+    // Cache file itself changes behind storage's back
+    return !storage->fs_api->common.equivalent_path(
+        storage_digest_cache_fs_path(path), STORAGE_DIGEST_CACHE_NAME);
+}
+
+static StorageDigestPathHash storage_digest_cache_hash(StorageData* storage, FuriString* path) {
+    // Same file must hash the same on case insensitive filesystems
+    bool fold_case = storage->fs_api->common.equivalent_path("/A", "/a");
+
+    // FNV-1a and Jenkins one-at-a-time
+    StorageDigestPathHash hash = {.fnv = 0x811c9dc5u};
+    for(const char* c = storage_digest_cache_fs_path(path); *c; c++) {
+        uint8_t value = fold_case ? tolower((uint8_t)*c) : (uint8_t)*c;
+        hash.fnv ^= value;
+        hash.fnv *= 0x01000193u;
+        hash.jenkins += value;
+        hash.jenkins += hash.jenkins << 10;
+        hash.jenkins ^= hash.jenkins >> 6;
+    }
+    hash.jenkins += hash.jenkins << 3;
+    hash.jenkins ^= hash.jenkins >> 11;
+    hash.jenkins += hash.jenkins << 15;
+
+    return hash;
+}
+
+static StorageDigestEntry*
+    storage_digest_cache_find(StorageDigestCache* cache, StorageDigestPathHash hash) {
+    for(size_t i = 0; i < cache->count; i++) {
+        StorageDigestEntry* entry = &cache->entries[i];
+        if(entry->path_hash.fnv == hash.fnv && entry->path_hash.jenkins == hash.jenkins) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void storage_digest_cache_remove(StorageDigestCache* cache, StorageDigestEntry* entry) {
+    *entry = cache->entries[--cache->count];
+}
+
+static StorageDigestEntry* storage_digest_cache_add(StorageDigestCache* cache) {
+    if(!cache->entries) {
+        cache->entries = malloc(sizeof(StorageDigestEntry) * STORAGE_DIGEST_CACHE_SIZE);
+    }
+
+    if(cache->count == STORAGE_DIGEST_CACHE_SIZE) {
+        // Evict least recently used
+        StorageDigestEntry* oldest = &cache->entries[0];
+        for(size_t i = 1; i < cache->count; i++) {
+            if(cache->entries[i].used < oldest->used) oldest = &cache->entries[i];
+        }
+        storage_digest_cache_remove(cache, oldest);
+    }
+
+    return &cache->entries[cache->count++];
+}
+
+/* Cache file is accessed through filesystem api directly: it must not move
+ * storage timestamp or produce file close events */
+
+static bool storage_digest_cache_file_open(
+    StorageData* storage,
+    File* file,
+    FuriString* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    if(storage_path_already_open(path, storage)) return false;
+
+    storage_push_storage_file(file, path, storage);
+    if(!storage->fs_api->file.open(
+           storage, file, STORAGE_DIGEST_CACHE_NAME, access_mode, open_mode)) {
+        storage->fs_api->file.close(storage, file);
+        storage_pop_storage_file(file, storage);
+        return false;
+    }
+
+    return true;
+}
+
+static void storage_digest_cache_file_close(StorageData* storage, File* file) {
+    storage->fs_api->file.close(storage, file);
+    storage_pop_storage_file(file, storage);
+}
+
+static void storage_digest_cache_load(StorageDigestCache* cache, StorageData* storage) {
+    cache->loaded = true;
+
+    FuriString* path = furi_string_alloc_set(STORAGE_DIGEST_CACHE_PATH);
+    File file = {.type = FileTypeOpenFile};
+
+    if(storage_digest_cache_file_open(storage, &file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        StorageDigestCacheHeader header;
+        size_t entries_size = 0;
+        bool valid = false;
+
+        do {
+            if(storage->fs_api->file.read(storage, &file, &header, sizeof(header)) !=
+               sizeof(header))
+                break;
+            if(header.magic != STORAGE_DIGEST_CACHE_MAGIC) break;
+            if(header.version != STORAGE_DIGEST_CACHE_VERSION) break;
+            if(header.count > STORAGE_DIGEST_CACHE_SIZE) break;
+
+            entries_size = sizeof(StorageDigestEntry) * header.count;
+            cache->entries = malloc(sizeof(StorageDigestEntry) * STORAGE_DIGEST_CACHE_SIZE);
+            if(storage->fs_api->file.read(storage, &file, cache->entries, entries_size) !=
+               entries_size)
+                break;
+
+            valid = true;
+        } while(false);
+
+        if(valid) {
+            cache->count = header.count;
+            for(size_t i = 0; i < cache->count; i++) {
+                cache->clock = MAX(cache->clock, cache->entries[i].used);
+            }
+        } else {
+            FURI_LOG_W(TAG, "Discarding invalid cache file");
+            free(cache->entries);
+            cache->entries = NULL;
+        }
+
+        storage_digest_cache_file_close(storage, &file);
+    }
+
+    furi_string_free(path);
+
+    FURI_LOG_D(TAG, "Loaded %zu entries", cache->count);
+}
+
+void storage_digest_cache_save(StorageDigestCache* cache, StorageData* storage) {
+    furi_check(cache);
+    furi_check(storage);
+
+    if(!cache->dirty || storage_data_status(storage) != StorageStatusOK) return;
+
+    FuriString* path = furi_string_alloc_set(STORAGE_DIGEST_CACHE_PATH);
+    File file = {.type = FileTypeOpenFile};
+
+    if(storage_digest_cache_file_open(storage, &file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        // Pending entries have no digest yet, keep them at the tail
+        size_t count = 0;
+        for(size_t i = 0; i < cache->count; i++) {
+            if(cache->entries[i].used) {
+                StorageDigestEntry entry = cache->entries[i];
+                cache->entries[i] = cache->entries[count];
+                cache->entries[count++] = entry;
+            }
+        }
+
+        StorageDigestCacheHeader header = {
+            .magic = STORAGE_DIGEST_CACHE_MAGIC,
+            .version = STORAGE_DIGEST_CACHE_VERSION,
+            .count = count,
+        };
+        size_t entries_size = sizeof(StorageDigestEntry) * count;
+
+        bool saved =
+            storage->fs_api->file.write(storage, &file, &header, sizeof(header)) ==
+                sizeof(header) &&
+            storage->fs_api->file.write(storage, &file, cache->entries, entries_size) ==
+                entries_size;
+        storage_digest_cache_file_close(storage, &file);
+
+        if(saved) {
+            cache->dirty = false;
+            FURI_LOG_D(TAG, "Saved %zu entries", count);
+        } else {
+            FURI_LOG_E(TAG, "Failed to save cache");
+        }
+    }
+
+    furi_string_free(path);
+}
+
+static bool storage_digest_cache_stat(
+    StorageData* storage,
+    FuriString* path,
+    uint64_t* size,
+    uint32_t* timestamp) {
+    if(storage_path_already_open(path, storage)) return false;
+
+    FileInfo fileinfo;
+    if(storage->fs_api->common.stat_timestamp(
+           storage, storage_digest_cache_fs_path(path), &fileinfo, timestamp) != FSE_OK) {
+        return false;
+    }
+    if(file_info_is_dir(&fileinfo)) return false;
+
+    *size = fileinfo.size;
+    return true;
+}
+
+bool storage_digest_cache_lookup(
+    StorageDigestCache* cache,
+    StorageData* storage,
+    FuriString* path,
+    StorageDigest* digest) {
+    furi_check(cache);
+    furi_check(storage);
+    furi_check(path);
+    furi_check(digest);
+
+    if(!storage_digest_cache_is_usable(storage, path)) return false;
+    if(!cache->loaded) storage_digest_cache_load(cache, storage);
+
+    uint64_t size;
+    uint32_t timestamp;
+    if(!storage_digest_cache_stat(storage, path, &size, &timestamp)) return false;
+
+    StorageDigestPathHash hash = storage_digest_cache_hash(storage, path);
+    StorageDigestEntry* entry = storage_digest_cache_find(cache, hash);
+
+    if(entry && entry->used && entry->size == size && entry->timestamp == timestamp) {
+        *digest = entry->digest;
+        entry->used = ++cache->clock;
+        return true;
+    }
+
+    if(!entry) {
+        entry = storage_digest_cache_add(cache);
+        entry->path_hash = hash;
+    } else if(entry->used) {
+        cache->dirty = true;
+    }
+
+    entry->size = size;
+    entry->timestamp = timestamp;
+    entry->used = 0;
+
+    return false;
+}
+
+void storage_digest_cache_store(
+    StorageDigestCache* cache,
+    StorageData* storage,
+    FuriString* path,
+    const StorageDigest* digest) {
+    furi_check(cache);
+    furi_check(storage);
+    furi_check(path);
+    furi_check(digest);
+
+    if(!storage_digest_cache_is_usable(storage, path)) return;
+
+    // Pending entry is gone if file was modified since lookup
+    StorageDigestEntry* entry =
+        storage_digest_cache_find(cache, storage_digest_cache_hash(storage, path));
+    if(!entry || entry->used) return;
+
+    uint64_t size;
+    uint32_t timestamp;
+    if(!storage_digest_cache_stat(storage, path, &size, &timestamp) || entry->size != size ||
+       entry->timestamp != timestamp) {
+        storage_digest_cache_remove(cache, entry);
+        return;
+    }
+
+    entry->digest = *digest;
+    entry->used = ++cache->clock;
+    cache->dirty = true;
+}
+
+void storage_digest_cache_invalidate(
+    StorageDigestCache* cache,
+    StorageData* storage,
+    FuriString* path) {
+    furi_check(cache);
+    furi_check(storage);
+    furi_check(path);
+
+    if(!storage_digest_cache_is_usable(storage, path)) return;
+    // Entry may still be in cache file
+    if(!cache->loaded) storage_digest_cache_load(cache, storage);
+
+    StorageDigestEntry* entry =
+        storage_digest_cache_find(cache, storage_digest_cache_hash(storage, path));
+    if(entry) {
+        if(entry->used) cache->dirty = true;
+        storage_digest_cache_remove(cache, entry);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <furi.h>
+#include "storage.h"
+#include "storage_glue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Persistent file digest cache
+ *
+ * Maps path, size and modification time of files on external storage to
+ * their digests. Paths are not stored: entries are keyed by two independent
+ * 32-bit path hashes. Lives in storage thread: writers invalidate entries while
+ * clients compute missing digests in their own threads.
+ */
+typedef struct StorageDigestCache StorageDigestCache;
+
+StorageDigestCache* storage_digest_cache_alloc(void);
+
+void storage_digest_cache_free(StorageDigestCache* cache);
+
+/** Drop all entries, cache file is loaded again on next lookup */
+void storage_digest_cache_reset(StorageDigestCache* cache);
+
+/** Find digest of unchanged file
+ *
+ * On miss, file key is remembered so that digest computed by client can be
+ * stored unless file is modified in the meantime.
+ *
+ * @param path full path, including vfs prefix
+ * @return true if digest was found
+ */
+bool storage_digest_cache_lookup(
+    StorageDigestCache* cache,
+    StorageData* storage,
+    FuriString* path,
+    StorageDigest* digest);
+
+/** Store digest for a file that was looked up before */
+void storage_digest_cache_store(
+    StorageDigestCache* cache,
+    StorageData* storage,
+    FuriString* path,
+    const StorageDigest* digest);
+
+/** Forget digest of a file that is about to be modified or removed */
+void storage_digest_cache_invalidate(
+    StorageDigestCache* cache,
+    StorageData* storage,
+    FuriString* path);
+
+/** Write modified cache to storage */
+void storage_digest_cache_save(StorageDigestCache* cache, StorageData* storage);
+
+#ifdef __cplusplus
+}
+#endif
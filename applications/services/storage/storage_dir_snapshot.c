@@ -0,0 +1,176 @@
+#include "storage_dir_snapshot.h"
+
+#include <ctype.h>
+
+#define STORAGE_DIR_TRACKER_SLOTS (32u)
+
+#define STORAGE_DIR_SNAPSHOT_ALIGN(x) (((x) + 7u) & ~7u)
+
+struct StorageDirTracker {
+    uint32_t slots[STORAGE_DIR_TRACKER_SLOTS];
+    uint32_t epoch;
+};
+
+StorageDirTracker* storage_dir_tracker_alloc(void) {
+    StorageDirTracker* tracker = malloc(sizeof(StorageDirTracker));
+    return tracker;
+}
+
+void storage_dir_tracker_free(StorageDirTracker* tracker) {
+    furi_check(tracker);
+    free(tracker);
+}
+
+void storage_dir_tracker_reset(StorageDirTracker* tracker) {
+    furi_check(tracker);
+    tracker->epoch++;
+}
+
+static uint32_t
+    storage_dir_tracker_slot(StorageData* storage, const char* path, size_t path_length) {
+    // Same directory must hash the same on case insensitive filesystems
+    bool fold_case = storage->fs_api->common.equivalent_path("/A", "/a");
+
+    // FNV-1a
+    uint32_t hash = 0x811c9dc5u;
+    for(size_t i = 0; i < path_length; i++) {
+        hash ^= (uint8_t)(fold_case ? tolower((uint8_t)path[i]) : path[i]);
+        hash *= 0x01000193u;
+    }
+    return hash % STORAGE_DIR_TRACKER_SLOTS;
+}
+
+void storage_dir_tracker_touch(
+    StorageDirTracker* tracker,
+    StorageData* storage,
+    FuriString* path) {
+    furi_check(tracker);
+
+    const char* path_cstr = furi_string_get_cstr(path);
+    size_t path_length = furi_string_size(path);
+    tracker->slots[storage_dir_tracker_slot(storage, path_cstr, path_length)]++;
+
+    // Parent directory listing changes as well
+    size_t parent_length = furi_string_search_rchar(path, '/');
+    if(parent_length != FURI_STRING_FAILURE && parent_length > 0) {
+        tracker->slots[storage_dir_tracker_slot(storage, path_cstr, parent_length)]++;
+    }
+}
+
+uint32_t
+    storage_dir_tracker_get(StorageDirTracker* tracker, StorageData* storage, FuriString* path) {
+    furi_check(tracker);
+
+    // Both parts only grow, so does the sum
+    uint32_t slot =
+        storage_dir_tracker_slot(storage, furi_string_get_cstr(path), furi_string_size(path));
+    return tracker->slots[slot] + tracker->epoch;
+}
+
+static bool storage_dir_snapshot_match_extension(const char* name, const char* extensions) {
+    size_t name_length = strlen(name);
+
+    while(true) {
+        size_t ext_length = strcspn(extensions, "|");
+        if(ext_length == 0 || (ext_length == 1 && extensions[0] == '*')) return true;
+
+        if(ext_length <= name_length &&
+           strncasecmp(name + name_length - ext_length, extensions, ext_length) == 0) {
+            return true;
+        }
+
+        if(extensions[ext_length] == '\0') break;
+        extensions += ext_length + 1;
+    }
+
+    return false;
+}
+
+bool storage_dir_snapshot_filter(
+    const char* name,
+    const FileInfo* fileinfo,
+    const char* extensions,
+    uint32_t flags) {
+    if(name[0] == '\0') return false;
+    if((flags & StorageDirSnapshotFlagSkipHidden) && name[0] == '.') return false;
+
+    // Directories are always listed so that they can be entered
+    if(file_info_is_dir(fileinfo) || !extensions) return true;
+
+    return storage_dir_snapshot_match_extension(name, extensions);
+}
+
+bool storage_dir_snapshot_push(
+    uint8_t* buffer,
+    size_t buffer_size,
+    StorageDirSnapshotWindow* window,
+    const char* name,
+    const FileInfo* fileinfo) {
+    size_t name_length = strlen(name);
+    size_t record_size =
+        STORAGE_DIR_SNAPSHOT_ALIGN(sizeof(StorageDirSnapshotEntry) + name_length + 1);
+    size_t index_size = (window->count + 1) * sizeof(uint32_t);
+
+    if(window->used + record_size + index_size > buffer_size) return false;
+
+    StorageDirSnapshotEntry* entry = (StorageDirSnapshotEntry*)(buffer + window->used);
+    entry->size = fileinfo->size;
+    entry->flags = fileinfo->flags;
+    entry->name_length = name_length;
+    memcpy(entry->name, name, name_length + 1);
+
+    uint32_t* index = (uint32_t*)(buffer + buffer_size);
+    index[-1 - (int32_t)window->count] = window->used;
+
+    window->used += record_size;
+    window->count++;
+
+    return true;
+}
+
+static int storage_dir_snapshot_compare(
+    const StorageDirSnapshotEntry* a,
+    const StorageDirSnapshotEntry* b) {
+    bool a_dir = a->flags & FSF_DIRECTORY;
+    bool b_dir = b->flags & FSF_DIRECTORY;
+    if(a_dir != b_dir) return a_dir ? -1 : 1;
+
+    int result = strcasecmp(a->name, b->name);
+    return result ? result : strcmp(a->name, b->name);
+}
+
+void storage_dir_snapshot_finish(
+    uint8_t* buffer,
+    size_t buffer_size,
+    StorageDirSnapshotWindow* window,
+    uint32_t flags) {
+    uint32_t* index = (uint32_t*)(buffer + buffer_size) - window->count;
+
+    // Offsets were pushed from the end of the buffer backwards
+    for(size_t i = 0, j = window->count; i + 1 < j; i++, j--) {
+        uint32_t tmp = index[i];
+        index[i] = index[j - 1];
+        index[j - 1] = tmp;
+    }
+
+    // Order of a partial listing would depend on the window
+    window->sorted = (flags & StorageDirSnapshotFlagSort) && window->offset == 0 &&
+                     window->count == window->total;
+    if(!window->sorted) return;
+
+    // Shell sort: no recursion on storage thread stack and no qsort context
+    for(size_t gap = window->count / 2; gap > 0; gap /= 2) {
+        for(size_t i = gap; i < window->count; i++) {
+            uint32_t offset = index[i];
+            const StorageDirSnapshotEntry* entry = (StorageDirSnapshotEntry*)(buffer + offset);
+            size_t j = i;
+            for(; j >= gap; j -= gap) {
+                const StorageDirSnapshotEntry* prev =
+                    (StorageDirSnapshotEntry*)(buffer + index[j - gap]);
+                if(storage_dir_snapshot_compare(prev, entry) <= 0) break;
+                index[j] = index[j - gap];
+            }
+            index[j] = offset;
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <furi.h>
+#include "storage.h"
+#include "storage_glue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STORAGE_DIR_SNAPSHOT_NAME_LENGTH (256u)
+
+/**
+ * Directory snapshot internals
+ *
+ * Snapshot buffer is filled by storage thread in one request: entry records
+ * grow from the start of the buffer, offsets of records grow from the end.
+ * Once filled, offsets are reversed so they form a plain array that ends at
+ * the end of the buffer.
+ */
+typedef struct {
+    uint64_t size;
+    uint32_t flags;
+    uint16_t name_length;
+    char name[];
+} StorageDirSnapshotEntry;
+
+/** Part of the directory stored in snapshot buffer */
+typedef struct {
+    size_t offset; /**< index of first stored entry */
+    size_t count; /**< number of stored entries */
+    size_t total; /**< number of matching entries in directory */
+    size_t used; /**< bytes taken by records */
+    uint32_t generation; /**< directory generation at the time of reading */
+    bool sorted;
+} StorageDirSnapshotWindow;
+
+/** Get array of record offsets, valid once buffer is filled */
+static inline const uint32_t* storage_dir_snapshot_index(
+    const uint8_t* buffer,
+    size_t buffer_size,
+    const StorageDirSnapshotWindow* window) {
+    return (const uint32_t*)(buffer + buffer_size) - window->count;
+}
+
+/**
+ * Directory generation tracker
+ *
+ * Lives in storage thread. Every directory hashes into one of the counters,
+ * writers bump counters of the modified path and its parent. Collisions only
+ * cause spurious invalidation.
+ */
+typedef struct StorageDirTracker StorageDirTracker;
+
+StorageDirTracker* storage_dir_tracker_alloc(void);
+
+void storage_dir_tracker_free(StorageDirTracker* tracker);
+
+/** Invalidate all directories, used when storage is (un)mounted or formatted */
+void storage_dir_tracker_reset(StorageDirTracker* tracker);
+
+/** Invalidate path and its parent directory
+ *
+ * @param path full path, including vfs prefix
+ */
+void storage_dir_tracker_touch(StorageDirTracker* tracker, StorageData* storage, FuriString* path);
+
+/** Get generation of directory
+ *
+ * @param path full path, including vfs prefix
+ */
+uint32_t
+    storage_dir_tracker_get(StorageDirTracker* tracker, StorageData* storage, FuriString* path);
+
+/** Check whether entry passes snapshot filters
+ *
+ * @param extensions "|" separated list of file extensions, NULL or "*" to pass all files
+ * @param flags StorageDirSnapshotFlag bits
+ */
+bool storage_dir_snapshot_filter(
+    const char* name,
+    const FileInfo* fileinfo,
+    const char* extensions,
+    uint32_t flags);
+
+/** Append entry to snapshot buffer
+ *
+ * @return false if entry does not fit
+ */
+bool storage_dir_snapshot_push(
+    uint8_t* buffer,
+    size_t buffer_size,
+    StorageDirSnapshotWindow* window,
+    const char* name,
+    const FileInfo* fileinfo);
+
+/** Turn offsets into plain array and sort entries if requested and possible */
+void storage_dir_snapshot_finish(
+    uint8_t* buffer,
+    size_t buffer_size,
+    StorageDirSnapshotWindow* window,
+    uint32_t flags);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,8 @@
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/dir_walk.h>
 #include "toolbox/path.h"
+#include <toolbox/crc32_calc.h>
+#include <mbedtls/md5.h>
 
 #define MAX_NAME_LENGTH  256
 #define MAX_EXT_LEN      16
@@ -426,6 +428,151 @@ bool storage_dir_exists(Storage* storage, const char* path) {
 
     return exist;
 }
+
+/****************** DIR SNAPSHOT ******************/
+
+struct StorageDirSnapshot {
+    Storage* storage;
+    uint8_t* buffer;
+    size_t buffer_size;
+    FuriString* path;
+    FuriString* extensions;
+    uint32_t flags;
+    StorageDirSnapshotWindow window;
+    FS_Error error;
+    bool loaded;
+};
+
+StorageDirSnapshot* storage_dir_snapshot_alloc(Storage* storage, size_t buffer_size) {
+    furi_check(storage);
+    // Offset index is kept at the end of the buffer
+    buffer_size &= ~(sizeof(uint32_t) - 1);
+    furi_check(buffer_size >= sizeof(StorageDirSnapshotEntry) + STORAGE_DIR_SNAPSHOT_NAME_LENGTH);
+
+    StorageDirSnapshot* snapshot = malloc(sizeof(StorageDirSnapshot));
+    snapshot->storage = storage;
+    snapshot->buffer = malloc(buffer_size);
+    snapshot->buffer_size = buffer_size;
+    snapshot->path = furi_string_alloc();
+    snapshot->extensions = furi_string_alloc();
+
+    return snapshot;
+}
+
+void storage_dir_snapshot_free(StorageDirSnapshot* snapshot) {
+    furi_check(snapshot);
+
+    furi_string_free(snapshot->extensions);
+    furi_string_free(snapshot->path);
+    free(snapshot->buffer);
+    free(snapshot);
+}
+
+static FS_Error storage_dir_snapshot_load_window(StorageDirSnapshot* snapshot, size_t offset) {
+    Storage* storage = snapshot->storage;
+    S_API_PROLOGUE;
+
+    snapshot->window.offset = offset;
+
+    SAData data = {
+        .dsnapshot = {
+            .path = furi_string_get_cstr(snapshot->path),
+            .extensions = furi_string_empty(snapshot->extensions) ?
+                              NULL :
+                              furi_string_get_cstr(snapshot->extensions),
+            .flags = snapshot->flags,
+            .buffer = snapshot->buffer,
+            .buffer_size = snapshot->buffer_size,
+            .window = &snapshot->window,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandDirSnapshotLoad);
+    S_API_EPILOGUE;
+
+    snapshot->error = return_data.error_value;
+    snapshot->loaded = return_data.error_value == FSE_OK;
+    return S_RETURN_ERROR;
+}
+
+FS_Error storage_dir_snapshot_load(
+    StorageDirSnapshot* snapshot,
+    const char* path,
+    const char* extensions,
+    uint32_t flags) {
+    furi_check(snapshot);
+    furi_check(path);
+
+    furi_string_set(snapshot->path, path);
+    furi_string_set(snapshot->extensions, extensions ? extensions : "");
+    snapshot->flags = flags;
+
+    return storage_dir_snapshot_load_window(snapshot, 0);
+}
+
+bool storage_dir_snapshot_is_valid(StorageDirSnapshot* snapshot) {
+    furi_check(snapshot);
+    if(!snapshot->loaded) return false;
+
+    Storage* storage = snapshot->storage;
+    S_API_PROLOGUE;
+
+    StorageDirSnapshotWindow window = {0};
+    SAData data = {
+        .dsnapshot = {
+            .path = furi_string_get_cstr(snapshot->path),
+            .window = &window,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandDirSnapshotGeneration);
+    S_API_EPILOGUE;
+
+    return return_data.error_value == FSE_OK && window.generation == snapshot->window.generation;
+}
+
+size_t storage_dir_snapshot_get_count(StorageDirSnapshot* snapshot) {
+    furi_check(snapshot);
+    return snapshot->loaded ? snapshot->window.total : 0;
+}
+
+FS_Error storage_dir_snapshot_get_error(StorageDirSnapshot* snapshot) {
+    furi_check(snapshot);
+    return snapshot->error;
+}
+
+bool storage_dir_snapshot_get(
+    StorageDirSnapshot* snapshot,
+    size_t index,
+    FileInfo* fileinfo,
+    const char** name) {
+    furi_check(snapshot);
+
+    StorageDirSnapshotWindow* window = &snapshot->window;
+    if(!snapshot->loaded || index >= window->total) return false;
+
+    if(index < window->offset || index >= window->offset + window->count) {
+        if(storage_dir_snapshot_load_window(snapshot, index) != FSE_OK) return false;
+        // Directory could shrink in the meantime
+        if(window->count == 0) return false;
+    }
+
+    const uint32_t* entry_index =
+        storage_dir_snapshot_index(snapshot->buffer, snapshot->buffer_size, window);
+    const StorageDirSnapshotEntry* entry =
+        (const StorageDirSnapshotEntry*)(snapshot->buffer + entry_index[index - window->offset]);
+
+    if(fileinfo) {
+        fileinfo->size = entry->size;
+        fileinfo->flags = entry->flags;
+    }
+    if(name) {
+        *name = entry->name;
+    }
+
+    return true;
+}
+
 /****************** COMMON ******************/
 
 FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t* timestamp) {
@@ -460,6 +607,28 @@ FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* filei
     return S_RETURN_ERROR;
 }
 
+FS_Error storage_common_stat_timestamp(
+    Storage* storage,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp) {
+    furi_check(storage);
+    furi_check(timestamp);
+
+    S_API_PROLOGUE;
+    SAData data = {
+        .cstat = {
+            .path = path,
+            .fileinfo = fileinfo,
+            .timestamp = timestamp,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonStat);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
 FS_Error storage_common_remove(Storage* storage, const char* path) {
     furi_check(storage);
 
@@ -778,6 +947,90 @@ FS_Error storage_common_fs_info(
     return S_RETURN_ERROR;
 }
 
+static bool storage_common_digest_lookup(Storage* storage, const char* path, StorageDigest* digest) {
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .cdigest = {
+            .path = path,
+            .digest = digest,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonDigestLookup);
+    S_API_EPILOGUE;
+    return S_RETURN_BOOL;
+}
+
+static void
+    storage_common_digest_store(Storage* storage, const char* path, StorageDigest* digest) {
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .cdigest = {
+            .path = path,
+            .digest = digest,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonDigestStore);
+    S_API_EPILOGUE;
+}
+
+static FS_Error storage_file_digest(File* file, StorageDigest* digest) {
+    uint8_t* data = malloc(FILE_BUFFER_SIZE);
+    mbedtls_md5_context* md5_ctx = malloc(sizeof(mbedtls_md5_context));
+    mbedtls_md5_init(md5_ctx);
+    mbedtls_md5_starts(md5_ctx);
+    digest->crc32 = 0;
+
+    FS_Error error;
+    while(true) {
+        size_t read_size = storage_file_read(file, data, FILE_BUFFER_SIZE);
+        error = storage_file_get_error(file);
+        if(error != FSE_OK || read_size == 0) break;
+
+        mbedtls_md5_update(md5_ctx, data, read_size);
+        digest->crc32 = crc32_calc_buffer(digest->crc32, data, read_size);
+    }
+
+    mbedtls_md5_finish(md5_ctx, digest->md5);
+    mbedtls_md5_free(md5_ctx);
+    free(md5_ctx);
+    free(data);
+
+    return error;
+}
+
+FS_Error storage_common_digest(Storage* storage, const char* path, StorageDigest* digest) {
+    furi_check(storage);
+    furi_check(path);
+    furi_check(digest);
+
+    if(storage_common_digest_lookup(storage, path, digest)) {
+        return FSE_OK;
+    }
+
+    // Digest is computed here, storage thread only keeps the cache
+    File* file = storage_file_alloc(storage);
+    FS_Error error;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        error = storage_file_digest(file, digest);
+    } else {
+        error = storage_file_get_error(file);
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    if(error == FSE_OK) {
+        storage_common_digest_store(storage, path, digest);
+    }
+
+    return error;
+}
+
 void storage_common_resolve_path_and_ensure_app_directory(Storage* storage, FuriString* path) {
     furi_check(storage);
 
@@ -9,18 +9,21 @@ void storage_file_init(StorageFile* obj) {
     obj->file = NULL;
     obj->file_data = NULL;
     obj->path = furi_string_alloc();
+    obj->modified = false;
 }
 
 void storage_file_init_set(StorageFile* obj, const StorageFile* src) {
     obj->file = src->file;
     obj->file_data = src->file_data;
     obj->path = furi_string_alloc_set(src->path);
+    obj->modified = src->modified;
 }
 
 void storage_file_set(StorageFile* obj, const StorageFile* src) { //-V524
     obj->file = src->file;
     obj->file_data = src->file_data;
     furi_string_set(obj->path, src->path);
+    obj->modified = src->modified;
 }
 
 void storage_file_clear(StorageFile* obj) {
@@ -126,6 +129,18 @@ void* storage_get_storage_file_data(const File* file, StorageData* storage) {
     return storage_file_ref->file_data;
 }
 
+void storage_set_storage_file_modified(const File* file, StorageData* storage) {
+    StorageFile* storage_file_ref = storage_get_file(file, storage);
+    furi_check(storage_file_ref != NULL);
+    storage_file_ref->modified = true;
+}
+
+FuriString* storage_get_storage_file_modified_path(const File* file, StorageData* storage) {
+    StorageFile* storage_file_ref = storage_get_file(file, storage);
+    furi_check(storage_file_ref != NULL);
+    return storage_file_ref->modified ? storage_file_ref->path : NULL;
+}
+
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage) {
     StorageFile* storage_file = StorageFileList_push_new(storage->files);
     file->file_id = (uint32_t)storage_file;
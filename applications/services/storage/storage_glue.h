@@ -25,6 +25,7 @@ typedef struct {
     File* file;
     void* file_data;
     FuriString* path;
+    bool modified;
 } StorageFile;
 
 typedef enum {
@@ -70,6 +71,10 @@ bool storage_path_already_open(FuriString* path, StorageData* storage_data);
 void storage_set_storage_file_data(const File* file, void* file_data, StorageData* storage);
 void* storage_get_storage_file_data(const File* file, StorageData* storage);
 
+void storage_set_storage_file_modified(const File* file, StorageData* storage);
+/** Get path of the file if it was written since open, NULL otherwise */
+FuriString* storage_get_storage_file_modified_path(const File* file, StorageData* storage);
+
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage);
 bool storage_pop_storage_file(File* file, StorageData* storage);
 
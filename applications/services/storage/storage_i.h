@@ -4,6 +4,8 @@
 #include <gui/gui.h>
 #include "storage_glue.h"
 #include "storage_sd_api.h"
+#include "storage_digest.h"
+#include "storage_dir_snapshot.h"
 #include "filesystem_api_internal.h"
 
 #ifdef __cplusplus
@@ -25,6 +27,8 @@ struct Storage {
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    StorageDigestCache* digest_cache;
+    StorageDirTracker* dir_tracker;
 };
 
 #ifdef __cplusplus
@@ -1,6 +1,7 @@
 #pragma once
 #include <furi.h>
 #include <toolbox/api_lock.h>
+#include "storage_dir_snapshot.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,6 +46,16 @@ typedef struct {
     uint16_t name_length;
 } SADataDRead;
 
+typedef struct {
+    const char* path;
+    const char* extensions;
+    uint32_t flags;
+    uint8_t* buffer;
+    size_t buffer_size;
+    StorageDirSnapshotWindow* window;
+    FuriThreadId thread_id;
+} SADataDSnapshot;
+
 typedef struct {
     const char* path;
     uint32_t* timestamp;
@@ -54,6 +65,7 @@ typedef struct {
 typedef struct {
     const char* path;
     FileInfo* fileinfo;
+    uint32_t* timestamp;
     FuriThreadId thread_id;
 } SADataCStat;
 
@@ -76,6 +88,12 @@ typedef struct {
     FuriThreadId thread_id;
 } SADataCEquivPath;
 
+typedef struct {
+    const char* path;
+    StorageDigest* digest;
+    FuriThreadId thread_id;
+} SADataCDigest;
+
 typedef struct {
     uint32_t id;
 } SADataError;
@@ -101,12 +119,14 @@ typedef union {
 
     SADataDOpen dopen;
     SADataDRead dread;
+    SADataDSnapshot dsnapshot;
 
     SADataCTimestamp ctimestamp;
     SADataCStat cstat;
     SADataCFSInfo cfsinfo;
     SADataCResolvePath cresolvepath;
     SADataCEquivPath cequivpath;
+    SADataCDigest cdigest;
 
     SADataError error;
 
@@ -151,6 +171,10 @@ typedef enum {
     StorageCommandCommonResolvePath,
     StorageCommandSDMount,
     StorageCommandCommonEquivalentPath,
+    StorageCommandCommonDigestLookup,
+    StorageCommandCommonDigestStore,
+    StorageCommandDirSnapshotLoad,
+    StorageCommandDirSnapshotGeneration,
 } StorageCommand;
 
 typedef struct {
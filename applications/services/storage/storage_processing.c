@@ -99,6 +99,14 @@ static void storage_path_trim_trailing_slashes(FuriString* path) {
     }
 }
 
+static void storage_process_file_touch_dir(Storage* app, File* file, StorageData* storage) {
+    // Size in directory listing is updated by sync and close only
+    FuriString* path = storage_get_storage_file_modified_path(file, storage);
+    if(path) {
+        storage_dir_tracker_touch(app->dir_tracker, storage, path);
+    }
+}
+
 /******************* File Functions *******************/
 
 bool storage_process_file_open(
@@ -117,6 +125,8 @@ bool storage_process_file_open(
         } else {
             if(access_mode & FSAM_WRITE) {
                 storage_data_timestamp(storage);
+                storage_digest_cache_invalidate(app->digest_cache, storage, path);
+                storage_dir_tracker_touch(app->dir_tracker, storage, path);
             }
             storage_push_storage_file(file, path, storage);
 
@@ -136,6 +146,7 @@ bool storage_process_file_close(Storage* app, File* file) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         FS_CALL(storage, file.close(storage, file));
+        storage_process_file_touch_dir(app, file, storage);
         storage_pop_storage_file(file, storage);
 
         StorageEvent event = {.type = StorageEventTypeFileClose};
@@ -171,6 +182,7 @@ static uint16_t storage_process_file_write(
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         storage_data_timestamp(storage);
+        storage_set_storage_file_modified(file, storage);
         FS_CALL(storage, file.write(storage, file, buff, bytes_to_write));
     }
 
@@ -215,6 +227,7 @@ static bool storage_process_file_truncate(Storage* app, File* file) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         storage_data_timestamp(storage);
+        storage_set_storage_file_modified(file, storage);
         FS_CALL(storage, file.truncate(storage, file));
     }
 
@@ -230,6 +243,7 @@ static bool storage_process_file_sync(Storage* app, File* file) {
     } else {
         storage_data_timestamp(storage);
         FS_CALL(storage, file.sync(storage, file));
+        storage_process_file_touch_dir(app, file, storage);
     }
 
     return ret;
@@ -342,11 +356,20 @@ static FS_Error
     return ret;
 }
 
-static FS_Error storage_process_common_stat(Storage* app, FuriString* path, FileInfo* fileinfo) {
+static FS_Error storage_process_common_stat(
+    Storage* app,
+    FuriString* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp) {
     StorageData* storage;
     FS_Error ret = storage_get_data(app, path, &storage);
 
-    if(ret == FSE_OK) {
+    if(ret == FSE_OK && timestamp) {
+        FS_CALL(
+            storage,
+            common.stat_timestamp(
+                storage, cstr_path_without_vfs_prefix(path), fileinfo, timestamp));
+    } else if(ret == FSE_OK) {
         FS_CALL(storage, common.stat(storage, cstr_path_without_vfs_prefix(path), fileinfo));
     }
 
@@ -366,6 +389,8 @@ static FS_Error storage_process_common_remove(Storage* app, FuriString* path) {
         }
 
         storage_data_timestamp(storage);
+        storage_digest_cache_invalidate(app->digest_cache, storage, path);
+        storage_dir_tracker_touch(app->dir_tracker, storage, path);
         FS_CALL(storage, common.remove(storage, cstr_path_without_vfs_prefix(path)));
     } while(false);
 
@@ -378,6 +403,7 @@ static FS_Error storage_process_common_mkdir(Storage* app, FuriString* path) {
 
     if(ret == FSE_OK) {
         storage_data_timestamp(storage);
+        storage_dir_tracker_touch(app->dir_tracker, storage, path);
         FS_CALL(storage, common.mkdir(storage, cstr_path_without_vfs_prefix(path)));
     }
 
@@ -426,6 +452,95 @@ static bool
     return ret;
 }
 
+static bool storage_process_common_digest_lookup(
+    Storage* app,
+    FuriString* path,
+    StorageDigest* digest) {
+    StorageData* storage;
+    bool ret = false;
+
+    if(storage_get_data(app, path, &storage) == FSE_OK) {
+        ret = storage_digest_cache_lookup(app->digest_cache, storage, path, digest);
+    }
+
+    return ret;
+}
+
+static void storage_process_common_digest_store(
+    Storage* app,
+    FuriString* path,
+    const StorageDigest* digest) {
+    StorageData* storage;
+
+    if(storage_get_data(app, path, &storage) == FSE_OK) {
+        storage_digest_cache_store(app->digest_cache, storage, path, digest);
+    }
+}
+
+/******************* Dir Snapshot Functions *******************/
+
+/* Directory is accessed through filesystem api directly: snapshot is taken
+ * in one go, so it must not wait for or produce directory close events */
+
+static FS_Error storage_process_dir_snapshot_load(
+    Storage* app,
+    FuriString* path,
+    const SADataDSnapshot* data) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+    if(ret != FSE_OK) return ret;
+
+    StorageDirSnapshotWindow* window = data->window;
+    size_t offset = window->offset;
+    memset(window, 0, sizeof(StorageDirSnapshotWindow));
+    window->offset = offset;
+    window->generation = storage_dir_tracker_get(app->dir_tracker, storage, path);
+
+    File dir = {.type = FileTypeOpenDir, .storage = app};
+    FileInfo fileinfo;
+    const uint16_t name_length = STORAGE_DIR_SNAPSHOT_NAME_LENGTH;
+    char* name = malloc(name_length);
+    bool full = false;
+
+    storage_push_storage_file(&dir, path, storage);
+    if(storage->fs_api->dir.open(storage, &dir, cstr_path_without_vfs_prefix(path))) {
+        while(storage->fs_api->dir.read(storage, &dir, &fileinfo, name, name_length)) {
+            if(!storage_dir_snapshot_filter(name, &fileinfo, data->extensions, data->flags)) {
+                continue;
+            }
+
+            // Keep counting past the window, paging needs the total
+            if(window->total++ < offset || full) continue;
+            full = !storage_dir_snapshot_push(
+                data->buffer, data->buffer_size, window, name, &fileinfo);
+        }
+        // Reading past the last entry is not an error
+        ret = (dir.error_id == FSE_NOT_EXIST) ? FSE_OK : dir.error_id;
+    } else {
+        ret = dir.error_id;
+    }
+    storage->fs_api->dir.close(storage, &dir);
+    storage_pop_storage_file(&dir, storage);
+
+    free(name);
+
+    storage_dir_snapshot_finish(data->buffer, data->buffer_size, window, data->flags);
+
+    return ret;
+}
+
+static FS_Error
+    storage_process_dir_snapshot_generation(Storage* app, FuriString* path, uint32_t* generation) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+
+    if(ret == FSE_OK) {
+        *generation = storage_dir_tracker_get(app->dir_tracker, storage, path);
+    }
+
+    return ret;
+}
+
 /****************** Raw SD API ******************/
 // TODO FL-3521: think about implementing a custom storage API to split that kind of api linkage
 #include "storages/storage_ext.h"
@@ -438,6 +553,8 @@ static FS_Error storage_process_sd_format(Storage* app) {
     } else {
         ret = sd_format_card(&app->storage[ST_EXT]);
         storage_data_timestamp(&app->storage[ST_EXT]);
+        storage_digest_cache_reset(app->digest_cache);
+        storage_dir_tracker_reset(app->dir_tracker);
     }
 
     return ret;
@@ -458,6 +575,9 @@ static FS_Error storage_process_sd_unmount(Storage* app) {
             break;
         }
 
+        storage_digest_cache_save(app->digest_cache, storage);
+        storage_digest_cache_reset(app->digest_cache);
+        storage_dir_tracker_reset(app->dir_tracker);
         sd_unmount_card(storage);
         storage_data_timestamp(storage);
     } while(false);
@@ -477,6 +597,8 @@ static FS_Error storage_process_sd_mount(Storage* app) {
 
         ret = sd_mount_card(storage, true);
         storage_data_timestamp(storage);
+        storage_digest_cache_reset(app->digest_cache);
+        storage_dir_tracker_reset(app->dir_tracker);
     } while(false);
 
     return ret;
@@ -533,7 +655,7 @@ void storage_process_alias(
 
         // Create app data folder if not exists
         if(create_folders &&
-           storage_process_common_stat(app, apps_data_path_with_appsid, NULL) != FSE_OK) {
+           storage_process_common_stat(app, apps_data_path_with_appsid, NULL, NULL) != FSE_OK) {
             furi_string_set(apps_data_path_with_appsid, APPS_DATA_PATH);
             storage_process_common_mkdir(app, apps_data_path_with_appsid);
             furi_string_cat(apps_data_path_with_appsid, "/");
@@ -560,7 +682,7 @@ void storage_process_alias(
             path, 0, strlen(STORAGE_INT_PATH_PREFIX), EXT_PATH(STORAGE_INTERNAL_DIR_NAME));
 
         FuriString* int_on_ext_path = furi_string_alloc_set(EXT_PATH(STORAGE_INTERNAL_DIR_NAME));
-        if(storage_process_common_stat(app, int_on_ext_path, NULL) != FSE_OK) {
+        if(storage_process_common_stat(app, int_on_ext_path, NULL, NULL) != FSE_OK) {
             storage_process_common_mkdir(app, int_on_ext_path);
         }
         furi_string_free(int_on_ext_path);
@@ -664,7 +786,8 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         path = furi_string_alloc_set(message->data->cstat.path);
         storage_process_alias(app, path, message->data->cstat.thread_id, false);
         message->return_data->error_value =
-            storage_process_common_stat(app, path, message->data->cstat.fileinfo);
+            storage_process_common_stat(
+                app, path, message->data->cstat.fileinfo, message->data->cstat.timestamp);
         break;
     case StorageCommandCommonRemove:
         path = furi_string_alloc_set(message->data->path.path);
@@ -720,6 +843,32 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         break;
     }
 
+    case StorageCommandCommonDigestLookup:
+        path = furi_string_alloc_set(message->data->cdigest.path);
+        storage_process_alias(app, path, message->data->cdigest.thread_id, false);
+        message->return_data->bool_value =
+            storage_process_common_digest_lookup(app, path, message->data->cdigest.digest);
+        break;
+    case StorageCommandCommonDigestStore:
+        path = furi_string_alloc_set(message->data->cdigest.path);
+        storage_process_alias(app, path, message->data->cdigest.thread_id, false);
+        storage_process_common_digest_store(app, path, message->data->cdigest.digest);
+        break;
+    case StorageCommandDirSnapshotLoad:
+        path = furi_string_alloc_set(message->data->dsnapshot.path);
+        storage_process_alias(app, path, message->data->dsnapshot.thread_id, false);
+        storage_path_trim_trailing_slashes(path);
+        message->return_data->error_value =
+            storage_process_dir_snapshot_load(app, path, &message->data->dsnapshot);
+        break;
+    case StorageCommandDirSnapshotGeneration:
+        path = furi_string_alloc_set(message->data->dsnapshot.path);
+        storage_process_alias(app, path, message->data->dsnapshot.thread_id, false);
+        storage_path_trim_trailing_slashes(path);
+        message->return_data->error_value = storage_process_dir_snapshot_generation(
+            app, path, &message->data->dsnapshot.window->generation);
+        break;
+
     // SD operations
     case StorageCommandSDFormat:
         message->return_data->error_value = storage_process_sd_format(app);
@@ -747,5 +896,7 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
+    FURI_TRACE_BEGIN(StorageCommand, message->command);
     storage_process_message_internal(app, message);
+    FURI_TRACE_END(StorageCommand, message->command);
 }
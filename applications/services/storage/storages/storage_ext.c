@@ -17,12 +17,32 @@ typedef FRESULT SDError;
 
 /********************* Definitions ********************/
 
+// Link maps are built for read-only files spanning at least this many clusters
+#define SD_LINK_MAP_MIN_CLUSTERS (8u)
+#define SD_LINK_MAP_POOL_SIZE    (4u)
+// Table size in DWORDs: size, then (length, cluster) pair per fragment, then 0
+#define SD_LINK_MAP_INITIAL_SIZE (32u)
+#define SD_LINK_MAP_MAX_SIZE     (256u)
+
+typedef struct {
+    DWORD* table; /**< FatFs CLMT, NULL if file is too fragmented */
+    DWORD start_cluster; /**< 0 for unused slot */
+    FSIZE_t size;
+    uint32_t used; /**< last use, for LRU */
+    uint8_t refs; /**< open files using the table */
+    bool stale; /**< chain may have changed, free once released */
+} SDLinkMap;
+
 typedef struct {
     FATFS* fs;
     const char* path;
     bool sd_was_present;
+    SDLinkMap link_maps[SD_LINK_MAP_POOL_SIZE];
+    uint32_t link_map_clock;
 } SDData;
 
+static void sd_link_map_flush(SDData* sd_data);
+
 static FS_Error storage_ext_parse_error(SDError error);
 
 /******************* Core Functions *******************/
@@ -163,6 +183,7 @@ FS_Error sd_unmount_card(StorageData* storage) {
 
     // TODO FL-3522: do i need to close the files?
     f_mount(0, sd_data->path, 0);
+    sd_link_map_flush(sd_data);
 
     return storage_ext_parse_error(error);
 }
@@ -213,6 +234,8 @@ FS_Error sd_format_card(StorageData* storage) {
     SDData* sd_data = storage->data;
     SDError error;
 
+    sd_link_map_flush(sd_data);
+
     work_area = malloc(_MAX_SS);
     error = f_mkfs(sd_data->path, FM_ANY, 0, work_area, _MAX_SS);
     free(work_area);
@@ -385,6 +408,119 @@ static FS_Error storage_ext_parse_error(SDError error) {
     return result;
 }
 
+/******************* Fast Seek Functions *******************/
+
+/* Without a cluster link map every seek follows the FAT chain from the start
+ * of the file. Maps are shared between opens of the same file and kept after
+ * close in a small LRU pool, keyed by start cluster and size. Any write or
+ * remove may reallocate clusters, so the pool is flushed. */
+
+static void sd_link_map_free(SDLinkMap* link_map) {
+    free(link_map->table);
+    memset(link_map, 0, sizeof(SDLinkMap));
+}
+
+static void sd_link_map_flush(SDData* sd_data) {
+    for(size_t i = 0; i < SD_LINK_MAP_POOL_SIZE; i++) {
+        SDLinkMap* link_map = &sd_data->link_maps[i];
+        if(link_map->refs) {
+            link_map->stale = true;
+        } else {
+            sd_link_map_free(link_map);
+        }
+    }
+}
+
+static SDLinkMap* sd_link_map_find(SDData* sd_data, SDFile* file_data) {
+    for(size_t i = 0; i < SD_LINK_MAP_POOL_SIZE; i++) {
+        SDLinkMap* link_map = &sd_data->link_maps[i];
+        if(link_map->start_cluster == file_data->obj.sclust &&
+           link_map->size == file_data->obj.objsize && !link_map->stale) {
+            return link_map;
+        }
+    }
+    return NULL;
+}
+
+static SDLinkMap* sd_link_map_evict(SDData* sd_data) {
+    SDLinkMap* oldest = NULL;
+    for(size_t i = 0; i < SD_LINK_MAP_POOL_SIZE; i++) {
+        SDLinkMap* link_map = &sd_data->link_maps[i];
+        if(link_map->refs) continue;
+        if(!link_map->start_cluster) return link_map;
+        if(!oldest || link_map->used < oldest->used) oldest = link_map;
+    }
+
+    if(oldest) sd_link_map_free(oldest);
+    return oldest;
+}
+
+static void sd_link_map_build(SDLinkMap* link_map, SDFile* file_data) {
+    DWORD size = SD_LINK_MAP_INITIAL_SIZE;
+
+    while(true) {
+        link_map->table = realloc(link_map->table, size * sizeof(DWORD)); //-V701
+        link_map->table[0] = size;
+        file_data->cltbl = link_map->table;
+
+        SDError error = f_lseek(file_data, CREATE_LINKMAP);
+        file_data->cltbl = NULL;
+        if(error == FR_OK) break;
+
+        // On shortage FatFs reports required size in the first item
+        size = link_map->table[0];
+        if(error != FR_NOT_ENOUGH_CORE || size > SD_LINK_MAP_MAX_SIZE) {
+            // Remember the file anyway, so that the chain is not walked on every seek
+            free(link_map->table);
+            link_map->table = NULL;
+            break;
+        }
+    }
+}
+
+static void sd_link_map_acquire(SDData* sd_data, SDFile* file_data) {
+    FATFS* fs = file_data->obj.fs;
+
+    if(file_data->cltbl || (file_data->flag & FA_WRITE)) return;
+    if(!file_data->obj.sclust) return;
+    if(file_data->obj.objsize < (FSIZE_t)SD_LINK_MAP_MIN_CLUSTERS * fs->csize * _MAX_SS) return;
+
+    SDLinkMap* link_map = sd_link_map_find(sd_data, file_data);
+    if(!link_map) {
+        link_map = sd_link_map_evict(sd_data);
+        // Every slot is used by an open file
+        if(!link_map) return;
+
+        link_map->start_cluster = file_data->obj.sclust;
+        link_map->size = file_data->obj.objsize;
+        sd_link_map_build(link_map, file_data);
+    }
+
+    link_map->used = ++sd_data->link_map_clock;
+    if(link_map->table) {
+        link_map->refs++;
+        file_data->cltbl = link_map->table;
+    }
+}
+
+static void sd_link_map_release(SDData* sd_data, SDFile* file_data) {
+    if(!file_data->cltbl) return;
+
+    for(size_t i = 0; i < SD_LINK_MAP_POOL_SIZE; i++) {
+        SDLinkMap* link_map = &sd_data->link_maps[i];
+        if(link_map->table != file_data->cltbl) continue;
+
+        furi_check(link_map->refs);
+        link_map->refs--;
+        if(link_map->stale && !link_map->refs) {
+            sd_link_map_free(link_map);
+        }
+        break;
+    }
+
+    file_data->cltbl = NULL;
+}
+
 /******************* File Functions *******************/
 
 static bool storage_ext_file_open(
@@ -407,6 +543,10 @@ static bool storage_ext_file_open(
     SDFile* file_data = malloc(sizeof(SDFile));
     storage_set_storage_file_data(file, file_data, storage);
 
+    if(_mode & FA_WRITE) {
+        sd_link_map_flush(storage->data);
+    }
+
     file->internal_error_id = f_open(file_data, path, _mode);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return file->error_id == FSE_OK;
@@ -417,6 +557,7 @@ static bool storage_ext_file_close(void* ctx, File* file) {
     SDFile* file_data = storage_get_storage_file_data(file, storage);
     file->internal_error_id = f_close(file_data);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+    sd_link_map_release(storage->data, file_data);
     free(file_data);
     storage_set_storage_file_data(file, NULL, storage);
     return file->error_id == FSE_OK;
@@ -455,6 +596,9 @@ static bool
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
+    // Files that are never seeked do not pay for the link map
+    sd_link_map_acquire(storage->data, file_data);
+
     if(from_start) {
         file->internal_error_id = f_lseek(file_data, offset);
     } else {
@@ -590,7 +734,11 @@ static bool storage_ext_dir_rewind(void* ctx, File* file) {
 }
 /******************* Common FS Functions *******************/
 
-static FS_Error storage_ext_common_stat(void* ctx, const char* path, FileInfo* fileinfo) {
+static FS_Error storage_ext_common_stat_timestamp(
+    void* ctx,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp) {
     UNUSED(ctx);
     SDFileInfo _fileinfo;
     SDError result = f_stat(path, &_fileinfo);
@@ -602,15 +750,26 @@ static FS_Error storage_ext_common_stat(void* ctx, const char* path, FileInfo* f
         if(_fileinfo.fattrib & AM_DIR) fileinfo->flags |= FSF_DIRECTORY;
     }
 
+    if(timestamp != NULL) {
+        // Packed FAT date and time, ordered like the time itself
+        *timestamp = ((uint32_t)_fileinfo.fdate << 16) | _fileinfo.ftime;
+    }
+
     return storage_ext_parse_error(result);
 }
 
+static FS_Error storage_ext_common_stat(void* ctx, const char* path, FileInfo* fileinfo) {
+    return storage_ext_common_stat_timestamp(ctx, path, fileinfo, NULL);
+}
+
 static FS_Error storage_ext_common_remove(void* ctx, const char* path) {
-    UNUSED(ctx);
 #ifdef FURI_RAM_EXEC
+    UNUSED(ctx);
     UNUSED(path);
     return FSE_NOT_READY;
 #else
+    StorageData* storage = ctx;
+    sd_link_map_flush(storage->data);
     SDError result = f_unlink(path);
     return storage_ext_parse_error(result);
 #endif
@@ -703,6 +862,7 @@ static const FS_Api fs_api = {
     .common =
         {
             .stat = storage_ext_common_stat,
+            .stat_timestamp = storage_ext_common_stat_timestamp,
             .mkdir = storage_ext_common_mkdir,
             .remove = storage_ext_common_remove,
             .fs_info = storage_ext_common_fs_info,
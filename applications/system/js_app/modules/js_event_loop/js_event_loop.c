@@ -8,6 +8,16 @@
  */
 #define SYSTEM_ARGS 2
 
+/**
+ * @brief Idle time after which garbage collection in progress is advanced
+ */
+#define GC_TICK_INTERVAL_MS 20
+
+/**
+ * @brief Garbage collection work done per tick, see `mjs_gc_step`
+ */
+#define GC_TICK_WORK 512
+
 /**
  * @brief Context passed to the generic event callback
  */
@@ -227,6 +237,15 @@ static void js_event_loop_subscribe(struct mjs* mjs) {
     mjs_return(mjs, subscription_obj);
 }
 
+/**
+ * @brief Uses idle time to advance garbage collection, so that it doesn't
+ * have to be done in the middle of event handling
+ */
+static void js_event_loop_tick(void* context) {
+    struct mjs* mjs = context;
+    mjs_gc_step(mjs, GC_TICK_WORK);
+}
+
 /**
  * @brief Runs the event loop until it is stopped
  */
@@ -363,6 +382,8 @@ static void* js_event_loop_create(struct mjs* mjs, mjs_val_t* object, JsModules*
     mjs_val_t event_loop_obj = mjs_mk_object(mjs);
     JsEventLoop* module = malloc(sizeof(JsEventLoop));
     module->loop = furi_event_loop_alloc();
+    furi_event_loop_tick_set(
+        module->loop, furi_ms_to_ticks(GC_TICK_INTERVAL_MS), js_event_loop_tick, mjs);
     SubscriptionArray_init(module->subscriptions);
     ContractArray_init(module->owned_contracts);
 
@@ -72,7 +72,7 @@
  * @brief Checks compatibility between the script and the JS SDK that the
  *        firmware provides
  * 
- * @note You're looking at JS SDK v1.0
+ * @note You're looking at JS SDK v1.1
  * 
  * @param expectedMajor JS SDK major version expected by the script
  * @param expectedMinor JS SDK minor version expected by the script
@@ -92,7 +92,7 @@ declare function sdkCompatibilityStatus(expectedMajor: number, expectedMinor: nu
  * @brief Checks compatibility between the script and the JS SDK that the
  *        firmware provides in a boolean fashion
  * 
- * @note You're looking at JS SDK v1.0
+ * @note You're looking at JS SDK v1.1
  * 
  * @param expectedMajor JS SDK major version expected by the script
  * @param expectedMinor JS SDK minor version expected by the script
@@ -105,7 +105,7 @@ declare function isSdkCompatible(expectedMajor: number, expectedMinor: number):
  * @brief Asks the user whether to continue executing the script if the versions
  *        are not compatible. Does nothing if they are.
  * 
- * @note You're looking at JS SDK v1.0
+ * @note You're looking at JS SDK v1.1
  * 
  * @param expectedMajor JS SDK major version expected by the script
  * @param expectedMinor JS SDK minor version expected by the script
@@ -195,6 +195,30 @@ declare function load(path: string, scope?: object): any;
  */
 declare function chr(n: number): string | null;
 
+/**
+ * @brief Returns garbage collector pause statistics
+ * 
+ * Garbage is collected in small steps as the script allocates and while it
+ * waits in the event loop, so pauses stay short. Values are counted since
+ * the script started.
+ * 
+ * @version Added in JS SDK 1.1
+ */
+declare function gcStats(): {
+    /** Completed collection cycles */
+    cycles: number,
+    /** Cycles that compacted strings, including ones requested with `gc(true)` */
+    fullCycles: number,
+    /** Collector steps taken */
+    pauses: number,
+    /** Duration of the last step, microseconds */
+    lastPauseUs: number,
+    /** Longest step, microseconds */
+    maxPauseUs: number,
+    /** Time spent in all steps, microseconds */
+    totalPauseUs: number,
+};
+
 /**
  * @brief Loads a natively implemented module
  * @param module The name of the module to load
@@ -0,0 +1,184 @@
+#include "arena.h"
+#include "check.h"
+#include "common_defines.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Same as heap alignment
+#define FURI_ARENA_ALIGNMENT (8U)
+
+typedef struct FuriArenaChunk FuriArenaChunk;
+
+struct FuriArenaChunk {
+    FuriArenaChunk* prev;
+    size_t size;
+    size_t used;
+    uint8_t data[] __attribute__((aligned(FURI_ARENA_ALIGNMENT)));
+};
+
+struct FuriArena {
+    // Newest chunk, allocations are made from it
+    FuriArenaChunk* chunk;
+    size_t chunk_size;
+
+    size_t used;
+    size_t peak_used;
+    size_t reserved;
+    size_t peak_reserved;
+    size_t chunk_count;
+};
+
+static inline void furi_arena_poison(uint8_t* data, size_t size) {
+#ifdef FURI_DEBUG
+    memset(data, FURI_ARENA_POISON, size);
+#else
+    UNUSED(data);
+    UNUSED(size);
+#endif
+}
+
+static FuriArenaChunk* furi_arena_chunk_alloc(FuriArena* arena, size_t size) {
+    FuriArenaChunk* chunk = malloc(sizeof(FuriArenaChunk) + size);
+    chunk->size = size;
+    chunk->prev = arena->chunk;
+    arena->chunk = chunk;
+
+    arena->chunk_count++;
+    arena->reserved += size;
+    if(arena->reserved > arena->peak_reserved) {
+        arena->peak_reserved = arena->reserved;
+    }
+
+    return chunk;
+}
+
+static void furi_arena_chunk_release(FuriArena* arena) {
+    FuriArenaChunk* chunk = arena->chunk;
+    arena->chunk = chunk->prev;
+
+    arena->chunk_count--;
+    arena->reserved -= chunk->size;
+    arena->used -= chunk->used;
+
+    furi_arena_poison(chunk->data, chunk->used);
+    free(chunk);
+}
+
+static void furi_arena_chunk_truncate(FuriArena* arena, FuriArenaChunk* chunk, size_t used) {
+    furi_check(used <= chunk->used, "Arena scopes exited out of order");
+
+    furi_arena_poison(chunk->data + used, chunk->used - used);
+    arena->used -= chunk->used - used;
+    chunk->used = used;
+}
+
+// Release everything allocated after given position, NULL chunk means arena start
+static void furi_arena_rewind(FuriArena* arena, FuriArenaChunk* chunk, size_t chunk_used) {
+    while(arena->chunk != chunk) {
+        furi_check(arena->chunk, "Arena scopes exited out of order");
+
+        // Keep first chunk unless it was made for an oversized allocation
+        if(!chunk && !arena->chunk->prev && arena->chunk->size == arena->chunk_size) {
+            furi_arena_chunk_truncate(arena, arena->chunk, 0);
+            return;
+        }
+
+        furi_arena_chunk_release(arena);
+    }
+
+    if(chunk) {
+        furi_arena_chunk_truncate(arena, chunk, chunk_used);
+    }
+}
+
+FuriArena* furi_arena_alloc(size_t chunk_size) {
+    furi_check(chunk_size);
+
+    FuriArena* arena = malloc(sizeof(FuriArena));
+    arena->chunk_size = chunk_size;
+
+    return arena;
+}
+
+void furi_arena_free(FuriArena* arena) {
+    furi_check(arena);
+
+    while(arena->chunk) {
+        furi_arena_chunk_release(arena);
+    }
+
+    free(arena);
+}
+
+void* furi_arena_malloc(FuriArena* arena, size_t size) {
+    furi_check(arena);
+
+    // Zero sized allocations still get unique pointers
+    size_t aligned_size = (MAX(size, 1U) + FURI_ARENA_ALIGNMENT - 1) & ~(FURI_ARENA_ALIGNMENT - 1);
+    furi_check(aligned_size >= size);
+
+    FuriArenaChunk* chunk = arena->chunk;
+    if(!chunk || chunk->size - chunk->used < aligned_size) {
+        // Tail of the previous chunk is wasted, chunk size should be well above object sizes
+        chunk = furi_arena_chunk_alloc(arena, MAX(arena->chunk_size, aligned_size));
+    }
+
+    void* data = chunk->data + chunk->used;
+    chunk->used += aligned_size;
+
+    arena->used += aligned_size;
+    if(arena->used > arena->peak_used) {
+        arena->peak_used = arena->used;
+    }
+
+    // Chunks are reused after reset and scope exit
+    memset(data, 0, size);
+
+    return data;
+}
+
+char* furi_arena_strdup(FuriArena* arena, const char* str) {
+    furi_check(str);
+
+    size_t size = strlen(str) + 1;
+    char* copy = furi_arena_malloc(arena, size);
+    memcpy(copy, str, size);
+
+    return copy;
+}
+
+void furi_arena_reset(FuriArena* arena) {
+    furi_check(arena);
+
+    furi_arena_rewind(arena, NULL, 0);
+}
+
+void furi_arena_scope_enter(FuriArena* arena, FuriArenaScope* scope) {
+    furi_check(arena);
+    furi_check(scope);
+
+    scope->chunk = arena->chunk;
+    scope->chunk_used = arena->chunk ? arena->chunk->used : 0;
+    scope->used = arena->used;
+}
+
+void furi_arena_scope_exit(FuriArena* arena, const FuriArenaScope* scope) {
+    furi_check(arena);
+    furi_check(scope);
+
+    furi_arena_rewind(arena, scope->chunk, scope->chunk_used);
+    furi_check(arena->used == scope->used, "Arena scopes exited out of order");
+}
+
+void furi_arena_get_stats(const FuriArena* arena, FuriArenaStats* stats) {
+    furi_check(arena);
+    furi_check(stats);
+
+    stats->used = arena->used;
+    stats->peak_used = arena->peak_used;
+    stats->reserved = arena->reserved;
+    stats->peak_reserved = arena->peak_reserved;
+    stats->chunk_count = arena->chunk_count;
+}
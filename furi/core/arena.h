@@ -0,0 +1,116 @@
+/**
+ * @file arena.h
+ * Furi: arena allocator
+ *
+ * Arena hands out memory from big heap chunks by bumping a pointer and
+ * releases it all at once: either completely with furi_arena_reset() or
+ * back to a point remembered with furi_arena_scope_enter(). There is no
+ * way to free a single allocation.
+ *
+ * Use it for many short lived objects with common lifetime: scene data,
+ * worker run temporaries, parser state. Memory returned by the arena is
+ * zeroed. In debug builds released memory is filled with
+ * FURI_ARENA_POISON, so access after release is easy to spot.
+ *
+ * Arena is not thread safe.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Value released memory is filled with in debug builds */
+#define FURI_ARENA_POISON (0xA5U)
+
+typedef struct FuriArena FuriArena;
+
+/** Scope marker, see furi_arena_scope_enter() */
+typedef struct {
+    void* chunk;
+    size_t chunk_used;
+    size_t used;
+} FuriArenaScope;
+
+typedef struct {
+    size_t used; /**< bytes handed out, including alignment */
+    size_t peak_used; /**< maximum of used */
+    size_t reserved; /**< bytes taken from heap for chunks */
+    size_t peak_reserved; /**< maximum of reserved */
+    size_t chunk_count; /**< chunks currently allocated */
+} FuriArenaStats;
+
+/** Allocate arena
+ *
+ * @param[in]  chunk_size  Size of heap chunks, allocations bigger than that
+ *                         get a chunk of their own
+ *
+ * @return     pointer to FuriArena instance
+ */
+FuriArena* furi_arena_alloc(size_t chunk_size);
+
+/** Free arena and all memory allocated from it
+ *
+ * @param      arena  pointer to FuriArena instance
+ */
+void furi_arena_free(FuriArena* arena);
+
+/** Allocate zeroed memory from the arena
+ *
+ * Memory is aligned same as malloc results.
+ *
+ * @param      arena  pointer to FuriArena instance
+ * @param[in]  size   Size in bytes
+ *
+ * @return     pointer to allocated memory
+ */
+void* furi_arena_malloc(FuriArena* arena, size_t size);
+
+/** Copy string into the arena
+ *
+ * @param      arena  pointer to FuriArena instance
+ * @param[in]  str    Zero terminated string
+ *
+ * @return     pointer to the copy
+ */
+char* furi_arena_strdup(FuriArena* arena, const char* str);
+
+/** Release all memory allocated from the arena
+ *
+ * First chunk is kept for the next round, so arena that is reset often
+ * doesn't go to heap all the time.
+ *
+ * @param      arena  pointer to FuriArena instance
+ */
+void furi_arena_reset(FuriArena* arena);
+
+/** Remember current arena position
+ *
+ * Scopes can be nested, inner scope must be exited first.
+ *
+ * @param      arena  pointer to FuriArena instance
+ * @param      scope  pointer to FuriArenaScope to fill
+ */
+void furi_arena_scope_enter(FuriArena* arena, FuriArenaScope* scope);
+
+/** Release memory allocated since scope was entered
+ *
+ * @param      arena  pointer to FuriArena instance
+ * @param      scope  pointer to FuriArenaScope filled by furi_arena_scope_enter
+ */
+void furi_arena_scope_exit(FuriArena* arena, const FuriArenaScope* scope);
+
+/** Get arena statistics
+ *
+ * Peak values are useful for choosing chunk size.
+ *
+ * @param      arena  pointer to FuriArena instance
+ * @param      stats  pointer to FuriArenaStats to fill
+ */
+void furi_arena_get_stats(const FuriArena* arena, FuriArenaStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
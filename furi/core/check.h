@@ -30,6 +30,17 @@ FURI_NORETURN void __furi_crash_implementation(void);
 /** Halt system */
 FURI_NORETURN void __furi_halt_implementation(void);
 
+#ifdef FURI_HOST
+/** Message of the crash in progress, host has no r12 to pass it through */
+extern __thread const void* __furi_check_message_host;
+
+/** Crash system with message. */
+#define __furi_crash(message)                             \
+    do {                                                  \
+        __furi_check_message_host = (const void*)message; \
+        __furi_crash_implementation();                    \
+    } while(0)
+#else
 /** Crash system with message. Show message after reboot. */
 #define __furi_crash(message)                                 \
     do {                                                      \
@@ -37,6 +48,7 @@ FURI_NORETURN void __furi_halt_implementation(void);
         asm volatile("sukima%=:" : : "r"(r12));               \
         __furi_crash_implementation();                        \
     } while(0)
+#endif
 
 /** Crash system
  *
@@ -44,6 +56,14 @@ FURI_NORETURN void __furi_halt_implementation(void);
  */
 #define furi_crash(...) M_APPLY(__furi_crash, M_IF_EMPTY(__VA_ARGS__)((NULL), (__VA_ARGS__)))
 
+#ifdef FURI_HOST
+/** Halt system with message. */
+#define __furi_halt(message)                              \
+    do {                                                  \
+        __furi_check_message_host = (const void*)message; \
+        __furi_halt_implementation();                     \
+    } while(0)
+#else
 /** Halt system with message. */
 #define __furi_halt(message)                                  \
     do {                                                      \
@@ -51,6 +71,7 @@ FURI_NORETURN void __furi_halt_implementation(void);
         asm volatile("sukima%=:" : : "r"(r12));               \
         __furi_halt_implementation();                         \
     } while(0)
+#endif
 
 /** Halt system
  *
@@ -98,12 +119,21 @@ FURI_NORETURN void __furi_halt_implementation(void);
 #define furi_assert(...) \
     M_APPLY(__furi_assert, M_DEFAULT_ARGS(2, (__FURI_ASSERT_MESSAGE_FLAG), __VA_ARGS__))
 
+#ifdef FURI_HOST
+#define furi_break(__e)       \
+    do {                      \
+        if(!(__e)) {          \
+            __builtin_trap(); \
+        }                     \
+    } while(0)
+#else
 #define furi_break(__e)             \
     do {                            \
         if(!(__e)) {                \
             asm volatile("bkpt 0"); \
         }                           \
     } while(0)
+#endif
 
 #ifdef __cplusplus
 }
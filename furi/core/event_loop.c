@@ -58,7 +58,7 @@ FuriEventLoop* furi_event_loop_alloc(void) {
 
     FuriEventLoopTree_init(instance->tree);
     WaitingList_init(instance->waiting_list);
-    TimerList_init(instance->timer_list);
+    furi_timer_wheel_init(&instance->timer_wheel, xTaskGetTickCount());
     TimerQueue_init(instance->timer_queue);
     PendingQueue_init(instance->pending_queue);
 
@@ -76,7 +76,7 @@ void furi_event_loop_free(FuriEventLoop* instance) {
     furi_check(instance->state == FuriEventLoopStateStopped);
 
     furi_event_loop_process_timer_queue(instance);
-    furi_check(TimerList_empty_p(instance->timer_list));
+    furi_check(furi_timer_wheel_is_empty(&instance->timer_wheel));
     furi_check(WaitingList_empty_p(instance->waiting_list));
     furi_check(!instance->are_thread_flags_subscribed);
 
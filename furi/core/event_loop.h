@@ -237,6 +237,9 @@ typedef struct FuriMessageQueue FuriMessageQueue;
  * 
  * @warning you can only have one subscription for one event type.
  *
+ * In callbacks may use furi_message_queue_get_batch() to take all pending
+ * messages at once instead of being called for every one of them.
+ *
  * @param      instance       The Event Loop instance
  * @param      message_queue  The message queue to add
  * @param[in]  event          The Event Loop event to trigger on
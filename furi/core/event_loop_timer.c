@@ -5,6 +5,9 @@
 
 #include <furi.h>
 
+// IMPORTANT: wheel_node MUST be the FIRST struct member
+static_assert(offsetof(FuriEventLoopTimer, wheel_node) == 0);
+
 /*
  * Private functions
  */
@@ -19,35 +22,9 @@ static inline uint32_t
     return elapsed_time < timer->interval ? timer->interval - elapsed_time : 0;
 }
 
-static inline bool furi_event_loop_timer_is_expired(const FuriEventLoopTimer* timer) {
-    return furi_event_loop_timer_get_elapsed_time(timer) >= timer->interval;
-}
-
 static void furi_event_loop_schedule_timer(FuriEventLoop* instance, FuriEventLoopTimer* timer) {
-    FuriEventLoopTimer* timer_pos = NULL;
-
-    FURI_CRITICAL_ENTER();
-
-    const uint32_t remaining_time = furi_event_loop_timer_get_remaining_time_private(timer);
-
-    TimerList_it_t it;
-    for(TimerList_it_last(it, instance->timer_list); !TimerList_end_p(it);
-        TimerList_previous(it)) {
-        FuriEventLoopTimer* tmp = TimerList_ref(it);
-        if(remaining_time >= furi_event_loop_timer_get_remaining_time_private(tmp)) {
-            timer_pos = tmp;
-            break;
-        }
-    }
-
-    FURI_CRITICAL_EXIT();
-
-    if(timer_pos) {
-        TimerList_push_after(timer_pos, timer);
-    } else {
-        TimerList_push_front(instance->timer_list, timer);
-    }
-    // At this point, TimerList_front() points to the first timer to expire
+    furi_timer_wheel_add(
+        &instance->timer_wheel, &timer->wheel_node, timer->start_time + timer->interval);
 }
 
 static void furi_event_loop_timer_enqueue_request(
@@ -78,9 +55,11 @@ static void furi_event_loop_timer_enqueue_request(
 uint32_t furi_event_loop_get_timer_wait_time(const FuriEventLoop* instance) {
     uint32_t wait_time = FuriWaitForever;
 
-    if(!TimerList_empty_p(instance->timer_list)) {
-        FuriEventLoopTimer* timer = TimerList_front(instance->timer_list);
-        wait_time = furi_event_loop_timer_get_remaining_time_private(timer);
+    if(!furi_timer_wheel_is_empty(&instance->timer_wheel)) {
+        // Either the earliest expiration or the moment the wheel has to be turned
+        const uint32_t next_time = furi_timer_wheel_get_next_time(&instance->timer_wheel);
+        const uint32_t remaining_time = next_time - xTaskGetTickCount();
+        wait_time = (int32_t)remaining_time > 0 ? remaining_time : 0;
     }
 
     return wait_time;
@@ -90,8 +69,8 @@ void furi_event_loop_process_timer_queue(FuriEventLoop* instance) {
     while(!TimerQueue_empty_p(instance->timer_queue)) {
         FuriEventLoopTimer* timer = TimerQueue_pop_front(instance->timer_queue);
 
-        if(timer->active) {
-            TimerList_unlink(timer);
+        if(furi_timer_wheel_node_is_linked(&timer->wheel_node)) {
+            furi_timer_wheel_remove(&instance->timer_wheel, &timer->wheel_node);
         }
 
         if(timer->request == FuriEventLoopTimerRequestStart) {
@@ -116,17 +95,13 @@ void furi_event_loop_process_timer_queue(FuriEventLoop* instance) {
 }
 
 bool furi_event_loop_process_expired_timers(FuriEventLoop* instance) {
-    if(TimerList_empty_p(instance->timer_list)) {
-        return false;
-    }
-    // The front() element contains the earliest-expiring timer
-    FuriEventLoopTimer* timer = TimerList_front(instance->timer_list);
-
-    if(!furi_event_loop_timer_is_expired(timer)) {
+    FuriTimerWheelNode* node =
+        furi_timer_wheel_pop_expired(&instance->timer_wheel, xTaskGetTickCount());
+    if(!node) {
         return false;
     }
 
-    TimerList_unlink(timer);
+    FuriEventLoopTimer* timer = (FuriEventLoopTimer*)node;
 
     if(timer->periodic) {
         const uint32_t num_events =
@@ -164,7 +139,6 @@ FuriEventLoopTimer* furi_event_loop_timer_alloc(
     timer->context = context;
     timer->periodic = (type == FuriEventLoopTimerTypePeriodic);
 
-    TimerList_init_field(timer);
     TimerQueue_init_field(timer);
 
     return timer;
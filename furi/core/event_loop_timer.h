@@ -2,6 +2,10 @@
  * @file event_loop_timer.h
  * @brief Software timer functionality for FuriEventLoop.
  *
+ * Timers are kept in a hierarchical timer wheel: starting and stopping a
+ * timer costs the same regardless of how many timers are running, and the
+ * event loop thread sleeps till the earliest expiration.
+ *
  * @warning ALL FuriEventLoopTimer functions MUST be called from the
  * same thread that the owner FuriEventLoop instance was created in.
  */
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "event_loop_timer.h"
+#include "timer_wheel_i.h"
 
 #include <m-i-list.h>
 
@@ -12,6 +13,9 @@ typedef enum {
 } FuriEventLoopTimerRequest;
 
 struct FuriEventLoopTimer {
+    // Node in the active timer wheel, MUST be the FIRST struct member
+    FuriTimerWheelNode wheel_node;
+
     FuriEventLoop* owner;
 
     FuriEventLoopTimerCallback callback;
@@ -21,9 +25,6 @@ struct FuriEventLoopTimer {
     uint32_t start_time;
     uint32_t next_interval;
 
-    // Interface for the active timer list
-    ILIST_INTERFACE(TimerList, FuriEventLoopTimer);
-
     // Interface for the timer request queue
     ILIST_INTERFACE(TimerQueue, FuriEventLoopTimer);
 
@@ -33,7 +34,6 @@ struct FuriEventLoopTimer {
     bool periodic;
 };
 
-ILIST_DEF(TimerList, FuriEventLoopTimer, M_POD_OPLIST)
 ILIST_DEF(TimerQueue, FuriEventLoopTimer, M_POD_OPLIST)
 
 uint32_t furi_event_loop_get_timer_wait_time(const FuriEventLoop* instance);
@@ -3,27 +3,29 @@
 #include <furi_hal_memory.h>
 #include <FreeRTOS.h>
 
-extern void* pvPortMalloc(size_t xSize);
+extern void* pvPortMallocCaller(size_t xSize, void* pvCaller);
 extern void vPortFree(void* pv);
 extern size_t xPortGetFreeHeapSize(void);
 extern size_t xPortGetTotalHeapSize(void);
 extern size_t xPortGetMinimumEverFreeHeapSize(void);
 
+// Call site is recorded in heap blocks with HEAP_TRACE=1, so wrappers pass their return address
+
 void* malloc(size_t size) {
-    return pvPortMalloc(size);
+    return pvPortMallocCaller(size, __builtin_return_address(0));
 }
 
 void free(void* ptr) {
     vPortFree(ptr);
 }
 
-void* realloc(void* ptr, size_t size) {
+static void* memmgr_realloc(void* ptr, size_t size, void* caller) {
     if(size == 0) {
         vPortFree(ptr);
         return NULL;
     }
 
-    void* p = pvPortMalloc(size);
+    void* p = pvPortMallocCaller(size, caller);
     if(ptr != NULL) {
         memcpy(p, ptr, size);
         vPortFree(ptr);
@@ -32,8 +34,12 @@ void* realloc(void* ptr, size_t size) {
     return p;
 }
 
+void* realloc(void* ptr, size_t size) {
+    return memmgr_realloc(ptr, size, __builtin_return_address(0));
+}
+
 void* calloc(size_t count, size_t size) {
-    return pvPortMalloc(count * size);
+    return pvPortMallocCaller(count * size, __builtin_return_address(0));
 }
 
 char* strdup(const char* s) {
@@ -41,7 +47,7 @@ char* strdup(const char* s) {
     furi_check(((uint32_t)s << 2) != 0);
 
     size_t siz = strlen(s) + 1;
-    char* y = pvPortMalloc(siz);
+    char* y = pvPortMallocCaller(siz, __builtin_return_address(0));
     memcpy(y, s, siz);
 
     return y;
@@ -61,7 +67,7 @@ size_t memmgr_get_minimum_free_heap(void) {
 
 void* __wrap__malloc_r(struct _reent* r, size_t size) {
     UNUSED(r);
-    return pvPortMalloc(size);
+    return pvPortMallocCaller(size, __builtin_return_address(0));
 }
 
 void __wrap__free_r(struct _reent* r, void* ptr) {
@@ -71,12 +77,12 @@ void __wrap__free_r(struct _reent* r, void* ptr) {
 
 void* __wrap__calloc_r(struct _reent* r, size_t count, size_t size) {
     UNUSED(r);
-    return calloc(count, size);
+    return pvPortMallocCaller(count * size, __builtin_return_address(0));
 }
 
 void* __wrap__realloc_r(struct _reent* r, void* ptr, size_t size) {
     UNUSED(r);
-    return realloc(ptr, size);
+    return memmgr_realloc(ptr, size, __builtin_return_address(0));
 }
 
 void* memmgr_alloc_from_pool(size_t size) {
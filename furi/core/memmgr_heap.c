@@ -44,6 +44,9 @@
 #include <stm32wb55_linker.h>
 #include <core/log.h>
 #include <core/common_defines.h>
+#include <core/kernel.h>
+#include <core/timer.h>
+#include <core/object_pool.h>
 
 // -V::562
 // -V::650
@@ -105,6 +108,10 @@ uint8_t* ucHeap = (uint8_t*)&__heap_start__;
 typedef struct A_BLOCK_LINK {
     struct A_BLOCK_LINK* pxNextFreeBlock; /**< The next free block in the list. */
     size_t xBlockSize; /**< The size of the free block. */
+#ifdef FURI_HEAP_TRACE
+    FuriThreadId owner; /**< Thread that allocated the block. */
+    void* caller; /**< Return address of the allocation call. */
+#endif
 } BlockLink_t;
 
 /* Setting configENABLE_HEAP_PROTECTOR to 1 enables heap block pointers
@@ -167,6 +174,8 @@ static const size_t xHeapStructSize = (sizeof(BlockLink_t) + ((size_t)(portBYTE_
 /* Create a couple of list links to mark the start and end of the list. */
 PRIVILEGED_DATA static BlockLink_t xStart;
 PRIVILEGED_DATA static BlockLink_t* pxEnd = NULL;
+/* Lowest block in the heap, start of physical walk. */
+PRIVILEGED_DATA static BlockLink_t* pxFirst = NULL;
 
 /* Keeps track of the number of calls to allocate and free memory as well as the
  * number of free bytes remaining, but says nothing about fragmentation. */
@@ -188,13 +197,22 @@ DICT_DEF2( //-V1048
     MemmgrHeapAllocDict_t,
     DICT_OPLIST(MemmgrHeapAllocDict))
 
+DICT_DEF2( //-V1048
+    MemmgrHeapStatsDict,
+    uint32_t,
+    M_DEFAULT_OPLIST,
+    MemmgrHeapThreadStats,
+    M_POD_OPLIST)
+
 /* Thread allocation tracing storage */
 static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
+static MemmgrHeapStatsDict_t memmgr_heap_stats_dict = {0};
 static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
 
 /* Initialize tracing storage on start */
 void memmgr_heap_init(void) {
     MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
+    MemmgrHeapStatsDict_init(memmgr_heap_stats_dict);
 }
 
 void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
@@ -206,6 +224,8 @@ void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
         MemmgrHeapAllocDict_init(alloc_dict);
         MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
         MemmgrHeapAllocDict_clear(alloc_dict);
+        MemmgrHeapThreadStats stats = {0};
+        MemmgrHeapStatsDict_set_at(memmgr_heap_stats_dict, (uint32_t)thread_id, stats);
         memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
@@ -216,6 +236,7 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
     {
         memmgr_heap_thread_trace_depth++;
         furi_check(MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id));
+        MemmgrHeapStatsDict_erase(memmgr_heap_stats_dict, (uint32_t)thread_id);
         memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
@@ -253,6 +274,39 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
     return leftovers;
 }
 
+bool memmgr_heap_get_thread_stats(FuriThreadId thread_id, MemmgrHeapThreadStats* stats) {
+    furi_check(stats);
+    bool result = false;
+    vTaskSuspendAll();
+    {
+        memmgr_heap_thread_trace_depth++;
+        MemmgrHeapThreadStats* thread_stats =
+            MemmgrHeapStatsDict_get(memmgr_heap_stats_dict, (uint32_t)thread_id);
+        if(thread_stats) {
+            *stats = *thread_stats;
+            result = true;
+        }
+        memmgr_heap_thread_trace_depth--;
+    }
+    (void)xTaskResumeAll();
+    return result;
+}
+
+void memmgr_heap_reset_thread_stats(FuriThreadId thread_id) {
+    vTaskSuspendAll();
+    {
+        memmgr_heap_thread_trace_depth++;
+        MemmgrHeapThreadStats* thread_stats =
+            MemmgrHeapStatsDict_get(memmgr_heap_stats_dict, (uint32_t)thread_id);
+        if(thread_stats) {
+            thread_stats->peak = thread_stats->current;
+            thread_stats->allocations = 0;
+        }
+        memmgr_heap_thread_trace_depth--;
+    }
+    (void)xTaskResumeAll();
+}
+
 #undef traceMALLOC
 static inline void traceMALLOC(void* pointer, size_t size) {
     FuriThreadId thread_id = furi_thread_get_current_id();
@@ -262,6 +316,13 @@ static inline void traceMALLOC(void* pointer, size_t size) {
             MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
         if(alloc_dict) {
             MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
+            MemmgrHeapThreadStats* stats =
+                MemmgrHeapStatsDict_get(memmgr_heap_stats_dict, (uint32_t)thread_id);
+            if(stats) {
+                stats->current += size;
+                stats->allocations++;
+                if(stats->current > stats->peak) stats->peak = stats->current;
+            }
         }
         memmgr_heap_thread_trace_depth--;
     }
@@ -277,13 +338,69 @@ static inline void traceFREE(void* pointer, size_t size) {
             MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
         if(alloc_dict) {
             // In some cases thread may want to release memory that was not allocated by it
-            const bool res = MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
-            UNUSED(res);
+            uint32_t* allocated_size = MemmgrHeapAllocDict_get(*alloc_dict, (uint32_t)pointer);
+            if(allocated_size) {
+                MemmgrHeapThreadStats* stats =
+                    MemmgrHeapStatsDict_get(memmgr_heap_stats_dict, (uint32_t)thread_id);
+                if(stats) stats->current -= *allocated_size;
+                MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
+            }
         }
         memmgr_heap_thread_trace_depth--;
     }
 }
 
+void memmgr_heap_trace_attach(void* pointer) {
+    furi_check(pointer);
+
+    BlockLink_t* pxLink = (void*)((uint8_t*)pointer - xHeapStructSize);
+    FuriThreadId thread_id = furi_thread_get_current_id();
+
+#ifdef FURI_HEAP_TRACE
+    // Block changes hands, call site stays the original one
+    pxLink->owner = thread_id;
+#endif
+
+    // Nothing else to do unless some thread is traced
+    if(!thread_id || MemmgrHeapThreadDict_size(memmgr_heap_thread_dict) == 0) return;
+
+    vTaskSuspendAll();
+    {
+        // Same accounting as for fresh allocation
+        traceMALLOC(pointer, pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK);
+    }
+    (void)xTaskResumeAll();
+}
+
+void memmgr_heap_trace_detach(void* pointer) {
+    furi_check(pointer);
+
+    if(MemmgrHeapThreadDict_size(memmgr_heap_thread_dict) == 0) return;
+
+    vTaskSuspendAll();
+    {
+        memmgr_heap_thread_trace_depth++;
+        // Block may have been allocated by any traced thread
+        MemmgrHeapThreadDict_it_t thread_it;
+        for(MemmgrHeapThreadDict_it(thread_it, memmgr_heap_thread_dict);
+            !MemmgrHeapThreadDict_end_p(thread_it);
+            MemmgrHeapThreadDict_next(thread_it)) {
+            MemmgrHeapThreadDict_itref_t* thread_data = MemmgrHeapThreadDict_ref(thread_it);
+            uint32_t* allocated_size =
+                MemmgrHeapAllocDict_get(thread_data->value, (uint32_t)pointer);
+            if(allocated_size) {
+                MemmgrHeapThreadStats* stats =
+                    MemmgrHeapStatsDict_get(memmgr_heap_stats_dict, thread_data->key);
+                if(stats) stats->current -= *allocated_size;
+                MemmgrHeapAllocDict_erase(thread_data->value, (uint32_t)pointer);
+                break;
+            }
+        }
+        memmgr_heap_thread_trace_depth--;
+    }
+    (void)xTaskResumeAll();
+}
+
 size_t memmgr_heap_get_max_free_block(void) {
     HeapStats_t heap_stats;
     vPortGetHeapStats(&heap_stats);
@@ -306,9 +423,158 @@ void memmgr_heap_printf_free_blocks(void) {
     //xTaskResumeAll();
 }
 
+bool memmgr_heap_is_owner_trace_available(void) {
+#ifdef FURI_HEAP_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+static void memmgr_heap_get_block_owner(BlockLink_t* pxBlock, MemmgrHeapBlock* block) {
+#ifdef FURI_HEAP_TRACE
+    block->thread_id = pxBlock->owner;
+    block->caller = (uint32_t)pxBlock->caller;
+#else
+    UNUSED(pxBlock);
+    // Only blocks of traced threads are known
+    MemmgrHeapThreadDict_it_t thread_it;
+    for(MemmgrHeapThreadDict_it(thread_it, memmgr_heap_thread_dict);
+        !MemmgrHeapThreadDict_end_p(thread_it);
+        MemmgrHeapThreadDict_next(thread_it)) {
+        MemmgrHeapThreadDict_itref_t* thread_data = MemmgrHeapThreadDict_ref(thread_it);
+        if(MemmgrHeapAllocDict_get(thread_data->value, block->address)) {
+            block->thread_id = (FuriThreadId)thread_data->key;
+            break;
+        }
+    }
+#endif
+}
+
+size_t memmgr_heap_get_blocks(uint32_t address, MemmgrHeapBlock* blocks, size_t count) {
+    furi_check(blocks);
+
+    size_t filled = 0;
+    vTaskSuspendAll();
+    {
+        memmgr_heap_thread_trace_depth++;
+        // Blocks are adjacent, so heap is walked by sizes from the lowest one
+        BlockLink_t* pxBlock = pxFirst;
+        while(pxBlock && pxBlock < pxEnd && filled < count) {
+            size_t xBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+            furi_check(xBlockSize >= xHeapStructSize, "heap corrupted");
+
+            uint32_t block_address = (uint32_t)pxBlock + xHeapStructSize;
+            if(block_address >= address) {
+                MemmgrHeapBlock* block = &blocks[filled++];
+                *block = (MemmgrHeapBlock){
+                    .address = block_address,
+                    .size = xBlockSize,
+                    .allocated = heapBLOCK_IS_ALLOCATED(pxBlock),
+                };
+                if(block->allocated) {
+                    memmgr_heap_get_block_owner(pxBlock, block);
+                }
+            }
+
+            pxBlock = (void*)((uint8_t*)pxBlock + xBlockSize);
+        }
+        memmgr_heap_thread_trace_depth--;
+    }
+    (void)xTaskResumeAll();
+
+    return filled;
+}
+
+void memmgr_heap_get_sample(MemmgrHeapSample* sample) {
+    furi_check(sample);
+
+    HeapStats_t heap_stats;
+    vPortGetHeapStats(&heap_stats);
+
+    sample->tick = furi_get_tick();
+    sample->free = heap_stats.xAvailableHeapSpaceInBytes;
+    sample->max_free_block = heap_stats.xSizeOfLargestFreeBlockInBytes;
+    sample->free_blocks = heap_stats.xNumberOfFreeBlocks;
+    sample->allocated_blocks =
+        heap_stats.xNumberOfSuccessfulAllocations - heap_stats.xNumberOfSuccessfulFrees;
+}
+
+/* Heap sampling storage, guarded by critical section */
+static FuriTimer* memmgr_heap_sampling_timer = NULL;
+static MemmgrHeapSample* memmgr_heap_samples = NULL;
+static size_t memmgr_heap_samples_capacity = 0;
+static size_t memmgr_heap_samples_count = 0;
+static size_t memmgr_heap_samples_head = 0;
+
+static void memmgr_heap_sampling_callback(void* context) {
+    UNUSED(context);
+
+    MemmgrHeapSample sample;
+    memmgr_heap_get_sample(&sample);
+
+    FURI_CRITICAL_ENTER();
+    if(memmgr_heap_samples) {
+        memmgr_heap_samples[memmgr_heap_samples_head] = sample;
+        memmgr_heap_samples_head = (memmgr_heap_samples_head + 1) % memmgr_heap_samples_capacity;
+        if(memmgr_heap_samples_count < memmgr_heap_samples_capacity) {
+            memmgr_heap_samples_count++;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void memmgr_heap_sampling_start(uint32_t interval, size_t capacity) {
+    furi_check(interval);
+    furi_check(capacity);
+
+    memmgr_heap_sampling_stop();
+
+    MemmgrHeapSample* samples = malloc(capacity * sizeof(MemmgrHeapSample));
+
+    FURI_CRITICAL_ENTER();
+    MemmgrHeapSample* old_samples = memmgr_heap_samples;
+    memmgr_heap_samples = samples;
+    memmgr_heap_samples_capacity = capacity;
+    memmgr_heap_samples_count = 0;
+    memmgr_heap_samples_head = 0;
+    FURI_CRITICAL_EXIT();
+
+    free(old_samples);
+
+    memmgr_heap_sampling_timer =
+        furi_timer_alloc(memmgr_heap_sampling_callback, FuriTimerTypePeriodic, NULL);
+    furi_timer_start(memmgr_heap_sampling_timer, interval);
+}
+
+void memmgr_heap_sampling_stop(void) {
+    if(!memmgr_heap_sampling_timer) return;
+
+    // Waits for pending callback
+    furi_timer_free(memmgr_heap_sampling_timer);
+    memmgr_heap_sampling_timer = NULL;
+}
+
+bool memmgr_heap_sampling_get(size_t index, MemmgrHeapSample* sample) {
+    furi_check(sample);
+
+    bool result = false;
+    FURI_CRITICAL_ENTER();
+    if(index < memmgr_heap_samples_count) {
+        size_t oldest = (memmgr_heap_samples_head + memmgr_heap_samples_capacity -
+                         memmgr_heap_samples_count) %
+                        memmgr_heap_samples_capacity;
+        *sample = memmgr_heap_samples[(oldest + index) % memmgr_heap_samples_capacity];
+        result = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return result;
+}
+
 /*-----------------------------------------------------------*/
 
-void* pvPortMalloc(size_t xWantedSize) {
+void* pvPortMallocCaller(size_t xWantedSize, void* pvCaller) {
     BlockLink_t* pxBlock;
     BlockLink_t* pxPreviousBlock;
     BlockLink_t* pxNewBlockLink;
@@ -433,6 +699,10 @@ void* pvPortMalloc(size_t xWantedSize) {
                      * by the application and has no "next" block. */
                     heapALLOCATE_BLOCK(pxBlock);
                     pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER(NULL);
+#ifdef FURI_HEAP_TRACE
+                    pxBlock->owner = furi_thread_get_current_id();
+                    pxBlock->caller = pvCaller;
+#endif
                     xNumberOfSuccessfulAllocations++;
                 } else {
                     mtCOVERAGE_TEST_MARKER();
@@ -448,9 +718,21 @@ void* pvPortMalloc(size_t xWantedSize) {
 
         /* Prevent compiler warnings when trace macros are not used. */
         (void)xAllocatedBlockSize;
+        (void)pvCaller;
     }
     (void)xTaskResumeAll();
 
+    if(pvReturn == NULL && xWantedSize > 0) {
+        /* Give memory cached by object pools back to the heap and retry if
+         * that freed anything. Second attempt can't free more, so recursion
+         * depth is one. */
+        size_t xFreeBytesBeforeTrim = xFreeBytesRemaining;
+        furi_object_pool_trim_all();
+        if(xFreeBytesRemaining > xFreeBytesBeforeTrim) {
+            return pvPortMallocCaller(xToWipe, pvCaller);
+        }
+    }
+
 #if(configUSE_MALLOC_FAILED_HOOK == 1)
     {
         if(pvReturn == NULL) {
@@ -469,6 +751,11 @@ void* pvPortMalloc(size_t xWantedSize) {
 }
 /*-----------------------------------------------------------*/
 
+void* pvPortMalloc(size_t xWantedSize) {
+    return pvPortMallocCaller(xWantedSize, __builtin_return_address(0));
+}
+/*-----------------------------------------------------------*/
+
 void vPortFree(void* pv) {
     uint8_t* puc = (uint8_t*)pv;
     BlockLink_t* pxLink;
@@ -600,6 +887,7 @@ static void prvHeapInit(void) /* PRIVILEGED_FUNCTION */
     /* To start with there is a single free block that is sized to take up the
      * entire heap space, minus the space taken by pxEnd. */
     pxFirstFreeBlock = (BlockLink_t*)uxStartAddress;
+    pxFirst = pxFirstFreeBlock;
     pxFirstFreeBlock->xBlockSize =
         (size_t)(uxEndAddress - (portPOINTER_SIZE_TYPE)pxFirstFreeBlock);
     pxFirstFreeBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER(pxEnd);
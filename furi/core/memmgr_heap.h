@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <core/thread.h>
 
 #ifdef __cplusplus
@@ -14,6 +15,31 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Thread allocation statistics, collected while thread trace is enabled */
+typedef struct {
+    size_t current; /**< Bytes allocated by thread right now */
+    size_t peak; /**< Highest value of current since last reset */
+    size_t allocations; /**< Allocation count since last reset */
+} MemmgrHeapThreadStats;
+
+/** Heap block description, see memmgr_heap_get_blocks */
+typedef struct {
+    uint32_t address; /**< Address of block data */
+    uint32_t size; /**< Block size, header included */
+    FuriThreadId thread_id; /**< Owner thread, NULL if not known */
+    uint32_t caller; /**< Allocation call site, 0 if not known */
+    bool allocated;
+} MemmgrHeapBlock;
+
+/** Heap state sample, see memmgr_heap_sampling_start */
+typedef struct {
+    uint32_t tick; /**< Kernel tick of the sample */
+    uint32_t free; /**< Free bytes */
+    uint32_t max_free_block; /**< Biggest free block */
+    uint32_t free_blocks; /**< Free blocks count */
+    uint32_t allocated_blocks; /**< Allocated blocks count */
+} MemmgrHeapSample;
+
 /** Memmgr heap enable thread allocation tracking
  *
  * @param      thread_id  - thread id to track
@@ -34,6 +60,38 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id);
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id);
 
+/** Memmgr heap get thread allocation statistics
+ *
+ * @param      thread_id  - thread id to track
+ * @param      stats      - pointer to MemmgrHeapThreadStats to fill
+ *
+ * @return     true if thread trace is enabled and stats were filled
+ */
+bool memmgr_heap_get_thread_stats(FuriThreadId thread_id, MemmgrHeapThreadStats* stats);
+
+/** Memmgr heap reset thread allocation statistics
+ *
+ * Peak is set to current allocation, allocation count is zeroed.
+ *
+ * @param      thread_id  - thread id to track
+ */
+void memmgr_heap_reset_thread_stats(FuriThreadId thread_id);
+
+/** Account allocated block to current thread, if it is traced
+ *
+ * Used by allocators that hand out the same block multiple times without
+ * going through the heap.
+ *
+ * @param      pointer  - block returned by malloc
+ */
+void memmgr_heap_trace_attach(void* pointer);
+
+/** Remove allocated block from the account of the thread that owns it
+ *
+ * @param      pointer  - block returned by malloc
+ */
+void memmgr_heap_trace_detach(void* pointer);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
@@ -44,6 +102,56 @@ size_t memmgr_heap_get_max_free_block(void);
  */
 void memmgr_heap_printf_free_blocks(void);
 
+/** Memmgr heap check if blocks carry owner thread and call site
+ *
+ * Enabled with `./fbt HEAP_TRACE=1`, costs 8 bytes per heap block. Without
+ * it owner is only known for blocks of threads with enabled trace.
+ *
+ * @return     true if owner and call site are recorded for every block
+ */
+bool memmgr_heap_is_owner_trace_available(void);
+
+/** Memmgr heap get blocks in address order
+ *
+ * Heap is walked with scheduler suspended, call repeatedly with address
+ * following the last returned block to get the whole map piece by piece.
+ *
+ * @param      address  - start address, blocks with data below it are skipped
+ * @param      blocks   - array to fill
+ * @param      count    - array size
+ *
+ * @return     number of blocks filled, 0 after the last block
+ */
+size_t memmgr_heap_get_blocks(uint32_t address, MemmgrHeapBlock* blocks, size_t count);
+
+/** Memmgr heap take heap state sample right now
+ *
+ * @param      sample   - pointer to MemmgrHeapSample to fill
+ */
+void memmgr_heap_get_sample(MemmgrHeapSample* sample);
+
+/** Memmgr heap start periodic sampling into ring buffer
+ *
+ * Samples of previous run are dropped.
+ *
+ * @param      interval  - sampling interval in ticks
+ * @param      capacity  - ring buffer size in samples, oldest are overwritten
+ */
+void memmgr_heap_sampling_start(uint32_t interval, size_t capacity);
+
+/** Memmgr heap stop periodic sampling, collected samples are kept
+ */
+void memmgr_heap_sampling_stop(void);
+
+/** Memmgr heap get collected sample
+ *
+ * @param      index    - sample index, 0 is the oldest one
+ * @param      sample   - pointer to MemmgrHeapSample to fill
+ *
+ * @return     false if there is no sample with such index
+ */
+bool memmgr_heap_sampling_get(size_t index, MemmgrHeapSample* sample);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,7 @@
 
 #include "kernel.h"
 #include "check.h"
+#include "trace.h"
 
 #include "event_loop_link_i.h"
 
@@ -63,6 +64,7 @@ FuriStatus
     BaseType_t yield;
 
     stat = FuriStatusOk;
+    FURI_TRACE_BEGIN(MessageQueuePut, instance);
 
     if(furi_kernel_is_irq_or_masked() != 0U) {
         if((msg_ptr == NULL) || (timeout != 0U)) {
@@ -91,8 +93,10 @@ FuriStatus
     }
 
     if(stat == FuriStatusOk) {
+        FURI_TRACE_COUNTER(MessageQueueDepth, instance->container.uxMessagesWaiting);
         furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
     }
+    FURI_TRACE_END(MessageQueuePut, instance);
 
     /* Return execution status */
     return stat;
@@ -106,6 +110,7 @@ FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uin
     BaseType_t yield;
 
     stat = FuriStatusOk;
+    FURI_TRACE_BEGIN(MessageQueueGet, instance);
 
     if(furi_kernel_is_irq_or_masked() != 0U) {
         if((msg_ptr == NULL) || (timeout != 0U)) {
@@ -136,6 +141,80 @@ FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uin
     if(stat == FuriStatusOk) {
         furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
     }
+    FURI_TRACE_END(MessageQueueGet, instance);
+
+    return stat;
+}
+
+FuriStatus furi_message_queue_get_batch(
+    FuriMessageQueue* instance,
+    void* msg_ptr,
+    uint32_t* msg_count,
+    uint32_t timeout) {
+    furi_check(instance);
+    furi_check(msg_count);
+
+    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    uint8_t* msg_buffer = msg_ptr;
+    uint32_t msg_size = instance->container.uxItemSize;
+    uint32_t count = 0;
+    FuriStatus stat;
+    BaseType_t yield;
+
+    stat = FuriStatusOk;
+    FURI_TRACE_BEGIN(MessageQueueGet, instance);
+
+    if((msg_ptr == NULL) || (*msg_count == 0U)) {
+        stat = FuriStatusErrorParameter;
+    } else if(furi_kernel_is_irq_or_masked() != 0U) {
+        if(timeout != 0U) {
+            stat = FuriStatusErrorParameter;
+        } else {
+            yield = pdFALSE;
+
+            while((count < *msg_count) &&
+                  (xQueueReceiveFromISR(hQueue, &msg_buffer[count * msg_size], &yield) ==
+                   pdPASS)) {
+                count++;
+            }
+
+            if(count == 0U) {
+                stat = FuriStatusErrorResource;
+            } else {
+                portYIELD_FROM_ISR(yield);
+            }
+        }
+    } else {
+        // Only the first message is waited for, the rest is what is already there
+        if(xQueueReceive(hQueue, msg_buffer, (TickType_t)timeout) != pdPASS) {
+            if(timeout != 0U) {
+                stat = FuriStatusErrorTimeout;
+            } else {
+                stat = FuriStatusErrorResource;
+            }
+        } else {
+            count = 1;
+            yield = pdFALSE;
+
+            // Senders woken by the drain are not switched to before it is done
+            FURI_CRITICAL_ENTER();
+            while((count < *msg_count) &&
+                  (xQueueReceiveFromISR(hQueue, &msg_buffer[count * msg_size], &yield) ==
+                   pdPASS)) {
+                count++;
+            }
+            FURI_CRITICAL_EXIT();
+
+            portYIELD_FROM_ISR(yield);
+        }
+    }
+
+    *msg_count = count;
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+    FURI_TRACE_END(MessageQueueGet, instance);
 
     return stat;
 }
@@ -48,6 +48,24 @@ FuriStatus
  */
 FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout);
 
+/** Get up to msg_count messages from queue
+ *
+ * Waits for the first message only, then takes whatever else is already in
+ * the queue in one critical section. Out event is reported once per batch.
+ *
+ * @param      instance   pointer to FuriMessageQueue instance
+ * @param      msg_ptr    buffer for msg_count messages
+ * @param      msg_count  in: buffer capacity in messages, out: messages received
+ * @param[in]  timeout    The timeout for the first message
+ *
+ * @return     The furi status.
+ */
+FuriStatus furi_message_queue_get_batch(
+    FuriMessageQueue* instance,
+    void* msg_ptr,
+    uint32_t* msg_count,
+    uint32_t timeout);
+
 /** Get queue capacity
  *
  * @param      instance  pointer to FuriMessageQueue instance
@@ -0,0 +1,219 @@
+#include "object_pool.h"
+#include "check.h"
+#include "common_defines.h"
+#include "memmgr.h"
+#include "memmgr_heap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct FuriObjectPoolNode FuriObjectPoolNode;
+
+struct FuriObjectPoolNode {
+    FuriObjectPoolNode* next;
+};
+
+struct FuriObjectPool {
+    const char* name;
+    size_t object_size;
+    size_t cache_limit;
+
+    // Guarded by critical section, which is way shorter than heap lock
+    FuriObjectPoolNode* cache;
+    size_t cached;
+    size_t in_use;
+    size_t peak;
+    size_t hits;
+    size_t misses;
+
+    FuriObjectPool* next;
+};
+
+// Don't keep objects for reuse when free heap drops below this
+#define FURI_OBJECT_POOL_FREE_HEAP 4096
+
+// All pools, for statistics and trimming
+static FuriObjectPool* furi_object_pool_list = NULL;
+
+FuriObjectPool* furi_object_pool_alloc(const char* name, size_t object_size, size_t cache_limit) {
+    furi_check(name);
+    furi_check(object_size);
+
+    FuriObjectPool* pool = malloc(sizeof(FuriObjectPool));
+    pool->name = name;
+    // Cached objects store free list link in place
+    pool->object_size = MAX(object_size, sizeof(FuriObjectPoolNode));
+    pool->cache_limit = cache_limit;
+
+    FURI_CRITICAL_ENTER();
+    pool->next = furi_object_pool_list;
+    furi_object_pool_list = pool;
+    FURI_CRITICAL_EXIT();
+
+    return pool;
+}
+
+FuriObjectPool* furi_object_pool_alloc_once(
+    FuriObjectPool** pool,
+    const char* name,
+    size_t object_size,
+    size_t cache_limit) {
+    furi_check(pool);
+
+    FuriObjectPool* instance = __atomic_load_n(pool, __ATOMIC_ACQUIRE);
+    if(instance) return instance;
+
+    FuriObjectPool* new_instance = furi_object_pool_alloc(name, object_size, cache_limit);
+    if(__atomic_compare_exchange_n(
+           pool, &instance, new_instance, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        instance = new_instance;
+    } else {
+        // Another thread was first, instance now holds its pool
+        furi_object_pool_free(new_instance);
+    }
+
+    return instance;
+}
+
+void furi_object_pool_free(FuriObjectPool* pool) {
+    furi_check(pool);
+    furi_check(pool->in_use == 0);
+
+    FURI_CRITICAL_ENTER();
+    FuriObjectPool** link = &furi_object_pool_list;
+    while(*link != pool) {
+        link = &(*link)->next;
+    }
+    *link = pool->next;
+    FURI_CRITICAL_EXIT();
+
+    furi_object_pool_trim(pool);
+    free(pool);
+}
+
+void* furi_object_pool_get(FuriObjectPool* pool) {
+    furi_check(pool);
+
+    FURI_CRITICAL_ENTER();
+    FuriObjectPoolNode* node = pool->cache;
+    if(node) {
+        pool->cache = node->next;
+        pool->cached--;
+        pool->hits++;
+    } else {
+        pool->misses++;
+    }
+    pool->in_use++;
+    if(pool->in_use > pool->peak) {
+        pool->peak = pool->in_use;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(node) {
+        memset(node, 0, pool->object_size);
+        memmgr_heap_trace_attach(node);
+        return node;
+    }
+
+    return malloc(pool->object_size);
+}
+
+void furi_object_pool_put(FuriObjectPool* pool, void* object) {
+    furi_check(pool);
+    furi_check(object);
+
+    if(memmgr_get_free_heap() < FURI_OBJECT_POOL_FREE_HEAP) {
+        // Heap is running low: give back this object and everything cached
+        FURI_CRITICAL_ENTER();
+        furi_check(pool->in_use > 0);
+        pool->in_use--;
+        FURI_CRITICAL_EXIT();
+
+        free(object);
+        furi_object_pool_trim_all();
+        return;
+    }
+
+    // Detach before publishing: once in cache, object may be taken by another thread
+    bool cache = pool->cached < pool->cache_limit;
+    if(cache) {
+        memmgr_heap_trace_detach(object);
+    }
+
+    FuriObjectPoolNode* node = object;
+    FURI_CRITICAL_ENTER();
+    furi_check(pool->in_use > 0);
+    pool->in_use--;
+    cache = cache && (pool->cached < pool->cache_limit);
+    if(cache) {
+        node->next = pool->cache;
+        pool->cache = node;
+        pool->cached++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(!cache) {
+        free(object);
+    }
+}
+
+void furi_object_pool_trim(FuriObjectPool* pool) {
+    furi_check(pool);
+
+    FURI_CRITICAL_ENTER();
+    FuriObjectPoolNode* node = pool->cache;
+    pool->cache = NULL;
+    pool->cached = 0;
+    FURI_CRITICAL_EXIT();
+
+    while(node) {
+        FuriObjectPoolNode* next = node->next;
+        free(node);
+        node = next;
+    }
+}
+
+void furi_object_pool_trim_all(void) {
+    // Pools are only removed by their owners, who must not be trimming them at the same time
+    FuriObjectPool* pool = __atomic_load_n(&furi_object_pool_list, __ATOMIC_ACQUIRE);
+    while(pool) {
+        furi_object_pool_trim(pool);
+        pool = pool->next;
+    }
+}
+
+static void furi_object_pool_fill_stats(FuriObjectPool* pool, FuriObjectPoolStats* stats) {
+    stats->name = pool->name;
+    stats->object_size = pool->object_size;
+    stats->cache_limit = pool->cache_limit;
+    stats->cached = pool->cached;
+    stats->in_use = pool->in_use;
+    stats->peak = pool->peak;
+    stats->hits = pool->hits;
+    stats->misses = pool->misses;
+}
+
+void furi_object_pool_get_stats(FuriObjectPool* pool, FuriObjectPoolStats* stats) {
+    furi_check(pool);
+    furi_check(stats);
+
+    FURI_CRITICAL_ENTER();
+    furi_object_pool_fill_stats(pool, stats);
+    FURI_CRITICAL_EXIT();
+}
+
+bool furi_object_pool_get_stats_by_index(size_t index, FuriObjectPoolStats* stats) {
+    furi_check(stats);
+
+    FURI_CRITICAL_ENTER();
+    FuriObjectPool* pool = furi_object_pool_list;
+    while(pool && index--) {
+        pool = pool->next;
+    }
+    if(pool) {
+        furi_object_pool_fill_stats(pool, stats);
+    }
+    FURI_CRITICAL_EXIT();
+
+    return pool != NULL;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file object_pool.h
+ * Furi: fixed size object pools
+ *
+ * Pool keeps a limited number of freed objects of one size and hands them
+ * out again without going through the heap. Objects returned by the pool
+ * are zeroed, same as malloc results. Cached objects are not accounted to
+ * any thread by heap trace, objects in use are accounted to the thread that
+ * took them from the pool.
+ *
+ * Cached objects of all pools are freed when an application exits, when free
+ * heap runs low and before an allocation is reported as failed.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriObjectPool FuriObjectPool;
+
+typedef struct {
+    const char* name;
+    size_t object_size;
+    size_t cache_limit; /**< maximum number of cached objects */
+    size_t cached; /**< objects kept for reuse */
+    size_t in_use; /**< objects taken from the pool and not returned yet */
+    size_t peak; /**< maximum of in_use */
+    size_t hits; /**< objects served from cache */
+    size_t misses; /**< objects allocated from heap */
+} FuriObjectPoolStats;
+
+/** Allocate object pool
+ *
+ * @param[in]  name         Pool name for statistics, must be static
+ * @param[in]  object_size  Object size
+ * @param[in]  cache_limit  Maximum number of objects to keep for reuse
+ *
+ * @return     pointer to FuriObjectPool instance
+ */
+FuriObjectPool* furi_object_pool_alloc(const char* name, size_t object_size, size_t cache_limit);
+
+/** Allocate object pool on first use
+ *
+ * For pools stored in static variables, safe to call from multiple threads.
+ *
+ * @param      pool         Location of the pool pointer, NULL initialized
+ * @param[in]  name         Pool name for statistics, must be static
+ * @param[in]  object_size  Object size
+ * @param[in]  cache_limit  Maximum number of objects to keep for reuse
+ *
+ * @return     pointer to FuriObjectPool instance stored in pool
+ */
+FuriObjectPool* furi_object_pool_alloc_once(
+    FuriObjectPool** pool,
+    const char* name,
+    size_t object_size,
+    size_t cache_limit);
+
+/** Free object pool and cached objects
+ *
+ * @warning    All objects must be returned to the pool
+ *
+ * @param      pool  pointer to FuriObjectPool instance
+ */
+void furi_object_pool_free(FuriObjectPool* pool);
+
+/** Take zeroed object from the pool
+ *
+ * @param      pool  pointer to FuriObjectPool instance
+ *
+ * @return     pointer to object of pool object size
+ */
+void* furi_object_pool_get(FuriObjectPool* pool);
+
+/** Return object to the pool
+ *
+ * Object is cached if there is room for it, freed otherwise.
+ *
+ * @param      pool    pointer to FuriObjectPool instance
+ * @param      object  Object taken from the same pool
+ */
+void furi_object_pool_put(FuriObjectPool* pool, void* object);
+
+/** Free cached objects
+ *
+ * @param      pool  pointer to FuriObjectPool instance
+ */
+void furi_object_pool_trim(FuriObjectPool* pool);
+
+/** Free cached objects of all pools */
+void furi_object_pool_trim_all(void);
+
+/** Get pool statistics
+ *
+ * @param      pool   pointer to FuriObjectPool instance
+ * @param      stats  pointer to FuriObjectPoolStats to fill
+ */
+void furi_object_pool_get_stats(FuriObjectPool* pool, FuriObjectPoolStats* stats);
+
+/** Get statistics of pool by index, for listing all pools
+ *
+ * @param[in]  index  Pool index
+ * @param      stats  pointer to FuriObjectPoolStats to fill
+ *
+ * @return     false if there is no pool with such index
+ */
+bool furi_object_pool_get_stats_by_index(size_t index, FuriObjectPoolStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,27 +1,96 @@
 #include "pubsub.h"
 #include "check.h"
+#include "common_defines.h"
+#include "kernel.h"
 #include "mutex.h"
+#include "thread.h"
 
-#include <m-list.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct FuriPubSubDelivery FuriPubSubDelivery;
+
+/** Callback call in progress, lives on the publisher stack */
+struct FuriPubSubDelivery {
+    FuriThreadId thread_id;
+    FuriPubSubDelivery* next;
+};
 
 struct FuriPubSubSubscription {
     FuriPubSubCallback callback;
     void* callback_context;
+    FuriMessageQueue* queue;
+    size_t dropped_count;
+    // Number of snapshots that contain this subscription
+    size_t refs;
+    // Number of publishers delivering to this subscription right now
+    size_t active;
+    // Callback calls in progress, guarded by critical section
+    FuriPubSubDelivery* deliveries;
+    bool removed;
 };
 
-LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
+/** Immutable list of subscriptions, replaced on every (un)subscribe */
+typedef struct {
+    size_t refs;
+    size_t count;
+    FuriPubSubSubscription* items[];
+} FuriPubSubSnapshot;
 
 struct FuriPubSub {
-    FuriPubSubSubscriptionList_t items;
+    FuriPubSubSnapshot* snapshot;
+    // Serializes writers, never held while delivering
     FuriMutex* mutex;
 };
 
+static FuriPubSubSnapshot* furi_pubsub_snapshot_alloc(size_t count) {
+    FuriPubSubSnapshot* snapshot =
+        malloc(sizeof(FuriPubSubSnapshot) + count * sizeof(FuriPubSubSubscription*));
+    snapshot->refs = 1;
+    snapshot->count = count;
+    return snapshot;
+}
+
+static FuriPubSubSnapshot* furi_pubsub_snapshot_acquire(FuriPubSub* pubsub) {
+    FURI_CRITICAL_ENTER();
+    // Pointer swap is done in critical section too, so snapshot can't be freed in between
+    FuriPubSubSnapshot* snapshot = pubsub->snapshot;
+    __atomic_add_fetch(&snapshot->refs, 1, __ATOMIC_SEQ_CST);
+    FURI_CRITICAL_EXIT();
+
+    return snapshot;
+}
+
+static void furi_pubsub_snapshot_release(FuriPubSubSnapshot* snapshot) {
+    if(__atomic_sub_fetch(&snapshot->refs, 1, __ATOMIC_SEQ_CST) > 0) return;
+
+    for(size_t i = 0; i < snapshot->count; i++) {
+        FuriPubSubSubscription* item = snapshot->items[i];
+        // Last snapshot that knows about unsubscribed item
+        if(__atomic_sub_fetch(&item->refs, 1, __ATOMIC_SEQ_CST) == 0) {
+            free(item);
+        }
+    }
+
+    free(snapshot);
+}
+
+// Old snapshot is left to the caller to release
+static void furi_pubsub_snapshot_swap(FuriPubSub* pubsub, FuriPubSubSnapshot* snapshot) {
+    for(size_t i = 0; i < snapshot->count; i++) {
+        __atomic_add_fetch(&snapshot->items[i]->refs, 1, __ATOMIC_SEQ_CST);
+    }
+
+    FURI_CRITICAL_ENTER();
+    pubsub->snapshot = snapshot;
+    FURI_CRITICAL_EXIT();
+}
+
 FuriPubSub* furi_pubsub_alloc(void) {
     FuriPubSub* pubsub = malloc(sizeof(FuriPubSub));
 
     pubsub->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
-
-    FuriPubSubSubscriptionList_init(pubsub->items);
+    pubsub->snapshot = furi_pubsub_snapshot_alloc(0);
 
     return pubsub;
 }
@@ -29,31 +98,89 @@ FuriPubSub* furi_pubsub_alloc(void) {
 void furi_pubsub_free(FuriPubSub* pubsub) {
     furi_assert(pubsub);
 
-    furi_check(FuriPubSubSubscriptionList_size(pubsub->items) == 0);
+    furi_check(pubsub->snapshot->count == 0);
 
-    FuriPubSubSubscriptionList_clear(pubsub->items);
+    furi_pubsub_snapshot_release(pubsub->snapshot);
 
     furi_mutex_free(pubsub->mutex);
 
     free(pubsub);
 }
 
+static FuriPubSubSubscription*
+    furi_pubsub_subscribe_item(FuriPubSub* pubsub, FuriPubSubSubscription* item) {
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+
+    FuriPubSubSnapshot* old_snapshot = pubsub->snapshot;
+    FuriPubSubSnapshot* snapshot = furi_pubsub_snapshot_alloc(old_snapshot->count + 1);
+    memcpy(
+        snapshot->items,
+        old_snapshot->items,
+        old_snapshot->count * sizeof(FuriPubSubSubscription*));
+    snapshot->items[old_snapshot->count] = item;
+
+    furi_pubsub_snapshot_swap(pubsub, snapshot);
+
+    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+
+    furi_pubsub_snapshot_release(old_snapshot);
+
+    return item;
+}
+
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context) {
     furi_check(pubsub);
     furi_check(callback);
 
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    // put uninitialized item to the list
-    FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
-
-    // initialize item
+    FuriPubSubSubscription* item = malloc(sizeof(FuriPubSubSubscription));
     item->callback = callback;
     item->callback_context = callback_context;
 
-    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+    return furi_pubsub_subscribe_item(pubsub, item);
+}
 
-    return item;
+FuriPubSubSubscription* furi_pubsub_subscribe_queue(FuriPubSub* pubsub, FuriMessageQueue* queue) {
+    furi_check(pubsub);
+    furi_check(queue);
+
+    FuriPubSubSubscription* item = malloc(sizeof(FuriPubSubSubscription));
+    item->queue = queue;
+
+    return furi_pubsub_subscribe_item(pubsub, item);
+}
+
+// Number of callback calls for this subscription in progress in given thread
+static size_t furi_pubsub_subscription_get_deliveries(
+    FuriPubSubSubscription* pubsub_subscription,
+    FuriThreadId thread_id) {
+    size_t count = 0;
+
+    FURI_CRITICAL_ENTER();
+    for(FuriPubSubDelivery* delivery = pubsub_subscription->deliveries; delivery;
+        delivery = delivery->next) {
+        if(delivery->thread_id == thread_id) count++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return count;
+}
+
+static void furi_pubsub_delivery_push(FuriPubSubSubscription* item, FuriPubSubDelivery* delivery) {
+    FURI_CRITICAL_ENTER();
+    delivery->next = item->deliveries;
+    item->deliveries = delivery;
+    FURI_CRITICAL_EXIT();
+}
+
+static void furi_pubsub_delivery_pop(FuriPubSubSubscription* item, FuriPubSubDelivery* delivery) {
+    FURI_CRITICAL_ENTER();
+    FuriPubSubDelivery** link = &item->deliveries;
+    while(*link != delivery) {
+        link = &(*link)->next;
+    }
+    *link = delivery->next;
+    FURI_CRITICAL_EXIT();
 }
 
 void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_subscription) {
@@ -61,38 +188,70 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
     furi_assert(pubsub_subscription);
 
     furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    bool result = false;
 
-    // iterate over items
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
+    FuriPubSubSnapshot* old_snapshot = pubsub->snapshot;
+    furi_check(old_snapshot->count > 0);
+    FuriPubSubSnapshot* snapshot = furi_pubsub_snapshot_alloc(old_snapshot->count - 1);
+    size_t count = 0;
+    bool result = false;
 
-        // if the iterator is equal to our element
-        if(item == pubsub_subscription) {
-            FuriPubSubSubscriptionList_remove(pubsub->items, it);
+    for(size_t i = 0; i < old_snapshot->count; i++) {
+        if(old_snapshot->items[i] == pubsub_subscription) {
             result = true;
-            break;
+        } else if(count < snapshot->count) {
+            snapshot->items[count++] = old_snapshot->items[i];
         }
     }
+    furi_check(result);
+
+    __atomic_store_n(&pubsub_subscription->removed, true, __ATOMIC_SEQ_CST);
+    furi_pubsub_snapshot_swap(pubsub, snapshot);
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
-    furi_check(result);
+
+    // Publishers that got in before removal must leave, except our own deliveries down the stack
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    while(__atomic_load_n(&pubsub_subscription->active, __ATOMIC_SEQ_CST) !=
+          furi_pubsub_subscription_get_deliveries(pubsub_subscription, thread_id)) {
+        furi_delay_tick(1);
+    }
+
+    // Subscription is freed together with the last snapshot that contains it
+    furi_pubsub_snapshot_release(old_snapshot);
+}
+
+size_t furi_pubsub_subscription_get_dropped_count(FuriPubSubSubscription* pubsub_subscription) {
+    furi_check(pubsub_subscription);
+
+    return __atomic_load_n(&pubsub_subscription->dropped_count, __ATOMIC_SEQ_CST);
 }
 
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
     furi_check(pubsub);
 
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+    FuriPubSubSnapshot* snapshot = furi_pubsub_snapshot_acquire(pubsub);
+
+    for(size_t i = 0; i < snapshot->count; i++) {
+        FuriPubSubSubscription* item = snapshot->items[i];
 
-    // iterate over subscribers
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
-        item->callback(message, item->callback_context);
+        __atomic_add_fetch(&item->active, 1, __ATOMIC_SEQ_CST);
+
+        if(!__atomic_load_n(&item->removed, __ATOMIC_SEQ_CST)) {
+            if(item->queue) {
+                if(furi_message_queue_put(item->queue, message, 0) != FuriStatusOk) {
+                    __atomic_add_fetch(&item->dropped_count, 1, __ATOMIC_SEQ_CST);
+                }
+            } else {
+                // Registered while active is held, so unsubscribe can tell own calls apart
+                FuriPubSubDelivery delivery = {.thread_id = furi_thread_get_current_id()};
+                furi_pubsub_delivery_push(item, &delivery);
+                item->callback(message, item->callback_context);
+                furi_pubsub_delivery_pop(item, &delivery);
+            }
+        }
+
+        __atomic_sub_fetch(&item->active, 1, __ATOMIC_SEQ_CST);
     }
 
-    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+    furi_pubsub_snapshot_release(snapshot);
 }
@@ -1,8 +1,14 @@
 /**
  * @file pubsub.h
  * FuriPubSub
+ *
+ * Publisher delivers to an immutable snapshot of subscriptions, no lock is
+ * held while callbacks run. Callbacks may (un)subscribe, and callbacks of
+ * publishers running in different threads may run concurrently.
  */
 #pragma once
+#include "base.h"
+#include "message_queue.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,9 +50,28 @@ void furi_pubsub_free(FuriPubSub* pubsub);
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context);
 
+/** Subscribe to FuriPubSub with message queue
+ *
+ * Messages are copied to the queue instead of running a callback, so heavy
+ * consumers can handle them in their own thread or event loop. Publisher does
+ * not wait: if the queue is full, message is dropped and counted.
+ *
+ * Threadsafe, Reentrable
+ *
+ * @warning    queue message size must not exceed the size of published messages
+ *
+ * @param      pubsub  pointer to FuriPubSub instance
+ * @param      queue   pointer to FuriMessageQueue instance, must outlive subscription
+ *
+ * @return     pointer to FuriPubSubSubscription instance
+ */
+FuriPubSubSubscription* furi_pubsub_subscribe_queue(FuriPubSub* pubsub, FuriMessageQueue* queue);
+
 /** Unsubscribe from FuriPubSub
  * 
  * No use of `pubsub_subscription` allowed after call of this method
+ * Waits for publishers that are delivering to this subscription, so callback
+ * context and queue can be freed right after. Can be called from the callback.
  * Threadsafe, Reentrable.
  *
  * @param      pubsub               pointer to FuriPubSub instance
@@ -54,6 +79,14 @@ FuriPubSubSubscription*
  */
 void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_subscription);
 
+/** Get number of messages dropped because subscription queue was full
+ *
+ * @param      pubsub_subscription  pointer to FuriPubSubSubscription instance
+ *
+ * @return     number of dropped messages, always 0 for callback subscription
+ */
+size_t furi_pubsub_subscription_get_dropped_count(FuriPubSubSubscription* pubsub_subscription);
+
 /** Publish message to FuriPubSub
  *
  * Threadsafe, Reentrable.
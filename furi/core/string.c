@@ -1,10 +1,26 @@
 #include "string.h"
+#include "object_pool.h"
 #include <m-string.h>
 
+// Strings come and go all the time: log lines, file parsing, keys
+#define FURI_STRING_POOL_CACHE_LIMIT 32
+
 struct FuriString {
     string_t string;
 };
 
+static FuriObjectPool* furi_string_pool = NULL;
+
+static FuriString* furi_string_alloc_object(void) {
+    FuriObjectPool* pool = furi_object_pool_alloc_once(
+        &furi_string_pool, "FuriString", sizeof(FuriString), FURI_STRING_POOL_CACHE_LIMIT);
+    return furi_object_pool_get(pool);
+}
+
+static void furi_string_free_object(FuriString* string) {
+    furi_object_pool_put(furi_string_pool, string);
+}
+
 #undef furi_string_alloc_set
 #undef furi_string_set
 #undef furi_string_cmp
@@ -24,19 +40,19 @@ struct FuriString {
 #undef furi_string_cat
 
 FuriString* furi_string_alloc(void) {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = furi_string_alloc_object();
     string_init(string->string);
     return string;
 }
 
 FuriString* furi_string_alloc_set(const FuriString* s) {
-    FuriString* string = malloc(sizeof(FuriString)); //-V799
+    FuriString* string = furi_string_alloc_object(); //-V799
     string_init_set(string->string, s->string);
     return string;
 } //-V773
 
 FuriString* furi_string_alloc_set_str(const char cstr[]) {
-    FuriString* string = malloc(sizeof(FuriString)); //-V799
+    FuriString* string = furi_string_alloc_object(); //-V799
     string_init_set(string->string, cstr);
     return string;
 } //-V773
@@ -50,21 +66,21 @@ FuriString* furi_string_alloc_printf(const char format[], ...) {
 }
 
 FuriString* furi_string_alloc_vprintf(const char format[], va_list args) {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = furi_string_alloc_object();
     string_init_vprintf(string->string, format, args);
     return string;
 }
 
 FuriString* furi_string_alloc_move(FuriString* s) {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = furi_string_alloc_object();
     string_init_move(string->string, s->string);
-    free(s);
+    furi_string_free_object(s);
     return string;
 }
 
 void furi_string_free(FuriString* s) {
     string_clear(s->string);
-    free(s);
+    furi_string_free_object(s);
 }
 
 void furi_string_reserve(FuriString* s, size_t alloc) {
@@ -83,7 +99,7 @@ void furi_string_swap(FuriString* v1, FuriString* v2) {
 void furi_string_move(FuriString* v1, FuriString* v2) {
     string_clear(v1->string);
     string_init_move(v1->string, v2->string);
-    free(v2);
+    furi_string_free_object(v2);
 }
 
 size_t furi_string_hash(const FuriString* v) {
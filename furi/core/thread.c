@@ -1,5 +1,6 @@
 #include "thread_i.h"
 #include "thread_list_i.h"
+#include "trace_i.h"
 #include "kernel.h"
 #include "message_queue.h"
 #include "memmgr.h"
@@ -26,10 +27,21 @@
 
 #define THREAD_STACK_WATERMARK_MIN (256u)
 
+// Host target runs threads on native stacks, which are much hungrier
+#ifndef FURI_THREAD_STACK_SCALE
+#define FURI_THREAD_STACK_SCALE (1u)
+#endif
+
+#define THREAD_STDOUT_BUFFER_SIZE (256u)
+
+// Output ring, allocated on first buffered write and released on thread exit
 typedef struct {
     FuriThreadStdoutWriteCallback write_callback;
-    FuriString* buffer;
     void* context;
+    char* buffer;
+    uint16_t head;
+    uint16_t count;
+    FuriThreadStdoutBuffering buffering;
 } FuriThreadStdout;
 
 typedef struct {
@@ -69,6 +81,10 @@ struct FuriThread {
     // this ensures that the size of this structure is minimal
     bool is_service;
     bool heap_trace_enabled;
+
+#ifdef FURI_TRACE
+    FuriTraceBuffer* trace_buffer;
+#endif
 };
 
 // IMPORTANT: container MUST be the FIRST struct member
@@ -81,6 +97,7 @@ static FuriMessageQueue* furi_thread_scrub_message_queue = NULL;
 
 static size_t __furi_thread_stdout_write(FuriThread* thread, const char* data, size_t size);
 static int32_t __furi_thread_stdout_flush(FuriThread* thread);
+static void __furi_thread_stdout_release(FuriThread* thread);
 
 /** Catch threads that are trying to exit wrong way */
 __attribute__((__noreturn__)) void furi_thread_catch(void) { //-V1082
@@ -107,6 +124,10 @@ static void furi_thread_body(void* context) {
     furi_check(pvTaskGetThreadLocalStoragePointer(NULL, 0) == NULL);
     vTaskSetThreadLocalStoragePointer(NULL, 0, thread);
 
+#ifdef FURI_TRACE
+    thread->trace_buffer = furi_trace_buffer_alloc((FuriThreadId)thread, thread->name);
+#endif
+
     furi_check(thread->state == FuriThreadStateStarting);
     furi_thread_set_state(thread, FuriThreadStateRunning);
 
@@ -130,6 +151,9 @@ static void furi_thread_body(void* context) {
             stack_watermark);
     }
 
+    // flush stdout, buffer is thread's own allocation
+    __furi_thread_stdout_release(thread);
+
     if(thread->heap_trace_enabled == true) {
         furi_delay_ms(33);
         thread->heap_size = memmgr_heap_get_thread_memory((FuriThreadId)thread);
@@ -144,9 +168,6 @@ static void furi_thread_body(void* context) {
 
     furi_check(thread->state == FuriThreadStateRunning);
 
-    // flush stdout
-    __furi_thread_stdout_flush(thread);
-
     furi_thread_set_state(thread, FuriThreadStateStopping);
 
     furi_message_queue_put(furi_thread_scrub_message_queue, &thread, FuriWaitForever);
@@ -156,7 +177,6 @@ static void furi_thread_body(void* context) {
 }
 
 static void furi_thread_init_common(FuriThread* thread) {
-    thread->output.buffer = furi_string_alloc();
     thread->input.unread_buffer = furi_string_alloc();
 
     FuriThread* parent = NULL;
@@ -206,6 +226,11 @@ void furi_thread_scrub(void) {
         furi_check(pvTaskGetThreadLocalStoragePointer(task, 0) == thread_to_scrub);
         vTaskSetThreadLocalStoragePointer(task, 0, NULL);
 
+#ifdef FURI_TRACE
+        furi_trace_buffer_retire(thread_to_scrub->trace_buffer);
+        thread_to_scrub->trace_buffer = NULL;
+#endif
+
         // Deliver thread stopped callback
         furi_thread_set_state(thread_to_scrub, FuriThreadStateStopped);
     }
@@ -228,7 +253,7 @@ FuriThread* furi_thread_alloc_service(
 
     furi_thread_init_common(thread);
 
-    thread->stack_buffer = memmgr_alloc_from_pool(stack_size);
+    thread->stack_buffer = memmgr_alloc_from_pool(stack_size * FURI_THREAD_STACK_SCALE);
     thread->stack_size = stack_size;
     thread->is_service = true;
 
@@ -266,7 +291,7 @@ void furi_thread_free(FuriThread* thread) {
         free(thread->stack_buffer);
     }
 
-    furi_string_free(thread->output.buffer);
+    free(thread->output.buffer);
     furi_string_free(thread->input.unread_buffer);
     free(thread);
 }
@@ -306,7 +331,7 @@ void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
         free(thread->stack_buffer);
     }
 
-    thread->stack_buffer = malloc(stack_size);
+    thread->stack_buffer = malloc(stack_size * FURI_THREAD_STACK_SCALE);
     thread->stack_size = stack_size;
 }
 
@@ -398,7 +423,7 @@ void furi_thread_start(FuriThread* thread) {
 
     furi_thread_set_state(thread, FuriThreadStateStarting);
 
-    uint32_t stack_depth = thread->stack_size / sizeof(StackType_t);
+    uint32_t stack_depth = thread->stack_size * FURI_THREAD_STACK_SCALE / sizeof(StackType_t);
 
     furi_check(
         xTaskCreateStatic(
@@ -467,6 +492,12 @@ FuriThread* furi_thread_get_current(void) {
     return thread;
 }
 
+#ifdef FURI_TRACE
+FuriTraceBuffer* furi_thread_get_trace_buffer(FuriThread* thread) {
+    return thread->trace_buffer;
+}
+#endif
+
 void furi_thread_yield(void) {
     furi_check(!FURI_IS_IRQ_MODE());
     taskYIELD();
@@ -752,16 +783,81 @@ static size_t
     }
 }
 
+// Pass oldest `size` bytes of the ring to the callback, at most two writes
+static void __furi_thread_stdout_drain(FuriThread* thread, size_t size) {
+    FuriThreadStdout* output = &thread->output;
+    furi_assert(size <= output->count);
+
+    size_t first = MIN(size, THREAD_STDOUT_BUFFER_SIZE - output->head);
+    if(first) __furi_thread_stdout_write(thread, output->buffer + output->head, first);
+    if(size > first) __furi_thread_stdout_write(thread, output->buffer, size - first);
+
+    output->count -= size;
+    // Empty ring restarts at the beginning: keeps next drain in one piece
+    output->head = output->count ? (output->head + size) % THREAD_STDOUT_BUFFER_SIZE : 0;
+}
+
+// Append to the ring, draining it whenever it fills up
+static void __furi_thread_stdout_push(FuriThread* thread, const char* data, size_t size) {
+    FuriThreadStdout* output = &thread->output;
+    if(!output->buffer) {
+        output->buffer = malloc(THREAD_STDOUT_BUFFER_SIZE);
+    }
+
+    while(size) {
+        if(output->count == THREAD_STDOUT_BUFFER_SIZE) {
+            __furi_thread_stdout_drain(thread, output->count);
+        }
+
+        size_t tail = (output->head + output->count) % THREAD_STDOUT_BUFFER_SIZE;
+        size_t chunk = MIN(size, THREAD_STDOUT_BUFFER_SIZE - output->count);
+        chunk = MIN(chunk, THREAD_STDOUT_BUFFER_SIZE - tail);
+        memcpy(output->buffer + tail, data, chunk);
+
+        output->count += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
 static int32_t __furi_thread_stdout_flush(FuriThread* thread) {
-    FuriString* buffer = thread->output.buffer;
-    size_t size = furi_string_size(buffer);
-    if(size > 0) {
-        __furi_thread_stdout_write(thread, furi_string_get_cstr(buffer), size);
-        furi_string_reset(buffer);
+    if(thread->output.count > 0) {
+        __furi_thread_stdout_drain(thread, thread->output.count);
     }
     return 0;
 }
 
+static void __furi_thread_stdout_release(FuriThread* thread) {
+    __furi_thread_stdout_flush(thread);
+    free(thread->output.buffer);
+    thread->output.buffer = NULL;
+}
+
+static void __furi_thread_stdout_write_line(FuriThread* thread, const char* data, size_t size) {
+    // Find end of the last complete line
+    size_t lines_size = 0;
+    const char* newline = data;
+    while((newline = memchr(newline, '\n', size - (newline - data))) != NULL) {
+        newline++;
+        lines_size = newline - data;
+    }
+
+    if(lines_size) {
+        if(lines_size <= THREAD_STDOUT_BUFFER_SIZE - thread->output.count) {
+            // Short lines (printf writes char by char) join buffer for a single write
+            __furi_thread_stdout_push(thread, data, lines_size);
+            __furi_thread_stdout_flush(thread);
+        } else {
+            __furi_thread_stdout_flush(thread);
+            __furi_thread_stdout_write(thread, data, lines_size);
+        }
+    }
+
+    if(size > lines_size) {
+        __furi_thread_stdout_push(thread, data + lines_size, size - lines_size);
+    }
+}
+
 void furi_thread_get_stdout_callback(FuriThreadStdoutWriteCallback* callback, void** context) {
     FuriThread* thread = furi_thread_get_current();
     furi_check(thread);
@@ -788,6 +884,20 @@ void furi_thread_set_stdout_callback(FuriThreadStdoutWriteCallback callback, voi
     thread->output.context = context;
 }
 
+void furi_thread_set_stdout_buffering(FuriThreadStdoutBuffering buffering) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+    furi_check(buffering <= FuriThreadStdoutBufferingNone);
+    __furi_thread_stdout_flush(thread);
+    thread->output.buffering = buffering;
+}
+
+FuriThreadStdoutBuffering furi_thread_get_stdout_buffering(void) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+    return thread->output.buffering;
+}
+
 void furi_thread_set_stdin_callback(FuriThreadStdinReadCallback callback, void* context) {
     FuriThread* thread = furi_thread_get_current();
     furi_check(thread);
@@ -801,20 +911,25 @@ size_t furi_thread_stdout_write(const char* data, size_t size) {
 
     if(size == 0 || data == NULL) {
         return __furi_thread_stdout_flush(thread);
-    } else {
-        if(data[size - 1] == '\n') {
-            // if the last character is a newline, we can flush buffer and write data as is, wo buffers
+    }
+
+    switch(thread->output.buffering) {
+    case FuriThreadStdoutBufferingLine:
+        __furi_thread_stdout_write_line(thread, data, size);
+        break;
+    case FuriThreadStdoutBufferingBlock:
+        if(size < THREAD_STDOUT_BUFFER_SIZE) {
+            __furi_thread_stdout_push(thread, data, size);
+        } else {
+            // Large blocks skip the copy
             __furi_thread_stdout_flush(thread);
             __furi_thread_stdout_write(thread, data, size);
-        } else {
-            // string_cat doesn't work here because we need to write the exact size data
-            for(size_t i = 0; i < size; i++) {
-                furi_string_push_back(thread->output.buffer, data[i]);
-                if(data[i] == '\n') {
-                    __furi_thread_stdout_flush(thread);
-                }
-            }
         }
+        break;
+    case FuriThreadStdoutBufferingNone:
+        __furi_thread_stdout_flush(thread);
+        __furi_thread_stdout_write(thread, data, size);
+        break;
     }
 
     return size;
@@ -831,6 +946,9 @@ size_t furi_thread_stdin_read(char* buffer, size_t size, FuriWait timeout) {
     FuriThread* thread = furi_thread_get_current();
     furi_check(thread);
 
+    // Prompt must be visible before we block on input
+    __furi_thread_stdout_flush(thread);
+
     size_t from_buffer = MIN(furi_string_size(thread->input.unread_buffer), size);
     size_t from_input = size - from_buffer;
     size_t from_input_actual =
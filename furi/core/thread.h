@@ -78,6 +78,18 @@ typedef int32_t (*FuriThreadCallback)(void* context);
  */
 typedef void (*FuriThreadStdoutWriteCallback)(const char* data, size_t size, void* context);
 
+/**
+ * @brief Standard output buffering mode.
+ *
+ * Buffered data is always flushed by `furi_thread_stdout_flush()`, before
+ * reading standard input, on callback change and on thread exit.
+ */
+typedef enum {
+    FuriThreadStdoutBufferingLine, /**< Flush after every complete line (default) */
+    FuriThreadStdoutBufferingBlock, /**< Flush only when the buffer is full */
+    FuriThreadStdoutBufferingNone, /**< Pass data to the callback as it is written */
+} FuriThreadStdoutBuffering;
+
 /**
  * @brief Standard input callback function pointer type
  * 
@@ -499,6 +511,21 @@ void furi_thread_get_stdin_callback(FuriThreadStdinReadCallback* callback, void*
  */
 void furi_thread_set_stdout_callback(FuriThreadStdoutWriteCallback callback, void* context);
 
+/** Set standard output buffering mode for the current thread.
+ *
+ * Block buffering suits commands that stream large outputs: data reaches the
+ * callback in buffer sized chunks instead of line by line.
+ *
+ * @param[in] buffering buffering mode, pending data is flushed before the change
+ */
+void furi_thread_set_stdout_buffering(FuriThreadStdoutBuffering buffering);
+
+/** Get standard output buffering mode of the current thread.
+ *
+ * @return current buffering mode
+ */
+FuriThreadStdoutBuffering furi_thread_get_stdout_buffering(void);
+
 /** Set standard input callback for the current thread.
  * 
  * @param[in] callback pointer to the callback function or NULL to clear
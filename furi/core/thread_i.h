@@ -1,7 +1,18 @@
 #pragma once
 
 #include "thread.h"
+#include "trace_i.h"
 
 void furi_thread_init(void);
 
 void furi_thread_scrub(void);
+
+#ifdef FURI_TRACE
+/** Get trace buffer of the thread
+ *
+ * @param      thread  FuriThread instance
+ *
+ * @return     FuriTraceBuffer instance, NULL if not attached yet
+ */
+FuriTraceBuffer* furi_thread_get_trace_buffer(FuriThread* thread);
+#endif
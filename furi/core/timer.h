@@ -1,6 +1,10 @@
 /**
  * @file timer.h
  * @brief Furi software Timer API.
+ *
+ * Timers are served by the timer daemon thread. Code that runs many timers
+ * from one thread should prefer FuriEventLoopTimer, which does not wake the
+ * daemon and scales better with the number of timers.
  */
 #pragma once
 
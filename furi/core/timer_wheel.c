@@ -0,0 +1,172 @@
+#include "timer_wheel_i.h"
+#include "check.h"
+
+#define FURI_TIMER_WHEEL_SLOT_MASK (FURI_TIMER_WHEEL_SLOTS - 1U)
+// Timers that expire later are parked at the top level and come back on its turn
+#define FURI_TIMER_WHEEL_RANGE (1UL << (FURI_TIMER_WHEEL_SLOT_BITS * FURI_TIMER_WHEEL_LEVELS))
+
+static inline uint32_t furi_timer_wheel_level_shift(uint32_t level) {
+    return level * FURI_TIMER_WHEEL_SLOT_BITS;
+}
+
+static inline uint32_t furi_timer_wheel_rotate(uint32_t mask, uint32_t count) {
+    return ((mask >> count) | (mask << (FURI_TIMER_WHEEL_SLOTS - count))) &
+           ((1UL << FURI_TIMER_WHEEL_SLOTS) - 1U);
+}
+
+static void furi_timer_wheel_place(FuriTimerWheel* wheel, FuriTimerWheelNode* node) {
+    uint32_t delta = node->expire_time - wheel->time;
+    if((int32_t)delta < 0) {
+        delta = 0;
+    } else if(delta >= FURI_TIMER_WHEEL_RANGE) {
+        delta = FURI_TIMER_WHEEL_RANGE - 1U;
+    }
+
+    // Finest level that can hold the delta: slot is then reached before expiration
+    uint32_t level = 0;
+    while(level < FURI_TIMER_WHEEL_LEVELS - 1U &&
+          delta >= (1UL << furi_timer_wheel_level_shift(level + 1U))) {
+        level++;
+    }
+
+    uint32_t shift = furi_timer_wheel_level_shift(level);
+    uint32_t slot = ((wheel->time + delta) >> shift) & FURI_TIMER_WHEEL_SLOT_MASK;
+
+    FuriTimerWheelNode** head = &wheel->slots[level][slot];
+    node->next = *head;
+    node->pprev = head;
+    if(*head) {
+        (*head)->pprev = &node->next;
+    }
+    *head = node;
+
+    wheel->occupied[level] |= 1U << slot;
+}
+
+// Move timers of the slots that come into turn at current time to finer levels
+static void furi_timer_wheel_cascade(FuriTimerWheel* wheel) {
+    for(uint32_t level = FURI_TIMER_WHEEL_LEVELS - 1U; level > 0; level--) {
+        uint32_t shift = furi_timer_wheel_level_shift(level);
+        if(wheel->time & ((1UL << shift) - 1U)) continue;
+
+        uint32_t slot = (wheel->time >> shift) & FURI_TIMER_WHEEL_SLOT_MASK;
+        FuriTimerWheelNode* node = wheel->slots[level][slot];
+        wheel->slots[level][slot] = NULL;
+        wheel->occupied[level] &= ~(1U << slot);
+
+        while(node) {
+            FuriTimerWheelNode* next = node->next;
+            furi_timer_wheel_place(wheel, node);
+            node = next;
+        }
+    }
+}
+
+void furi_timer_wheel_init(FuriTimerWheel* wheel, uint32_t time) {
+    furi_check(wheel);
+
+    *wheel = (FuriTimerWheel){.time = time};
+}
+
+bool furi_timer_wheel_is_empty(const FuriTimerWheel* wheel) {
+    furi_check(wheel);
+
+    for(size_t level = 0; level < FURI_TIMER_WHEEL_LEVELS; level++) {
+        if(wheel->occupied[level]) return false;
+    }
+
+    return true;
+}
+
+void furi_timer_wheel_add(FuriTimerWheel* wheel, FuriTimerWheelNode* node, uint32_t expire_time) {
+    furi_check(wheel);
+    furi_check(node);
+    furi_check(!furi_timer_wheel_node_is_linked(node));
+
+    node->expire_time = expire_time;
+    furi_timer_wheel_place(wheel, node);
+}
+
+void furi_timer_wheel_remove(FuriTimerWheel* wheel, FuriTimerWheelNode* node) {
+    furi_check(wheel);
+    furi_check(node);
+    furi_check(furi_timer_wheel_node_is_linked(node));
+
+    FuriTimerWheelNode** pprev = node->pprev;
+    *pprev = node->next;
+    if(node->next) {
+        node->next->pprev = pprev;
+    }
+    node->next = NULL;
+    node->pprev = NULL;
+
+    // Only the first node of a slot points into the slot array
+    FuriTimerWheelNode** first_slot = &wheel->slots[0][0];
+    if(*pprev == NULL && pprev >= first_slot &&
+       pprev < first_slot + FURI_TIMER_WHEEL_LEVELS * FURI_TIMER_WHEEL_SLOTS) {
+        size_t index = pprev - first_slot;
+        wheel->occupied[index / FURI_TIMER_WHEEL_SLOTS] &=
+            ~(1U << (index % FURI_TIMER_WHEEL_SLOTS));
+    }
+}
+
+uint32_t furi_timer_wheel_get_next_time(const FuriTimerWheel* wheel) {
+    furi_check(wheel);
+
+    uint32_t distance = UINT32_MAX;
+
+    for(uint32_t level = 0; level < FURI_TIMER_WHEEL_LEVELS; level++) {
+        if(!wheel->occupied[level]) continue;
+
+        uint32_t shift = furi_timer_wheel_level_shift(level);
+        uint32_t current = (wheel->time >> shift) & FURI_TIMER_WHEEL_SLOT_MASK;
+        uint32_t level_distance;
+
+        if(level == 0) {
+            // Current slot expires now
+            uint32_t mask = furi_timer_wheel_rotate(wheel->occupied[0], current);
+            level_distance = __builtin_ctz(mask);
+        } else {
+            // Current slot has already come into turn, so it is the last one
+            uint32_t mask = furi_timer_wheel_rotate(
+                wheel->occupied[level], (current + 1U) & FURI_TIMER_WHEEL_SLOT_MASK);
+            uint32_t buckets = __builtin_ctz(mask) + 1U;
+            level_distance = (((wheel->time >> shift) + buckets) << shift) - wheel->time;
+        }
+
+        if(level_distance < distance) {
+            distance = level_distance;
+        }
+    }
+
+    furi_check(distance != UINT32_MAX);
+
+    return wheel->time + distance;
+}
+
+FuriTimerWheelNode* furi_timer_wheel_pop_expired(FuriTimerWheel* wheel, uint32_t now) {
+    furi_check(wheel);
+
+    while(true) {
+        if(furi_timer_wheel_is_empty(wheel)) {
+            if((int32_t)(now - wheel->time) > 0) wheel->time = now;
+            return NULL;
+        }
+
+        FuriTimerWheelNode* node = wheel->slots[0][wheel->time & FURI_TIMER_WHEEL_SLOT_MASK];
+        if(node) {
+            furi_timer_wheel_remove(wheel, node);
+            return node;
+        }
+
+        // Skip ticks with nothing to do at once
+        uint32_t next_time = furi_timer_wheel_get_next_time(wheel);
+        if((int32_t)(next_time - now) > 0) {
+            if((int32_t)(now - wheel->time) > 0) wheel->time = now;
+            return NULL;
+        }
+
+        wheel->time = next_time;
+        furi_timer_wheel_cascade(wheel);
+    }
+}
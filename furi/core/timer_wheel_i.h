@@ -0,0 +1,98 @@
+/**
+ * @file timer_wheel_i.h
+ * Hierarchical timer wheel
+ *
+ * Timers are kept in slots of FURI_TIMER_WHEEL_LEVELS wheels, every level
+ * being FURI_TIMER_WHEEL_SLOTS times coarser than the previous one. Adding
+ * and removing a timer is O(1), a timer is moved to a finer level at most
+ * once per level on its way to expiration. Occupied slots are tracked in
+ * bitmasks, so next tick that needs attention is found without walking
+ * timers and idle periods are skipped at once.
+ *
+ * Wheel has no locking and no notion of current time, owner provides both.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FURI_TIMER_WHEEL_SLOT_BITS (4U)
+#define FURI_TIMER_WHEEL_SLOTS     (1U << FURI_TIMER_WHEEL_SLOT_BITS)
+#define FURI_TIMER_WHEEL_LEVELS    (4U)
+
+typedef struct FuriTimerWheelNode FuriTimerWheelNode;
+
+/** Wheel node, embed into timer structure */
+struct FuriTimerWheelNode {
+    FuriTimerWheelNode* next;
+    FuriTimerWheelNode** pprev;
+    uint32_t expire_time;
+};
+
+typedef struct {
+    // Tick being processed, all earlier ticks are done
+    uint32_t time;
+    uint16_t occupied[FURI_TIMER_WHEEL_LEVELS];
+    FuriTimerWheelNode* slots[FURI_TIMER_WHEEL_LEVELS][FURI_TIMER_WHEEL_SLOTS];
+} FuriTimerWheel;
+
+/** Init empty wheel
+ *
+ * @param      wheel  The wheel
+ * @param[in]  time   Current tick
+ */
+void furi_timer_wheel_init(FuriTimerWheel* wheel, uint32_t time);
+
+/** Check if there are timers in the wheel */
+bool furi_timer_wheel_is_empty(const FuriTimerWheel* wheel);
+
+/** Check if node is in the wheel */
+static inline bool furi_timer_wheel_node_is_linked(const FuriTimerWheelNode* node) {
+    return node->pprev != NULL;
+}
+
+/** Add node to the wheel
+ *
+ * @param      wheel        The wheel
+ * @param      node         Node that is not in the wheel
+ * @param[in]  expire_time  Tick to expire at, ticks in the past expire at once
+ */
+void furi_timer_wheel_add(FuriTimerWheel* wheel, FuriTimerWheelNode* node, uint32_t expire_time);
+
+/** Remove node from the wheel
+ *
+ * @param      wheel  The wheel
+ * @param      node   Node that is in the wheel
+ */
+void furi_timer_wheel_remove(FuriTimerWheel* wheel, FuriTimerWheelNode* node);
+
+/** Get tick when the wheel needs attention next
+ *
+ * It is either expiration or moment when timers move to a finer level, the
+ * latter comes earlier than any of them expire. Wheel must not be empty.
+ *
+ * @param      wheel  The wheel
+ *
+ * @return     tick to call furi_timer_wheel_pop_expired() at
+ */
+uint32_t furi_timer_wheel_get_next_time(const FuriTimerWheel* wheel);
+
+/** Take one expired node out of the wheel
+ *
+ * Order of nodes expiring at the same tick is not defined.
+ *
+ * @param      wheel  The wheel
+ * @param[in]  now    Current tick
+ *
+ * @return     expired node or NULL
+ */
+FuriTimerWheelNode* furi_timer_wheel_pop_expired(FuriTimerWheel* wheel, uint32_t now);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,304 @@
+#include "trace_i.h"
+#include "thread_i.h"
+#include "check.h"
+#include "common_defines.h"
+#include "mutex.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <furi_hal.h>
+
+#define FURI_TRACE_POINT_NAME(id, name) name,
+
+static const char* const furi_trace_point_names[FuriTracePointNum] = {
+    FURI_TRACE_POINTS(FURI_TRACE_POINT_NAME)};
+
+#undef FURI_TRACE_POINT_NAME
+
+const char* furi_trace_get_point_name(FuriTracePoint point) {
+    furi_check(point < FuriTracePointNum);
+    return furi_trace_point_names[point];
+}
+
+uint32_t furi_trace_get_timestamp(void) {
+    return DWT->CYCCNT;
+}
+
+#ifdef FURI_TRACE
+
+// Sizes must be a power of 2
+#ifndef FURI_TRACE_THREAD_BUFFER_SIZE
+#define FURI_TRACE_THREAD_BUFFER_SIZE (128U)
+#endif
+#ifndef FURI_TRACE_SYSTEM_BUFFER_SIZE
+#define FURI_TRACE_SYSTEM_BUFFER_SIZE (512U)
+#endif
+
+#define FURI_TRACE_RETIRED_MAX (4U)
+#define FURI_TRACE_NAME_SIZE   (16U)
+
+static_assert((FURI_TRACE_THREAD_BUFFER_SIZE & (FURI_TRACE_THREAD_BUFFER_SIZE - 1)) == 0);
+static_assert((FURI_TRACE_SYSTEM_BUFFER_SIZE & (FURI_TRACE_SYSTEM_BUFFER_SIZE - 1)) == 0);
+
+struct FuriTraceBuffer {
+    FuriTraceBuffer* next;
+    FuriThreadId owner;
+    char name[FURI_TRACE_NAME_SIZE];
+    uint32_t size;
+    volatile uint32_t head;
+    volatile uint32_t generation;
+    FuriTraceEvent* events;
+};
+
+typedef struct {
+    volatile bool enabled;
+    FuriMutex* mutex;
+    volatile uint32_t generation;
+    FuriTraceBuffer* active;
+    FuriTraceBuffer* retired;
+    size_t retired_count;
+    FuriTraceBuffer system;
+    FuriTraceEvent system_events[FURI_TRACE_SYSTEM_BUFFER_SIZE];
+} FuriTrace;
+
+static FuriTrace furi_trace = {
+    .system =
+        {
+            .name = "system",
+            .size = FURI_TRACE_SYSTEM_BUFFER_SIZE,
+            .events = furi_trace.system_events,
+        },
+};
+
+void furi_trace_init(void) {
+    furi_check(!furi_trace.mutex);
+
+    furi_trace.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    furi_trace.enabled = true;
+}
+
+static inline void furi_trace_buffer_write(
+    FuriTraceBuffer* buffer,
+    FuriTracePoint point,
+    FuriTraceEventType type,
+    uint32_t value) {
+    uint32_t head = buffer->head;
+    FuriTraceEvent* event = &buffer->events[head & (buffer->size - 1)];
+
+    event->timestamp = DWT->CYCCNT;
+    event->point = point;
+    event->type = type;
+    event->value = value;
+
+    // Event must be complete before reader can see it
+    __DMB();
+    buffer->head = head + 1;
+}
+
+static void furi_trace_system_write(FuriTracePoint point, FuriTraceEventType type, uint32_t value) {
+    // Shared by all interrupts and foreign tasks: keep the slot private for the write
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    furi_trace_buffer_write(&furi_trace.system, point, type, value);
+    __set_PRIMASK(primask);
+}
+
+bool furi_trace_is_available(void) {
+    return true;
+}
+
+void furi_trace_event(FuriTracePoint point, FuriTraceEventType type, uint32_t value) {
+    if(!furi_trace.enabled) return;
+
+    FuriTraceBuffer* buffer = NULL;
+    if(!FURI_IS_IRQ_MODE() && (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)) {
+        FuriThread* thread = furi_thread_get_current();
+        if(thread) {
+            buffer = furi_thread_get_trace_buffer(thread);
+        }
+    }
+
+    if(buffer) {
+        // Only the owner thread writes into its buffer, no locking required
+        uint32_t generation = furi_trace.generation;
+        if(buffer->generation != generation) {
+            // Reset since the last write, owner clears the buffer itself
+            buffer->head = 0;
+            __DMB();
+            buffer->generation = generation;
+        }
+        furi_trace_buffer_write(buffer, point, type, value);
+    } else {
+        furi_trace_system_write(point, type, value);
+    }
+}
+
+void furi_trace_task_switched_in(void* task) {
+    if(!furi_trace.enabled) return;
+    furi_trace_system_write(FuriTracePointThreadRun, FuriTraceEventTypeBegin, (uint32_t)task);
+}
+
+void furi_trace_task_switched_out(void* task) {
+    if(!furi_trace.enabled) return;
+    furi_trace_system_write(FuriTracePointThreadRun, FuriTraceEventTypeEnd, (uint32_t)task);
+}
+
+void furi_trace_set_enabled(bool enabled) {
+    furi_trace.enabled = enabled;
+}
+
+bool furi_trace_is_enabled(void) {
+    return furi_trace.enabled;
+}
+
+FuriTraceBuffer* furi_trace_buffer_alloc(FuriThreadId owner, const char* name) {
+    FuriTraceBuffer* buffer =
+        malloc(sizeof(FuriTraceBuffer) + FURI_TRACE_THREAD_BUFFER_SIZE * sizeof(FuriTraceEvent));
+
+    buffer->owner = owner;
+    strlcpy(buffer->name, name ? name : "", sizeof(buffer->name));
+    buffer->size = FURI_TRACE_THREAD_BUFFER_SIZE;
+    buffer->events = (FuriTraceEvent*)&buffer[1];
+
+    furi_check(furi_mutex_acquire(furi_trace.mutex, FuriWaitForever) == FuriStatusOk);
+    buffer->generation = furi_trace.generation;
+    buffer->next = furi_trace.active;
+    furi_trace.active = buffer;
+    furi_check(furi_mutex_release(furi_trace.mutex) == FuriStatusOk);
+
+    return buffer;
+}
+
+void furi_trace_buffer_retire(FuriTraceBuffer* buffer) {
+    if(!buffer) return;
+
+    furi_check(furi_mutex_acquire(furi_trace.mutex, FuriWaitForever) == FuriStatusOk);
+
+    FuriTraceBuffer** link = &furi_trace.active;
+    while(*link != buffer) {
+        furi_check(*link);
+        link = &(*link)->next;
+    }
+    *link = buffer->next;
+
+    // Keep recently stopped threads in the dump, newest first
+    buffer->next = furi_trace.retired;
+    furi_trace.retired = buffer;
+    furi_trace.retired_count++;
+
+    if(furi_trace.retired_count > FURI_TRACE_RETIRED_MAX) {
+        FuriTraceBuffer** oldest = &furi_trace.retired;
+        while((*oldest)->next) {
+            oldest = &(*oldest)->next;
+        }
+        free(*oldest);
+        *oldest = NULL;
+        furi_trace.retired_count--;
+    }
+
+    furi_check(furi_mutex_release(furi_trace.mutex) == FuriStatusOk);
+}
+
+void furi_trace_reset(void) {
+    furi_check(furi_mutex_acquire(furi_trace.mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Thread buffers are cleared by their owners on the next write
+    uint32_t generation = furi_trace.generation + 1;
+    furi_trace.generation = generation;
+
+    while(furi_trace.retired) {
+        FuriTraceBuffer* buffer = furi_trace.retired;
+        furi_trace.retired = buffer->next;
+        free(buffer);
+    }
+    furi_trace.retired_count = 0;
+
+    FURI_CRITICAL_ENTER();
+    furi_trace.system.head = 0;
+    furi_trace.system.generation = generation;
+    FURI_CRITICAL_EXIT();
+
+    furi_check(furi_mutex_release(furi_trace.mutex) == FuriStatusOk);
+}
+
+static void furi_trace_buffer_enumerate(
+    FuriTraceBuffer* buffer,
+    FuriTraceEvent* snapshot,
+    FuriTraceBufferCallback callback,
+    void* context) {
+    // Generation can not change while the mutex is held, owner may only catch up
+    uint32_t head = 0;
+    if(buffer->generation == furi_trace.generation) {
+        __DMB();
+        head = buffer->head;
+    }
+    uint32_t count = MIN(head, buffer->size);
+
+    for(uint32_t i = 0; i < count; i++) {
+        snapshot[i] = buffer->events[(head - count + i) & (buffer->size - 1)];
+    }
+
+    // Events overwritten while copying are torn, drop them
+    uint32_t overwritten = buffer->head - head;
+    if(overwritten >= count) {
+        count = 0;
+    } else {
+        snapshot += overwritten;
+        count -= overwritten;
+    }
+
+    callback(buffer->owner, buffer->name, snapshot, count, context);
+}
+
+void furi_trace_enumerate(FuriTraceBufferCallback callback, void* context) {
+    furi_check(callback);
+
+    FuriTraceEvent* snapshot = malloc(FURI_TRACE_SYSTEM_BUFFER_SIZE * sizeof(FuriTraceEvent));
+
+    furi_check(furi_mutex_acquire(furi_trace.mutex, FuriWaitForever) == FuriStatusOk);
+
+    furi_trace_buffer_enumerate(&furi_trace.system, snapshot, callback, context);
+    for(FuriTraceBuffer* buffer = furi_trace.active; buffer; buffer = buffer->next) {
+        furi_trace_buffer_enumerate(buffer, snapshot, callback, context);
+    }
+    for(FuriTraceBuffer* buffer = furi_trace.retired; buffer; buffer = buffer->next) {
+        furi_trace_buffer_enumerate(buffer, snapshot, callback, context);
+    }
+
+    furi_check(furi_mutex_release(furi_trace.mutex) == FuriStatusOk);
+
+    free(snapshot);
+}
+
+#else
+
+void furi_trace_init(void) {
+}
+
+bool furi_trace_is_available(void) {
+    return false;
+}
+
+void furi_trace_event(FuriTracePoint point, FuriTraceEventType type, uint32_t value) {
+    UNUSED(point);
+    UNUSED(type);
+    UNUSED(value);
+}
+
+void furi_trace_set_enabled(bool enabled) {
+    UNUSED(enabled);
+}
+
+bool furi_trace_is_enabled(void) {
+    return false;
+}
+
+void furi_trace_reset(void) {
+}
+
+void furi_trace_enumerate(FuriTraceBufferCallback callback, void* context) {
+    furi_check(callback);
+    UNUSED(context);
+}
+
+#endif
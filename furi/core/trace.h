@@ -0,0 +1,161 @@
+/**
+ * @file trace.h
+ * Furi Trace: static tracepoints
+ *
+ * Tracepoints record cycle stamped begin, end and counter events into ring
+ * buffers: one per FuriThread, written only by its owner without locking, and
+ * one system buffer for interrupts, scheduler hooks and non-Furi tasks.
+ *
+ * Tracepoint macros are compiled in only when FURI_TRACE is defined
+ * (`./fbt TRACE=1`), otherwise they expand to nothing. Buffers are dumped
+ * with the `trace` CLI command, `scripts/trace2chrome.py` converts the dump
+ * to Chrome trace JSON viewable in Perfetto or chrome://tracing.
+ */
+#pragma once
+
+#include "base.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Tracepoint list: X(Id, "name") */
+#define FURI_TRACE_POINTS(X)                         \
+    X(ThreadRun, "thread_run")                       \
+    X(MessageQueuePut, "message_queue_put")          \
+    X(MessageQueueGet, "message_queue_get")          \
+    X(MessageQueueDepth, "message_queue_depth")      \
+    X(StorageCommand, "storage_command")             \
+    X(GuiRedraw, "gui_redraw")                       \
+    X(JsGc, "js_gc")                                 \
+    X(JsGcPause, "js_gc_pause")                      \
+    X(User0, "user0")                                \
+    X(User1, "user1")                                \
+    X(User2, "user2")                                \
+    X(User3, "user3")
+
+#define FURI_TRACE_POINT_ENUM(id, name) FuriTracePoint##id,
+
+/** Compile time tracepoint identifiers */
+typedef enum {
+    FURI_TRACE_POINTS(FURI_TRACE_POINT_ENUM) FuriTracePointNum,
+} FuriTracePoint;
+
+#undef FURI_TRACE_POINT_ENUM
+
+/** Trace event type */
+typedef enum {
+    FuriTraceEventTypeBegin, /**< Start of a duration, closed by End with the same point */
+    FuriTraceEventTypeEnd, /**< End of a duration */
+    FuriTraceEventTypeCounter, /**< Counter value sample */
+    FuriTraceEventTypeInstant, /**< Single point in time */
+} FuriTraceEventType;
+
+/** Trace event, 12 bytes */
+typedef struct {
+    uint32_t timestamp; /**< DWT cycle counter */
+    uint16_t point; /**< FuriTracePoint */
+    uint8_t type; /**< FuriTraceEventType */
+    uint8_t reserved;
+    uint32_t value; /**< Point specific value: object address, command, counter */
+} FuriTraceEvent;
+
+/** Trace buffer enumeration callback
+ *
+ * @param      owner    buffer owner thread id, NULL for system buffer
+ * @param      name     owner thread name at the moment of buffer allocation
+ * @param      events   events in chronological order
+ * @param      count    events count
+ * @param      context  callback context
+ */
+typedef void (*FuriTraceBufferCallback)(
+    FuriThreadId owner,
+    const char* name,
+    const FuriTraceEvent* events,
+    size_t count,
+    void* context);
+
+#ifdef FURI_TRACE
+#define FURI_TRACE_BEGIN(point, value) \
+    furi_trace_event(FuriTracePoint##point, FuriTraceEventTypeBegin, (uint32_t)(value))
+#define FURI_TRACE_END(point, value) \
+    furi_trace_event(FuriTracePoint##point, FuriTraceEventTypeEnd, (uint32_t)(value))
+#define FURI_TRACE_COUNTER(point, value) \
+    furi_trace_event(FuriTracePoint##point, FuriTraceEventTypeCounter, (uint32_t)(value))
+#define FURI_TRACE_INSTANT(point, value) \
+    furi_trace_event(FuriTracePoint##point, FuriTraceEventTypeInstant, (uint32_t)(value))
+#else
+#define FURI_TRACE_BEGIN(point, value) \
+    do {                               \
+    } while(0)
+#define FURI_TRACE_END(point, value) \
+    do {                             \
+    } while(0)
+#define FURI_TRACE_COUNTER(point, value) \
+    do {                                 \
+    } while(0)
+#define FURI_TRACE_INSTANT(point, value) \
+    do {                                 \
+    } while(0)
+#endif
+
+/** Check if tracepoints are compiled in
+ *
+ * @return     true if firmware is built with FURI_TRACE
+ */
+bool furi_trace_is_available(void);
+
+/** Record trace event, use FURI_TRACE_* macros instead
+ *
+ * Safe to call from any context including interrupts.
+ *
+ * @param      point  tracepoint
+ * @param      type   event type
+ * @param      value  point specific value
+ */
+void furi_trace_event(FuriTracePoint point, FuriTraceEventType type, uint32_t value);
+
+/** Enable or disable event recording
+ *
+ * Recording is enabled on boot when tracepoints are compiled in.
+ *
+ * @param      enabled  recording state
+ */
+void furi_trace_set_enabled(bool enabled);
+
+/** Get event recording state
+ *
+ * @return     true if recording
+ */
+bool furi_trace_is_enabled(void);
+
+/** Drop all recorded events */
+void furi_trace_reset(void);
+
+/** Get tracepoint name
+ *
+ * @param      point  tracepoint
+ *
+ * @return     name string
+ */
+const char* furi_trace_get_point_name(FuriTracePoint point);
+
+/** Get current trace timestamp
+ *
+ * @return     DWT cycle counter
+ */
+uint32_t furi_trace_get_timestamp(void);
+
+/** Enumerate trace buffers
+ *
+ * Pause recording while enumerating to get consistent snapshots.
+ *
+ * @param      callback  callback called for every buffer
+ * @param      context   callback context
+ */
+void furi_trace_enumerate(FuriTraceBufferCallback callback, void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriTraceBuffer FuriTraceBuffer;
+
+/** Initialize tracing, must be called before any thread is started */
+void furi_trace_init(void);
+
+/** Allocate and register per thread trace buffer
+ *
+ * @param      owner  owner thread id
+ * @param      name   owner thread name, can be NULL
+ *
+ * @return     FuriTraceBuffer instance
+ */
+FuriTraceBuffer* furi_trace_buffer_alloc(FuriThreadId owner, const char* name);
+
+/** Retire trace buffer of a stopped thread
+ *
+ * Retired buffers stay available for dumps until newer ones push them out.
+ *
+ * @param      buffer  FuriTraceBuffer instance, can be NULL
+ */
+void furi_trace_buffer_retire(FuriTraceBuffer* buffer);
+
+/** Scheduler hook: task is about to run
+ *
+ * @param      task  task handle
+ */
+void furi_trace_task_switched_in(void* task);
+
+/** Scheduler hook: task is about to be switched out
+ *
+ * @param      task  task handle
+ */
+void furi_trace_task_switched_out(void* task);
+
+#ifdef __cplusplus
+}
+#endif
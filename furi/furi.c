@@ -9,6 +9,7 @@ void furi_init(void) {
     furi_check(!furi_kernel_is_irq_or_masked());
     furi_check(xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED);
 
+    furi_trace_init();
     furi_thread_init();
     furi_log_init();
     furi_record_init();
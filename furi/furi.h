@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 
+#include "core/arena.h"
 #include "core/common_defines.h"
 #include "core/check.h"
 #include "core/event_loop.h"
@@ -13,12 +14,14 @@
 #include "core/memmgr_heap.h"
 #include "core/message_queue.h"
 #include "core/mutex.h"
+#include "core/object_pool.h"
 #include "core/pubsub.h"
 #include "core/record.h"
 #include "core/semaphore.h"
 #include "core/thread.h"
 #include "core/thread_list.h"
 #include "core/timer.h"
+#include "core/trace.h"
 #include "core/string.h"
 #include "core/stream_buffer.h"
 
@@ -185,12 +185,7 @@ static void ble_profile_hid_stop(FuriHalBleProfileBase* profile) {
     free(hid_profile->consumer_report);
 }
 
-bool ble_profile_hid_kb_press(FuriHalBleProfileBase* profile, uint16_t button) {
-    furi_check(profile);
-    furi_check(profile->config == ble_profile_hid);
-
-    BleProfileHid* hid_profile = (BleProfileHid*)profile;
-    FuriHalBtHidKbReport* kb_report = hid_profile->kb_report;
+static void ble_profile_hid_kb_set_pressed(FuriHalBtHidKbReport* kb_report, uint16_t button) {
     for(uint8_t i = 0; i < BLE_PROFILE_HID_KB_MAX_KEYS; i++) {
         if(kb_report->key[i] == 0) {
             kb_report->key[i] = button & 0xFF;
@@ -198,6 +193,35 @@ bool ble_profile_hid_kb_press(FuriHalBleProfileBase* profile, uint16_t button) {
         }
     }
     kb_report->mods |= (button >> 8);
+}
+
+static void ble_profile_hid_kb_set_released(FuriHalBtHidKbReport* kb_report, uint16_t button) {
+    for(uint8_t i = 0; i < BLE_PROFILE_HID_KB_MAX_KEYS; i++) {
+        if(kb_report->key[i] == (button & 0xFF)) {
+            kb_report->key[i] = 0;
+            break;
+        }
+    }
+    kb_report->mods &= ~(button >> 8);
+}
+
+bool ble_profile_hid_kb_press(FuriHalBleProfileBase* profile, uint16_t button) {
+    return ble_profile_hid_kb_press_multiple(profile, &button, 1);
+}
+
+bool ble_profile_hid_kb_press_multiple(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count) {
+    furi_check(profile);
+    furi_check(profile->config == ble_profile_hid);
+    furi_check(buttons);
+
+    BleProfileHid* hid_profile = (BleProfileHid*)profile;
+    FuriHalBtHidKbReport* kb_report = hid_profile->kb_report;
+    for(size_t i = 0; i < count; i++) {
+        ble_profile_hid_kb_set_pressed(kb_report, buttons[i]);
+    }
     return ble_svc_hid_update_input_report(
         hid_profile->hid_svc,
         ReportNumberKeyboard,
@@ -206,19 +230,22 @@ bool ble_profile_hid_kb_press(FuriHalBleProfileBase* profile, uint16_t button) {
 }
 
 bool ble_profile_hid_kb_release(FuriHalBleProfileBase* profile, uint16_t button) {
+    return ble_profile_hid_kb_release_multiple(profile, &button, 1);
+}
+
+bool ble_profile_hid_kb_release_multiple(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count) {
     furi_check(profile);
     furi_check(profile->config == ble_profile_hid);
+    furi_check(buttons);
 
     BleProfileHid* hid_profile = (BleProfileHid*)profile;
-
     FuriHalBtHidKbReport* kb_report = hid_profile->kb_report;
-    for(uint8_t i = 0; i < BLE_PROFILE_HID_KB_MAX_KEYS; i++) {
-        if(kb_report->key[i] == (button & 0xFF)) {
-            kb_report->key[i] = 0;
-            break;
-        }
+    for(size_t i = 0; i < count; i++) {
+        ble_profile_hid_kb_set_released(kb_report, buttons[i]);
     }
-    kb_report->mods &= ~(button >> 8);
     return ble_svc_hid_update_input_report(
         hid_profile->hid_svc,
         ReportNumberKeyboard,
@@ -67,6 +67,7 @@ void mjs_destroy(struct mjs* mjs) {
     gc_arena_destroy(mjs, &mjs->object_arena);
     gc_arena_destroy(mjs, &mjs->property_arena);
     gc_arena_destroy(mjs, &mjs->ffi_sig_arena);
+    mbuf_free(&mjs->gc.gray);
     free(mjs);
 }
 
@@ -86,6 +87,7 @@ struct mjs* mjs_create(void* context) {
     mbuf_init(&mjs->loop_addresses, 0);
     mbuf_init(&mjs->json_visited_stack, 0);
     mbuf_init(&mjs->array_buffers, 0);
+    mbuf_init(&mjs->gc.gray, 0);
 
     mjs->bcode_len = 0;
 
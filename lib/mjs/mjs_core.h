@@ -88,9 +88,11 @@ struct mjs {
     struct gc_arena object_arena;
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
+    struct gc_state gc;
 
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
+    unsigned need_gc_strings : 1;
     unsigned generate_jsc : 1;
 };
 
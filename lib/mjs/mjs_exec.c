@@ -655,9 +655,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
         mjs->cur_bcode_offset = i;
 
         if(mjs->need_gc) {
-            if(maybe_gc(mjs)) {
-                mjs->need_gc = 0;
-            }
+            maybe_gc(mjs);
         }
 #if MJS_AGGRESSIVE_GC
         maybe_gc(mjs);
@@ -5,6 +5,9 @@
 
 #include <stdio.h>
 
+#include <furi.h>
+#include <furi_hal_cortex.h>
+
 #include "common/cs_varint.h"
 #include "common/mbuf.h"
 
@@ -17,29 +20,58 @@
 #include "mjs_string.h"
 
 /*
- * Macros for marking reachable things: use bit 0.
+ * Collection is incremental: marking and sweeping are done in steps between
+ * bytecode instructions, and the program runs in between. Cells are
+ * allocated marked, and mark bit value meaning "marked" is flipped at the
+ * start of each cycle, so sweep doesn't have to unmark anything. Property
+ * stores go through `gc_write_barrier()`, which marks stored values while
+ * marking is in progress. Roots are not guarded, they are marked once more
+ * before sweep.
+ *
+ * Strings are moved when compacted, so every reference to them is rewritten
+ * at once. That is done at the end of marking of an incremental cycle, see
+ * `gc_compact_live_strings()`: the pause covers object sweep and string
+ * compaction, but not marking or the sweep of other arenas.
+ */
+
+/*
+ * Work done by one collection step, one unit is roughly one object, property
+ * or cell visited. Sets the length of collection pauses.
+ */
+#ifndef MJS_GC_STEP_WORK
+#define MJS_GC_STEP_WORK 256
+#endif
+
+/*
+ * Work owed by every cell allocated while collection is in progress. The
+ * more it is, the sooner collection is over and the less arenas grow.
  */
-#define MARK(p) (((struct gc_cell*)(p))->head.word |= 1)
-#define UNMARK(p) (((struct gc_cell*)(p))->head.word &= ~1)
-#define MARKED(p) (((struct gc_cell*)(p))->head.word & 1)
+#ifndef MJS_GC_ALLOC_WORK
+#define MJS_GC_ALLOC_WORK 32
+#endif
 
 /*
- * Similar to `MARK()` / `UNMARK()` / `MARKED()`, but `.._FREE` counterparts
- * are intended to mark free cells (as opposed to used ones), so they use
- * bit 1.
+ * Free cells are marked with bit 1 of the free list link. Cells in use start
+ * with an aligned pointer, so the bit is always clear for them.
  */
-#define MARK_FREE(p) (((struct gc_cell*)(p))->head.word |= 2)
-#define UNMARK_FREE(p) (((struct gc_cell*)(p))->head.word &= ~2)
-#define MARKED_FREE(p) (((struct gc_cell*)(p))->head.word & 2)
+#define GC_CELL_FREE ((uintptr_t)2)
+#define GC_CELL_IS_FREE(p) (((struct gc_cell*)(p))->head.word & GC_CELL_FREE)
+#define GC_CELL_NEXT_FREE(p) \
+    ((struct gc_cell*)(((struct gc_cell*)(p))->head.word & ~GC_CELL_FREE))
+
+#define GC_MARK_GET(b, i) (((b)->marks[(i) >> 3] >> ((i) & 7)) & 1)
 
 /*
  * When each arena has that or less free cells, GC will be scheduled
  */
 #define GC_ARENA_CELLS_RESERVE 2
 
+typedef void (*gc_mark_fn_t)(struct mjs* mjs, mjs_val_t* v);
+
 static struct gc_block* gc_new_block(struct gc_arena* a, size_t size);
 static void gc_free_block(struct gc_block* b);
-static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf);
+static void gc_mark_roots(struct mjs* mjs, gc_mark_fn_t mark);
+static void gc_compact_live_strings(struct mjs* mjs);
 
 MJS_PRIVATE struct mjs_object* new_object(struct mjs* mjs) {
     return (struct mjs_object*)gc_alloc_cell(mjs, &mjs->object_arena);
@@ -69,16 +101,25 @@ MJS_PRIVATE void gc_arena_init(
 
 MJS_PRIVATE void gc_arena_destroy(struct mjs* mjs, struct gc_arena* a) {
     struct gc_block* b;
+    struct gc_cell* cur;
+
+    for(b = a->blocks; b != NULL;) {
+        struct gc_block* tmp;
 
-    if(a->blocks != NULL) {
-        gc_sweep(mjs, a, 0);
-        for(b = a->blocks; b != NULL;) {
-            struct gc_block* tmp;
-            tmp = b;
-            b = b->next;
-            gc_free_block(tmp);
+        if(a->destructor != NULL) {
+            for(cur = b->base; cur < GC_CELL_OP(a, b->base, +, b->size);
+                cur = GC_CELL_OP(a, cur, +, 1)) {
+                if(!GC_CELL_IS_FREE(cur)) {
+                    a->destructor(mjs, cur);
+                }
+            }
         }
+
+        tmp = b;
+        b = b->next;
+        gc_free_block(tmp);
     }
+    a->blocks = NULL;
 }
 
 static void gc_free_block(struct gc_block* b) {
@@ -86,11 +127,16 @@ static void gc_free_block(struct gc_block* b) {
     free(b);
 }
 
+static void gc_push_free(struct gc_arena* a, struct gc_cell* cell) {
+    cell->head.word = (uintptr_t)a->free | GC_CELL_FREE;
+    a->free = cell;
+}
+
 static struct gc_block* gc_new_block(struct gc_arena* a, size_t size) {
     struct gc_cell* cur;
     struct gc_block* b;
 
-    b = (struct gc_block*)calloc(1, sizeof(*b));
+    b = (struct gc_block*)calloc(1, sizeof(*b) + (size + 7) / 8);
     if(b == NULL) abort();
 
     b->size = size;
@@ -99,13 +145,49 @@ static struct gc_block* gc_new_block(struct gc_arena* a, size_t size) {
 
     for(cur = GC_CELL_OP(a, b->base, +, 0); cur < GC_CELL_OP(a, b->base, +, b->size);
         cur = GC_CELL_OP(a, cur, +, 1)) {
-        cur->head.link = a->free;
-        a->free = cur;
+        gc_push_free(a, cur);
     }
 
     return b;
 }
 
+/* Returns block the cell belongs to, or NULL for a pointer outside of arena */
+static struct gc_block* gc_find_block(struct gc_arena* a, const void* ptr) {
+    const struct gc_cell* p = (const struct gc_cell*)ptr;
+    struct gc_block* b = a->last;
+
+    /* Cells are mostly allocated and marked a block after block */
+    if(b != NULL && p >= b->base && p < GC_CELL_OP(a, b->base, +, b->size)) {
+        return b;
+    }
+
+    for(b = a->blocks; b != NULL; b = b->next) {
+        if(p >= b->base && p < GC_CELL_OP(a, b->base, +, b->size)) {
+            a->last = b;
+            return b;
+        }
+    }
+    return NULL;
+}
+
+/* Marks the cell, returns 1 if it was not marked before */
+static int gc_mark_cell(struct mjs* mjs, struct gc_arena* a, const void* cell) {
+    struct gc_block* b = gc_find_block(a, cell);
+    size_t i;
+
+    if(b == NULL) {
+        abort();
+    }
+
+    i = ((const char*)cell - (const char*)b->base) / a->cell_size;
+    if(GC_MARK_GET(b, i) == mjs->gc.live) {
+        return 0;
+    }
+
+    b->marks[i >> 3] ^= 1 << (i & 7);
+    return 1;
+}
+
 /*
  * Returns whether the given arena has GC_ARENA_CELLS_RESERVE or less free
  * cells
@@ -114,7 +196,7 @@ static int gc_arena_is_gc_needed(struct gc_arena* a) {
     struct gc_cell* r = a->free;
     int i;
 
-    for(i = 0; i <= GC_ARENA_CELLS_RESERVE; i++, r = r->head.link) {
+    for(i = 0; i <= GC_ARENA_CELLS_RESERVE; i++, r = GC_CELL_NEXT_FREE(r)) {
         if(r == NULL) {
             return 1;
         }
@@ -138,9 +220,10 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
     }
     r = a->free;
 
-    UNMARK(r);
+    a->free = GC_CELL_NEXT_FREE(r);
 
-    a->free = r->head.link;
+    /* New cells survive collection in progress */
+    gc_mark_cell(mjs, a, r);
 
 #if MJS_MEMORY_STATS
     a->allocations++;
@@ -148,8 +231,15 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
 #endif
 
     /* Schedule GC if needed */
-    if(gc_arena_is_gc_needed(a)) {
-        mjs->need_gc = 1;
+    if(mjs->gc.phase == GC_PHASE_IDLE) {
+        if(gc_arena_is_gc_needed(a)) {
+            mjs->need_gc = 1;
+        }
+    } else {
+        mjs->gc.debt += MJS_GC_ALLOC_WORK;
+        if(mjs->gc.debt >= MJS_GC_STEP_WORK) {
+            mjs->need_gc = 1;
+        }
     }
 
     /*
@@ -160,162 +250,271 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
     return (void*)r;
 }
 
+/* Removes block cells from the free list and frees it, returns work done */
+static size_t gc_release_block(struct gc_arena* a, struct gc_block* b) {
+    struct gc_cell* end = GC_CELL_OP(a, b->base, +, b->size);
+    struct gc_cell* prev = NULL;
+    struct gc_cell* cur;
+    struct gc_cell* next;
+    struct gc_block** link;
+    size_t work = 0;
+
+    for(cur = a->free; cur != NULL; cur = next, work++) {
+        next = GC_CELL_NEXT_FREE(cur);
+        if(cur >= b->base && cur < end) {
+            if(prev != NULL) {
+                prev->head.word = (uintptr_t)next | GC_CELL_FREE;
+            } else {
+                a->free = next;
+            }
+        } else {
+            prev = cur;
+        }
+    }
+
+    for(link = &a->blocks; *link != b; link = &(*link)->next)
+        ;
+    *link = b->next;
+    if(a->last == b) {
+        a->last = NULL;
+    }
+    gc_free_block(b);
+
+    return work;
+}
+
 /*
- * Scans the arena and add all unmarked cells to the free list.
+ * Frees unmarked cells of the block, returns work done.
  *
- * Empty blocks get deallocated. The head of the free list will contais cells
- * from the last (oldest) block. Cells will thus be allocated in block order.
+ * Empty blocks get deallocated, except for the initial one, which is at the
+ * tail: it has a special size aimed at reducing waste and simplifying
+ * initial startup.
  */
-void gc_sweep(struct mjs* mjs, struct gc_arena* a, size_t start) {
-    struct gc_block* b;
+static size_t gc_sweep_block(struct mjs* mjs, struct gc_arena* a, struct gc_block* b) {
     struct gc_cell* cur;
-    struct gc_block** prevp = &a->blocks;
+    size_t i;
+
+    for(i = 0, cur = b->base; i < b->size; i++, cur = GC_CELL_OP(a, cur, +, 1)) {
+        if(GC_CELL_IS_FREE(cur) || GC_MARK_GET(b, i) == mjs->gc.live) {
+            continue;
+        }
+
+        /*
+     * The cell is used and should be freed: call the destructor and
+     * reset the memory
+     */
+        if(a->destructor != NULL) {
+            a->destructor(mjs, cur);
+        }
+        memset(cur, 0, a->cell_size);
+        gc_push_free(a, cur);
 #if MJS_MEMORY_STATS
-    a->alive = 0;
+        a->garbage++;
+        a->alive--;
 #endif
+    }
 
-    /*
-   * Before we sweep, we should mark all free cells in a way that is
-   * distinguishable from marked used cells.
-   */
-    {
-        struct gc_cell* next;
-        for(cur = a->free; cur != NULL; cur = next) {
-            next = cur->head.link;
-            MARK_FREE(cur);
+    if(b->next != NULL) {
+        /* Destructors may allocate, so check the cells again */
+        for(i = 0, cur = b->base; i < b->size && GC_CELL_IS_FREE(cur);
+            i++, cur = GC_CELL_OP(a, cur, +, 1))
+            ;
+        if(i == b->size) {
+            return b->size + gc_release_block(a, b);
         }
     }
 
-    /*
-   * We'll rebuild the whole `free` list, so initially we just reset it
-   */
-    a->free = NULL;
+    return b->size;
+}
 
-    for(b = a->blocks; b != NULL;) {
-        size_t freed_in_block = 0;
-        /*
-     * if it turns out that this block is 100% garbage
-     * we can release the whole block, but the addition
-     * of it's cells to the free list has to be undone.
-     */
-        struct gc_cell* prev_free = a->free;
+static void gc_sweep_start(struct mjs* mjs, struct gc_arena* a) {
+    mjs->gc.sweep_arena = a;
+    mjs->gc.sweep_block = a->blocks;
+}
 
-        for(cur = GC_CELL_OP(a, b->base, +, start); cur < GC_CELL_OP(a, b->base, +, b->size);
-            cur = GC_CELL_OP(a, cur, +, 1)) {
-            if(MARKED(cur)) {
-                /* The cell is used and marked  */
-                UNMARK(cur);
-#if MJS_MEMORY_STATS
-                a->alive++;
-#endif
-            } else {
-                /*
-         * The cell is either:
-         * - free
-         * - garbage that's about to be freed
-         */
-
-                if(MARKED_FREE(cur)) {
-                    /* The cell is free, so, just unmark it */
-                    UNMARK_FREE(cur);
-                } else {
-                    /*
-           * The cell is used and should be freed: call the destructor and
-           * reset the memory
-           */
-                    if(a->destructor != NULL) {
-                        a->destructor(mjs, cur);
-                    }
-                    memset(cur, 0, a->cell_size);
-                }
+/*
+ * Sweeps arenas until the budget is spent, returns work done.
+ *
+ * Blocks allocated during sweep are put in front of the list, so they are
+ * not visited.
+ */
+static size_t gc_sweep_step(struct mjs* mjs, size_t budget) {
+    struct gc_block* b;
+    size_t work = 0;
 
-                /* Add this cell to the `free` list */
-                cur->head.link = a->free;
-                a->free = cur;
-                freed_in_block++;
-#if MJS_MEMORY_STATS
-                a->garbage++;
-#endif
+    while(work < budget) {
+        struct gc_arena* a = mjs->gc.sweep_arena;
+
+        if(mjs->gc.sweep_block == NULL) {
+            /* Objects go first: their destructors look at their properties */
+            if(a == &mjs->object_arena) {
+                gc_sweep_start(mjs, &mjs->property_arena);
+            } else if(a == &mjs->property_arena) {
+                gc_sweep_start(mjs, &mjs->ffi_sig_arena);
+            } else {
+                mjs->gc.phase = GC_PHASE_IDLE;
+                mjs->gc.stats.cycles++;
+                /* Collection may be finished by mjs_gc_step(), nothing is owed now */
+                mjs->need_gc = mjs->need_gc_strings;
+                break;
             }
+            continue;
         }
 
-        /*
-     * don't free the initial block, which is at the tail
-     * because it has a special size aimed at reducing waste
-     * and simplifying initial startup. TODO(mkm): improve
-     * */
-        if(b->next != NULL && freed_in_block == b->size) {
-            *prevp = b->next;
-            gc_free_block(b);
-            b = *prevp;
-            a->free = prev_free;
-        } else {
-            prevp = &b->next;
-            b = b->next;
-        }
+        /* The block may be released */
+        b = mjs->gc.sweep_block;
+        mjs->gc.sweep_block = b->next;
+        work += gc_sweep_block(mjs, a, b);
     }
-}
 
-/* Mark an FFI signature */
-static void gc_mark_ffi_sig(struct mjs* mjs, mjs_val_t* v) {
-    struct mjs_ffi_sig* psig;
+    return work;
+}
 
-    assert(mjs_is_ffi_sig(*v));
+/* Marks a value, objects are queued for their properties to be marked */
+static void gc_shade(struct mjs* mjs, mjs_val_t* v) {
+    if(mjs_is_object_based(*v)) {
+        struct mjs_object* obj = get_object_struct(*v);
+        if(gc_mark_cell(mjs, &mjs->object_arena, obj)) {
+            mbuf_append(&mjs->gc.gray, &obj, sizeof(obj));
+        }
+    } else if(mjs_is_ffi_sig(*v)) {
+        gc_mark_cell(mjs, &mjs->ffi_sig_arena, mjs_get_ffi_sig_struct(*v));
+    }
+}
 
-    psig = mjs_get_ffi_sig_struct(*v);
+/*
+ * Marks properties of the object being scanned and values they refer to,
+ * until the budget is spent. Returns work done.
+ *
+ * Properties are only unlinked on delete and freed by sweep, so the saved
+ * position stays valid between steps. Properties added in the meantime go
+ * through write barrier.
+ */
+static size_t gc_scan_properties(struct mjs* mjs, size_t budget) {
+    struct mjs_property* prop = mjs->gc.scan_prop;
+    size_t work = 0;
+
+    for(; prop != NULL && work < budget; prop = prop->next, work++) {
+        gc_mark_cell(mjs, &mjs->property_arena, prop);
+        gc_shade(mjs, &prop->name);
+        gc_shade(mjs, &prop->value);
+    }
+    mjs->gc.scan_prop = prop;
 
+    /* mark object's prototype */
     /*
-   * we treat all object like things like objects but they might be functions,
-   * gc_check_val checks the appropriate arena per actual value type.
+   * We dropped support for object prototypes in MJS.
+   * If we ever bring it back, don't forget to mark it
    */
-    if(!gc_check_val(mjs, *v)) {
-        abort();
+    /* gc_mark(mjs, mjs_get_proto(mjs, v)); */
+
+    return work;
+}
+
+/* Scans queued objects until the budget is spent, returns work done */
+static size_t gc_scan_gray(struct mjs* mjs, size_t budget) {
+    struct mbuf* gray = &mjs->gc.gray;
+    struct mjs_object* obj;
+    size_t work = 0;
+
+    while(work < budget) {
+        if(mjs->gc.scan_prop == NULL) {
+            if(gray->len == 0) {
+                break;
+            }
+            gray->len -= sizeof(obj);
+            memcpy(&obj, gray->buf + gray->len, sizeof(obj));
+            mjs->gc.scan_prop = obj->properties;
+            work++;
+        }
+        work += gc_scan_properties(mjs, budget - work);
     }
 
-    if(MARKED(psig)) return;
+    return work;
+}
 
-    MARK(psig);
+static void gc_start_cycle(struct mjs* mjs) {
+    /* Everything that was alive is unmarked now */
+    mjs->gc.live ^= 1;
+    mjs->gc.phase = GC_PHASE_MARK;
+    gc_mark_roots(mjs, gc_shade);
 }
 
-/* Mark an object */
-static void gc_mark_object(struct mjs* mjs, mjs_val_t* v) {
-    struct mjs_object* obj_base;
-    struct mjs_property* prop;
-    struct mjs_property* next;
+/* Marks until the budget is spent, returns work done */
+static size_t gc_mark_step(struct mjs* mjs, size_t budget) {
+    size_t work = gc_scan_gray(mjs, budget);
 
-    assert(mjs_is_object_based(*v));
+    if(mjs->gc.gray.len == 0 && mjs->gc.scan_prop == NULL) {
+        /*
+     * Roots are changed without write barrier, so whatever they refer to
+     * now is marked to the end before sweep
+     */
+        gc_mark_roots(mjs, gc_shade);
+        work += gc_scan_gray(mjs, SIZE_MAX);
 
-    obj_base = get_object_struct(*v);
+        mjs->gc.phase = GC_PHASE_SWEEP;
+        if(mjs->gc.compact_strings) {
+            gc_compact_live_strings(mjs);
+        } else {
+            gc_sweep_start(mjs, &mjs->object_arena);
+        }
+    }
+
+    return work;
+}
+
+/* Advances collection in progress, returns 1 if it is not finished yet */
+static int gc_step(struct mjs* mjs, size_t budget) {
+    size_t work = 0;
 
     /*
-   * we treat all object like things like objects but they might be functions,
-   * gc_check_val checks the appropriate arena per actual value type.
-   */
-    if(!gc_check_val(mjs, *v)) {
-        abort();
+     * Cycle that is sweeping already can't compact strings, they are left
+     * for the next one. String buffer grows in the meantime.
+     */
+    if(mjs->need_gc_strings && mjs->gc.phase == GC_PHASE_MARK) {
+        mjs->gc.compact_strings = 1;
     }
+    if(mjs->gc.phase == GC_PHASE_MARK) {
+        work += gc_mark_step(mjs, budget);
+    }
+    if(mjs->gc.phase == GC_PHASE_SWEEP && work < budget) {
+        gc_sweep_step(mjs, budget - work);
+    }
+    mjs->gc.debt = 0;
 
-    if(MARKED(obj_base)) return;
+    return mjs->gc.phase != GC_PHASE_IDLE;
+}
 
-    /* mark object itself, and its properties */
-    for((prop = obj_base->properties), MARK(obj_base); prop != NULL; prop = next) {
-        if(!gc_check_ptr(&mjs->property_arena, prop)) {
-            abort();
-        }
+static uint32_t gc_pause_begin(struct mjs* mjs) {
+    UNUSED(mjs);
+    FURI_TRACE_BEGIN(JsGc, mjs->gc.phase);
+    return furi_trace_get_timestamp();
+}
 
-        gc_mark(mjs, &prop->name);
-        gc_mark(mjs, &prop->value);
+static void gc_pause_end(struct mjs* mjs, uint32_t start) {
+    struct mjs_gc_stats* stats = &mjs->gc.stats;
+    uint32_t pause_us =
+        (furi_trace_get_timestamp() - start) / furi_hal_cortex_instructions_per_microsecond();
 
-        next = prop->next;
-        MARK(prop);
+    stats->pauses++;
+    stats->last_pause_us = pause_us;
+    stats->total_pause_us += pause_us;
+    if(pause_us > stats->max_pause_us) {
+        stats->max_pause_us = pause_us;
     }
 
-    /* mark object's prototype */
-    /*
-   * We dropped support for object prototypes in MJS.
-   * If we ever bring it back, don't forget to mark it
-   */
-    /* gc_mark(mjs, mjs_get_proto(mjs, v)); */
+    FURI_TRACE_END(JsGc, mjs->gc.phase);
+    FURI_TRACE_COUNTER(JsGcPause, pause_us);
+}
+
+MJS_PRIVATE void gc_write_barrier(struct mjs* mjs, struct mjs_property* p) {
+    if(mjs->gc.phase != GC_PHASE_MARK) {
+        return;
+    }
+
+    /* Owner object may be scanned already */
+    gc_mark_cell(mjs, &mjs->property_arena, p);
+    gc_shade(mjs, &p->value);
 }
 
 /* Mark a string value */
@@ -366,18 +565,31 @@ static void gc_mark_string(struct mjs* mjs, mjs_val_t* v) {
     memcpy(v, &tmp, sizeof(tmp));
 }
 
-MJS_PRIVATE void gc_mark(struct mjs* mjs, mjs_val_t* v) {
-    if(mjs_is_object_based(*v)) {
-        gc_mark_object(mjs, v);
-    }
-    if(mjs_is_ffi_sig(*v)) {
-        gc_mark_ffi_sig(mjs, v);
-    }
+/* Mark a value for string compaction */
+static void gc_mark_strings(struct mjs* mjs, mjs_val_t* v) {
     if((*v & MJS_TAG_MASK) == MJS_TAG_STRING_O) {
         gc_mark_string(mjs, v);
     }
 }
 
+/* Mark strings referred to by properties that survive collection */
+static void gc_mark_property_strings(struct mjs* mjs) {
+    struct gc_arena* a = &mjs->property_arena;
+    struct mjs_property* prop;
+    struct gc_block* b;
+    size_t i;
+
+    for(b = a->blocks; b != NULL; b = b->next) {
+        for(i = 0; i < b->size; i++) {
+            prop = (struct mjs_property*)GC_CELL_OP(a, b->base, +, i);
+            if(!GC_CELL_IS_FREE(prop) && GC_MARK_GET(b, i) == mjs->gc.live) {
+                gc_mark_strings(mjs, &prop->name);
+                gc_mark_strings(mjs, &prop->value);
+            }
+        }
+    }
+}
+
 MJS_PRIVATE uint64_t gc_string_mjs_val_to_offset(mjs_val_t v) {
     return (((uint64_t)(uintptr_t)get_ptr(v)) & ~MJS_TAG_MASK);
 }
@@ -442,63 +654,135 @@ void gc_compact_strings(struct mjs* mjs) {
 }
 
 MJS_PRIVATE int maybe_gc(struct mjs* mjs) {
-    if(!mjs->inhibit_gc) {
-        mjs_gc(mjs, 0);
-        return 1;
+    uint32_t start;
+
+    if(mjs->inhibit_gc) {
+        return 0;
     }
-    return 0;
+
+    /* Set again when collection ends, if strings are still to be compacted */
+    mjs->need_gc = 0;
+
+    start = gc_pause_begin(mjs);
+    if(mjs->gc.phase == GC_PHASE_IDLE) {
+        gc_start_cycle(mjs);
+    }
+    gc_step(mjs, MAX(mjs->gc.debt, (size_t)MJS_GC_STEP_WORK));
+    gc_pause_end(mjs, start);
+
+    return 1;
+}
+
+int mjs_gc_step(struct mjs* mjs, size_t budget) {
+    uint32_t start;
+
+    if(mjs->inhibit_gc || mjs->gc.phase == GC_PHASE_IDLE) {
+        return mjs->gc.phase != GC_PHASE_IDLE;
+    }
+
+    start = gc_pause_begin(mjs);
+    gc_step(mjs, budget);
+    gc_pause_end(mjs, start);
+
+    return mjs->gc.phase != GC_PHASE_IDLE;
+}
+
+void mjs_gc_get_stats(struct mjs* mjs, mjs_gc_stats_t* stats) {
+    *stats = mjs->gc.stats;
 }
 
 /*
  * mark an array of `mjs_val_t` values (*not pointers* to them)
  */
-static void gc_mark_val_array(struct mjs* mjs, mjs_val_t* vals, size_t len) {
+static void gc_mark_val_array(struct mjs* mjs, mjs_val_t* vals, size_t len, gc_mark_fn_t mark) {
     mjs_val_t* vp;
     for(vp = vals; vp < vals + len; vp++) {
-        gc_mark(mjs, vp);
+        mark(mjs, vp);
     }
 }
 
 /*
  * mark an mbuf containing *pointers* to `mjs_val_t` values
  */
-static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf) {
+static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf, gc_mark_fn_t mark) {
     mjs_val_t** vp;
     for(vp = (mjs_val_t**)mbuf->buf; (char*)vp < mbuf->buf + mbuf->len; vp++) {
-        gc_mark(mjs, *vp);
+        mark(mjs, *vp);
     }
 }
 
 /*
  * mark an mbuf containing `mjs_val_t` values (*not pointers* to them)
  */
-static void gc_mark_mbuf_val(struct mjs* mjs, const struct mbuf* mbuf) {
-    gc_mark_val_array(mjs, (mjs_val_t*)mbuf->buf, mbuf->len / sizeof(mjs_val_t));
+static void gc_mark_mbuf_val(struct mjs* mjs, const struct mbuf* mbuf, gc_mark_fn_t mark) {
+    gc_mark_val_array(mjs, (mjs_val_t*)mbuf->buf, mbuf->len / sizeof(mjs_val_t), mark);
 }
 
-static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs) {
+static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs, gc_mark_fn_t mark) {
     for(; cbargs != NULL; cbargs = cbargs->next) {
-        gc_mark(mjs, &cbargs->func);
-        gc_mark(mjs, &cbargs->userdata);
+        mark(mjs, &cbargs->func);
+        mark(mjs, &cbargs->userdata);
     }
 }
 
-/* Perform garbage collection */
-void mjs_gc(struct mjs* mjs, int full) {
-    gc_mark_val_array(mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t));
+static void gc_mark_roots(struct mjs* mjs, gc_mark_fn_t mark) {
+    gc_mark_val_array(
+        mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t), mark);
 
-    gc_mark_mbuf_pt(mjs, &mjs->owned_values);
-    gc_mark_mbuf_val(mjs, &mjs->scopes);
-    gc_mark_mbuf_val(mjs, &mjs->stack);
-    gc_mark_mbuf_val(mjs, &mjs->call_stack);
+    gc_mark_mbuf_pt(mjs, &mjs->owned_values, mark);
+    gc_mark_mbuf_val(mjs, &mjs->scopes, mark);
+    gc_mark_mbuf_val(mjs, &mjs->stack, mark);
+    gc_mark_mbuf_val(mjs, &mjs->call_stack, mark);
 
-    gc_mark_ffi_cbargs_list(mjs, mjs->ffi_cb_args);
+    gc_mark_ffi_cbargs_list(mjs, mjs->ffi_cb_args, mark);
+}
+
+/*
+ * Compacts strings referred to by live values. Called once marking is over,
+ * before anything is swept. Objects are swept first: their destructors look
+ * at property names, which may be strings of dead properties.
+ */
+static void gc_compact_live_strings(struct mjs* mjs) {
+    gc_sweep_start(mjs, &mjs->object_arena);
+    while(mjs->gc.sweep_block != NULL) {
+        struct gc_block* b = mjs->gc.sweep_block;
+        mjs->gc.sweep_block = b->next;
+        gc_sweep_block(mjs, &mjs->object_arena, b);
+    }
 
+    gc_mark_roots(mjs, gc_mark_strings);
+    gc_mark_property_strings(mjs);
     gc_compact_strings(mjs);
+    mjs->need_gc_strings = 0;
+    mjs->gc.compact_strings = 0;
 
-    gc_sweep(mjs, &mjs->object_arena, 0);
-    gc_sweep(mjs, &mjs->property_arena, 0);
-    gc_sweep(mjs, &mjs->ffi_sig_arena, 0);
+    if(mjs->owned_strings.len > mjs->owned_strings.size / 4 * 3) {
+        /*
+     * Leave room for new strings, otherwise every few short-lived strings
+     * schedule another compaction
+     */
+        mbuf_resize(
+            &mjs->owned_strings,
+            mjs->owned_strings.len + mjs->owned_strings.len / 2 + _MJS_STRING_BUF_RESERVE);
+    }
+
+    /* Rest of the sweep continues incrementally */
+    gc_sweep_start(mjs, &mjs->property_arena);
+}
+
+/* Perform garbage collection */
+void mjs_gc(struct mjs* mjs, int full) {
+    uint32_t start = gc_pause_begin(mjs);
+
+    /* Collection in progress may have swept already, so it is finished first */
+    while(gc_step(mjs, SIZE_MAX))
+        ;
+
+    gc_start_cycle(mjs);
+    mjs->gc.compact_strings = 1;
+    while(gc_step(mjs, SIZE_MAX))
+        ;
+    mjs->gc.stats.full_cycles++;
 
     if(full) {
         /*
@@ -511,6 +795,8 @@ void mjs_gc(struct mjs* mjs, int full) {
             mbuf_resize(&mjs->owned_strings, trimmed_size);
         }
     }
+
+    gc_pause_end(mjs, start);
 }
 
 MJS_PRIVATE int gc_check_val(struct mjs* mjs, mjs_val_t v) {
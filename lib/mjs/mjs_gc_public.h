@@ -12,12 +12,42 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/*
+ * Garbage collector pause statistics. Pauses are measured in microseconds.
+ */
+typedef struct mjs_gc_stats {
+    uint32_t cycles; /* completed collections */
+    uint32_t full_cycles; /* collections done by mjs_gc() */
+    uint32_t pauses; /* times the program was stopped for collection */
+    uint32_t last_pause_us;
+    uint32_t max_pause_us;
+    uint32_t total_pause_us;
+} mjs_gc_stats_t;
+
 /*
  * Perform garbage collection.
  * Pass true to full in order to reclaim unused heap back to the OS.
+ *
+ * Collection in progress is finished first, and strings are compacted, so
+ * the program is stopped for the whole heap walk.
  */
 void mjs_gc(struct mjs* mjs, int full);
 
+/*
+ * Advance incremental collection in progress by at most `budget` units of
+ * work, one unit is roughly one object, property or cell visited.
+ * Collections are started by allocations, this function only lets idle
+ * time be used for them, e.g. from event loop tick.
+ *
+ * Returns 1 if collection is still in progress.
+ */
+int mjs_gc_step(struct mjs* mjs, size_t budget);
+
+/*
+ * Get garbage collector pause statistics.
+ */
+void mjs_gc_get_stats(struct mjs* mjs, mjs_gc_stats_t* stats);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
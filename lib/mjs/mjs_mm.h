@@ -7,6 +7,7 @@
 #define MJS_MM_H_
 
 #include "mjs_internal.h"
+#include "mjs_gc_public.h"
 
 #if defined(__cplusplus)
 extern "C" {
@@ -20,12 +21,19 @@ struct gc_block {
     struct gc_block* next;
     struct gc_cell* base;
     size_t size;
+    /*
+   * Mark bits live outside of cells: unlike the stop-the-world collector, the
+   * incremental one keeps marks while the program runs, and cells start with
+   * pointers that the program uses.
+   */
+    uint8_t marks[];
 };
 
 struct gc_arena {
     struct gc_block* blocks;
     size_t size_increment;
     struct gc_cell* free; /* head of free list */
+    struct gc_block* last; /* last block found by gc_find_block() */
     size_t cell_size;
 
 #if MJS_MEMORY_STATS
@@ -37,6 +45,30 @@ struct gc_arena {
     gc_cell_destructor_t destructor;
 };
 
+enum gc_phase {
+    GC_PHASE_IDLE,
+    GC_PHASE_MARK,
+    GC_PHASE_SWEEP,
+};
+
+struct gc_state {
+    enum gc_phase phase;
+    /* Mark bit value of live cells, flipped at the start of each cycle */
+    uint8_t live;
+    /* Objects that are marked, but whose properties are not yet */
+    struct mbuf gray;
+    /* Next property of the object being scanned, large objects take several steps */
+    struct mjs_property* scan_prop;
+    /* Sweep position */
+    struct gc_arena* sweep_arena;
+    struct gc_block* sweep_block;
+    /* Work owed by allocations since the last step */
+    size_t debt;
+    /* Strings are compacted at the end of marking of the current cycle */
+    unsigned compact_strings : 1;
+    struct mjs_gc_stats stats;
+};
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
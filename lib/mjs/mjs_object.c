@@ -216,6 +216,7 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
     }
 
     p->value = val;
+    gc_write_barrier(mjs, p);
 
 clean:
     if(need_free) {
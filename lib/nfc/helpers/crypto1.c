@@ -1,4 +1,4 @@
-#include "crypto1.h"
+#include "crypto1_i.h"
 
 #include <lib/nfc/helpers/nfc_util.h>
 #include <lib/bit_lib/bit_lib.h>
@@ -8,10 +8,6 @@
 
 #define SWAPENDIAN(x) \
     ((x) = ((x) >> 8 & 0xff00ff) | ((x) & 0xff00ff) << 8, (x) = (x) >> 16 | (x) << 16)
-#define LF_POLY_ODD  (0x29CE5C)
-#define LF_POLY_EVEN (0x870804)
-
-#define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
 
 Crypto1* crypto1_alloc(void) {
     Crypto1* instance = malloc(sizeof(Crypto1));
@@ -41,14 +37,78 @@ void crypto1_init(Crypto1* crypto1, uint64_t key) {
     }
 }
 
-static uint32_t crypto1_filter(uint32_t in) {
+const uint8_t crypto1_filter_lut_low[256] = {
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+};
+
+const uint8_t crypto1_filter_lut_mid[256] = {
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+};
+
+const uint8_t crypto1_filter_lut_high[16] = {
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x01,
+};
+
+// Clock cipher by 8 bits, state is kept in registers for the whole byte
+static inline uint8_t
+    crypto1_step_byte(uint32_t* odd, uint32_t* even, uint8_t in, uint32_t is_encrypted) {
+    uint32_t state_odd = *odd;
+    uint32_t state_even = *even;
+    uint8_t out = 0;
+
+    for(uint8_t i = 0; i < 8; i++) {
+        const uint32_t ks = crypto1_filter(state_odd);
+        const uint32_t feed = ((ks & is_encrypted) ^ FURI_BIT(in, i)) ^
+                              (LF_POLY_ODD & state_odd) ^ (LF_POLY_EVEN & state_even);
+        const uint32_t next = state_even << 1 | __builtin_parity(feed);
+        state_even = state_odd;
+        state_odd = next;
+        out |= ks << i;
+    }
+
+    *odd = state_odd;
+    *even = state_even;
+    return out;
+}
+
+// Clock cipher by 32 bits, input and output are big endian byte ordered
+static inline uint32_t
+    crypto1_step_word(uint32_t* odd, uint32_t* even, uint32_t in, uint32_t is_encrypted) {
     uint32_t out = 0;
-    out = 0xf22c0 >> (in & 0xf) & 16;
-    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
-    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
-    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
-    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
-    return FURI_BIT(0xEC57E80A, out);
+    for(int8_t shift = 24; shift >= 0; shift -= 8) {
+        out |= (uint32_t)crypto1_step_byte(odd, even, in >> shift, is_encrypted) << shift;
+    }
+    return out;
 }
 
 uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
@@ -66,20 +126,27 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
 
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = 0;
-    for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
-    }
-    return out;
+    return crypto1_step_byte(&crypto1->odd, &crypto1->even, in, !!is_encrypted);
 }
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint32_t out = 0;
-    for(uint8_t i = 0; i < 32; i++) {
-        out |= (uint32_t)crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+    return crypto1_step_word(&crypto1->odd, &crypto1->even, in, !!is_encrypted);
+}
+
+void crypto1_keystream(Crypto1* crypto1, uint8_t* keystream, uint8_t* parity, size_t length) {
+    furi_assert(crypto1);
+    furi_assert(keystream);
+
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    for(size_t i = 0; i < length; i++) {
+        keystream[i] = crypto1_step_byte(&odd, &even, 0, 0);
+        // Parity bit is encrypted with the keystream bit of the next clock
+        if(parity) parity[i] = crypto1_filter(odd);
     }
-    return out;
+    crypto1->odd = odd;
+    crypto1->even = even;
 }
 
 uint32_t crypto1_prng_successor(uint32_t x, uint32_t n) {
@@ -107,10 +174,14 @@ void crypto1_decrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
         decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 3)) << 3;
         bit_buffer_set_byte(out, 0, decrypted_byte);
     } else {
+        uint32_t odd = crypto->odd;
+        uint32_t even = crypto->even;
         for(size_t i = 0; i < bits / 8; i++) {
-            uint8_t decrypted_byte = crypto1_byte(crypto, 0, 0) ^ encrypted_data[i];
+            uint8_t decrypted_byte = crypto1_step_byte(&odd, &even, 0, 0) ^ encrypted_data[i];
             bit_buffer_set_byte(out, i, decrypted_byte);
         }
+        crypto->odd = odd;
+        crypto->even = even;
     }
 }
 
@@ -129,13 +200,16 @@ void crypto1_encrypt(Crypto1* crypto, uint8_t* keystream, const BitBuffer* buff,
         }
         bit_buffer_set_byte(out, 0, encrypted_byte);
     } else {
+        uint32_t odd = crypto->odd;
+        uint32_t even = crypto->even;
         for(size_t i = 0; i < bits / 8; i++) {
-            uint8_t encrypted_byte = crypto1_byte(crypto, keystream ? keystream[i] : 0, 0) ^
-                                     plain_data[i];
-            bool parity_bit =
-                ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01);
+            uint8_t encrypted_byte =
+                crypto1_step_byte(&odd, &even, keystream ? keystream[i] : 0, 0) ^ plain_data[i];
+            bool parity_bit = ((crypto1_filter(odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01);
             bit_buffer_set_byte_with_parity(out, i, encrypted_byte, parity_bit);
         }
+        crypto->odd = odd;
+        crypto->even = even;
     }
 }
 
@@ -178,31 +252,34 @@ void crypto1_encrypt_reader_nonce(
     }
 }
 
-static uint8_t lfsr_rollback_bit(Crypto1* crypto1, uint32_t in, int fb) {
-    int out;
-    uint8_t ret;
-    uint32_t t;
-
-    crypto1->odd &= 0xffffff;
-    t = crypto1->odd;
-    crypto1->odd = crypto1->even;
-    crypto1->even = t;
-
-    out = crypto1->even & 1;
-    out ^= LF_POLY_EVEN & (crypto1->even >>= 1);
-    out ^= LF_POLY_ODD & crypto1->odd;
-    out ^= !!in;
-    out ^= (ret = crypto1_filter(crypto1->odd)) & (!!fb);
-
-    crypto1->even |= (nfc_util_even_parity32(out)) << 23;
-    return ret;
-}
-
 uint32_t crypto1_lfsr_rollback_word(Crypto1* crypto1, uint32_t in, int fb) {
+    furi_assert(crypto1);
+
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    const uint32_t feedback = !!fb;
     uint32_t ret = 0;
+
     for(int i = 31; i >= 0; i--) {
-        ret |= lfsr_rollback_bit(crypto1, BEBIT(in, i), fb) << (24 ^ i);
+        // Undo one clock: the newest bit of the register is recomputed from the rest
+        const uint32_t t = odd & 0xffffff;
+        odd = even;
+        even = t;
+
+        uint32_t out = even & 1;
+        even >>= 1;
+        out ^= LF_POLY_EVEN & even;
+        out ^= LF_POLY_ODD & odd;
+        out ^= BEBIT(in, i);
+        const uint32_t ks = crypto1_filter(odd);
+        out ^= ks & feedback;
+
+        even |= (uint32_t)__builtin_parity(out) << 23;
+        ret |= ks << (24 ^ i);
     }
+
+    crypto1->odd = odd;
+    crypto1->even = even;
     return ret;
 }
 
@@ -230,8 +307,35 @@ uint32_t crypto1_decrypt_nt_enc(uint32_t cuid, uint32_t nt_enc, MfClassicKey kno
     uint64_t known_key_int = bit_lib_bytes_to_num_be(known_key.data, 6);
     Crypto1 crypto_temp;
     crypto1_init(&crypto_temp, known_key_int);
-    crypto1_word(&crypto_temp, nt_enc ^ cuid, 1);
-    uint32_t decrypted_nt_enc =
-        (nt_enc ^ crypto1_lfsr_rollback_word(&crypto_temp, nt_enc ^ cuid, 1));
-    return decrypted_nt_enc;
+    // Keystream produced while feeding the nonce is exactly what encrypted it
+    uint32_t keystream =
+        crypto1_step_word(&crypto_temp.odd, &crypto_temp.even, nt_enc ^ cuid, 1);
+    return nt_enc ^ keystream;
+}
+
+size_t crypto1_nt_enc_filter_keys(
+    uint32_t cuid,
+    uint32_t nt_enc,
+    uint8_t nt_par_enc,
+    bool is_weak,
+    MfClassicKey* keys,
+    size_t keys_count) {
+    furi_assert(keys || keys_count == 0);
+
+    size_t matched = 0;
+    Crypto1 crypto_temp;
+    for(size_t i = 0; i < keys_count; i++) {
+        crypto1_init(&crypto_temp, bit_lib_bytes_to_num_be(keys[i].data, 6));
+        uint32_t keystream =
+            crypto1_step_word(&crypto_temp.odd, &crypto_temp.even, nt_enc ^ cuid, 1);
+        uint32_t nt = nt_enc ^ keystream;
+
+        if(is_weak && !crypto1_is_weak_prng_nonce(nt)) continue;
+        if(!crypto1_nonce_matches_encrypted_parity_bits(nt, keystream, nt_par_enc)) continue;
+
+        if(matched != i) keys[matched] = keys[i];
+        matched++;
+    }
+
+    return matched;
 }
@@ -26,6 +26,15 @@ uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted);
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted);
 
+/** Generate keystream bytes
+ *
+ * @param crypto1 Crypto1 instance
+ * @param keystream output buffer for length keystream bytes
+ * @param parity output buffer for length parity keystream bits, one per byte, may be NULL
+ * @param length number of bytes to generate
+ */
+void crypto1_keystream(Crypto1* crypto1, uint8_t* keystream, uint8_t* parity, size_t length);
+
 void crypto1_decrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out);
 
 void crypto1_encrypt(Crypto1* crypto, uint8_t* keystream, const BitBuffer* buff, BitBuffer* out);
@@ -47,6 +56,28 @@ bool crypto1_is_weak_prng_nonce(uint32_t nonce);
 
 uint32_t crypto1_decrypt_nt_enc(uint32_t cuid, uint32_t nt_enc, MfClassicKey known_key);
 
+/** Test candidate keys against one encrypted nested nonce
+ *
+ * Keys that decrypt nt_enc into a nonce consistent with the encrypted parity
+ * bits (and the weak PRNG, if requested) are moved to the front of the array,
+ * preserving their order.
+ *
+ * @param cuid card UID
+ * @param nt_enc encrypted nonce
+ * @param nt_par_enc encrypted parity bits of the nonce
+ * @param is_weak require decrypted nonce to be a weak PRNG nonce
+ * @param keys candidate keys, filtered in place
+ * @param keys_count number of candidate keys
+ * @return number of matching keys
+ */
+size_t crypto1_nt_enc_filter_keys(
+    uint32_t cuid,
+    uint32_t nt_enc,
+    uint8_t nt_par_enc,
+    bool is_weak,
+    MfClassicKey* keys,
+    size_t keys_count);
+
 uint32_t crypto1_prng_successor(uint32_t x, uint32_t n);
 
 #ifdef __cplusplus
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "crypto1.h"
+
+#include <core/common_defines.h>
+
+#define LF_POLY_ODD  (0x29CE5C)
+#define LF_POLY_EVEN (0x870804)
+
+#define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
+
+// Filter function split into lookup tables, two nibbles of odd state per table
+extern const uint8_t crypto1_filter_lut_low[256];
+extern const uint8_t crypto1_filter_lut_mid[256];
+extern const uint8_t crypto1_filter_lut_high[16];
+
+static inline uint32_t crypto1_filter(uint32_t in) {
+    const uint32_t index = crypto1_filter_lut_low[in & 0xff] |
+                           crypto1_filter_lut_mid[(in >> 8) & 0xff] |
+                           crypto1_filter_lut_high[(in >> 16) & 0xf];
+    return FURI_BIT(0xEC57E80A, index);
+}
@@ -0,0 +1,610 @@
+#include "crypto1_recovery.h"
+#include "crypto1_i.h"
+
+#include <furi.h>
+
+// Algorithm from https://github.com/RfidResearchGroup/proxmark3.git (crapto1 lfsr_recovery32)
+
+#define CRYPTO1_RECOVERY_SEED_BITS          (20)
+#define CRYPTO1_RECOVERY_LEVELS_MAX         (4)
+#define CRYPTO1_RECOVERY_BUCKETS            (256)
+#define CRYPTO1_RECOVERY_TABLE_HEADROOM     (3)
+#define CRYPTO1_RECOVERY_EXTEND_ROUNDS      (11)
+#define CRYPTO1_RECOVERY_SIMPLE_ROUNDS      (4)
+#define CRYPTO1_RECOVERY_LEVEL_ROUNDS       (4)
+#define CRYPTO1_RECOVERY_INSERTION_SORT_MAX (32)
+
+typedef struct {
+    uint16_t odd_start;
+    uint16_t odd_end;
+    uint16_t even_start;
+    uint16_t even_end;
+} Crypto1RecoveryBucket;
+
+typedef struct {
+    Crypto1RecoveryBucket buckets[CRYPTO1_RECOVERY_BUCKETS];
+    size_t count;
+} Crypto1RecoveryLevel;
+
+struct Crypto1Recovery {
+    uint8_t partition_bits;
+    size_t capacity;
+    uint32_t* odd;
+    uint32_t* even;
+    Crypto1RecoveryLevel levels[CRYPTO1_RECOVERY_LEVELS_MAX];
+
+    // Odd slice table extended up to the first intersection, shared by all even slices
+    uint32_t* odd_base;
+    size_t odd_base_end;
+    uint32_t odd_base_ks2;
+    uint32_t odd_base_slice;
+    bool odd_base_valid;
+
+    Crypto1RecoveryCallback callback;
+    void* context;
+    bool aborted;
+    bool overflow_odd;
+    bool overflow_even;
+};
+
+Crypto1Recovery* crypto1_recovery_alloc(uint8_t partition_bits) {
+    furi_check(partition_bits >= 5 && partition_bits <= 10);
+
+    Crypto1Recovery* instance = malloc(sizeof(Crypto1Recovery));
+    instance->partition_bits = partition_bits;
+    // About half of the seeds pass the first filter check, leave room for table growth
+    instance->capacity = (1UL << (CRYPTO1_RECOVERY_SEED_BITS - 1 - partition_bits)) *
+                         CRYPTO1_RECOVERY_TABLE_HEADROOM;
+    furi_check(instance->capacity < UINT16_MAX);
+    // One extra slot for the look-ahead write of table extension
+    instance->odd = malloc(sizeof(uint32_t) * (instance->capacity + 1));
+    instance->even = malloc(sizeof(uint32_t) * (instance->capacity + 1));
+    instance->odd_base = malloc(sizeof(uint32_t) * (instance->capacity + 1));
+
+    return instance;
+}
+
+void crypto1_recovery_free(Crypto1Recovery* instance) {
+    furi_check(instance);
+
+    free(instance->odd);
+    free(instance->even);
+    free(instance->odd_base);
+    free(instance);
+}
+
+uint32_t crypto1_recovery_get_partition_count(Crypto1Recovery* instance) {
+    furi_check(instance);
+
+    return 1UL << (instance->partition_bits * 2);
+}
+
+uint64_t crypto1_recovery_get_key(const Crypto1* state) {
+    furi_check(state);
+
+    uint64_t key = 0;
+    // Inverse of crypto1_init
+    for(int8_t i = 23; i >= 0; i--) {
+        key = key << 1 | FURI_BIT(state->odd, i ^ 3);
+        key = key << 1 | FURI_BIT(state->even, i ^ 3);
+    }
+    return key;
+}
+
+static inline void
+    crypto1_recovery_update_contribution(uint32_t* item, uint32_t mask1, uint32_t mask2) {
+    uint32_t p = *item >> 25;
+
+    p = p << 1 | __builtin_parity(*item & mask1);
+    p = p << 1 | __builtin_parity(*item & mask2);
+    *item = p << 24 | (*item & 0xffffff);
+}
+
+/** Extend table by one bit without tracking contribution
+ *
+ * Every entry is shifted and the new bit is chosen to match keystream bit.
+ * Entries where both choices match are duplicated, entries where none
+ * matches are dropped.
+ */
+static bool crypto1_recovery_extend_table_simple(
+    uint32_t* table,
+    size_t* end,
+    size_t capacity,
+    uint32_t bit) {
+    size_t i = 0;
+    while(i < *end) {
+        const uint32_t value = table[i] << 1;
+        const uint32_t filter = crypto1_filter(value);
+        if(filter ^ crypto1_filter(value | 1)) {
+            table[i++] = value | (filter ^ bit);
+        } else if(filter == bit) {
+            if(*end >= capacity) return false;
+            // Move next unprocessed entry out of the way, place the duplicate instead
+            table[(*end)++] = table[i + 1];
+            table[i++] = value;
+            table[i++] = value | 1;
+        } else {
+            table[i] = table[--(*end)];
+        }
+    }
+    return true;
+}
+
+/** Extend table by one bit, tracking feedback contribution in the top byte */
+static bool crypto1_recovery_extend_table(
+    uint32_t* table,
+    size_t start,
+    size_t* end,
+    size_t capacity,
+    uint32_t bit,
+    uint32_t mask1,
+    uint32_t mask2,
+    uint32_t in) {
+    in <<= 24;
+    size_t i = start;
+    while(i < *end) {
+        uint32_t value = table[i] << 1;
+        const uint32_t filter = crypto1_filter(value);
+        if(filter ^ crypto1_filter(value | 1)) {
+            value |= filter ^ bit;
+            crypto1_recovery_update_contribution(&value, mask1, mask2);
+            table[i++] = value ^ in;
+        } else if(filter == bit) {
+            if(*end >= capacity) return false;
+            table[(*end)++] = table[i + 1];
+            uint32_t value_one = value | 1;
+            crypto1_recovery_update_contribution(&value, mask1, mask2);
+            crypto1_recovery_update_contribution(&value_one, mask1, mask2);
+            table[i++] = value ^ in;
+            table[i++] = value_one ^ in;
+        } else {
+            table[i] = table[--(*end)];
+        }
+    }
+    return true;
+}
+
+static void crypto1_recovery_insertion_sort(uint32_t* table, size_t start, size_t end) {
+    for(size_t i = start + 1; i < end; i++) {
+        const uint32_t value = table[i];
+        size_t j = i;
+        while(j > start && (table[j - 1] >> 24) > (value >> 24)) {
+            table[j] = table[j - 1];
+            j--;
+        }
+        table[j] = value;
+    }
+}
+
+/** Sort table range in place by the top byte (contribution bits) */
+static void crypto1_recovery_bucket_sort(uint32_t* table, size_t start, size_t end) {
+    if(end - start <= CRYPTO1_RECOVERY_INSERTION_SORT_MAX) {
+        crypto1_recovery_insertion_sort(table, start, end);
+        return;
+    }
+
+    uint16_t next[CRYPTO1_RECOVERY_BUCKETS] = {};
+    uint16_t bucket_end[CRYPTO1_RECOVERY_BUCKETS];
+
+    for(size_t i = start; i < end; i++) {
+        next[table[i] >> 24]++;
+    }
+
+    size_t offset = start;
+    for(size_t b = 0; b < CRYPTO1_RECOVERY_BUCKETS; b++) {
+        const size_t size = next[b];
+        next[b] = offset;
+        offset += size;
+        bucket_end[b] = offset;
+    }
+
+    // American flag sort: cycle every entry into its bucket
+    for(size_t b = 0; b < CRYPTO1_RECOVERY_BUCKETS; b++) {
+        while(next[b] < bucket_end[b]) {
+            uint32_t value = table[next[b]];
+            size_t value_bucket = value >> 24;
+            while(value_bucket != b) {
+                const uint32_t swap = table[next[value_bucket]];
+                table[next[value_bucket]++] = value;
+                value = swap;
+                value_bucket = value >> 24;
+            }
+            table[next[b]++] = value;
+        }
+    }
+}
+
+/** Keep only buckets present in both sorted tables
+ *
+ * Kept buckets are compacted to the start of each range. Odd entries are read
+ * from odd_src, which is either the odd table itself or the odd slice base.
+ */
+static void crypto1_recovery_bucket_intersect(
+    Crypto1Recovery* instance,
+    Crypto1RecoveryLevel* level,
+    const uint32_t* odd_src,
+    size_t odd_start,
+    size_t odd_end,
+    size_t even_start,
+    size_t even_end) {
+    uint32_t* odd = instance->odd;
+    uint32_t* even = instance->even;
+
+    size_t odd_write = odd_start;
+    size_t even_write = even_start;
+    size_t o = odd_start;
+    size_t e = even_start;
+    level->count = 0;
+    while(o < odd_end && e < even_end) {
+        const uint32_t odd_bucket = odd_src[o] >> 24;
+        const uint32_t even_bucket = even[e] >> 24;
+        if(odd_bucket < even_bucket) {
+            while(o < odd_end && (odd_src[o] >> 24) == odd_bucket) o++;
+        } else if(even_bucket < odd_bucket) {
+            while(e < even_end && (even[e] >> 24) == even_bucket) e++;
+        } else {
+            // Write position never passes read position, compaction is safe
+            Crypto1RecoveryBucket* bucket = &level->buckets[level->count++];
+            bucket->odd_start = odd_write;
+            while(o < odd_end && (odd_src[o] >> 24) == odd_bucket) odd[odd_write++] = odd_src[o++];
+            bucket->odd_end = odd_write;
+            bucket->even_start = even_write;
+            while(e < even_end && (even[e] >> 24) == even_bucket) even[even_write++] = even[e++];
+            bucket->even_end = even_write;
+        }
+    }
+}
+
+static void crypto1_recovery_descend(
+    Crypto1Recovery* instance,
+    uint32_t oks,
+    uint32_t eks,
+    int32_t rem,
+    uint32_t in,
+    size_t depth);
+
+static void crypto1_recovery_recover(
+    Crypto1Recovery* instance,
+    size_t odd_start,
+    size_t odd_end,
+    uint32_t oks,
+    size_t even_start,
+    size_t even_end,
+    uint32_t eks,
+    int32_t rem,
+    uint32_t in,
+    size_t depth) {
+    if(instance->aborted || instance->overflow_odd || instance->overflow_even) return;
+
+    if(rem == -1) {
+        for(size_t e = even_start; e < even_end; e++) {
+            const uint32_t even = instance->even[e] << 1 ^
+                                  __builtin_parity(instance->even[e] & LF_POLY_EVEN) ^
+                                  !!(in & 4);
+            for(size_t o = odd_start; o < odd_end; o++) {
+                const uint32_t odd = instance->odd[o];
+                Crypto1 state = {
+                    .even = odd & 0xffffff,
+                    .odd = (even ^ __builtin_parity(odd & LF_POLY_ODD)) & 0xffffff,
+                };
+                if(!instance->callback(&state, instance->context)) {
+                    instance->aborted = true;
+                    return;
+                }
+            }
+        }
+        return;
+    }
+
+    for(uint32_t i = 0; i < CRYPTO1_RECOVERY_LEVEL_ROUNDS && rem--; i++) {
+        oks >>= 1;
+        eks >>= 1;
+        in >>= 2;
+        if(!crypto1_recovery_extend_table(
+               instance->odd,
+               odd_start,
+               &odd_end,
+               instance->capacity,
+               oks & 1,
+               LF_POLY_EVEN << 1 | 1,
+               LF_POLY_ODD << 1,
+               0)) {
+            instance->overflow_odd = true;
+            return;
+        }
+        if(odd_start == odd_end) return;
+
+        if(!crypto1_recovery_extend_table(
+               instance->even,
+               even_start,
+               &even_end,
+               instance->capacity,
+               eks & 1,
+               LF_POLY_ODD,
+               LF_POLY_EVEN << 1 | 1,
+               in & 3)) {
+            instance->overflow_even = true;
+            return;
+        }
+        if(even_start == even_end) return;
+    }
+
+    furi_check(depth < CRYPTO1_RECOVERY_LEVELS_MAX);
+    crypto1_recovery_bucket_sort(instance->odd, odd_start, odd_end);
+    crypto1_recovery_bucket_sort(instance->even, even_start, even_end);
+    crypto1_recovery_bucket_intersect(
+        instance,
+        &instance->levels[depth],
+        instance->odd,
+        odd_start,
+        odd_end,
+        even_start,
+        even_end);
+    crypto1_recovery_descend(instance, oks, eks, rem, in, depth);
+}
+
+/** Recover every bucket kept by the intersection at given depth */
+static void crypto1_recovery_descend(
+    Crypto1Recovery* instance,
+    uint32_t oks,
+    uint32_t eks,
+    int32_t rem,
+    uint32_t in,
+    size_t depth) {
+    const Crypto1RecoveryLevel* level = &instance->levels[depth];
+
+    // Last bucket first: its growth only overwrites free space, earlier buckets
+    // then grow over buckets that are already processed
+    for(int32_t b = level->count - 1; b >= 0; b--) {
+        const Crypto1RecoveryBucket bucket = level->buckets[b];
+        crypto1_recovery_recover(
+            instance,
+            bucket.odd_start,
+            bucket.odd_end,
+            oks,
+            bucket.even_start,
+            bucket.even_end,
+            eks,
+            rem,
+            in,
+            depth + 1);
+    }
+}
+
+static size_t crypto1_recovery_fill_table(
+    uint32_t* table,
+    size_t capacity,
+    uint32_t seed_start,
+    uint32_t seed_end,
+    uint32_t bit) {
+    size_t count = 0;
+    for(uint32_t seed = seed_start; seed < seed_end; seed++) {
+        if(crypto1_filter(seed) == bit) {
+            if(count >= capacity) return SIZE_MAX;
+            table[count++] = seed;
+        }
+    }
+    return count;
+}
+
+static void crypto1_recovery_run_slices(
+    Crypto1Recovery* instance,
+    uint32_t oks,
+    uint32_t eks,
+    uint32_t in,
+    uint32_t odd_seed_start,
+    uint32_t odd_seed_end,
+    uint32_t even_seed_start,
+    uint32_t even_seed_end) {
+    instance->overflow_odd = false;
+    instance->overflow_even = false;
+
+    size_t odd_end = crypto1_recovery_fill_table(
+        instance->odd, instance->capacity, odd_seed_start, odd_seed_end, oks & 1);
+    size_t even_end = crypto1_recovery_fill_table(
+        instance->even, instance->capacity, even_seed_start, even_seed_end, eks & 1);
+    instance->overflow_odd = odd_end == SIZE_MAX;
+    instance->overflow_even = even_end == SIZE_MAX;
+
+    uint32_t odd_ks = oks;
+    uint32_t even_ks = eks;
+    for(uint8_t i = 0;
+        i < CRYPTO1_RECOVERY_SIMPLE_ROUNDS && !instance->overflow_odd && !instance->overflow_even;
+        i++) {
+        odd_ks >>= 1;
+        even_ks >>= 1;
+        instance->overflow_odd = !crypto1_recovery_extend_table_simple(
+            instance->odd, &odd_end, instance->capacity, odd_ks & 1);
+        instance->overflow_even = !crypto1_recovery_extend_table_simple(
+            instance->even, &even_end, instance->capacity, even_ks & 1);
+    }
+
+    if(!instance->overflow_odd && !instance->overflow_even) {
+        crypto1_recovery_recover(
+            instance,
+            0,
+            odd_end,
+            odd_ks,
+            0,
+            even_end,
+            even_ks,
+            CRYPTO1_RECOVERY_EXTEND_ROUNDS,
+            in,
+            0);
+    }
+
+    if(instance->aborted) return;
+
+    // Unlucky slice: split overflowing half and run again, some candidates may repeat
+    if(instance->overflow_odd && (odd_seed_end - odd_seed_start) > 1) {
+        const uint32_t odd_seed_mid = odd_seed_start + (odd_seed_end - odd_seed_start) / 2;
+        crypto1_recovery_run_slices(
+            instance, oks, eks, in, odd_seed_start, odd_seed_mid, even_seed_start, even_seed_end);
+        crypto1_recovery_run_slices(
+            instance, oks, eks, in, odd_seed_mid, odd_seed_end, even_seed_start, even_seed_end);
+    } else if(instance->overflow_even && (even_seed_end - even_seed_start) > 1) {
+        const uint32_t even_seed_mid = even_seed_start + (even_seed_end - even_seed_start) / 2;
+        crypto1_recovery_run_slices(
+            instance, oks, eks, in, odd_seed_start, odd_seed_end, even_seed_start, even_seed_mid);
+        crypto1_recovery_run_slices(
+            instance, oks, eks, in, odd_seed_start, odd_seed_end, even_seed_mid, even_seed_end);
+    }
+}
+
+/** Build odd slice table up to the first intersection
+ *
+ * Odd extension does not depend on the even half, so the table is built once
+ * per odd slice and bucket sorted. On overflow odd_base_end is SIZE_MAX and
+ * partitions of this slice take the splitting path instead.
+ */
+static void crypto1_recovery_build_odd_base(
+    Crypto1Recovery* instance,
+    uint32_t oks,
+    uint32_t seed_start,
+    uint32_t seed_end) {
+    uint32_t* table = instance->odd_base;
+    size_t end =
+        crypto1_recovery_fill_table(table, instance->capacity, seed_start, seed_end, oks & 1);
+
+    bool overflow = end == SIZE_MAX;
+    for(uint8_t i = 0; i < CRYPTO1_RECOVERY_SIMPLE_ROUNDS && !overflow; i++) {
+        oks >>= 1;
+        overflow = !crypto1_recovery_extend_table_simple(table, &end, instance->capacity, oks & 1);
+    }
+    for(uint8_t i = 0; i < CRYPTO1_RECOVERY_LEVEL_ROUNDS && !overflow; i++) {
+        oks >>= 1;
+        overflow = !crypto1_recovery_extend_table(
+            table,
+            0,
+            &end,
+            instance->capacity,
+            oks & 1,
+            LF_POLY_EVEN << 1 | 1,
+            LF_POLY_ODD << 1,
+            0);
+    }
+
+    if(!overflow) {
+        crypto1_recovery_bucket_sort(table, 0, end);
+    }
+    instance->odd_base_end = overflow ? SIZE_MAX : end;
+}
+
+/** Run even slice against the prebuilt odd slice table
+ *
+ * Same as crypto1_recovery_run_slices followed by the first level of
+ * crypto1_recovery_recover, with odd work taken from the odd slice base.
+ */
+static void crypto1_recovery_run_even_slice(
+    Crypto1Recovery* instance,
+    uint32_t oks,
+    uint32_t eks,
+    uint32_t in,
+    uint32_t even_seed_start,
+    uint32_t even_seed_end) {
+    instance->overflow_odd = false;
+    instance->overflow_even = false;
+
+    size_t even_end = crypto1_recovery_fill_table(
+        instance->even, instance->capacity, even_seed_start, even_seed_end, eks & 1);
+    instance->overflow_even = even_end == SIZE_MAX;
+
+    for(uint8_t i = 0; i < CRYPTO1_RECOVERY_SIMPLE_ROUNDS && !instance->overflow_even; i++) {
+        eks >>= 1;
+        instance->overflow_even = !crypto1_recovery_extend_table_simple(
+            instance->even, &even_end, instance->capacity, eks & 1);
+    }
+    for(uint8_t i = 0; i < CRYPTO1_RECOVERY_LEVEL_ROUNDS && !instance->overflow_even; i++) {
+        eks >>= 1;
+        in >>= 2;
+        instance->overflow_even = !crypto1_recovery_extend_table(
+            instance->even,
+            0,
+            &even_end,
+            instance->capacity,
+            eks & 1,
+            LF_POLY_ODD,
+            LF_POLY_EVEN << 1 | 1,
+            in & 3);
+    }
+    if(instance->overflow_even || even_end == 0 || instance->odd_base_end == 0) return;
+
+    crypto1_recovery_bucket_sort(instance->even, 0, even_end);
+    crypto1_recovery_bucket_intersect(
+        instance,
+        &instance->levels[0],
+        instance->odd_base,
+        0,
+        instance->odd_base_end,
+        0,
+        even_end);
+    crypto1_recovery_descend(
+        instance,
+        oks >> (CRYPTO1_RECOVERY_SIMPLE_ROUNDS + CRYPTO1_RECOVERY_LEVEL_ROUNDS),
+        eks,
+        CRYPTO1_RECOVERY_EXTEND_ROUNDS - CRYPTO1_RECOVERY_LEVEL_ROUNDS,
+        in,
+        0);
+}
+
+bool crypto1_recovery_run_partition(
+    Crypto1Recovery* instance,
+    uint32_t ks2,
+    uint32_t in,
+    uint32_t partition,
+    Crypto1RecoveryCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(callback);
+    furi_check(partition < crypto1_recovery_get_partition_count(instance));
+
+    instance->callback = callback;
+    instance->context = context;
+    instance->aborted = false;
+
+    uint32_t oks = 0;
+    uint32_t eks = 0;
+    for(int8_t i = 31; i >= 0; i -= 2) {
+        oks = oks << 1 | BEBIT(ks2, i);
+    }
+    for(int8_t i = 30; i >= 0; i -= 2) {
+        eks = eks << 1 | BEBIT(ks2, i);
+    }
+
+    in = (in >> 16 & 0xff) | (in << 16) | (in & 0xff00);
+
+    const uint32_t slice_bits = CRYPTO1_RECOVERY_SEED_BITS - instance->partition_bits;
+    const uint32_t odd_slice = partition >> instance->partition_bits;
+    const uint32_t even_slice = partition & ((1UL << instance->partition_bits) - 1);
+
+    if(!instance->odd_base_valid || instance->odd_base_ks2 != ks2 ||
+       instance->odd_base_slice != odd_slice) {
+        crypto1_recovery_build_odd_base(
+            instance, oks, odd_slice << slice_bits, (odd_slice + 1) << slice_bits);
+        instance->odd_base_ks2 = ks2;
+        instance->odd_base_slice = odd_slice;
+        instance->odd_base_valid = true;
+    }
+
+    bool overflow = instance->odd_base_end == SIZE_MAX;
+    if(!overflow) {
+        crypto1_recovery_run_even_slice(
+            instance, oks, eks, in << 1, even_slice << slice_bits, (even_slice + 1) << slice_bits);
+        overflow = instance->overflow_odd || instance->overflow_even;
+    }
+
+    // Unlucky partition: start over on the splitting path, some candidates may repeat
+    if(overflow && !instance->aborted) {
+        crypto1_recovery_run_slices(
+            instance,
+            oks,
+            eks,
+            in << 1,
+            odd_slice << slice_bits,
+            (odd_slice + 1) << slice_bits,
+            even_slice << slice_bits,
+            (even_slice + 1) << slice_bits);
+    }
+
+    return !instance->aborted;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "crypto1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Crypto1 state recovery from 32 bits of keystream
+ *
+ * Memory bounded variant of the lfsr_recovery32 algorithm. Candidate tables
+ * for the odd and even register halves are built from a fixed slice of the
+ * 20 bit filter seeds, so the full state space is covered by running every
+ * partition (odd slice x even slice) in turn. Each partition only needs
+ * tables of about 3 * 2^(19 - partition_bits) entries. Slices that do not fit
+ * are split and processed again, so some candidates may be reported twice.
+ *
+ * The odd slice table is kept between calls, so running partitions in order
+ * builds it only once per odd slice.
+ */
+typedef struct Crypto1Recovery Crypto1Recovery;
+
+/** Candidate state callback
+ *
+ * State is positioned right after the 32 keystream bits.
+ *
+ * @param state recovered candidate state
+ * @param context callback context
+ * @return false to abort enumeration
+ */
+typedef bool (*Crypto1RecoveryCallback)(const Crypto1* state, void* context);
+
+/** Allocate Crypto1Recovery
+ *
+ * Allocates three candidate tables of 3 * 2^(19 - partition_bits) entries.
+ *
+ * @param partition_bits number of seed bits fixed per partition half, 5..10
+ * @return Crypto1Recovery instance
+ */
+Crypto1Recovery* crypto1_recovery_alloc(uint8_t partition_bits);
+
+/** Free Crypto1Recovery
+ *
+ * @param instance Crypto1Recovery instance
+ */
+void crypto1_recovery_free(Crypto1Recovery* instance);
+
+/** Get number of partitions to run for complete enumeration
+ *
+ * @param instance Crypto1Recovery instance
+ * @return partitions count
+ */
+uint32_t crypto1_recovery_get_partition_count(Crypto1Recovery* instance);
+
+/** Enumerate candidate states of one partition
+ *
+ * @param instance Crypto1Recovery instance
+ * @param ks2 32 bits of keystream
+ * @param in input fed to the cipher while ks2 was produced
+ * @param partition partition index, below crypto1_recovery_get_partition_count
+ * @param callback candidate state callback
+ * @param context callback context
+ * @return false if aborted by callback
+ */
+bool crypto1_recovery_run_partition(
+    Crypto1Recovery* instance,
+    uint32_t ks2,
+    uint32_t in,
+    uint32_t partition,
+    Crypto1RecoveryCallback callback,
+    void* context);
+
+/** Extract key from cipher state rolled back to its initial position
+ *
+ * @param state cipher state
+ * @return 48 bit key
+ */
+uint64_t crypto1_recovery_get_key(const Crypto1* state);
+
+#ifdef __cplusplus
+}
+#endif
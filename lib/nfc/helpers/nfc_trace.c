@@ -0,0 +1,321 @@
+#include "nfc_trace.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+
+#define TAG "NfcTrace"
+
+#define NFC_TRACE_FLAG_PARITY (1U << 0)
+
+// Carrier is 13.56 MHz: 339 / 25 periods per microsecond
+#define NFC_TRACE_FC_PER_US_NUM (339U)
+#define NFC_TRACE_FC_PER_US_DEN (25U)
+#define NFC_TRACE_FC_PER_BIT    (128U)
+
+#define NFC_TRACE_PM3_RESPONSE_FLAG (1U << 15)
+#define NFC_TRACE_PM3_DATA_LEN_MASK (NFC_TRACE_PM3_RESPONSE_FLAG - 1)
+
+// Same as transport buffers, longer frames can not come from Flipper
+#define NFC_TRACE_LOAD_FRAME_SIZE_MAX (256U)
+
+#define NFC_TRACE_ISO14443_3A_REQA (0x26)
+#define NFC_TRACE_ISO14443_3A_WUPA (0x52)
+
+typedef struct {
+    uint32_t timestamp;
+    uint32_t fdt;
+    uint16_t bits;
+    uint8_t direction;
+    uint8_t flags;
+} NfcTraceRecord;
+
+// Proxmark3 tracelog_hdr_t, followed by data and (data_len - 1) / 8 + 1 parity bytes
+typedef struct FURI_PACKED {
+    uint32_t timestamp;
+    uint16_t duration;
+    uint16_t data_len;
+} NfcTracePm3Header;
+
+struct NfcTrace {
+    uint8_t* buffer;
+    size_t capacity;
+    size_t size;
+    size_t frame_count;
+    size_t dropped_count;
+};
+
+static size_t nfc_trace_get_data_size(size_t bits) {
+    return (bits + 7) / 8;
+}
+
+static size_t nfc_trace_get_parity_size(size_t data_size) {
+    return (data_size + 7) / 8;
+}
+
+static size_t nfc_trace_get_record_size(const NfcTraceRecord* record) {
+    size_t data_size = nfc_trace_get_data_size(record->bits);
+    size_t size = sizeof(NfcTraceRecord) + data_size;
+    if(record->flags & NFC_TRACE_FLAG_PARITY) {
+        size += nfc_trace_get_parity_size(data_size);
+    }
+    // Keep records word aligned
+    return (size + 3) & ~3U;
+}
+
+NfcTrace* nfc_trace_alloc(size_t capacity) {
+    furi_check(capacity > sizeof(NfcTraceRecord));
+
+    NfcTrace* instance = malloc(sizeof(NfcTrace));
+    instance->buffer = malloc(capacity);
+    instance->capacity = capacity;
+
+    return instance;
+}
+
+void nfc_trace_free(NfcTrace* instance) {
+    furi_check(instance);
+
+    free(instance->buffer);
+    free(instance);
+}
+
+void nfc_trace_reset(NfcTrace* instance) {
+    furi_check(instance);
+
+    instance->size = 0;
+    instance->frame_count = 0;
+    instance->dropped_count = 0;
+}
+
+uint32_t nfc_trace_get_timestamp(void) {
+    return DWT->CYCCNT;
+}
+
+bool nfc_trace_add(NfcTrace* instance, const NfcTraceFrame* frame) {
+    furi_check(instance);
+    furi_check(frame);
+
+    if(frame->bits == 0) return true;
+    furi_check(frame->data);
+    furi_check(frame->bits <= UINT16_MAX);
+
+    NfcTraceRecord record = {
+        .timestamp = frame->timestamp,
+        .fdt = frame->fdt,
+        .bits = frame->bits,
+        .direction = frame->direction,
+        .flags = frame->parity ? NFC_TRACE_FLAG_PARITY : 0,
+    };
+
+    size_t record_size = nfc_trace_get_record_size(&record);
+    if(instance->size + record_size > instance->capacity) {
+        instance->dropped_count++;
+        return false;
+    }
+
+    uint8_t* dest = &instance->buffer[instance->size];
+    memcpy(dest, &record, sizeof(NfcTraceRecord));
+    dest += sizeof(NfcTraceRecord);
+
+    size_t data_size = nfc_trace_get_data_size(frame->bits);
+    memcpy(dest, frame->data, data_size);
+    if(frame->parity) {
+        memcpy(dest + data_size, frame->parity, nfc_trace_get_parity_size(data_size));
+    }
+
+    instance->size += record_size;
+    instance->frame_count++;
+
+    return true;
+}
+
+size_t nfc_trace_get_frame_count(const NfcTrace* instance) {
+    furi_check(instance);
+    return instance->frame_count;
+}
+
+size_t nfc_trace_get_dropped_count(const NfcTrace* instance) {
+    furi_check(instance);
+    return instance->dropped_count;
+}
+
+bool nfc_trace_get_next_frame(const NfcTrace* instance, size_t* position, NfcTraceFrame* frame) {
+    furi_check(instance);
+    furi_check(position);
+    furi_check(frame);
+
+    if(*position >= instance->size) return false;
+
+    const uint8_t* src = &instance->buffer[*position];
+    NfcTraceRecord record;
+    memcpy(&record, src, sizeof(NfcTraceRecord));
+
+    frame->timestamp = record.timestamp;
+    frame->fdt = record.fdt;
+    frame->direction = record.direction;
+    frame->bits = record.bits;
+    frame->data = src + sizeof(NfcTraceRecord);
+    frame->parity = (record.flags & NFC_TRACE_FLAG_PARITY) ?
+                        frame->data + nfc_trace_get_data_size(record.bits) :
+                        NULL;
+
+    *position += nfc_trace_get_record_size(&record);
+
+    return true;
+}
+
+static uint32_t nfc_trace_cycles_to_fc(uint64_t cycles) {
+    return cycles * NFC_TRACE_FC_PER_US_NUM /
+           (furi_hal_cortex_instructions_per_microsecond() * NFC_TRACE_FC_PER_US_DEN);
+}
+
+static uint32_t nfc_trace_fc_to_cycles(uint64_t fc) {
+    return fc * furi_hal_cortex_instructions_per_microsecond() * NFC_TRACE_FC_PER_US_DEN /
+           NFC_TRACE_FC_PER_US_NUM;
+}
+
+static bool nfc_trace_get_parity_bit(const NfcTraceFrame* frame, size_t byte_index) {
+    if(frame->parity) {
+        return frame->parity[byte_index / 8] & (1U << (byte_index % 8));
+    }
+
+    // Not captured means generated or checked by hardware, so it is the odd parity
+    uint8_t byte = frame->data[byte_index];
+    return !__builtin_parity(byte);
+}
+
+bool nfc_trace_save(const NfcTrace* instance, Storage* storage, const char* path) {
+    furi_check(instance);
+    furi_check(storage);
+    furi_check(path);
+
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        NfcTraceFrame frame;
+        size_t position = 0;
+        size_t frame_index = 0;
+        uint32_t prev_timestamp = 0;
+        uint64_t elapsed = 0;
+        bool written = true;
+
+        while(written && nfc_trace_get_next_frame(instance, &position, &frame)) {
+            // Cycle counter wraps, only deltas between frames are meaningful
+            if(frame_index++) {
+                elapsed += (uint32_t)(frame.timestamp - prev_timestamp);
+            }
+            prev_timestamp = frame.timestamp;
+
+            size_t data_size = nfc_trace_get_data_size(frame.bits);
+            size_t air_bits = data_size > 1 ? data_size * 9 : frame.bits;
+            NfcTracePm3Header header = {
+                .timestamp = nfc_trace_cycles_to_fc(elapsed),
+                .duration = MIN(air_bits * NFC_TRACE_FC_PER_BIT, (size_t)UINT16_MAX),
+                .data_len = data_size,
+            };
+            if(frame.direction == NfcTraceDirectionCard) {
+                header.data_len |= NFC_TRACE_PM3_RESPONSE_FLAG;
+            }
+
+            // Proxmark3 packs parity most significant bit first
+            uint8_t parity[nfc_trace_get_parity_size(data_size)];
+            memset(parity, 0, sizeof(parity));
+            for(size_t i = 0; i < data_size; i++) {
+                if(nfc_trace_get_parity_bit(&frame, i)) {
+                    parity[i / 8] |= 0x80 >> (i % 8);
+                }
+            }
+
+            written = storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+                      storage_file_write(file, frame.data, data_size) == data_size &&
+                      storage_file_write(file, parity, sizeof(parity)) == sizeof(parity);
+        }
+
+        success = written;
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return success;
+}
+
+bool nfc_trace_load(NfcTrace* instance, Storage* storage, const char* path) {
+    furi_check(instance);
+    furi_check(storage);
+    furi_check(path);
+
+    nfc_trace_reset(instance);
+
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(NFC_TRACE_LOAD_FRAME_SIZE_MAX);
+    uint8_t* parity = malloc(nfc_trace_get_parity_size(NFC_TRACE_LOAD_FRAME_SIZE_MAX));
+    uint8_t* frame_parity = malloc(nfc_trace_get_parity_size(NFC_TRACE_LOAD_FRAME_SIZE_MAX));
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        uint32_t timestamp = nfc_trace_get_timestamp();
+        uint32_t prev_end_fc = 0;
+        NfcTracePm3Header header;
+        bool valid = true;
+
+        while(valid) {
+            size_t read = storage_file_read(file, &header, sizeof(header));
+            if(read == 0) break;
+
+            size_t data_size = header.data_len & NFC_TRACE_PM3_DATA_LEN_MASK;
+            size_t parity_size = nfc_trace_get_parity_size(MAX(data_size, 1U));
+            valid = read == sizeof(header) && data_size <= NFC_TRACE_LOAD_FRAME_SIZE_MAX &&
+                    storage_file_read(file, data, data_size) == data_size &&
+                    storage_file_read(file, parity, parity_size) == parity_size;
+            if(!valid || data_size == 0) continue;
+
+            NfcTraceFrame frame = {
+                .timestamp = timestamp + nfc_trace_fc_to_cycles(header.timestamp),
+                .direction = (header.data_len & NFC_TRACE_PM3_RESPONSE_FLAG) ?
+                                 NfcTraceDirectionCard :
+                                 NfcTraceDirectionReader,
+                .bits = data_size * 8,
+                .data = data,
+            };
+            if(frame.direction == NfcTraceDirectionCard && header.timestamp > prev_end_fc) {
+                frame.fdt = nfc_trace_fc_to_cycles(header.timestamp - prev_end_fc);
+            }
+            if(frame.direction == NfcTraceDirectionReader && data_size == 1 &&
+               (data[0] == NFC_TRACE_ISO14443_3A_REQA || data[0] == NFC_TRACE_ISO14443_3A_WUPA)) {
+                frame.bits = 7;
+            }
+            prev_end_fc = header.timestamp + header.duration;
+
+            // Keep parity only where it carries information
+            bool parity_odd = true;
+            memset(frame_parity, 0, nfc_trace_get_parity_size(data_size));
+            for(size_t i = 0; i < data_size; i++) {
+                bool bit = parity[i / 8] & (0x80 >> (i % 8));
+                parity_odd &= bit == !__builtin_parity(data[i]);
+                if(bit) frame_parity[i / 8] |= 1U << (i % 8);
+            }
+            if(!parity_odd) frame.parity = frame_parity;
+
+            if(!nfc_trace_add(instance, &frame)) {
+                FURI_LOG_W(TAG, "Trace does not fit into buffer");
+                break;
+            }
+        }
+
+        success = valid;
+    } while(false);
+
+    free(frame_parity);
+    free(parity);
+    free(data);
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return success;
+}
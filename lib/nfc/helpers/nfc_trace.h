@@ -0,0 +1,146 @@
+/**
+ * @file nfc_trace.h
+ * @brief Timestamped NFC frame trace.
+ *
+ * An NfcTrace instance attached to an Nfc instance with nfc_set_trace() records every
+ * frame passing through the transport layer together with its timing. Recording only
+ * copies the frame into a preallocated buffer, so it can stay enabled during emulation.
+ * When the buffer is full, new frames are counted as dropped.
+ *
+ * Traces are saved in the Proxmark3 trace format and can be inspected with
+ * `trace load` and `trace list -t 14a`, or replayed with nfc_trace_replay.h.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief NfcTrace opaque type definition.
+ */
+typedef struct NfcTrace NfcTrace;
+
+/**
+ * @brief Frame direction.
+ */
+typedef enum {
+    NfcTraceDirectionReader, /**< Frame sent by the reader (poller). */
+    NfcTraceDirectionCard, /**< Frame sent by the card (listener). */
+} NfcTraceDirection;
+
+/**
+ * @brief Recorded frame.
+ *
+ * Pointers returned by nfc_trace_get_next_frame() point into the trace buffer
+ * and stay valid until the trace is reset or freed.
+ */
+typedef struct {
+    uint32_t timestamp; /**< CPU cycle counter value when the frame was seen. */
+    uint32_t fdt; /**< CPU cycles since the frame it answers, 0 if not applicable. */
+    NfcTraceDirection direction; /**< Frame direction. */
+    size_t bits; /**< Frame size, in bits, parity not included. */
+    const uint8_t* data; /**< Frame data. */
+    const uint8_t* parity; /**< Parity bits as in bit_buffer_get_parity(), NULL if not captured. */
+} NfcTraceFrame;
+
+/**
+ * @brief Allocate an NfcTrace instance.
+ *
+ * @param[in] capacity size of the frame buffer, in bytes.
+ * @returns pointer to the allocated instance.
+ */
+NfcTrace* nfc_trace_alloc(size_t capacity);
+
+/**
+ * @brief Delete an NfcTrace instance.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void nfc_trace_free(NfcTrace* instance);
+
+/**
+ * @brief Remove all recorded frames.
+ *
+ * @param[in,out] instance pointer to the instance to be reset.
+ */
+void nfc_trace_reset(NfcTrace* instance);
+
+/**
+ * @brief Get current timestamp in trace units.
+ *
+ * @returns CPU cycle counter value.
+ */
+uint32_t nfc_trace_get_timestamp(void);
+
+/**
+ * @brief Append a frame to the trace.
+ *
+ * Empty frames are ignored.
+ *
+ * @param[in,out] instance pointer to the instance to be modified.
+ * @param[in] frame pointer to the frame to be copied.
+ * @returns true if the frame was recorded, false if the buffer is full.
+ */
+bool nfc_trace_add(NfcTrace* instance, const NfcTraceFrame* frame);
+
+/**
+ * @brief Get the number of recorded frames.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @returns number of frames.
+ */
+size_t nfc_trace_get_frame_count(const NfcTrace* instance);
+
+/**
+ * @brief Get the number of frames that did not fit into the buffer.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @returns number of dropped frames.
+ */
+size_t nfc_trace_get_dropped_count(const NfcTrace* instance);
+
+/**
+ * @brief Iterate over recorded frames.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @param[in,out] position iterator position, must be 0 for the first frame.
+ * @param[out] frame pointer to the frame to be filled.
+ * @returns true if the frame was read, false if there are no more frames.
+ */
+bool nfc_trace_get_next_frame(const NfcTrace* instance, size_t* position, NfcTraceFrame* frame);
+
+/**
+ * @brief Save the trace in the Proxmark3 trace format.
+ *
+ * Timestamps are converted to carrier periods relative to the first frame.
+ *
+ * @param[in] instance pointer to the instance to be saved.
+ * @param[in] storage pointer to a Storage instance.
+ * @param[in] path file path.
+ * @returns true on success, false otherwise.
+ */
+bool nfc_trace_save(const NfcTrace* instance, Storage* storage, const char* path);
+
+/**
+ * @brief Load a trace saved in the Proxmark3 trace format.
+ *
+ * The format stores whole bytes, so 1-byte REQA and WUPA reader frames are restored
+ * as 7-bit short frames and all other frames as byte-aligned ones.
+ *
+ * @param[in,out] instance pointer to the instance to be loaded, its frames are replaced.
+ * @param[in] storage pointer to a Storage instance.
+ * @param[in] path file path.
+ * @returns true on success, false otherwise.
+ */
+bool nfc_trace_load(NfcTrace* instance, Storage* storage, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,198 @@
+#include "nfc_trace_replay.h"
+
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+
+#include <furi.h>
+
+#define TAG "NfcTraceReplay"
+
+#define NFC_TRACE_REPLAY_BUFFER_SIZE (256U)
+#define NFC_TRACE_REPLAY_FWT_FC      (60000U)
+
+#define NFC_TRACE_REPLAY_SHORT_FRAME_BITS (7U)
+#define NFC_TRACE_REPLAY_REQA             (0x26)
+#define NFC_TRACE_REPLAY_WUPA             (0x52)
+
+struct NfcTraceReplay {
+    Nfc* nfc;
+    const NfcTrace* trace;
+    size_t position;
+    size_t mismatch_count;
+    bool complete;
+    bool running;
+    BitBuffer* tx_buffer;
+    BitBuffer* rx_buffer;
+};
+
+NfcTraceReplay* nfc_trace_replay_alloc(Nfc* nfc, const NfcTrace* trace) {
+    furi_check(nfc);
+    furi_check(trace);
+
+    NfcTraceReplay* instance = malloc(sizeof(NfcTraceReplay));
+    instance->nfc = nfc;
+    instance->trace = trace;
+    instance->tx_buffer = bit_buffer_alloc(NFC_TRACE_REPLAY_BUFFER_SIZE);
+    instance->rx_buffer = bit_buffer_alloc(NFC_TRACE_REPLAY_BUFFER_SIZE);
+
+    return instance;
+}
+
+void nfc_trace_replay_free(NfcTraceReplay* instance) {
+    furi_check(instance);
+    furi_check(!instance->running);
+
+    bit_buffer_free(instance->tx_buffer);
+    bit_buffer_free(instance->rx_buffer);
+    free(instance);
+}
+
+static void nfc_trace_replay_frame_to_buffer(const NfcTraceFrame* frame, BitBuffer* buffer) {
+    bit_buffer_copy_bits(buffer, frame->data, frame->bits);
+    if(frame->parity) {
+        for(size_t i = 0; i < bit_buffer_get_size_bytes(buffer); i++) {
+            bool parity = frame->parity[i / 8] & (1U << (i % 8));
+            bit_buffer_set_byte_with_parity(buffer, i, frame->data[i], parity);
+        }
+    }
+}
+
+static bool nfc_trace_replay_frame_is_equal(const NfcTraceFrame* frame, const BitBuffer* buffer) {
+    return frame->bits == bit_buffer_get_size(buffer) &&
+           memcmp(frame->data, bit_buffer_get_data(buffer), bit_buffer_get_size_bytes(buffer)) ==
+               0;
+}
+
+static NfcCommand nfc_trace_replay_listener_callback(NfcEvent event, void* context) {
+    NfcTraceReplay* instance = context;
+
+    if(event.type != NfcEventTypeRxEnd) return NfcCommandContinue;
+
+    NfcTraceFrame frame;
+    size_t position = instance->position;
+    if(!nfc_trace_get_next_frame(instance->trace, &position, &frame) ||
+       frame.direction != NfcTraceDirectionReader ||
+       !nfc_trace_replay_frame_is_equal(&frame, event.data.buffer)) {
+        FURI_LOG_D(TAG, "Unexpected reader frame");
+        instance->mismatch_count++;
+        return NfcCommandContinue;
+    }
+    instance->position = position;
+
+    // Stay silent if the card did not answer
+    if(nfc_trace_get_next_frame(instance->trace, &position, &frame) &&
+       frame.direction == NfcTraceDirectionCard) {
+        nfc_trace_replay_frame_to_buffer(&frame, instance->tx_buffer);
+        if(frame.parity) {
+            nfc_iso14443a_listener_tx_custom_parity(instance->nfc, instance->tx_buffer);
+        } else {
+            nfc_listener_tx(instance->nfc, instance->tx_buffer);
+        }
+        instance->position = position;
+    }
+
+    instance->complete = !nfc_trace_get_next_frame(instance->trace, &position, &frame);
+
+    return NfcCommandContinue;
+}
+
+static NfcError
+    nfc_trace_replay_poller_send(NfcTraceReplay* instance, const NfcTraceFrame* frame) {
+    NfcError error = NfcErrorNone;
+
+    if(frame->bits == NFC_TRACE_REPLAY_SHORT_FRAME_BITS &&
+       (frame->data[0] == NFC_TRACE_REPLAY_REQA || frame->data[0] == NFC_TRACE_REPLAY_WUPA)) {
+        NfcIso14443aShortFrame short_frame = (frame->data[0] == NFC_TRACE_REPLAY_WUPA) ?
+                                                 NfcIso14443aShortFrameAllReqa :
+                                                 NfcIso14443aShortFrameSensReq;
+        error = nfc_iso14443a_poller_trx_short_frame(
+            instance->nfc, short_frame, instance->rx_buffer, NFC_TRACE_REPLAY_FWT_FC);
+    } else {
+        nfc_trace_replay_frame_to_buffer(frame, instance->tx_buffer);
+        if(frame->parity) {
+            error = nfc_iso14443a_poller_trx_custom_parity(
+                instance->nfc, instance->tx_buffer, instance->rx_buffer, NFC_TRACE_REPLAY_FWT_FC);
+        } else {
+            error = nfc_poller_trx(
+                instance->nfc, instance->tx_buffer, instance->rx_buffer, NFC_TRACE_REPLAY_FWT_FC);
+        }
+    }
+
+    return error;
+}
+
+static NfcCommand nfc_trace_replay_poller_callback(NfcEvent event, void* context) {
+    NfcTraceReplay* instance = context;
+
+    if(event.type != NfcEventTypePollerReady) return NfcCommandContinue;
+
+    NfcTraceFrame frame;
+    bool has_frame = nfc_trace_get_next_frame(instance->trace, &instance->position, &frame);
+
+    while(has_frame) {
+        // Card frames without request come from traces recorded on listener side
+        if(frame.direction != NfcTraceDirectionReader) {
+            has_frame = nfc_trace_get_next_frame(instance->trace, &instance->position, &frame);
+            continue;
+        }
+
+        NfcError error = nfc_trace_replay_poller_send(instance, &frame);
+
+        has_frame = nfc_trace_get_next_frame(instance->trace, &instance->position, &frame);
+        if(has_frame && frame.direction == NfcTraceDirectionCard) {
+            if(error != NfcErrorNone ||
+               !nfc_trace_replay_frame_is_equal(&frame, instance->rx_buffer)) {
+                FURI_LOG_D(TAG, "Unexpected card frame: %d", error);
+                instance->mismatch_count++;
+            }
+            has_frame = nfc_trace_get_next_frame(instance->trace, &instance->position, &frame);
+        } else if(error != NfcErrorTimeout) {
+            FURI_LOG_D(TAG, "Unexpected card response: %d", error);
+            instance->mismatch_count++;
+        }
+    }
+
+    instance->complete = true;
+
+    return NfcCommandStop;
+}
+
+void nfc_trace_replay_start(NfcTraceReplay* instance, NfcMode mode) {
+    furi_check(instance);
+    furi_check(!instance->running);
+    furi_check(mode < NfcModeNum);
+
+    instance->position = 0;
+    instance->mismatch_count = 0;
+    instance->complete = nfc_trace_get_frame_count(instance->trace) == 0;
+    instance->running = true;
+
+    if(mode == NfcModePoller) {
+        nfc_config(instance->nfc, NfcModePoller, NfcTechIso14443a);
+        nfc_set_guard_time_us(instance->nfc, ISO14443_3A_GUARD_TIME_US);
+        nfc_set_fdt_poll_fc(instance->nfc, ISO14443_3A_FDT_POLL_FC);
+        nfc_set_fdt_poll_poll_us(instance->nfc, ISO14443_3A_POLL_POLL_MIN_US);
+        nfc_start(instance->nfc, nfc_trace_replay_poller_callback, instance);
+    } else {
+        nfc_set_fdt_listen_fc(instance->nfc, ISO14443_3A_FDT_LISTEN_FC);
+        nfc_config(instance->nfc, NfcModeListener, NfcTechIso14443a);
+        nfc_start(instance->nfc, nfc_trace_replay_listener_callback, instance);
+    }
+}
+
+void nfc_trace_replay_stop(NfcTraceReplay* instance) {
+    furi_check(instance);
+    furi_check(instance->running);
+
+    nfc_stop(instance->nfc);
+    instance->running = false;
+}
+
+bool nfc_trace_replay_is_complete(const NfcTraceReplay* instance) {
+    furi_check(instance);
+    return instance->complete;
+}
+
+size_t nfc_trace_replay_get_mismatch_count(const NfcTraceReplay* instance) {
+    furi_check(instance);
+    return instance->mismatch_count;
+}
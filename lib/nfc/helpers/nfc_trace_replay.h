@@ -0,0 +1,79 @@
+/**
+ * @file nfc_trace_replay.h
+ * @brief Deterministic replay of recorded ISO14443-3A traces.
+ *
+ * In listener mode the replay acts as the recorded card: every received frame is
+ * compared against the next reader frame of the trace and answered with the recorded
+ * card frame, if any. In poller mode it acts as the recorded reader: reader frames are
+ * sent one by one and responses are compared against the recorded card frames.
+ *
+ * Timing is not reproduced, only frame order and content. The replay is meant to be
+ * paired with the nfc_mock transport in unit tests, where anticollision is not done
+ * by hardware and all frames reach the replay.
+ */
+#pragma once
+
+#include <nfc/nfc.h>
+#include "nfc_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief NfcTraceReplay opaque type definition.
+ */
+typedef struct NfcTraceReplay NfcTraceReplay;
+
+/**
+ * @brief Allocate an NfcTraceReplay instance.
+ *
+ * @param[in] nfc pointer to an Nfc instance to replay with.
+ * @param[in] trace pointer to the trace to replay, must outlive the replay.
+ * @returns pointer to the allocated instance.
+ */
+NfcTraceReplay* nfc_trace_replay_alloc(Nfc* nfc, const NfcTrace* trace);
+
+/**
+ * @brief Delete an NfcTraceReplay instance.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void nfc_trace_replay_free(NfcTraceReplay* instance);
+
+/**
+ * @brief Start the replay.
+ *
+ * @param[in,out] instance pointer to the instance to be started.
+ * @param[in] mode NfcModeListener to act as the card, NfcModePoller to act as the reader.
+ */
+void nfc_trace_replay_start(NfcTraceReplay* instance, NfcMode mode);
+
+/**
+ * @brief Stop the replay.
+ *
+ * In poller mode waits until all reader frames are sent.
+ *
+ * @param[in,out] instance pointer to the instance to be stopped.
+ */
+void nfc_trace_replay_stop(NfcTraceReplay* instance);
+
+/**
+ * @brief Check whether all frames of the trace were replayed.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @returns true if the end of the trace was reached.
+ */
+bool nfc_trace_replay_is_complete(const NfcTraceReplay* instance);
+
+/**
+ * @brief Get the number of frames that differ from the trace.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @returns number of unexpected frames, missing responses included.
+ */
+size_t nfc_trace_replay_get_mismatch_count(const NfcTraceReplay* instance);
+
+#ifdef __cplusplus
+}
+#endif
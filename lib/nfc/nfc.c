@@ -12,6 +12,10 @@
 #define NFC_FELICA_LISTENER_RESPONSE_TIME_A_FC (512 * 64)
 #define NFC_FELICA_LISTENER_RESPONSE_TIME_B_FC (256 * 64)
 
+#define NFC_ISO14443A_SHORT_FRAME_REQA (0x26)
+#define NFC_ISO14443A_SHORT_FRAME_WUPA (0x52)
+#define NFC_ISO14443A_SHORT_FRAME_BITS (7)
+
 typedef enum {
     NfcStateIdle,
     NfcStateRunning,
@@ -61,6 +65,12 @@ struct Nfc {
     uint8_t rx_buffer[NFC_MAX_BUFFER_SIZE];
     size_t rx_bits;
 
+    NfcTrace* trace;
+    uint32_t trace_tx_start;
+    uint32_t trace_tx_end;
+    uint32_t trace_rx_start;
+    uint32_t trace_rx_end;
+
     FuriThread* worker_thread;
 };
 
@@ -104,6 +114,61 @@ static NfcError nfc_process_hal_error(FuriHalNfcError error) {
     return ret;
 }
 
+static void nfc_trace_frame(
+    Nfc* instance,
+    NfcTraceDirection direction,
+    uint32_t timestamp,
+    uint32_t fdt,
+    const uint8_t* data,
+    size_t bits,
+    const uint8_t* parity) {
+    if(!instance->trace) return;
+
+    NfcTraceFrame frame = {
+        .timestamp = timestamp,
+        .fdt = fdt,
+        .direction = direction,
+        .bits = bits,
+        .data = data,
+        .parity = parity,
+    };
+    nfc_trace_add(instance->trace, &frame);
+}
+
+static void nfc_trace_poller_tx(
+    Nfc* instance,
+    const uint8_t* data,
+    size_t bits,
+    const uint8_t* parity) {
+    // Poller reaction time, unknown for the first frame
+    uint32_t fdt = instance->trace_rx_end ? instance->trace_tx_start - instance->trace_rx_end : 0;
+    nfc_trace_frame(
+        instance, NfcTraceDirectionReader, instance->trace_tx_start, fdt, data, bits, parity);
+}
+
+static void nfc_trace_poller_rx(Nfc* instance, const BitBuffer* rx_buffer, bool with_parity) {
+    nfc_trace_frame(
+        instance,
+        NfcTraceDirectionCard,
+        instance->trace_rx_start,
+        instance->trace_rx_start - instance->trace_tx_end,
+        bit_buffer_get_data(rx_buffer),
+        bit_buffer_get_size(rx_buffer),
+        with_parity ? bit_buffer_get_parity(rx_buffer) : NULL);
+}
+
+static void nfc_trace_listener_tx(Nfc* instance, const BitBuffer* tx_buffer, bool with_parity) {
+    uint32_t timestamp = nfc_trace_get_timestamp();
+    nfc_trace_frame(
+        instance,
+        NfcTraceDirectionCard,
+        timestamp,
+        timestamp - instance->trace_rx_end,
+        bit_buffer_get_data(tx_buffer),
+        bit_buffer_get_size(tx_buffer),
+        with_parity ? bit_buffer_get_parity(tx_buffer) : NULL);
+}
+
 static int32_t nfc_worker_listener(void* context) {
     furi_assert(context);
 
@@ -142,10 +207,19 @@ static int32_t nfc_worker_listener(void* context) {
         }
         if(event & FuriHalNfcEventRxEnd) {
             furi_hal_nfc_timer_block_tx_start(instance->fdt_listen_fc);
+            instance->trace_rx_end = nfc_trace_get_timestamp();
 
             nfc_event.type = NfcEventTypeRxEnd;
             furi_hal_nfc_listener_rx(
                 instance->rx_buffer, sizeof(instance->rx_buffer), &instance->rx_bits);
+            nfc_trace_frame(
+                instance,
+                NfcTraceDirectionReader,
+                instance->trace_rx_end,
+                0,
+                instance->rx_buffer,
+                instance->rx_bits,
+                NULL);
             bit_buffer_copy_bits(event_data.buffer, instance->rx_buffer, instance->rx_bits);
             command = instance->callback(nfc_event, instance->context);
             if(command == NfcCommandStop) {
@@ -227,6 +301,7 @@ static int32_t nfc_worker_poller(void* context) {
     furi_assert(instance->callback);
     instance->state = NfcStateRunning;
     instance->poller_state = NfcPollerStateStart;
+    instance->trace_rx_end = 0;
 
     furi_hal_nfc_event_start();
 
@@ -309,6 +384,11 @@ void nfc_set_mask_receive_time_fc(Nfc* instance, uint32_t mask_rx_time_fc) {
     instance->mask_rx_time_fc = mask_rx_time_fc;
 }
 
+void nfc_set_trace(Nfc* instance, NfcTrace* trace) {
+    furi_check(instance);
+    instance->trace = trace;
+}
+
 void nfc_start(Nfc* instance, NfcEventCallback callback, void* context) {
     furi_check(instance);
     furi_check(instance->worker_thread);
@@ -347,6 +427,7 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
     while(furi_hal_nfc_timer_block_tx_is_running()) {
     }
 
+    nfc_trace_listener_tx(instance, tx_buffer, false);
     FuriHalNfcError error =
         furi_hal_nfc_listener_tx(bit_buffer_get_data(tx_buffer), bit_buffer_get_size(tx_buffer));
     if(error != FuriHalNfcErrorNone) {
@@ -370,6 +451,7 @@ static NfcError nfc_poller_trx_state_machine(Nfc* instance, uint32_t fwt_fc) {
         }
         if(event & FuriHalNfcEventTxEnd) {
             if(instance->comm_state == NfcCommStateWaitTxEnd) {
+                instance->trace_tx_end = nfc_trace_get_timestamp();
                 if(fwt_fc) {
                     furi_hal_nfc_timer_fwt_start(fwt_fc);
                 }
@@ -379,6 +461,7 @@ static NfcError nfc_poller_trx_state_machine(Nfc* instance, uint32_t fwt_fc) {
         }
         if(event & FuriHalNfcEventRxStart) {
             if(instance->comm_state == NfcCommStateWaitRxStart) {
+                instance->trace_rx_start = nfc_trace_get_timestamp();
                 furi_hal_nfc_timer_block_tx_stop();
                 furi_hal_nfc_timer_fwt_stop();
                 instance->comm_state = NfcCommStateWaitRxEnd;
@@ -387,6 +470,7 @@ static NfcError nfc_poller_trx_state_machine(Nfc* instance, uint32_t fwt_fc) {
         if(event & FuriHalNfcEventRxEnd) {
             furi_hal_nfc_timer_block_tx_start(instance->fdt_poll_fc);
             furi_hal_nfc_timer_fwt_stop();
+            instance->trace_rx_end = nfc_trace_get_timestamp();
             instance->comm_state = NfcCommStateWaitBlockTxTimer;
             break;
         }
@@ -429,6 +513,7 @@ NfcError nfc_iso14443a_poller_trx_custom_parity(
         }
         bit_buffer_write_bytes_with_parity(
             tx_buffer, instance->tx_buffer, sizeof(instance->tx_buffer), &instance->tx_bits);
+        instance->trace_tx_start = nfc_trace_get_timestamp();
         error =
             furi_hal_nfc_iso14443a_poller_tx_custom_parity(instance->tx_buffer, instance->tx_bits);
         if(error != FuriHalNfcErrorNone) {
@@ -438,6 +523,11 @@ NfcError nfc_iso14443a_poller_trx_custom_parity(
         }
         instance->comm_state = NfcCommStateWaitTxEnd;
         ret = nfc_poller_trx_state_machine(instance, fwt);
+        nfc_trace_poller_tx(
+            instance,
+            bit_buffer_get_data(tx_buffer),
+            bit_buffer_get_size(tx_buffer),
+            bit_buffer_get_parity(tx_buffer));
         if(ret != NfcErrorNone) {
             FURI_LOG_T(TAG, "Failed TRX state machine");
             break;
@@ -458,6 +548,7 @@ NfcError nfc_iso14443a_poller_trx_custom_parity(
         }
 
         bit_buffer_copy_bytes_with_parity(rx_buffer, instance->rx_buffer, instance->rx_bits);
+        nfc_trace_poller_rx(instance, rx_buffer, true);
     } while(false);
 
     return ret;
@@ -480,6 +571,7 @@ NfcError
                 furi_hal_nfc_poller_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
             if(event & FuriHalNfcEventTimerBlockTxExpired) break;
         }
+        instance->trace_tx_start = nfc_trace_get_timestamp();
         error =
             furi_hal_nfc_poller_tx(bit_buffer_get_data(tx_buffer), bit_buffer_get_size(tx_buffer));
         if(error != FuriHalNfcErrorNone) {
@@ -489,6 +581,8 @@ NfcError
         }
         instance->comm_state = NfcCommStateWaitTxEnd;
         ret = nfc_poller_trx_state_machine(instance, fwt);
+        nfc_trace_poller_tx(
+            instance, bit_buffer_get_data(tx_buffer), bit_buffer_get_size(tx_buffer), NULL);
         if(ret != NfcErrorNone) {
             FURI_LOG_T(TAG, "Failed TRX state machine");
             break;
@@ -503,6 +597,7 @@ NfcError
         }
 
         bit_buffer_copy_bits(rx_buffer, instance->rx_buffer, instance->rx_bits);
+        nfc_trace_poller_rx(instance, rx_buffer, false);
     } while(false);
 
     return ret;
@@ -545,6 +640,7 @@ NfcError nfc_iso14443a_poller_trx_short_frame(
                 furi_hal_nfc_poller_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
             if(event & FuriHalNfcEventTimerBlockTxExpired) break;
         }
+        instance->trace_tx_start = nfc_trace_get_timestamp();
         error = furi_hal_nfc_iso14443a_poller_trx_short_frame(short_frame);
         if(error != FuriHalNfcErrorNone) {
             FURI_LOG_D(TAG, "Failed in poller TX");
@@ -553,6 +649,10 @@ NfcError nfc_iso14443a_poller_trx_short_frame(
         }
         instance->comm_state = NfcCommStateWaitTxEnd;
         ret = nfc_poller_trx_state_machine(instance, fwt);
+        const uint8_t short_frame_data = (frame == NfcIso14443aShortFrameAllReqa) ?
+                                             NFC_ISO14443A_SHORT_FRAME_WUPA :
+                                             NFC_ISO14443A_SHORT_FRAME_REQA;
+        nfc_trace_poller_tx(instance, &short_frame_data, NFC_ISO14443A_SHORT_FRAME_BITS, NULL);
         if(ret != NfcErrorNone) {
             FURI_LOG_T(TAG, "Failed TRX state machine");
             break;
@@ -567,6 +667,7 @@ NfcError nfc_iso14443a_poller_trx_short_frame(
         }
 
         bit_buffer_copy_bits(rx_buffer, instance->rx_buffer, instance->rx_bits);
+        nfc_trace_poller_rx(instance, rx_buffer, false);
     } while(false);
 
     return ret;
@@ -592,6 +693,7 @@ NfcError nfc_iso14443a_poller_trx_sdd_frame(
                 furi_hal_nfc_poller_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
             if(event & FuriHalNfcEventTimerBlockTxExpired) break;
         }
+        instance->trace_tx_start = nfc_trace_get_timestamp();
         error = furi_hal_nfc_iso14443a_tx_sdd_frame(
             bit_buffer_get_data(tx_buffer), bit_buffer_get_size(tx_buffer));
         if(error != FuriHalNfcErrorNone) {
@@ -601,6 +703,8 @@ NfcError nfc_iso14443a_poller_trx_sdd_frame(
         }
         instance->comm_state = NfcCommStateWaitTxEnd;
         ret = nfc_poller_trx_state_machine(instance, fwt);
+        nfc_trace_poller_tx(
+            instance, bit_buffer_get_data(tx_buffer), bit_buffer_get_size(tx_buffer), NULL);
         if(ret != NfcErrorNone) {
             FURI_LOG_T(TAG, "Failed TRX state machine");
             break;
@@ -615,6 +719,7 @@ NfcError nfc_iso14443a_poller_trx_sdd_frame(
         }
 
         bit_buffer_copy_bits(rx_buffer, instance->rx_buffer, instance->rx_bits);
+        nfc_trace_poller_rx(instance, rx_buffer, false);
     } while(false);
 
     return ret;
@@ -631,6 +736,7 @@ NfcError nfc_iso14443a_listener_tx_custom_parity(Nfc* instance, const BitBuffer*
     const uint8_t* tx_parity = bit_buffer_get_parity(tx_buffer);
     size_t tx_bits = bit_buffer_get_size(tx_buffer);
 
+    nfc_trace_listener_tx(instance, tx_buffer, true);
     error = furi_hal_nfc_iso14443a_listener_tx_custom_parity(tx_data, tx_parity, tx_bits);
     ret = nfc_process_hal_error(error);
 
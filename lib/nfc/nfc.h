@@ -18,6 +18,7 @@
 #pragma once
 
 #include <toolbox/bit_buffer.h>
+#include "helpers/nfc_trace.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -192,6 +193,17 @@ void nfc_set_fdt_poll_poll_us(Nfc* instance, uint32_t fdt_poll_poll_us);
  */
 void nfc_set_guard_time_us(Nfc* instance, uint32_t guard_time_us);
 
+/**
+ * @brief Start or stop recording exchanged frames.
+ *
+ * Frames are appended to the trace from the worker thread, so the trace must not be
+ * accessed until recording is stopped by passing NULL.
+ *
+ * @param[in,out] instance pointer to the instance to be modified.
+ * @param[in,out] trace pointer to the trace to record to, NULL to stop recording.
+ */
+void nfc_set_trace(Nfc* instance, NfcTrace* trace);
+
 /**
  * @brief Start the Nfc instance.
  *
@@ -85,6 +85,9 @@ struct Nfc {
 
     NfcMode mode;
 
+    NfcTrace* trace;
+    uint32_t trace_last_timestamp;
+
     FuriThread* worker_thread;
 };
 
@@ -108,6 +111,25 @@ static void nfc_test_print(
     furi_string_free(str);
 }
 
+static void nfc_trace_message(Nfc* instance, NfcTraceDirection direction, NfcMessage* message) {
+    if(!instance->trace) return;
+
+    // Mock has no air timing, answer delay is the peer processing time
+    uint32_t timestamp = nfc_trace_get_timestamp();
+    NfcTraceFrame frame = {
+        .timestamp = timestamp,
+        .direction = direction,
+        .bits = message->data.data_bits,
+        .data = message->data.data,
+    };
+    if(direction == NfcTraceDirectionCard) {
+        frame.fdt = timestamp - instance->trace_last_timestamp;
+    }
+    instance->trace_last_timestamp = timestamp;
+
+    nfc_trace_add(instance->trace, &frame);
+}
+
 static void nfc_prepare_col_res_data(
     Nfc* instance,
     uint8_t* uid,
@@ -183,6 +205,11 @@ void nfc_set_guard_time_us(Nfc* instance, uint32_t guard_time_us) {
     UNUSED(guard_time_us);
 }
 
+void nfc_set_trace(Nfc* instance, NfcTrace* trace) {
+    furi_check(instance);
+    instance->trace = trace;
+}
+
 NfcError nfc_iso14443a_listener_set_col_res_data(
     Nfc* instance,
     uint8_t* uid,
@@ -316,6 +343,7 @@ static int32_t nfc_worker_listener(void* context) {
         } else if(message.type == NfcMessageTypeTx) {
             nfc_test_print(
                 NfcTransportLogLevelInfo, "RDR", message.data.data, message.data.data_bits);
+            nfc_trace_message(instance, NfcTraceDirectionReader, &message);
             if(instance->software_col_res_required &&
                (instance->col_res_status != Iso14443_3aColResStatusDone)) {
                 nfc_worker_listener_pass_col_res(
@@ -412,6 +440,7 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
     message.type = NfcMessageTypeTx;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
+    nfc_trace_message(instance, NfcTraceDirectionCard, &message);
 
     furi_message_queue_put(poller_queue, &message, FuriWaitForever);
 
@@ -437,6 +466,7 @@ NfcError
     message.type = NfcMessageTypeTx;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
+    nfc_trace_message(instance, NfcTraceDirectionReader, &message);
     // Tx
     furi_check(furi_message_queue_put(listener_queue, &message, FuriWaitForever) == FuriStatusOk);
     // Rx
@@ -448,6 +478,7 @@ NfcError
         bit_buffer_copy_bits(rx_buffer, message.data.data, message.data.data_bits);
         nfc_test_print(
             NfcTransportLogLevelWarning, "TAG", message.data.data, message.data.data_bits);
+        nfc_trace_message(instance, NfcTraceDirectionCard, &message);
     } else if(message.type == NfcMessageTypeTimeout) {
         error = NfcErrorTimeout;
     }
@@ -0,0 +1,476 @@
+#include "mf_classic_key_recovery.h"
+
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/crypto1_recovery.h>
+#include <bit_lib/bit_lib.h>
+#include <toolbox/keys_dict.h>
+#include <toolbox/stream/buffered_file_stream.h>
+#include <storage/storage.h>
+#include <m-array.h>
+#include <furi.h>
+
+#define TAG "MfClassicKeyRecovery"
+
+// 2^16 partitions with three 24 KiB candidate tables
+#define MF_CLASSIC_KEY_RECOVERY_PARTITION_BITS (8)
+#define MF_CLASSIC_KEY_RECOVERY_STACK_SIZE     (4 * 1024)
+
+typedef enum {
+    MfClassicKeyRecoveryEntryTypeMfkey32,
+    MfClassicKeyRecoveryEntryTypeNested,
+    MfClassicKeyRecoveryEntryTypeStaticNested,
+} MfClassicKeyRecoveryEntryType;
+
+typedef struct {
+    MfClassicKeyRecoveryEntryType type;
+    uint8_t sector;
+    MfClassicKeyType key_type;
+    uint32_t cuid;
+    uint32_t nt0;
+    uint32_t nr0; // Unused for nested entries
+    uint32_t ks0; // ar0 for MFKey32 entries
+    uint32_t nt1;
+    uint32_t nr1; // Unused for nested entries
+    uint32_t ks1; // ar1 for MFKey32 entries
+    bool solved;
+} MfClassicKeyRecoveryEntry;
+
+ARRAY_DEF(MfClassicKeyRecoveryEntryArray, MfClassicKeyRecoveryEntry, M_POD_OPLIST); // -V658
+ARRAY_DEF(MfClassicKeyRecoveryKeyArray, MfClassicKey, M_POD_OPLIST); // -V658
+
+typedef enum {
+    MfClassicKeyRecoverySessionStateIdle,
+    MfClassicKeyRecoverySessionStateActive,
+    MfClassicKeyRecoverySessionStateStopRequest,
+} MfClassicKeyRecoverySessionState;
+
+struct MfClassicKeyRecovery {
+    FuriThread* thread;
+    volatile MfClassicKeyRecoverySessionState session_state;
+    MfClassicKeyRecoveryConfig config;
+    MfClassicKeyRecoveryCallback callback;
+    void* context;
+
+    MfClassicKeyRecoveryEntryArray_t entries;
+    MfClassicKeyRecoveryKeyArray_t found_keys;
+    Crypto1Recovery* recovery;
+    KeysDict* user_dict;
+    Stream* spill_stream;
+    FuriString* line;
+
+    const MfClassicKeyRecoveryEntry* entry;
+    bool key_found;
+    MfClassicKey key;
+    MfClassicKeyRecoveryEvent event;
+
+    // Copy of event for the GUI thread, worker only touches it under mutex
+    FuriMutex* mutex;
+    MfClassicKeyRecoveryEvent event_published;
+};
+
+MfClassicKeyRecovery* mf_classic_key_recovery_alloc(void) {
+    MfClassicKeyRecovery* instance = malloc(sizeof(MfClassicKeyRecovery));
+    MfClassicKeyRecoveryEntryArray_init(instance->entries);
+    MfClassicKeyRecoveryKeyArray_init(instance->found_keys);
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    return instance;
+}
+
+void mf_classic_key_recovery_free(MfClassicKeyRecovery* instance) {
+    furi_check(instance);
+    furi_check(instance->session_state == MfClassicKeyRecoverySessionStateIdle);
+
+    MfClassicKeyRecoveryEntryArray_clear(instance->entries);
+    MfClassicKeyRecoveryKeyArray_clear(instance->found_keys);
+    furi_mutex_free(instance->mutex);
+    free(instance);
+}
+
+static bool mf_classic_key_recovery_is_active(MfClassicKeyRecovery* instance) {
+    return instance->session_state == MfClassicKeyRecoverySessionStateActive;
+}
+
+static void mf_classic_key_recovery_notify(
+    MfClassicKeyRecovery* instance,
+    MfClassicKeyRecoveryEventType type) {
+    instance->event.type = type;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    instance->event_published = instance->event;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    instance->callback(&instance->event, instance->context);
+}
+
+static bool mf_classic_key_recovery_parse_key_type(char key_type, MfClassicKeyType* out) {
+    bool parsed = true;
+    if(key_type == 'A') {
+        *out = MfClassicKeyTypeA;
+    } else if(key_type == 'B') {
+        *out = MfClassicKeyTypeB;
+    } else {
+        parsed = false;
+    }
+    return parsed;
+}
+
+static bool mf_classic_key_recovery_parse_mfkey32(
+    const char* line,
+    MfClassicKeyRecoveryEntry* entry) {
+    int sector = 0;
+    char key_type = 0;
+    int parsed = sscanf(
+        line,
+        "Sec %d key %c cuid %lx nt0 %lx nr0 %lx ar0 %lx nt1 %lx nr1 %lx ar1 %lx",
+        &sector,
+        &key_type,
+        &entry->cuid,
+        &entry->nt0,
+        &entry->nr0,
+        &entry->ks0,
+        &entry->nt1,
+        &entry->nr1,
+        &entry->ks1);
+
+    entry->type = MfClassicKeyRecoveryEntryTypeMfkey32;
+    entry->sector = sector;
+    return (parsed == 9) && mf_classic_key_recovery_parse_key_type(key_type, &entry->key_type);
+}
+
+static bool mf_classic_key_recovery_parse_nested(
+    const char* line,
+    MfClassicKeyRecoveryEntry* entry) {
+    int sector = 0;
+    char key_type = 0;
+    int parsed = sscanf(
+        line,
+        "Sec %d key %c cuid %lx nt0 %lx ks0 %lx par0 %*s nt1 %lx ks1 %lx",
+        &sector,
+        &key_type,
+        &entry->cuid,
+        &entry->nt0,
+        &entry->ks0,
+        &entry->nt1,
+        &entry->ks1);
+
+    bool valid = false;
+    if(parsed == 7) {
+        entry->type = MfClassicKeyRecoveryEntryTypeNested;
+        valid = true;
+    } else if(parsed == 5) {
+        // Plain nonce is unknown for hardnested entries, those are logged with zero nt
+        entry->type = MfClassicKeyRecoveryEntryTypeStaticNested;
+        valid = entry->nt0 != 0;
+    }
+    entry->sector = sector;
+    return valid && mf_classic_key_recovery_parse_key_type(key_type, &entry->key_type);
+}
+
+static void mf_classic_key_recovery_load_log(
+    MfClassicKeyRecovery* instance,
+    Storage* storage,
+    const char* path,
+    bool (*parse)(const char* line, MfClassicKeyRecoveryEntry* entry)) {
+    Stream* stream = buffered_file_stream_alloc(storage);
+
+    if(buffered_file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        MfClassicKeyRecoveryEntry entry = {};
+        while(stream_read_line(stream, instance->line)) {
+            if(!parse(furi_string_get_cstr(instance->line), &entry)) continue;
+            MfClassicKeyRecoveryEntryArray_push_back(instance->entries, entry);
+        }
+    } else {
+        FURI_LOG_D(TAG, "No log at %s", path);
+    }
+
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+}
+
+static bool
+    mf_classic_key_recovery_check_key(const MfClassicKeyRecoveryEntry* entry, uint64_t key) {
+    Crypto1 crypto = {};
+    crypto1_init(&crypto, key);
+
+    bool valid = false;
+    if(entry->type == MfClassicKeyRecoveryEntryTypeMfkey32) {
+        crypto1_word(&crypto, entry->cuid ^ entry->nt1, 0);
+        crypto1_word(&crypto, entry->nr1, 1);
+        valid = (entry->ks1 ^ crypto1_word(&crypto, 0, 0)) ==
+                crypto1_prng_successor(entry->nt1, 64);
+    } else if(entry->type == MfClassicKeyRecoveryEntryTypeNested) {
+        valid = crypto1_word(&crypto, entry->cuid ^ entry->nt1, 0) == entry->ks1;
+    }
+
+    return valid;
+}
+
+static bool mf_classic_key_recovery_candidate_callback(const Crypto1* state, void* context) {
+    MfClassicKeyRecovery* instance = context;
+    const MfClassicKeyRecoveryEntry* entry = instance->entry;
+
+    Crypto1 crypto = *state;
+    if(entry->type == MfClassicKeyRecoveryEntryTypeMfkey32) {
+        crypto1_lfsr_rollback_word(&crypto, 0, 0);
+        crypto1_lfsr_rollback_word(&crypto, entry->nr0, 1);
+    }
+    crypto1_lfsr_rollback_word(&crypto, entry->cuid ^ entry->nt0, 0);
+    const uint64_t key = crypto1_recovery_get_key(&crypto);
+
+    if(entry->type == MfClassicKeyRecoveryEntryTypeStaticNested) {
+        // Single nonce can't pin the key down, keep every candidate for nested dict attack
+        if(instance->spill_stream) {
+            stream_write_format(instance->spill_stream, "%012llX\n", key);
+        }
+    } else if(mf_classic_key_recovery_check_key(entry, key)) {
+        bit_lib_num_to_bytes_be(key, sizeof(MfClassicKey), instance->key.data);
+        instance->key_found = true;
+    }
+
+    return !instance->key_found && mf_classic_key_recovery_is_active(instance);
+}
+
+static bool mf_classic_key_recovery_check_found_keys(MfClassicKeyRecovery* instance) {
+    MfClassicKeyRecoveryKeyArray_it_t it;
+    for(MfClassicKeyRecoveryKeyArray_it(it, instance->found_keys);
+        !MfClassicKeyRecoveryKeyArray_end_p(it);
+        MfClassicKeyRecoveryKeyArray_next(it)) {
+        const MfClassicKey* key = MfClassicKeyRecoveryKeyArray_cref(it);
+        const uint64_t key_num = bit_lib_bytes_to_num_be(key->data, sizeof(MfClassicKey));
+        if(mf_classic_key_recovery_check_key(instance->entry, key_num)) {
+            instance->key = *key;
+            instance->key_found = true;
+            break;
+        }
+    }
+
+    return instance->key_found;
+}
+
+static void mf_classic_key_recovery_process_entry(MfClassicKeyRecovery* instance) {
+    const MfClassicKeyRecoveryEntry* entry = instance->entry;
+    instance->key_found = false;
+
+    // Keys are often shared between sectors, try the ones already recovered first
+    if(mf_classic_key_recovery_check_found_keys(instance)) return;
+
+    uint32_t ks2 = entry->ks0;
+    uint32_t in = entry->cuid ^ entry->nt0;
+    if(entry->type == MfClassicKeyRecoveryEntryTypeMfkey32) {
+        ks2 = entry->ks0 ^ crypto1_prng_successor(entry->nt0, 64);
+        in = 0;
+    }
+
+    const uint32_t partition_count = crypto1_recovery_get_partition_count(instance->recovery);
+    const uint32_t start_tick = furi_get_tick();
+    for(uint32_t i = 0; i < partition_count; i++) {
+        // Callback only sees partitions with candidates, most of them have none
+        if(!mf_classic_key_recovery_is_active(instance)) break;
+        if(!crypto1_recovery_run_partition(
+               instance->recovery,
+               ks2,
+               in,
+               i,
+               mf_classic_key_recovery_candidate_callback,
+               instance)) {
+            break;
+        }
+
+        const uint8_t progress = (uint64_t)(i + 1) * 100 / partition_count;
+        if(progress != instance->event.progress) {
+            const uint64_t elapsed = furi_get_tick() - start_tick;
+            instance->event.progress = progress;
+            instance->event.eta_s = elapsed * (partition_count - i - 1) / (i + 1) /
+                                    furi_kernel_get_tick_frequency();
+            mf_classic_key_recovery_notify(instance, MfClassicKeyRecoveryEventTypeProgress);
+        }
+        // Enumeration is pure computation, let other low priority threads run
+        furi_thread_yield();
+    }
+}
+
+static void mf_classic_key_recovery_store_key(MfClassicKeyRecovery* instance) {
+    bool is_new = true;
+    MfClassicKeyRecoveryKeyArray_it_t it;
+    for(MfClassicKeyRecoveryKeyArray_it(it, instance->found_keys);
+        !MfClassicKeyRecoveryKeyArray_end_p(it);
+        MfClassicKeyRecoveryKeyArray_next(it)) {
+        if(memcmp(MfClassicKeyRecoveryKeyArray_cref(it), &instance->key, sizeof(MfClassicKey)) ==
+           0) {
+            is_new = false;
+            break;
+        }
+    }
+    if(is_new) {
+        MfClassicKeyRecoveryKeyArray_push_back(instance->found_keys, instance->key);
+    }
+
+    if(!keys_dict_is_key_present(instance->user_dict, instance->key.data, sizeof(MfClassicKey))) {
+        keys_dict_add_key(instance->user_dict, instance->key.data, sizeof(MfClassicKey));
+        instance->event.keys_new++;
+    }
+
+    instance->event.keys_found++;
+    instance->event.sector = instance->entry->sector;
+    instance->event.key_type = instance->entry->key_type;
+    instance->event.key = instance->key;
+    mf_classic_key_recovery_notify(instance, MfClassicKeyRecoveryEventTypeKeyFound);
+}
+
+static bool mf_classic_key_recovery_is_duplicate(MfClassicKeyRecovery* instance, size_t index) {
+    const MfClassicKeyRecoveryEntry* entry =
+        MfClassicKeyRecoveryEntryArray_cget(instance->entries, index);
+
+    bool duplicate = false;
+    for(size_t i = 0; i < index && !duplicate; i++) {
+        const MfClassicKeyRecoveryEntry* prev =
+            MfClassicKeyRecoveryEntryArray_cget(instance->entries, i);
+        if((prev->cuid != entry->cuid) || (prev->sector != entry->sector) ||
+           (prev->key_type != entry->key_type)) {
+            continue;
+        }
+        // Static nonce repeats, so its candidates are already spilled
+        const bool same_static_nonce =
+            (prev->type == MfClassicKeyRecoveryEntryTypeStaticNested) &&
+            (entry->type == MfClassicKeyRecoveryEntryTypeStaticNested) &&
+            (prev->nt0 == entry->nt0);
+        duplicate = prev->solved || same_static_nonce;
+    }
+    return duplicate;
+}
+
+static int32_t mf_classic_key_recovery_worker(void* context) {
+    MfClassicKeyRecovery* instance = context;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    instance->line = furi_string_alloc();
+
+    MfClassicKeyRecoveryEntryArray_reset(instance->entries);
+    if(instance->config.mfkey32_log_path) {
+        mf_classic_key_recovery_load_log(
+            instance,
+            storage,
+            instance->config.mfkey32_log_path,
+            mf_classic_key_recovery_parse_mfkey32);
+    }
+    if(instance->config.nested_log_path) {
+        mf_classic_key_recovery_load_log(
+            instance,
+            storage,
+            instance->config.nested_log_path,
+            mf_classic_key_recovery_parse_nested);
+    }
+    instance->event.entries_total = MfClassicKeyRecoveryEntryArray_size(instance->entries);
+    FURI_LOG_I(TAG, "Loaded %zu entries", instance->event.entries_total);
+
+    instance->user_dict = keys_dict_alloc(
+        instance->config.user_dict_path, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    if(instance->config.candidates_dict_path) {
+        instance->spill_stream = buffered_file_stream_alloc(storage);
+        if(!buffered_file_stream_open(
+               instance->spill_stream,
+               instance->config.candidates_dict_path,
+               FSAM_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            buffered_file_stream_close(instance->spill_stream);
+            stream_free(instance->spill_stream);
+            instance->spill_stream = NULL;
+        }
+    }
+
+    if(instance->user_dict) {
+        instance->recovery = crypto1_recovery_alloc(MF_CLASSIC_KEY_RECOVERY_PARTITION_BITS);
+
+        for(size_t i = 0; i < instance->event.entries_total; i++) {
+            if(!mf_classic_key_recovery_is_active(instance)) break;
+            if(mf_classic_key_recovery_is_duplicate(instance, i)) continue;
+
+            instance->entry = MfClassicKeyRecoveryEntryArray_cget(instance->entries, i);
+            instance->event.entry_index = i;
+            instance->event.progress = 0;
+            instance->event.eta_s = 0;
+            mf_classic_key_recovery_notify(instance, MfClassicKeyRecoveryEventTypeProgress);
+
+            mf_classic_key_recovery_process_entry(instance);
+            if(instance->key_found) {
+                MfClassicKeyRecoveryEntryArray_get(instance->entries, i)->solved = true;
+                mf_classic_key_recovery_store_key(instance);
+            }
+        }
+
+        crypto1_recovery_free(instance->recovery);
+        instance->recovery = NULL;
+        keys_dict_free(instance->user_dict);
+        instance->user_dict = NULL;
+    }
+
+    if(instance->spill_stream) {
+        buffered_file_stream_close(instance->spill_stream);
+        stream_free(instance->spill_stream);
+        instance->spill_stream = NULL;
+    }
+
+    furi_string_free(instance->line);
+    furi_record_close(RECORD_STORAGE);
+
+    if(mf_classic_key_recovery_is_active(instance)) {
+        mf_classic_key_recovery_notify(
+            instance,
+            instance->event.entries_total ? MfClassicKeyRecoveryEventTypeFinished :
+                                            MfClassicKeyRecoveryEventTypeFail);
+    }
+
+    return 0;
+}
+
+void mf_classic_key_recovery_start(
+    MfClassicKeyRecovery* instance,
+    const MfClassicKeyRecoveryConfig* config,
+    MfClassicKeyRecoveryCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(config);
+    furi_check(config->user_dict_path);
+    furi_check(callback);
+    furi_check(instance->session_state == MfClassicKeyRecoverySessionStateIdle);
+
+    instance->config = *config;
+    instance->callback = callback;
+    instance->context = context;
+    memset(&instance->event, 0, sizeof(MfClassicKeyRecoveryEvent));
+    instance->event_published = instance->event;
+    MfClassicKeyRecoveryKeyArray_reset(instance->found_keys);
+    instance->session_state = MfClassicKeyRecoverySessionStateActive;
+
+    instance->thread = furi_thread_alloc_ex(
+        "MfClassicKeyRecovery",
+        MF_CLASSIC_KEY_RECOVERY_STACK_SIZE,
+        mf_classic_key_recovery_worker,
+        instance);
+    // Below GUI and app threads, so the enumeration never makes the UI lag
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->thread);
+}
+
+void mf_classic_key_recovery_stop(MfClassicKeyRecovery* instance) {
+    furi_check(instance);
+
+    if(instance->session_state == MfClassicKeyRecoverySessionStateIdle) return;
+
+    instance->session_state = MfClassicKeyRecoverySessionStateStopRequest;
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+    instance->thread = NULL;
+    instance->session_state = MfClassicKeyRecoverySessionStateIdle;
+}
+
+void mf_classic_key_recovery_get_event(
+    MfClassicKeyRecovery* instance,
+    MfClassicKeyRecoveryEvent* event) {
+    furi_check(instance);
+    furi_check(event);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    *event = instance->event_published;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+}
@@ -0,0 +1,134 @@
+/**
+ * @file mf_classic_key_recovery.h
+ * @brief On-device MIFARE Classic key recovery from collected nonces.
+ *
+ * Consumes the MFKey32 log written while emulating a card and the nested
+ * log written by the dict attack poller, recovers keys with partitioned
+ * Crypto1 state enumeration and adds them to the user dictionary.
+ *
+ * Supported entries:
+ * - MFKey32 entries (two reader authentications of the same sector).
+ * - Nested entries with two known nonces (weak PRNG cards).
+ * - Static encrypted nested entries with a known nonce: one nonce cannot
+ *   pin down the key, so all candidates are spilled to the candidates
+ *   dictionary on SD, the nested dict attack filters them against card nonces.
+ *
+ * Hardnested entries are skipped. Recovery runs in a low priority thread and
+ * can be stopped at any moment.
+ */
+#pragma once
+
+#include "mf_classic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief MfClassicKeyRecovery opaque type definition.
+ */
+typedef struct MfClassicKeyRecovery MfClassicKeyRecovery;
+
+/**
+ * @brief Key recovery configuration.
+ */
+typedef struct {
+    const char* mfkey32_log_path; /**< MFKey32 log path, NULL to skip. */
+    const char* nested_log_path; /**< Nested log path, NULL to skip. */
+    const char* user_dict_path; /**< Dictionary to store recovered keys. */
+    const char* candidates_dict_path; /**< Dictionary to spill key candidates, NULL to skip. */
+} MfClassicKeyRecoveryConfig;
+
+/**
+ * @brief Event type passed to the user callback.
+ */
+typedef enum {
+    MfClassicKeyRecoveryEventTypeProgress, /**< Progress of current entry changed. */
+    MfClassicKeyRecoveryEventTypeKeyFound, /**< Key was recovered. */
+    MfClassicKeyRecoveryEventTypeFinished, /**< All entries processed. */
+    MfClassicKeyRecoveryEventTypeFail, /**< Logs or dictionaries not accessible. */
+} MfClassicKeyRecoveryEventType;
+
+/**
+ * @brief Event passed to the user callback.
+ */
+typedef struct {
+    MfClassicKeyRecoveryEventType type; /**< Type of event. */
+    size_t entries_total; /**< Number of entries found in logs. */
+    size_t entry_index; /**< Entry being processed. */
+    uint8_t progress; /**< Progress of current entry, percent. */
+    uint32_t eta_s; /**< Estimated time left for current entry, seconds, 0 if unknown. */
+    size_t keys_found; /**< Number of keys recovered so far. */
+    size_t keys_new; /**< Number of recovered keys missing in user dictionary. */
+    uint8_t sector; /**< Sector of recovered key, valid for KeyFound. */
+    MfClassicKeyType key_type; /**< Type of recovered key, valid for KeyFound. */
+    MfClassicKey key; /**< Recovered key, valid for KeyFound. */
+} MfClassicKeyRecoveryEvent;
+
+/**
+ * @brief User callback function signature.
+ *
+ * Called from the recovery thread, the event is only valid during the call.
+ * Other threads must use mf_classic_key_recovery_get_event() instead.
+ *
+ * @param[in] event occurred event.
+ * @param[in] context pointer to the context data provided in mf_classic_key_recovery_start() call.
+ */
+typedef void (
+    *MfClassicKeyRecoveryCallback)(const MfClassicKeyRecoveryEvent* event, void* context);
+
+/**
+ * @brief Allocate an MfClassicKeyRecovery instance.
+ *
+ * @returns pointer to the allocated instance.
+ */
+MfClassicKeyRecovery* mf_classic_key_recovery_alloc(void);
+
+/**
+ * @brief Delete an MfClassicKeyRecovery instance.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void mf_classic_key_recovery_free(MfClassicKeyRecovery* instance);
+
+/**
+ * @brief Start key recovery in background.
+ *
+ * Paths in config must stay valid until recovery is stopped.
+ *
+ * @param[in,out] instance pointer to the instance to be started.
+ * @param[in] config pointer to the recovery configuration.
+ * @param[in] callback pointer to the callback function.
+ * @param[in] context pointer to the user-specific context.
+ */
+void mf_classic_key_recovery_start(
+    MfClassicKeyRecovery* instance,
+    const MfClassicKeyRecoveryConfig* config,
+    MfClassicKeyRecoveryCallback callback,
+    void* context);
+
+/**
+ * @brief Stop key recovery.
+ *
+ * Cancels processing of the current entry and waits for the thread to exit.
+ * Keys recovered before cancellation stay in the user dictionary.
+ *
+ * @param[in,out] instance pointer to the instance to be stopped.
+ */
+void mf_classic_key_recovery_stop(MfClassicKeyRecovery* instance);
+
+/**
+ * @brief Get a copy of the last event passed to the user callback.
+ *
+ * Safe to call from any thread while recovery is running.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @param[out] event pointer to the event to be filled.
+ */
+void mf_classic_key_recovery_get_event(
+    MfClassicKeyRecovery* instance,
+    MfClassicKeyRecoveryEvent* event);
+
+#ifdef __cplusplus
+}
+#endif
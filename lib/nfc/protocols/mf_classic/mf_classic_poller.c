@@ -77,6 +77,10 @@ void mf_classic_poller_free(MfClassicPoller* instance) {
         keys_dict_free(dict_attack_ctx->mf_classic_user_dict);
         dict_attack_ctx->mf_classic_user_dict = NULL;
     }
+    if(dict_attack_ctx->mf_classic_candidates_dict) {
+        keys_dict_free(dict_attack_ctx->mf_classic_candidates_dict);
+        dict_attack_ctx->mf_classic_candidates_dict = NULL;
+    }
 
     // Free the nested nonce array if it exists
     if(dict_attack_ctx->nested_nonce.nonces) {
@@ -484,6 +488,10 @@ NfcCommand mf_classic_poller_handler_request_read_sector(MfClassicPoller* instan
     command = instance->callback(instance->general_event, instance->context);
 
     if(!sec_read->key_provided) {
+        if(sec_read_ctx->auth_passed) {
+            mf_classic_poller_halt(instance);
+            sec_read_ctx->auth_passed = false;
+        }
         instance->state = MfClassicPollerStateSuccess;
     } else {
         sec_read_ctx->current_sector = sec_read->sector_num;
@@ -491,6 +499,8 @@ NfcCommand mf_classic_poller_handler_request_read_sector(MfClassicPoller* instan
         sec_read_ctx->key_type = sec_read->key_type;
         sec_read_ctx->current_block =
             mf_classic_get_first_block_num_of_sector(sec_read->sector_num);
+        // Card is still authenticated to the previous sector, skip reselection with nested auth
+        sec_read_ctx->nested_auth = sec_read_ctx->auth_passed;
         sec_read_ctx->auth_passed = false;
         instance->state = MfClassicPollerStateReadSectorBlocks;
     }
@@ -502,27 +512,47 @@ NfcCommand mf_classic_poller_handler_request_read_sector_blocks(MfClassicPoller*
     NfcCommand command = NfcCommandContinue;
 
     MfClassicPollerReadContext* sec_read_ctx = &instance->mode_ctx.read_ctx;
+    uint8_t sec_tr_num = mf_classic_get_sector_trailer_num_by_sector(sec_read_ctx->current_sector);
 
-    do {
+    // Read the whole sector in one pass, return early only if card must be reselected
+    while(sec_read_ctx->current_block <= sec_tr_num) {
         MfClassicError error = MfClassicErrorNone;
 
         if(!sec_read_ctx->auth_passed) {
             uint64_t key = bit_lib_bytes_to_num_be(sec_read_ctx->key.data, sizeof(MfClassicKey));
             FURI_LOG_D(
                 TAG,
-                "Auth to block %d with key %c: %06llx",
+                "%s to block %d with key %c: %06llx",
+                sec_read_ctx->nested_auth ? "Nested auth" : "Auth",
                 sec_read_ctx->current_block,
                 sec_read_ctx->key_type == MfClassicKeyTypeA ? 'A' : 'B',
                 key);
-            error = mf_classic_poller_auth(
-                instance,
-                sec_read_ctx->current_block,
-                &sec_read_ctx->key,
-                sec_read_ctx->key_type,
-                NULL,
-                false);
-            if(error != MfClassicErrorNone) break;
+            if(sec_read_ctx->nested_auth) {
+                error = mf_classic_poller_auth_nested(
+                    instance,
+                    sec_read_ctx->current_block,
+                    &sec_read_ctx->key,
+                    sec_read_ctx->key_type,
+                    NULL,
+                    false,
+                    false);
+            } else {
+                error = mf_classic_poller_auth(
+                    instance,
+                    sec_read_ctx->current_block,
+                    &sec_read_ctx->key,
+                    sec_read_ctx->key_type,
+                    NULL,
+                    false);
+            }
+            if(error != MfClassicErrorNone) {
+                // Failed nested auth is retried with regular auth on the same block
+                if(!sec_read_ctx->nested_auth) sec_read_ctx->current_block++;
+                sec_read_ctx->nested_auth = false;
+                break;
+            }
 
+            sec_read_ctx->nested_auth = false;
             sec_read_ctx->auth_passed = true;
             if(!mf_classic_is_key_found(
                    instance->data, sec_read_ctx->current_sector, sec_read_ctx->key_type)) {
@@ -530,27 +560,30 @@ NfcCommand mf_classic_poller_handler_request_read_sector_blocks(MfClassicPoller*
                     instance->data, sec_read_ctx->current_sector, sec_read_ctx->key_type, key);
             }
         }
-        if(mf_classic_is_block_read(instance->data, sec_read_ctx->current_block)) break;
 
-        FURI_LOG_D(TAG, "Reading block %d", sec_read_ctx->current_block);
-        MfClassicBlock read_block = {};
-        error = mf_classic_poller_read_block(instance, sec_read_ctx->current_block, &read_block);
-        if(error == MfClassicErrorNone) {
+        if(!mf_classic_is_block_read(instance->data, sec_read_ctx->current_block)) {
+            FURI_LOG_D(TAG, "Reading block %d", sec_read_ctx->current_block);
+            MfClassicBlock read_block = {};
+            error =
+                mf_classic_poller_read_block(instance, sec_read_ctx->current_block, &read_block);
+            if(error != MfClassicErrorNone) {
+                mf_classic_poller_halt(instance);
+                sec_read_ctx->auth_passed = false;
+                sec_read_ctx->current_block++;
+                break;
+            }
+
             mf_classic_set_block_read(instance->data, sec_read_ctx->current_block, &read_block);
             if(sec_read_ctx->key_type == MfClassicKeyTypeA) {
                 mf_classic_poller_check_key_b_is_readable(
                     instance, sec_read_ctx->current_block, &read_block);
             }
-        } else {
-            mf_classic_poller_halt(instance);
-            sec_read_ctx->auth_passed = false;
         }
-    } while(false);
 
-    uint8_t sec_tr_num = mf_classic_get_sector_trailer_num_by_sector(sec_read_ctx->current_sector);
-    sec_read_ctx->current_block++;
+        sec_read_ctx->current_block++;
+    }
+
     if(sec_read_ctx->current_block > sec_tr_num) {
-        mf_classic_poller_halt(instance);
         instance->state = MfClassicPollerStateRequestReadSector;
     }
 
@@ -684,10 +717,20 @@ NfcCommand mf_classic_poller_handler_request_key(MfClassicPoller* instance) {
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
 
     instance->mfc_event.type = MfClassicPollerEventTypeRequestKey;
+    instance->mfc_event_data.key_request_data.all_sectors = false;
     command = instance->callback(instance->general_event, instance->context);
     if(instance->mfc_event_data.key_request_data.key_provided) {
         dict_attack_ctx->current_key = instance->mfc_event_data.key_request_data.key;
-        instance->state = MfClassicPollerStateAuthKeyA;
+        if(instance->mfc_event_data.key_request_data.all_sectors) {
+            // Cached keys are likely to open sectors other than current, check them all at once
+            dict_attack_ctx->all_sectors_pass = true;
+            dict_attack_ctx->reuse_key_sector = 0;
+            dict_attack_ctx->current_key_type = MfClassicKeyTypeA;
+            dict_attack_ctx->auth_passed = false;
+            instance->state = MfClassicPollerStateKeyReuseStartNoOffset;
+        } else {
+            instance->state = MfClassicPollerStateAuthKeyA;
+        }
     } else {
         instance->state = MfClassicPollerStateNextSector;
     }
@@ -790,46 +833,55 @@ NfcCommand mf_classic_poller_handler_read_sector(MfClassicPoller* instance) {
     NfcCommand command = NfcCommandContinue;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
 
-    MfClassicError error = MfClassicErrorNone;
-    uint8_t block_num = dict_attack_ctx->current_block;
-    MfClassicBlock block = {};
-
-    do {
-        if(mf_classic_is_block_read(instance->data, block_num)) break;
+    uint8_t sec_tr_block_num =
+        mf_classic_get_sector_trailer_num_by_sector(dict_attack_ctx->current_sector);
+    bool reselect_required = false;
 
-        if(!dict_attack_ctx->auth_passed) {
-            error = mf_classic_poller_auth(
-                instance,
-                block_num,
-                &dict_attack_ctx->current_key,
-                dict_attack_ctx->current_key_type,
-                NULL,
-                false);
-            if(error != MfClassicErrorNone) {
-                instance->state = MfClassicPollerStateNextSector;
-                FURI_LOG_W(TAG, "Failed to re-auth. Go to next sector");
-                break;
+    // Read the rest of the sector back to back, return early only if card must be reselected
+    while(!reselect_required && (dict_attack_ctx->current_block <= sec_tr_block_num)) {
+        MfClassicError error = MfClassicErrorNone;
+        uint8_t block_num = dict_attack_ctx->current_block;
+        MfClassicBlock block = {};
+
+        do {
+            if(mf_classic_is_block_read(instance->data, block_num)) break;
+
+            if(!dict_attack_ctx->auth_passed) {
+                error = mf_classic_poller_auth(
+                    instance,
+                    block_num,
+                    &dict_attack_ctx->current_key,
+                    dict_attack_ctx->current_key_type,
+                    NULL,
+                    false);
+                if(error != MfClassicErrorNone) {
+                    instance->state = MfClassicPollerStateNextSector;
+                    FURI_LOG_W(TAG, "Failed to re-auth. Go to next sector");
+                    reselect_required = true;
+                    break;
+                }
+                dict_attack_ctx->auth_passed = true;
             }
-        }
 
-        FURI_LOG_D(TAG, "Reading block %d", block_num);
-        error = mf_classic_poller_read_block(instance, block_num, &block);
+            FURI_LOG_D(TAG, "Reading block %d", block_num);
+            error = mf_classic_poller_read_block(instance, block_num, &block);
 
-        if(error != MfClassicErrorNone) {
-            mf_classic_poller_halt(instance);
-            dict_attack_ctx->auth_passed = false;
-            FURI_LOG_D(TAG, "Failed to read block %d", block_num);
-        } else {
-            mf_classic_set_block_read(instance->data, block_num, &block);
-            if(dict_attack_ctx->current_key_type == MfClassicKeyTypeA) {
-                mf_classic_poller_check_key_b_is_readable(instance, block_num, &block);
+            if(error != MfClassicErrorNone) {
+                mf_classic_poller_halt(instance);
+                dict_attack_ctx->auth_passed = false;
+                reselect_required = true;
+                FURI_LOG_D(TAG, "Failed to read block %d", block_num);
+            } else {
+                mf_classic_set_block_read(instance->data, block_num, &block);
+                if(dict_attack_ctx->current_key_type == MfClassicKeyTypeA) {
+                    mf_classic_poller_check_key_b_is_readable(instance, block_num, &block);
+                }
             }
-        }
-    } while(false);
+        } while(false);
+
+        dict_attack_ctx->current_block++;
+    }
 
-    uint8_t sec_tr_block_num =
-        mf_classic_get_sector_trailer_num_by_sector(dict_attack_ctx->current_sector);
-    dict_attack_ctx->current_block++;
     if(dict_attack_ctx->current_block > sec_tr_block_num) {
         mf_classic_poller_handle_data_update(instance);
 
@@ -864,6 +916,11 @@ NfcCommand mf_classic_poller_handler_key_reuse_start(MfClassicPoller* instance)
             if(dict_attack_ctx->reuse_key_sector == instance->sectors_total) {
                 instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStop;
                 command = instance->callback(instance->general_event, instance->context);
+                if(dict_attack_ctx->all_sectors_pass) {
+                    dict_attack_ctx->all_sectors_pass = false;
+                    instance->state = MfClassicPollerStateRequestKey;
+                    break;
+                }
                 // Nested entrypoint
                 bool nested_active = dict_attack_ctx->nested_phase != MfClassicNestedPhaseNone;
                 if((dict_attack_ctx->enhanced_dict) &&
@@ -982,45 +1039,54 @@ NfcCommand mf_classic_poller_handler_key_reuse_read_sector(MfClassicPoller* inst
     NfcCommand command = NfcCommandContinue;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
 
-    MfClassicError error = MfClassicErrorNone;
-    uint8_t block_num = dict_attack_ctx->current_block;
-    MfClassicBlock block = {};
-
-    do {
-        if(mf_classic_is_block_read(instance->data, block_num)) break;
+    uint16_t sec_tr_block_num =
+        mf_classic_get_sector_trailer_num_by_sector(dict_attack_ctx->reuse_key_sector);
+    bool reselect_required = false;
 
-        if(!dict_attack_ctx->auth_passed) {
-            error = mf_classic_poller_auth(
-                instance,
-                block_num,
-                &dict_attack_ctx->current_key,
-                dict_attack_ctx->current_key_type,
-                NULL,
-                false);
-            if(error != MfClassicErrorNone) {
-                instance->state = MfClassicPollerStateKeyReuseStart;
-                break;
+    // Same batching as for the dict attack sector read
+    while(!reselect_required && (dict_attack_ctx->current_block <= sec_tr_block_num)) {
+        MfClassicError error = MfClassicErrorNone;
+        uint8_t block_num = dict_attack_ctx->current_block;
+        MfClassicBlock block = {};
+
+        do {
+            if(mf_classic_is_block_read(instance->data, block_num)) break;
+
+            if(!dict_attack_ctx->auth_passed) {
+                error = mf_classic_poller_auth(
+                    instance,
+                    block_num,
+                    &dict_attack_ctx->current_key,
+                    dict_attack_ctx->current_key_type,
+                    NULL,
+                    false);
+                if(error != MfClassicErrorNone) {
+                    instance->state = MfClassicPollerStateKeyReuseStart;
+                    reselect_required = true;
+                    break;
+                }
+                dict_attack_ctx->auth_passed = true;
             }
-        }
 
-        FURI_LOG_D(TAG, "Reading block %d", block_num);
-        error = mf_classic_poller_read_block(instance, block_num, &block);
+            FURI_LOG_D(TAG, "Reading block %d", block_num);
+            error = mf_classic_poller_read_block(instance, block_num, &block);
 
-        if(error != MfClassicErrorNone) {
-            mf_classic_poller_halt(instance);
-            dict_attack_ctx->auth_passed = false;
-            FURI_LOG_D(TAG, "Failed to read block %d", block_num);
-        } else {
-            mf_classic_set_block_read(instance->data, block_num, &block);
-            if(dict_attack_ctx->current_key_type == MfClassicKeyTypeA) {
-                mf_classic_poller_check_key_b_is_readable(instance, block_num, &block);
+            if(error != MfClassicErrorNone) {
+                mf_classic_poller_halt(instance);
+                dict_attack_ctx->auth_passed = false;
+                reselect_required = true;
+                FURI_LOG_D(TAG, "Failed to read block %d", block_num);
+            } else {
+                mf_classic_set_block_read(instance->data, block_num, &block);
+                if(dict_attack_ctx->current_key_type == MfClassicKeyTypeA) {
+                    mf_classic_poller_check_key_b_is_readable(instance, block_num, &block);
+                }
             }
-        }
-    } while(false);
+        } while(false);
+
+        dict_attack_ctx->current_block++;
+    }
 
-    uint16_t sec_tr_block_num =
-        mf_classic_get_sector_trailer_num_by_sector(dict_attack_ctx->reuse_key_sector);
-    dict_attack_ctx->current_block++;
     if(dict_attack_ctx->current_block > sec_tr_block_num) {
         mf_classic_poller_halt(instance);
         dict_attack_ctx->auth_passed = false;
@@ -1515,43 +1581,51 @@ static MfClassicKey* search_dicts_for_nonce_key(
     MfClassicNestedNonceArray* nonce_array,
     KeysDict* system_dict,
     KeysDict* user_dict,
+    KeysDict* candidates_dict,
     bool is_weak) {
     MfClassicKey stack_key;
-    KeysDict* dicts[] = {user_dict, system_dict};
+    MfClassicKey key_batch[MF_CLASSIC_NESTED_KEY_BATCH_SIZE];
+    KeysDict* dicts[] = {user_dict, candidates_dict, system_dict};
     bool is_resumed = dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackResume;
     bool found_resume_point = false;
 
-    for(int i = 0; i < 2; i++) {
+    for(size_t i = 0; i < COUNT_OF(dicts); i++) {
         if(!dicts[i]) continue;
         keys_dict_rewind(dicts[i]);
-        while(keys_dict_get_next_key(dicts[i], stack_key.data, sizeof(MfClassicKey))) {
-            if(is_resumed && !found_resume_point) {
-                found_resume_point =
-                    (memcmp(
-                         dict_attack_ctx->current_key.data,
-                         stack_key.data,
-                         sizeof(MfClassicKey)) == 0);
-                continue;
+        bool dict_end = false;
+        while(!dict_end) {
+            // Collect a batch of candidates, all of them are tested against each nonce at once
+            size_t batch_count = 0;
+            while(batch_count < MF_CLASSIC_NESTED_KEY_BATCH_SIZE) {
+                if(!keys_dict_get_next_key(dicts[i], stack_key.data, sizeof(MfClassicKey))) {
+                    dict_end = true;
+                    break;
+                }
+                if(is_resumed && !found_resume_point) {
+                    found_resume_point =
+                        (memcmp(
+                             dict_attack_ctx->current_key.data,
+                             stack_key.data,
+                             sizeof(MfClassicKey)) == 0);
+                    continue;
+                }
+                key_batch[batch_count++] = stack_key;
             }
-            bool full_match = true;
-            for(uint8_t j = 0; j < nonce_array->count; j++) {
+
+            for(uint8_t j = 0; (j < nonce_array->count) && batch_count; j++) {
                 // Verify nonce matches encrypted parity bits for all nonces
-                uint32_t nt_enc_plain = crypto1_decrypt_nt_enc(
-                    nonce_array->nonces[j].cuid, nonce_array->nonces[j].nt_enc, stack_key);
-                if(is_weak) {
-                    full_match &= crypto1_is_weak_prng_nonce(nt_enc_plain);
-                    if(!full_match) break;
-                }
-                full_match &= crypto1_nonce_matches_encrypted_parity_bits(
-                    nt_enc_plain,
-                    nt_enc_plain ^ nonce_array->nonces[j].nt_enc,
-                    nonce_array->nonces[j].par);
-                if(!full_match) break;
+                batch_count = crypto1_nt_enc_filter_keys(
+                    nonce_array->nonces[j].cuid,
+                    nonce_array->nonces[j].nt_enc,
+                    nonce_array->nonces[j].par,
+                    is_weak,
+                    key_batch,
+                    batch_count);
             }
-            if(full_match) {
+            if(batch_count) {
                 MfClassicKey* new_candidate = malloc(sizeof(MfClassicKey));
                 if(new_candidate == NULL) return NULL; // malloc failed
-                memcpy(new_candidate, &stack_key, sizeof(MfClassicKey));
+                memcpy(new_candidate, &key_batch[0], sizeof(MfClassicKey));
                 return new_candidate;
             }
         }
@@ -1654,6 +1728,7 @@ NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instanc
                 &dict_attack_ctx->nested_nonce,
                 dict_attack_ctx->mf_classic_system_dict,
                 dict_attack_ctx->mf_classic_user_dict,
+                dict_attack_ctx->mf_classic_candidates_dict,
                 is_weak);
             if(key_candidate != NULL) {
                 FURI_LOG_I(
@@ -1920,6 +1995,15 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                         KeysDictModeOpenExisting,
                         sizeof(MfClassicKey)) :
                     NULL;
+
+            // Too many for auth tests, candidates are only checked against collected nonces
+            dict_attack_ctx->mf_classic_candidates_dict =
+                keys_dict_check_presence(MF_CLASSIC_NESTED_CANDIDATES_DICT_PATH) ?
+                    keys_dict_alloc(
+                        MF_CLASSIC_NESTED_CANDIDATES_DICT_PATH,
+                        KeysDictModeOpenExisting,
+                        sizeof(MfClassicKey)) :
+                    NULL;
         }
         if((is_weak && (dict_attack_ctx->nested_nonce.count == 1)) ||
            (is_last_iter_for_hard_key && (dict_attack_ctx->nested_nonce.count == 8))) {
@@ -1948,6 +2032,10 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                 keys_dict_free(dict_attack_ctx->mf_classic_user_dict);
                 dict_attack_ctx->mf_classic_user_dict = NULL;
             }
+            if(dict_attack_ctx->mf_classic_candidates_dict) {
+                keys_dict_free(dict_attack_ctx->mf_classic_candidates_dict);
+                dict_attack_ctx->mf_classic_candidates_dict = NULL;
+            }
             dict_attack_ctx->nested_target_key = 0;
             if(mf_classic_is_card_read(instance->data)) {
                 // All keys have been collected
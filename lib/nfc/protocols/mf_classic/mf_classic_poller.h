@@ -130,6 +130,7 @@ typedef struct {
 typedef struct {
     MfClassicKey key; /**< Key to be used by poller. */
     bool key_provided; /**< Flag indicating if key is provided. */
+    bool all_sectors; /**< Try key on all sectors in one pass before next request. */
 } MfClassicPollerEventDataKeyRequest;
 
 /**
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "mf_classic_poller.h"
+#include "mf_classic_poller_sync.h"
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a_poller_i.h>
 #include <bit_lib/bit_lib.h>
 #include <nfc/helpers/iso14443_crc.h>
@@ -22,6 +23,7 @@ extern "C" {
 #define MF_CLASSIC_NESTED_RETRY_MAXIMUM         (60)
 #define MF_CLASSIC_NESTED_HARD_RETRY_MAXIMUM    (3)
 #define MF_CLASSIC_NESTED_CALIBRATION_COUNT     (21)
+#define MF_CLASSIC_NESTED_KEY_BATCH_SIZE        (32)
 #define MF_CLASSIC_NESTED_LOGS_FILE_NAME        ".nested.log"
 #define MF_CLASSIC_NESTED_SYSTEM_DICT_FILE_NAME "mf_classic_dict_nested.nfc"
 #define MF_CLASSIC_NESTED_USER_DICT_FILE_NAME   "mf_classic_dict_user_nested.nfc"
@@ -30,6 +32,8 @@ extern "C" {
     (NFC_ASSETS_FOLDER "/" MF_CLASSIC_NESTED_SYSTEM_DICT_FILE_NAME)
 #define MF_CLASSIC_NESTED_USER_DICT_PATH \
     (NFC_ASSETS_FOLDER "/" MF_CLASSIC_NESTED_USER_DICT_FILE_NAME)
+#define MF_CLASSIC_NESTED_CANDIDATES_DICT_PATH \
+    (NFC_ASSETS_FOLDER "/mf_classic_dict_candidates.nfc")
 #define SET_PACKED_BIT(arr, bit) ((arr)[(bit) / 8] |= (1 << ((bit) % 8)))
 #define GET_PACKED_BIT(arr, bit) ((arr)[(bit) / 8] & (1 << ((bit) % 8)))
 
@@ -131,6 +135,7 @@ typedef struct {
     bool auth_passed;
     uint16_t current_block;
     uint8_t reuse_key_sector;
+    bool all_sectors_pass;
     MfClassicBackdoor backdoor;
     // Enhanced dictionary attack and nested nonce collection
     bool enhanced_dict;
@@ -150,6 +155,7 @@ typedef struct {
     uint8_t attempt_count;
     KeysDict* mf_classic_system_dict;
     KeysDict* mf_classic_user_dict;
+    KeysDict* mf_classic_candidates_dict; // Key candidates from on-device recovery
     // Hardnested
     uint8_t nt_enc_msb
         [32]; // Bit-packed array to track which unique most significant bytes have been seen (256 bits = 32 bytes)
@@ -163,6 +169,7 @@ typedef struct {
     MfClassicKeyType key_type;
     MfClassicKey key;
     bool auth_passed;
+    bool nested_auth;
 } MfClassicPollerReadContext;
 
 typedef union {
@@ -238,9 +245,15 @@ typedef struct {
     uint8_t current_sector;
 } MfClassicReadContext;
 
+typedef struct {
+    MfClassicAuthProbe* probes;
+    size_t probes_num;
+} MfClassicAuthBatchContext;
+
 typedef union {
     MfClassicCollectNtContext collect_nt_context;
     MfClassicAuthContext auth_context;
+    MfClassicAuthBatchContext auth_batch_context;
     MfClassicReadBlockContext read_block_context;
     MfClassicWriteBlockContext write_block_context;
     MfClassicReadValueContext read_value_context;
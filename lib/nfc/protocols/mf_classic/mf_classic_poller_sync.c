@@ -12,6 +12,7 @@
 typedef enum {
     MfClassicPollerCmdTypeCollectNt,
     MfClassicPollerCmdTypeAuth,
+    MfClassicPollerCmdTypeAuthBatch,
     MfClassicPollerCmdTypeReadBlock,
     MfClassicPollerCmdTypeWriteBlock,
     MfClassicPollerCmdTypeReadValue,
@@ -52,6 +53,38 @@ static MfClassicError
         false);
 }
 
+static MfClassicError mf_classic_poller_auth_batch_handler(
+    MfClassicPoller* poller,
+    MfClassicPollerContextData* data) {
+    MfClassicError error = MfClassicErrorNone;
+    MfClassicAuthBatchContext* batch = &data->auth_batch_context;
+
+    for(size_t i = 0; i < batch->probes_num; i++) {
+        MfClassicAuthProbe* probe = &batch->probes[i];
+
+        if(i > 0) {
+            // Previous probe left the card halted either way
+            Iso14443_3aError iso_error =
+                iso14443_3a_poller_activate(poller->iso14443_3a_poller, NULL);
+            if(iso_error != Iso14443_3aErrorNone) {
+                error = mf_classic_process_error(iso_error);
+                break;
+            }
+        }
+
+        // Wrong key is indistinguishable from no answer, activation tells if card is gone
+        probe->authenticated =
+            mf_classic_poller_auth(
+                poller, probe->block_num, &probe->key, probe->key_type, NULL, false) ==
+            MfClassicErrorNone;
+        if(probe->authenticated) {
+            mf_classic_poller_halt(poller);
+        }
+    }
+
+    return error;
+}
+
 static MfClassicError mf_classic_poller_read_block_handler(
     MfClassicPoller* poller,
     MfClassicPollerContextData* data) {
@@ -183,6 +216,7 @@ static MfClassicError mf_classic_poller_change_value_handler(
 static const MfClassicPollerCmdHandler mf_classic_poller_cmd_handlers[MfClassicPollerCmdTypeNum] = {
     [MfClassicPollerCmdTypeCollectNt] = mf_classic_poller_collect_nt_handler,
     [MfClassicPollerCmdTypeAuth] = mf_classic_poller_auth_handler,
+    [MfClassicPollerCmdTypeAuthBatch] = mf_classic_poller_auth_batch_handler,
     [MfClassicPollerCmdTypeReadBlock] = mf_classic_poller_read_block_handler,
     [MfClassicPollerCmdTypeWriteBlock] = mf_classic_poller_write_block_handler,
     [MfClassicPollerCmdTypeReadValue] = mf_classic_poller_read_value_handler,
@@ -277,6 +311,25 @@ MfClassicError mf_classic_poller_sync_auth(
     return error;
 }
 
+MfClassicError
+    mf_classic_poller_sync_auth_batch(Nfc* nfc, MfClassicAuthProbe* probes, size_t probes_num) {
+    furi_check(nfc);
+    furi_check(probes || probes_num == 0);
+
+    for(size_t i = 0; i < probes_num; i++) {
+        probes[i].authenticated = false;
+    }
+    if(probes_num == 0) return MfClassicErrorNone;
+
+    MfClassicPollerContext poller_context = {
+        .cmd_type = MfClassicPollerCmdTypeAuthBatch,
+        .data.auth_batch_context.probes = probes,
+        .data.auth_batch_context.probes_num = probes_num,
+    };
+
+    return mf_classic_poller_cmd_execute(nfc, &poller_context);
+}
+
 MfClassicError mf_classic_poller_sync_read_block(
     Nfc* nfc,
     uint8_t block_num,
@@ -7,6 +7,13 @@
 extern "C" {
 #endif
 
+typedef struct {
+    uint8_t block_num;
+    MfClassicKey key;
+    MfClassicKeyType key_type;
+    bool authenticated; /**< Result, set by mf_classic_poller_sync_auth_batch() */
+} MfClassicAuthProbe;
+
 MfClassicError mf_classic_poller_sync_collect_nt(
     Nfc* nfc,
     uint8_t block_num,
@@ -20,6 +27,16 @@ MfClassicError mf_classic_poller_sync_auth(
     MfClassicKeyType key_type,
     MfClassicAuthContext* data);
 
+/** Try several authentications in one poller session
+ *
+ * Wrong key is not an error: probe is marked as not authenticated and card
+ * is reactivated for the next one.
+ *
+ * @return MfClassicErrorNone unless card was lost
+ */
+MfClassicError
+    mf_classic_poller_sync_auth_batch(Nfc* nfc, MfClassicAuthProbe* probes, size_t probes_num);
+
 MfClassicError mf_classic_poller_sync_read_block(
     Nfc* nfc,
     uint8_t block_num,
@@ -26,6 +26,7 @@ void subghz_environment_free(SubGhzEnvironment* instance);
 
 /**
  * Downloading the manufacture key file.
+ * File is decrypted once and shared by all environments.
  * @param instance Pointer to a SubGhzEnvironment instance
  * @param filename Full path to the file
  * @return true On success
@@ -228,7 +228,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                 //Simple Learning
                 decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
                 if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                    *manufacture_name = manufacture_code->name;
                     return 1;
                 }
                 break;
@@ -239,7 +239,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
                 decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
                 if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                    *manufacture_name = manufacture_code->name;
                     return 1;
                 }
                 break;
@@ -247,7 +247,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                 // Simple Learning
                 decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
                 if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                    *manufacture_name = manufacture_code->name;
                     return 1;
                 }
                 // Check for mirrored man
@@ -259,7 +259,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                 }
                 decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
                 if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                    *manufacture_name = manufacture_code->name;
                     return 1;
                 }
                 //###########################
@@ -269,13 +269,13 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
                 decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
                 if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                    *manufacture_name = manufacture_code->name;
                     return 1;
                 }
                 man_normal_learning = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
                 decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
                 if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                    *manufacture_name = manufacture_code->name;
                     return 1;
                 }
                 break;
@@ -21,56 +21,130 @@
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+// Ciphertext decrypted in one call, lines are chained by CBC anyway
+#define SUBGHZ_KEYSTORE_DECRYPT_BATCH_SIZE  (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
+#define SUBGHZ_KEYSTORE_DECRYPT_BATCH_LINES (SUBGHZ_KEYSTORE_DECRYPT_BATCH_SIZE / 16)
+
+#define SUBGHZ_KEYSTORE_NAME_CHUNK_SIZE 512
+#define SUBGHZ_KEYSTORE_NAME_SIZE       65
+
+#define SUBGHZ_KEYSTORE_TABLES_MAX 4
+
+// Unused tables are dropped when free heap goes below this
+#define SUBGHZ_KEYSTORE_CACHE_FREE_HEAP 20480
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+typedef struct SubGhzKeystoreNameChunk SubGhzKeystoreNameChunk;
+
+struct SubGhzKeystoreNameChunk {
+    SubGhzKeystoreNameChunk* next;
+    size_t used;
+    char data[];
+};
+
+typedef struct SubGhzKeystoreTable SubGhzKeystoreTable;
+
+struct SubGhzKeystoreTable {
+    SubGhzKeystoreTable* next;
+    FuriString* file_name;
+    // Stat of the file the table was loaded from
+    uint64_t size;
+    uint32_t timestamp;
+    size_t refs;
+    bool stale;
+    SubGhzKeyArray_t data;
+    SubGhzKeystoreNameChunk* names;
+};
+
 struct SubGhzKeystore {
+    SubGhzKeystoreTable* tables[SUBGHZ_KEYSTORE_TABLES_MAX];
+    size_t table_count;
+    // Keys of all tables, only used if there is more than one
     SubGhzKeyArray_t data;
 };
 
-SubGhzKeystore* subghz_keystore_alloc(void) {
-    SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
+static FuriMutex* subghz_keystore_cache_mutex = NULL;
+static SubGhzKeystoreTable* subghz_keystore_cache = NULL;
 
-    SubGhzKeyArray_init(instance->data);
+static FuriMutex* subghz_keystore_cache_get_mutex(void) {
+    if(!subghz_keystore_cache_mutex) {
+        FuriMutex* mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 
-    return instance;
+        FURI_CRITICAL_ENTER();
+        if(!subghz_keystore_cache_mutex) {
+            subghz_keystore_cache_mutex = mutex;
+            mutex = NULL;
+        }
+        FURI_CRITICAL_EXIT();
+
+        if(mutex) furi_mutex_free(mutex);
+    }
+
+    return subghz_keystore_cache_mutex;
 }
 
-void subghz_keystore_free(SubGhzKeystore* instance) {
-    furi_assert(instance);
+static SubGhzKeystoreTable* subghz_keystore_table_alloc(const char* file_name) {
+    SubGhzKeystoreTable* table = malloc(sizeof(SubGhzKeystoreTable));
 
-    for
-        M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            furi_string_free(manufacture_code->name);
-            manufacture_code->key = 0;
-        }
-    SubGhzKeyArray_clear(instance->data);
+    table->file_name = furi_string_alloc_set(file_name);
+    SubGhzKeyArray_init(table->data);
 
-    free(instance);
+    return table;
 }
 
-static void subghz_keystore_add_key(
-    SubGhzKeystore* instance,
-    const char* name,
-    uint64_t key,
-    uint16_t type) {
-    SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    manufacture_code->name = furi_string_alloc_set(name);
-    manufacture_code->key = key;
-    manufacture_code->type = type;
+static void subghz_keystore_table_free(SubGhzKeystoreTable* table) {
+    while(table->names) {
+        SubGhzKeystoreNameChunk* chunk = table->names;
+        table->names = chunk->next;
+        free(chunk);
+    }
+    SubGhzKeyArray_clear(table->data);
+    furi_string_free(table->file_name);
+
+    free(table);
 }
 
-static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
+static const char* subghz_keystore_table_add_name(SubGhzKeystoreTable* table, const char* name) {
+    // Consecutive keys of one manufacture share the name
+    if(SubGhzKeyArray_size(table->data)) {
+        const char* last_name = SubGhzKeyArray_back(table->data)->name;
+        if(strcmp(last_name, name) == 0) return last_name;
+    }
+
+    size_t size = strlen(name) + 1;
+    furi_assert(size <= SUBGHZ_KEYSTORE_NAME_CHUNK_SIZE);
+
+    SubGhzKeystoreNameChunk* chunk = table->names;
+    if(!chunk || chunk->used + size > SUBGHZ_KEYSTORE_NAME_CHUNK_SIZE) {
+        chunk = malloc(sizeof(SubGhzKeystoreNameChunk) + SUBGHZ_KEYSTORE_NAME_CHUNK_SIZE);
+        chunk->next = table->names;
+        table->names = chunk;
+    }
+
+    char* dest = &chunk->data[chunk->used];
+    memcpy(dest, name, size);
+    chunk->used += size;
+
+    return dest;
+}
+
+static bool subghz_keystore_process_line(SubGhzKeystoreTable* table, const char* line) {
     uint64_t key = 0;
     uint16_t type = 0;
     char skey[17] = {0};
-    char name[65] = {0};
+    char name[SUBGHZ_KEYSTORE_NAME_SIZE] = {0};
     int ret = sscanf(line, "%16s:%hu:%64s", skey, &type, name);
     key = strtoull(skey, NULL, 16);
     if(ret == 3) {
-        subghz_keystore_add_key(instance, name, key, type);
+        const char* table_name = subghz_keystore_table_add_name(table, name);
+        SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(table->data);
+        manufacture_code->name = table_name;
+        manufacture_code->key = key;
+        manufacture_code->type = type;
         return true;
     } else {
         FURI_LOG_E(TAG, "Failed to load line: %s\r\n", line);
@@ -106,14 +180,78 @@ static void subghz_keystore_mess_with_iv(uint8_t* iv) {
                  : "r0", "r1", "r2", "r3", "memory");
 }
 
-static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream, uint8_t* iv) {
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    uint16_t line_end[SUBGHZ_KEYSTORE_DECRYPT_BATCH_LINES];
+    size_t line_count;
+    char* line;
+} SubGhzKeystoreDecryptBatch;
+
+static bool subghz_keystore_decrypt_batch_flush(
+    SubGhzKeystoreTable* table,
+    SubGhzKeystoreDecryptBatch* batch) {
+    if(batch->size == 0) return true;
+
+    // In place: every block is read by the engine before its output is stored
+    bool result = furi_hal_crypto_decrypt(batch->data, batch->data, batch->size);
+    if(result) {
+        size_t line_start = 0;
+        for(size_t i = 0; i < batch->line_count; i++) {
+            size_t len = batch->line_end[i] - line_start;
+            memcpy(batch->line, &batch->data[line_start], len);
+            batch->line[len] = '\0';
+            subghz_keystore_process_line(table, batch->line);
+            line_start = batch->line_end[i];
+        }
+    } else {
+        FURI_LOG_E(TAG, "Decryption failed");
+    }
+
+    memset(batch->data, 0, SUBGHZ_KEYSTORE_DECRYPT_BATCH_SIZE);
+    memset(batch->line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE + 1);
+    batch->size = 0;
+    batch->line_count = 0;
+
+    return result;
+}
+
+static bool subghz_keystore_decrypt_batch_push(
+    SubGhzKeystoreTable* table,
+    SubGhzKeystoreDecryptBatch* batch,
+    const char* encrypted_line,
+    size_t len) {
+    if(batch->size + len / 2 > SUBGHZ_KEYSTORE_DECRYPT_BATCH_SIZE) {
+        if(!subghz_keystore_decrypt_batch_flush(table, batch)) return false;
+    }
+
+    uint8_t* dest = &batch->data[batch->size];
+    for(size_t i = 0; i < len; i += 2) {
+        uint8_t hi_nibble = 0;
+        uint8_t lo_nibble = 0;
+        hex_char_to_hex_nibble(encrypted_line[i], &hi_nibble);
+        hex_char_to_hex_nibble(encrypted_line[i + 1], &lo_nibble);
+        dest[i / 2] = (hi_nibble << 4) | lo_nibble;
+    }
+    batch->size += len / 2;
+    batch->line_end[batch->line_count++] = batch->size;
+
+    return true;
+}
+
+static bool subghz_keystore_read_file(SubGhzKeystoreTable* table, Stream* stream, uint8_t* iv) {
     bool result = true;
     uint8_t buffer[FILE_BUFFER_SIZE];
 
-    char* decrypted_line = malloc(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
-    char* encrypted_line = malloc(SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE);
+    char* encrypted_line = malloc(SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE + 1);
     size_t encrypted_line_cursor = 0;
 
+    SubGhzKeystoreDecryptBatch batch = {0};
+    if(iv) {
+        batch.data = malloc(SUBGHZ_KEYSTORE_DECRYPT_BATCH_SIZE);
+        batch.line = malloc(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE + 1);
+    }
+
     do {
         if(iv) {
             if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
@@ -130,35 +268,18 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
                     // Process line
                     if(iv) {
                         // Data alignment check, 32 instead of 16 because of hex encoding
-                        size_t len = strlen(encrypted_line);
-                        if(len % 32 == 0) {
-                            // Inplace hex to bin conversion
-                            for(size_t i = 0; i < len; i += 2) {
-                                uint8_t hi_nibble = 0;
-                                uint8_t lo_nibble = 0;
-                                hex_char_to_hex_nibble(encrypted_line[i], &hi_nibble);
-                                hex_char_to_hex_nibble(encrypted_line[i + 1], &lo_nibble);
-                                encrypted_line[i / 2] = (hi_nibble << 4) | lo_nibble;
-                            }
-                            len /= 2;
-
-                            if(furi_hal_crypto_decrypt(
-                                   (uint8_t*)encrypted_line, (uint8_t*)decrypted_line, len)) {
-                                subghz_keystore_process_line(instance, decrypted_line);
-                            } else {
-                                FURI_LOG_E(TAG, "Decryption failed");
-                                result = false;
-                                break;
-                            }
+                        if(encrypted_line_cursor % 32 == 0) {
+                            result = subghz_keystore_decrypt_batch_push(
+                                table, &batch, encrypted_line, encrypted_line_cursor);
+                            if(!result) break;
                         } else {
                             FURI_LOG_E(TAG, "Invalid encrypted data: %s", encrypted_line);
                         }
                     } else {
-                        subghz_keystore_process_line(instance, encrypted_line);
+                        subghz_keystore_process_line(table, encrypted_line);
                     }
                     // reset line buffer
-                    memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
-                    memset(encrypted_line, 0, SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE);
+                    memset(encrypted_line, 0, SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE + 1);
                     encrypted_line_cursor = 0;
                 } else if(buffer[i] == '\r' || buffer[i] == '\n') {
                     // do not add line endings to the buffer
@@ -175,21 +296,27 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
             }
         } while(ret > 0 && result);
 
-        if(iv) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+        if(iv) {
+            if(result) result = subghz_keystore_decrypt_batch_flush(table, &batch);
+            furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+        }
     } while(false);
 
+    if(iv) {
+        free(batch.line);
+        free(batch.data);
+    }
     free(encrypted_line);
-    free(decrypted_line);
 
     return result;
 }
 
-bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
-    furi_assert(instance);
+static bool subghz_keystore_table_load(SubGhzKeystoreTable* table) {
     bool result = false;
     uint8_t iv[16];
     uint32_t version;
     uint32_t encryption;
+    const char* file_name = furi_string_get_cstr(table->file_name);
 
     FuriString* filetype;
     filetype = furi_string_alloc();
@@ -221,14 +348,14 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
 
         Stream* stream = flipper_format_get_raw_stream(flipper_format);
         if(encryption == SubGhzKeystoreEncryptionNone) {
-            result = subghz_keystore_read_file(instance, stream, NULL);
+            result = subghz_keystore_read_file(table, stream, NULL);
         } else if(encryption == SubGhzKeystoreEncryptionAES256) {
             if(!flipper_format_read_hex(flipper_format, "IV", iv, 16)) {
                 FURI_LOG_E(TAG, "Missing IV");
                 break;
             }
             subghz_keystore_mess_with_iv(iv);
-            result = subghz_keystore_read_file(instance, stream, iv);
+            result = subghz_keystore_read_file(table, stream, iv);
         } else {
             FURI_LOG_E(TAG, "Unknown encryption");
             break;
@@ -240,9 +367,183 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
 
     furi_string_free(filetype);
 
+    // Table is immutable from now on
+    SubGhzKeyArray_reserve(table->data, SubGhzKeyArray_size(table->data));
+
     return result;
 }
 
+static void
+    subghz_keystore_get_stat(const char* file_name, uint64_t* size, uint32_t* timestamp) {
+    FileInfo fileinfo = {};
+    *timestamp = 0;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_stat_timestamp(storage, file_name, &fileinfo, timestamp);
+    furi_record_close(RECORD_STORAGE);
+
+    *size = fileinfo.size;
+}
+
+// Must be called with cache mutex taken
+static void subghz_keystore_cache_drop(SubGhzKeystoreTable* table) {
+    SubGhzKeystoreTable** link = &subghz_keystore_cache;
+    while(*link != table) {
+        link = &(*link)->next;
+    }
+    *link = table->next;
+
+    if(table->refs) {
+        // Freed by the last user
+        table->stale = true;
+    } else {
+        subghz_keystore_table_free(table);
+    }
+}
+
+// Must be called with cache mutex taken
+static void subghz_keystore_cache_drop_unused(void) {
+    SubGhzKeystoreTable* table = subghz_keystore_cache;
+    while(table) {
+        SubGhzKeystoreTable* next = table->next;
+        if(table->refs == 0) subghz_keystore_cache_drop(table);
+        table = next;
+    }
+}
+
+// Must be called with cache mutex taken
+static SubGhzKeystoreTable* subghz_keystore_cache_find(const char* file_name) {
+    SubGhzKeystoreTable* table = subghz_keystore_cache;
+    while(table) {
+        if(furi_string_cmp_str(table->file_name, file_name) == 0) break;
+        table = table->next;
+    }
+    return table;
+}
+
+static SubGhzKeystoreTable* subghz_keystore_table_acquire(const char* file_name) {
+    FuriMutex* mutex = subghz_keystore_cache_get_mutex();
+    furi_check(furi_mutex_acquire(mutex, FuriWaitForever) == FuriStatusOk);
+
+    uint64_t size;
+    uint32_t timestamp;
+    subghz_keystore_get_stat(file_name, &size, &timestamp);
+
+    SubGhzKeystoreTable* table = subghz_keystore_cache_find(file_name);
+    if(table && (table->size != size || table->timestamp != timestamp)) {
+        FURI_LOG_D(TAG, "Keystore changed: %s", file_name);
+        subghz_keystore_cache_drop(table);
+        table = NULL;
+    }
+
+    if(!table) {
+        if(memmgr_get_free_heap() < SUBGHZ_KEYSTORE_CACHE_FREE_HEAP) {
+            subghz_keystore_cache_drop_unused();
+        }
+
+        table = subghz_keystore_table_alloc(file_name);
+        table->size = size;
+        table->timestamp = timestamp;
+        if(subghz_keystore_table_load(table)) {
+            table->next = subghz_keystore_cache;
+            subghz_keystore_cache = table;
+        } else {
+            subghz_keystore_table_free(table);
+            table = NULL;
+        }
+    }
+
+    if(table) table->refs++;
+
+    furi_check(furi_mutex_release(mutex) == FuriStatusOk);
+
+    return table;
+}
+
+static void subghz_keystore_table_release(SubGhzKeystoreTable* table) {
+    FuriMutex* mutex = subghz_keystore_cache_get_mutex();
+    furi_check(furi_mutex_acquire(mutex, FuriWaitForever) == FuriStatusOk);
+
+    furi_check(table->refs > 0);
+    table->refs--;
+
+    if(table->refs == 0) {
+        if(table->stale) {
+            subghz_keystore_table_free(table);
+        } else if(memmgr_get_free_heap() < SUBGHZ_KEYSTORE_CACHE_FREE_HEAP) {
+            subghz_keystore_cache_drop(table);
+        }
+    }
+
+    furi_check(furi_mutex_release(mutex) == FuriStatusOk);
+}
+
+static void subghz_keystore_cache_invalidate(const char* file_name) {
+    FuriMutex* mutex = subghz_keystore_cache_get_mutex();
+    furi_check(furi_mutex_acquire(mutex, FuriWaitForever) == FuriStatusOk);
+
+    SubGhzKeystoreTable* table = subghz_keystore_cache_find(file_name);
+    if(table) subghz_keystore_cache_drop(table);
+
+    furi_check(furi_mutex_release(mutex) == FuriStatusOk);
+}
+
+void subghz_keystore_cache_trim(void) {
+    FuriMutex* mutex = subghz_keystore_cache_get_mutex();
+    furi_check(furi_mutex_acquire(mutex, FuriWaitForever) == FuriStatusOk);
+
+    subghz_keystore_cache_drop_unused();
+
+    furi_check(furi_mutex_release(mutex) == FuriStatusOk);
+}
+
+SubGhzKeystore* subghz_keystore_alloc(void) {
+    SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
+
+    SubGhzKeyArray_init(instance->data);
+
+    return instance;
+}
+
+void subghz_keystore_free(SubGhzKeystore* instance) {
+    furi_assert(instance);
+
+    // Keys and names belong to shared tables
+    SubGhzKeyArray_clear(instance->data);
+    for(size_t i = 0; i < instance->table_count; i++) {
+        subghz_keystore_table_release(instance->tables[i]);
+    }
+
+    free(instance);
+}
+
+bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
+    furi_assert(instance);
+
+    if(instance->table_count == SUBGHZ_KEYSTORE_TABLES_MAX) {
+        FURI_LOG_E(TAG, "Too many keystore files");
+        return false;
+    }
+
+    SubGhzKeystoreTable* table = subghz_keystore_table_acquire(file_name);
+    if(!table) return false;
+
+    instance->tables[instance->table_count++] = table;
+
+    // Single table is used directly, several are merged into own array
+    if(instance->table_count > 1) {
+        SubGhzKeyArray_reset(instance->data);
+        for(size_t i = 0; i < instance->table_count; i++) {
+            for
+                M_EACH(manufacture_code, instance->tables[i]->data, SubGhzKeyArray_t) {
+                    SubGhzKeyArray_push_back(instance->data, *manufacture_code);
+                }
+        }
+    }
+
+    return true;
+}
+
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8_t* iv) {
     furi_assert(instance);
     bool result = false;
@@ -280,9 +581,10 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
         }
 
         Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        SubGhzKeyArray_t* data = subghz_keystore_get_data(instance);
         size_t encrypted_line_count = 0;
         for
-            M_EACH(key, instance->data, SubGhzKeyArray_t) {
+            M_EACH(key, *data, SubGhzKeyArray_t) {
                 // Wipe buffer before packing
                 memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
                 memset(encrypted_line, 0, SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE);
@@ -294,7 +596,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
                     (uint32_t)(key->key >> 32),
                     (uint32_t)key->key,
                     key->type,
-                    furi_string_get_cstr(key->name));
+                    key->name);
                 // Verify length and align
                 furi_assert(len > 0);
                 if(len % 16 != 0) {
@@ -321,7 +623,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
                 encrypted_line_count++;
             }
         furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
-        size_t total_keys = SubGhzKeyArray_size(instance->data);
+        size_t total_keys = SubGhzKeyArray_size(*data);
         result = encrypted_line_count == total_keys;
         if(result) {
             FURI_LOG_I(TAG, "Success. Encrypted: %zu of %zu", encrypted_line_count, total_keys);
@@ -331,6 +633,9 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
     } while(0);
     flipper_format_free(flipper_format);
 
+    // Shared table of this file, if any, is outdated now
+    subghz_keystore_cache_invalidate(file_name);
+
     free(encrypted_line);
     free(decrypted_line);
     furi_record_close(RECORD_STORAGE);
@@ -340,6 +645,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
 
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     furi_assert(instance);
+    if(instance->table_count == 1) return &instance->tables[0]->data;
     return &instance->data;
 }
 
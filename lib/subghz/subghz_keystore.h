@@ -9,7 +9,7 @@ extern "C" {
 #endif
 
 typedef struct {
-    FuriString* name;
+    const char* name;
     uint64_t key;
     uint16_t type;
 } SubGhzKey;
@@ -18,6 +18,15 @@ ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST) //-V658
 
 #define M_OPL_SubGhzKeyArray_t() ARRAY_OPLIST(SubGhzKeyArray, M_POD_OPLIST)
 
+/**
+ * Keystore is a view on shared key tables.
+ *
+ * Every keystore file is decrypted once into an immutable table that stays
+ * resident and is shared by all keystores that load the same file. Table is
+ * reloaded if size or modification time of that file changes, or after it is
+ * written by subghz_keystore_save. Tables that are not used by any
+ * keystore are freed when free heap runs low or on subghz_keystore_cache_trim.
+ */
 typedef struct SubGhzKeystore SubGhzKeystore;
 
 /**
@@ -34,6 +43,7 @@ void subghz_keystore_free(SubGhzKeystore* instance);
 
 /** 
  * Loading manufacture key from file
+ * Uses shared table if the file was already loaded.
  * @param instance Pointer to a SubGhzKeystore instance
  * @param filename Full path to the file
  */
@@ -49,11 +59,17 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_
 
 /** 
  * Get array of keys and names manufacture
+ * Array and names are shared, they must not be modified.
  * @param instance Pointer to a SubGhzKeystore instance
  * @return SubGhzKeyArray_t*
  */
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
 
+/** 
+ * Free shared key tables that are not used by any keystore
+ */
+void subghz_keystore_cache_trim(void);
+
 /** 
  * Save RAW encrypted to file
  * @param input_file_name Full path to the input file
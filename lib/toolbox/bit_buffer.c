@@ -4,6 +4,12 @@
 
 #define BITS_IN_BYTE (8)
 
+// Buffer, data and parity share one allocation, which comes from a pool if it fits a size class
+#define BIT_BUFFER_SIZE_CLASS_COUNT  (5U)
+#define BIT_BUFFER_SIZE_CLASS_MIN    (32U)
+#define BIT_BUFFER_POOL_CACHE_LIMIT  (4U)
+#define BIT_BUFFER_PARITY_SIZE(size) (((size) + BITS_IN_BYTE - 1) / BITS_IN_BYTE)
+
 struct BitBuffer {
     uint8_t* data;
     uint8_t* parity;
@@ -11,14 +17,44 @@ struct BitBuffer {
     size_t size_bits;
 };
 
+static const char* const bit_buffer_pool_names[BIT_BUFFER_SIZE_CLASS_COUNT] = {
+    "BitBuffer32",
+    "BitBuffer64",
+    "BitBuffer128",
+    "BitBuffer256",
+    "BitBuffer512",
+};
+
+static FuriObjectPool* bit_buffer_pools[BIT_BUFFER_SIZE_CLASS_COUNT] = {};
+
+static size_t bit_buffer_get_alloc_size(size_t capacity_bytes) {
+    return sizeof(BitBuffer) + capacity_bytes + BIT_BUFFER_PARITY_SIZE(capacity_bytes);
+}
+
+static FuriObjectPool* bit_buffer_get_pool(size_t capacity_bytes) {
+    size_t class_capacity = BIT_BUFFER_SIZE_CLASS_MIN;
+    for(size_t i = 0; i < BIT_BUFFER_SIZE_CLASS_COUNT; i++, class_capacity *= 2) {
+        if(capacity_bytes <= class_capacity) {
+            return furi_object_pool_alloc_once(
+                &bit_buffer_pools[i],
+                bit_buffer_pool_names[i],
+                bit_buffer_get_alloc_size(class_capacity),
+                BIT_BUFFER_POOL_CACHE_LIMIT);
+        }
+    }
+
+    return NULL;
+}
+
 BitBuffer* bit_buffer_alloc(size_t capacity_bytes) {
     furi_check(capacity_bytes);
 
-    BitBuffer* buf = malloc(sizeof(BitBuffer));
+    FuriObjectPool* pool = bit_buffer_get_pool(capacity_bytes);
+    BitBuffer* buf = pool ? furi_object_pool_get(pool) :
+                            malloc(bit_buffer_get_alloc_size(capacity_bytes));
 
-    buf->data = malloc(capacity_bytes);
-    size_t parity_buf_size = (capacity_bytes + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
-    buf->parity = malloc(parity_buf_size);
+    buf->data = (uint8_t*)buf + sizeof(BitBuffer);
+    buf->parity = buf->data + capacity_bytes;
     buf->capacity_bytes = capacity_bytes;
     buf->size_bits = 0;
 
@@ -28,17 +64,19 @@ BitBuffer* bit_buffer_alloc(size_t capacity_bytes) {
 void bit_buffer_free(BitBuffer* buf) {
     furi_check(buf);
 
-    free(buf->data);
-    free(buf->parity);
-    free(buf);
+    FuriObjectPool* pool = bit_buffer_get_pool(buf->capacity_bytes);
+    if(pool) {
+        furi_object_pool_put(pool, buf);
+    } else {
+        free(buf);
+    }
 }
 
 void bit_buffer_reset(BitBuffer* buf) {
     furi_check(buf);
 
     memset(buf->data, 0, buf->capacity_bytes);
-    size_t parity_buf_size = (buf->capacity_bytes + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
-    memset(buf->parity, 0, parity_buf_size);
+    memset(buf->parity, 0, BIT_BUFFER_PARITY_SIZE(buf->capacity_bytes));
     buf->size_bits = 0;
 }
 
@@ -1,10 +1,14 @@
 #include "dir_walk.h"
 #include <m-list.h>
 
+// Directories that don't fit are read again on every window move, see storage_dir_snapshot_load
+#define DIR_WALK_SNAPSHOT_SIZE (2 * 1024)
+
 LIST_DEF(DirIndexList, uint32_t);
 
 struct DirWalk {
-    File* file;
+    StorageDirSnapshot* snapshot;
+    FS_Error error;
     FuriString* path;
     DirIndexList_t index_list;
     uint32_t current_index;
@@ -18,7 +22,7 @@ DirWalk* dir_walk_alloc(Storage* storage) {
 
     DirWalk* dir_walk = malloc(sizeof(DirWalk));
     dir_walk->path = furi_string_alloc();
-    dir_walk->file = storage_file_alloc(storage);
+    dir_walk->snapshot = storage_dir_snapshot_alloc(storage, DIR_WALK_SNAPSHOT_SIZE);
     DirIndexList_init(dir_walk->index_list);
     dir_walk->recursive = true;
     dir_walk->filter_cb = NULL;
@@ -28,7 +32,7 @@ DirWalk* dir_walk_alloc(Storage* storage) {
 void dir_walk_free(DirWalk* dir_walk) {
     furi_check(dir_walk);
 
-    storage_file_free(dir_walk->file);
+    storage_dir_snapshot_free(dir_walk->snapshot);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
     free(dir_walk);
@@ -49,7 +53,8 @@ bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_check(dir_walk);
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
-    return storage_dir_open(dir_walk->file, path);
+    dir_walk->error = storage_dir_snapshot_load(dir_walk->snapshot, path, NULL, 0);
+    return dir_walk->error == FSE_OK;
 }
 
 static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* fileinfo) {
@@ -63,14 +68,16 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     DirWalkResult result = DirWalkError;
-    char* name = malloc(256); // FIXME: remove magic number
+    const char* name;
     FileInfo info;
     bool end = false;
 
     while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, 255);
-
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
+        if(dir_walk->error != FSE_OK) {
+            result = DirWalkError;
+            end = true;
+        } else if(storage_dir_snapshot_get(
+                      dir_walk->snapshot, dir_walk->current_index, &info, &name)) {
             result = DirWalkOK;
             dir_walk->current_index++;
 
@@ -94,60 +101,39 @@ static DirWalkResult
                 // step into
                 DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
                 dir_walk->current_index = 0;
-                storage_dir_close(dir_walk->file);
 
                 furi_string_cat_printf(dir_walk->path, "/%s", name);
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                dir_walk->error = storage_dir_snapshot_load(
+                    dir_walk->snapshot, furi_string_get_cstr(dir_walk->path), NULL, 0);
             }
-        } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
-            if(DirIndexList_size(dir_walk->index_list) == 0) {
-                // last
-                result = DirWalkLast;
-                end = true;
-            } else {
-                // step out
-                uint32_t index;
-                DirIndexList_pop_back(&index, dir_walk->index_list);
-                dir_walk->current_index = 0;
-
-                storage_dir_close(dir_walk->file);
-
-                size_t last_char = furi_string_search_rchar(dir_walk->path, '/');
-                if(last_char != FURI_STRING_FAILURE) {
-                    furi_string_left(dir_walk->path, last_char);
-                }
-
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
-
-                // rewind
-                while(true) {
-                    if(index == dir_walk->current_index) {
-                        result = DirWalkOK;
-                        break;
-                    }
-
-                    if(!storage_dir_read(dir_walk->file, &info, name, 255)) {
-                        result = DirWalkError;
-                        end = true;
-                        break;
-                    }
+        } else if(storage_dir_snapshot_get_error(dir_walk->snapshot) != FSE_OK) {
+            // window reload failed, not the end of directory
+            dir_walk->error = storage_dir_snapshot_get_error(dir_walk->snapshot);
+        } else if(DirIndexList_size(dir_walk->index_list) == 0) {
+            // last
+            result = DirWalkLast;
+            end = true;
+        } else {
+            // step out, snapshot continues right from the saved index
+            DirIndexList_pop_back(&dir_walk->current_index, dir_walk->index_list);
 
-                    dir_walk->current_index++;
-                }
+            size_t last_char = furi_string_search_rchar(dir_walk->path, '/');
+            if(last_char != FURI_STRING_FAILURE) {
+                furi_string_left(dir_walk->path, last_char);
             }
-        } else {
-            result = DirWalkError;
-            end = true;
+
+            dir_walk->error = storage_dir_snapshot_load(
+                dir_walk->snapshot, furi_string_get_cstr(dir_walk->path), NULL, 0);
+            result = DirWalkOK;
         }
     }
 
-    free(name);
     return result;
 }
 
 FS_Error dir_walk_get_error(DirWalk* dir_walk) {
     furi_check(dir_walk);
-    return storage_file_get_error(dir_walk->file);
+    return dir_walk->error;
 }
 
 DirWalkResult dir_walk_read(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
@@ -157,11 +143,8 @@ DirWalkResult dir_walk_read(DirWalk* dir_walk, FuriString* return_path, FileInfo
 
 void dir_walk_close(DirWalk* dir_walk) {
     furi_check(dir_walk);
-    if(storage_file_is_open(dir_walk->file)) {
-        storage_dir_close(dir_walk->file);
-    }
-
     DirIndexList_reset(dir_walk->index_list);
     furi_string_reset(dir_walk->path);
     dir_walk->current_index = 0;
+    dir_walk->error = FSE_OK;
 }
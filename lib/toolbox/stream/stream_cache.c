@@ -1,6 +1,8 @@
 #include "stream_cache.h"
 
 #define STREAM_CACHE_MAX_SIZE 1024U
+// One is enough for open-parse-close cycle of FlipperFormat files
+#define STREAM_CACHE_POOL_CACHE_LIMIT 1U
 
 struct StreamCache {
     uint8_t data[STREAM_CACHE_MAX_SIZE];
@@ -8,8 +10,12 @@ struct StreamCache {
     size_t position;
 };
 
+static FuriObjectPool* stream_cache_pool = NULL;
+
 StreamCache* stream_cache_alloc(void) {
-    StreamCache* cache = malloc(sizeof(StreamCache));
+    FuriObjectPool* pool = furi_object_pool_alloc_once(
+        &stream_cache_pool, "StreamCache", sizeof(StreamCache), STREAM_CACHE_POOL_CACHE_LIMIT);
+    StreamCache* cache = furi_object_pool_get(pool);
     cache->data_size = 0;
     cache->position = 0;
     return cache;
@@ -18,7 +24,7 @@ void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
     cache->data_size = 0;
     cache->position = 0;
-    free(cache);
+    furi_object_pool_put(stream_cache_pool, cache);
 }
 
 void stream_cache_drop(StreamCache* cache) {
@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+
+"""Analyze `heap map` and `heap sample` CLI output.
+
+`map` renders heap fragmentation map and lists top allocators by thread and
+by call site. Call sites are only recorded by firmware built with
+`./fbt HEAP_TRACE=1`, pass firmware ELF to resolve them to functions.
+`samples` converts periodic heap samples to CSV.
+"""
+
+import argparse
+import logging
+import subprocess
+import sys
+from collections import defaultdict
+
+from flipper.utils.cdc import resolve_port
+
+MAP_COLUMNS = 64
+# Free blocks smaller than that are too small for most allocations
+SMALL_FREE_BLOCK = 256
+
+
+def capture(logger, port_name, command, end_marker):
+    from serial import Serial
+
+    if not (port_name := resolve_port(logger, port_name)):
+        logger.error("Is Flipper connected via USB and not in DFU mode?")
+        return None
+
+    port = Serial(port_name, 230400)
+    port.timeout = 5
+
+    port.read_until(b">: ")
+    port.write(command.encode() + b"\r")
+    data = port.read_until(end_marker.encode())
+    port.read_until(b">: ")
+    port.close()
+
+    return data.decode("utf-8", errors="replace")
+
+
+class HeapMap:
+    def __init__(self):
+        self.total = 0
+        self.free = 0
+        self.owner_trace = False
+        self.tasks = {}
+        # [(address, size, allocated, owner, caller)]
+        self.blocks = []
+
+    def parse(self, text):
+        started = False
+        for line in text.splitlines():
+            line = line.strip()
+            if not line:
+                continue
+
+            fields = line.split(" ")
+            if fields[0] == "heap" and len(fields) == 5 and fields[1] == "begin":
+                self.total = int(fields[2])
+                self.free = int(fields[3])
+                self.owner_trace = fields[4] == "1"
+                started = True
+            elif not started:
+                continue
+            elif line == "heap end":
+                break
+            elif fields[0] == "task":
+                self.tasks[int(fields[1], 16)] = " ".join(fields[2:])
+            elif len(fields) == 5:
+                self.blocks.append(
+                    (
+                        int(fields[0], 16),
+                        int(fields[1]),
+                        fields[2] == "A",
+                        int(fields[3], 16),
+                        int(fields[4], 16),
+                    )
+                )
+
+        if not started:
+            raise ValueError("No `heap begin` found")
+
+    def owner_name(self, owner):
+        if not owner:
+            return "unknown"
+        return self.tasks.get(owner, f"0x{owner:08x} (exited)")
+
+
+def render_map(heap, cell_size):
+    if not heap.blocks:
+        return []
+
+    start = heap.blocks[0][0]
+    end = heap.blocks[-1][0] + heap.blocks[-1][1]
+    cells = [[0, 0] for _ in range((end - start + cell_size - 1) // cell_size)]
+
+    # Count allocated and free bytes falling into every cell
+    for address, size, allocated, _, _ in heap.blocks:
+        offset = address - start
+        while size > 0:
+            cell = offset // cell_size
+            chunk = min(size, cell_size - offset % cell_size)
+            cells[cell][0 if allocated else 1] += chunk
+            offset += chunk
+            size -= chunk
+
+    lines = []
+    for row in range(0, len(cells), MAP_COLUMNS):
+        chars = []
+        for used, free in cells[row : row + MAP_COLUMNS]:
+            if not free:
+                chars.append("#")
+            elif not used:
+                chars.append(".")
+            else:
+                chars.append("+")
+        lines.append(f"{start + row * cell_size:08x} {''.join(chars)}")
+    return lines
+
+
+def resolve_callers(elf, callers):
+    if not elf or not callers:
+        return {}
+
+    # Return address points after the call, Thumb bit is set
+    addresses = [f"0x{(caller & ~1) - 2:08x}" for caller in callers]
+    try:
+        output = subprocess.run(
+            ["arm-none-eabi-addr2line", "-f", "-s", "-e", elf, *addresses],
+            capture_output=True,
+            text=True,
+            check=True,
+        ).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError) as e:
+        logging.getLogger().warning(f"Call sites not resolved: {e}")
+        return {}
+
+    return {
+        caller: f"{output[i * 2]} ({output[i * 2 + 1]})"
+        for i, caller in enumerate(callers)
+    }
+
+
+def print_top(title, totals, names, count):
+    print(f"\n{title}:")
+    top = sorted(totals.items(), key=lambda item: item[1][0], reverse=True)
+    for key, (size, blocks) in top[:count]:
+        print(f"  {size:8} bytes {blocks:6} blocks  {names(key)}")
+
+
+def analyze_map(heap, args):
+    free_blocks = [size for _, size, allocated, _, _ in heap.blocks if not allocated]
+    free = sum(free_blocks)
+    max_free = max(free_blocks, default=0)
+    small_free = sum(size for size in free_blocks if size < SMALL_FREE_BLOCK)
+
+    print(f"Heap: total {heap.total}, free {free}, max free block {max_free}")
+    print(
+        f"Blocks: {len(heap.blocks) - len(free_blocks)} allocated, "
+        f"{len(free_blocks)} free"
+    )
+    if free:
+        print(f"Fragmentation: {100 * (1 - max_free / free):.1f}%")
+        print(
+            f"Free bytes in blocks under {SMALL_FREE_BLOCK} bytes: {small_free} "
+            f"({100 * small_free / free:.1f}%)"
+        )
+
+    print(f"\nMap, {args.cell} bytes per cell: # allocated, . free, + mixed")
+    for line in render_map(heap, args.cell):
+        print(line)
+
+    by_owner = defaultdict(lambda: [0, 0])
+    by_caller = defaultdict(lambda: [0, 0])
+    for _, size, allocated, owner, caller in heap.blocks:
+        if not allocated:
+            continue
+        by_owner[owner][0] += size
+        by_owner[owner][1] += 1
+        if caller:
+            by_caller[caller][0] += size
+            by_caller[caller][1] += 1
+
+    print_top("Top allocators by thread", by_owner, heap.owner_name, args.top)
+
+    if heap.owner_trace:
+        sites = resolve_callers(args.elf, list(by_caller.keys()))
+        print_top(
+            "Top allocators by call site",
+            by_caller,
+            lambda caller: sites.get(caller, f"0x{caller:08x}"),
+            args.top,
+        )
+    else:
+        print("\nCall sites are not recorded, rebuild firmware with HEAP_TRACE=1")
+
+
+def parse_samples(text):
+    tick_hz = 0
+    samples = []
+    started = False
+    for line in text.splitlines():
+        fields = line.strip().split(" ")
+        if fields[:2] == ["samples", "begin"] and len(fields) == 3:
+            tick_hz = int(fields[2])
+            started = True
+        elif not started:
+            continue
+        elif fields[:2] == ["samples", "end"]:
+            break
+        elif len(fields) == 5:
+            samples.append(tuple(int(field) for field in fields))
+
+    if not started:
+        raise ValueError("No `samples begin` found")
+    return tick_hz, samples
+
+
+def write_samples(tick_hz, samples, output):
+    with open(output, "w") as f:
+        f.write("time_s,free,max_free_block,free_blocks,allocated_blocks\n")
+        for tick, *values in samples:
+            f.write(f"{tick / tick_hz:.3f},{','.join(str(v) for v in values)}\n")
+
+
+def read_input(logger, args, command, end_marker):
+    if args.port:
+        return capture(logger, args.port, command, end_marker)
+    if args.input:
+        with open(args.input, "r") as f:
+            return f.read()
+    logger.error("Either input file or --port is required")
+    return None
+
+
+def main():
+    logging.basicConfig(level=logging.INFO)
+    logger = logging.getLogger()
+    parser = argparse.ArgumentParser(description=__doc__)
+    subparsers = parser.add_subparsers(dest="mode", required=True)
+
+    map_parser = subparsers.add_parser("map", help="Analyze `heap map` output")
+    map_parser.add_argument("input", nargs="?", help="`heap map` output file")
+    map_parser.add_argument("--elf", help="Firmware ELF to resolve call sites")
+    map_parser.add_argument("--cell", type=int, default=256, help="Bytes per map cell")
+    map_parser.add_argument(
+        "--top", type=int, default=10, help="Number of top allocators to show"
+    )
+
+    samples_parser = subparsers.add_parser(
+        "samples", help="Convert `heap sample` output to CSV"
+    )
+    samples_parser.add_argument("input", nargs="?", help="`heap sample` output file")
+    samples_parser.add_argument(
+        "-o", "--output", help="Output CSV file", default="heap_samples.csv"
+    )
+
+    for subparser in (map_parser, samples_parser):
+        subparser.add_argument(
+            "-p", "--port", help="Capture output from CDC port ('auto' to detect)"
+        )
+
+    args = parser.parse_args()
+
+    try:
+        if args.mode == "map":
+            if (text := read_input(logger, args, "heap map", "heap end")) is None:
+                return 1
+            heap = HeapMap()
+            heap.parse(text)
+            analyze_map(heap, args)
+        else:
+            text = read_input(logger, args, "heap sample", "samples end")
+            if text is None:
+                return 1
+            tick_hz, samples = parse_samples(text)
+            write_samples(tick_hz, samples, args.output)
+            logger.info(f"{len(samples)} samples: {args.output}")
+    except ValueError as e:
+        logger.error(e)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
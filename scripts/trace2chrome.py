@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+
+"""Convert `trace dump` CLI output to Chrome trace JSON.
+
+Open the result in https://ui.perfetto.dev or chrome://tracing.
+Firmware must be built with `./fbt TRACE=1`.
+"""
+
+import argparse
+import json
+import logging
+import sys
+
+from flipper.utils.cdc import resolve_port
+
+# Must match FuriTraceEventType
+EVENT_BEGIN = 0
+EVENT_END = 1
+EVENT_COUNTER = 2
+EVENT_INSTANT = 3
+
+PID_SCHEDULER = 1
+PID_THREADS = 2
+TID_SYSTEM = 0
+
+
+def capture(logger, port_name):
+    from serial import Serial
+
+    if not (port_name := resolve_port(logger, port_name)):
+        logger.error("Is Flipper connected via USB and not in DFU mode?")
+        return None
+
+    port = Serial(port_name, 230400)
+    port.timeout = 5
+
+    port.read_until(b">: ")
+    port.write(b"trace dump\r")
+    data = port.read_until(b"trace end")
+    port.read_until(b">: ")
+    port.close()
+
+    return data.decode("utf-8", errors="replace")
+
+
+class TraceDump:
+    def __init__(self):
+        self.cpu_hz = 0
+        self.now = 0
+        self.points = {}
+        self.tasks = {}
+        # [(owner, name, [(timestamp, point, type, value)])]
+        self.buffers = []
+
+    def parse(self, text):
+        buffer = None
+        started = False
+        for line in text.splitlines():
+            line = line.strip()
+            if not line:
+                continue
+
+            fields = line.split(" ")
+            if fields[0] == "trace" and len(fields) == 4 and fields[1] == "begin":
+                self.cpu_hz = int(fields[2])
+                self.now = int(fields[3], 16)
+                started = True
+            elif not started:
+                continue
+            elif line == "trace end":
+                break
+            elif fields[0] == "point":
+                self.points[int(fields[1])] = fields[2]
+            elif fields[0] == "task":
+                self.tasks[int(fields[1], 16)] = " ".join(fields[2:])
+            elif fields[0] == "buffer":
+                buffer = (int(fields[1], 16), " ".join(fields[3:]), [])
+                self.buffers.append(buffer)
+            elif buffer is not None and len(fields) == 4:
+                buffer[2].append(
+                    (
+                        int(fields[0], 16),
+                        int(fields[1]),
+                        int(fields[2]),
+                        int(fields[3], 16),
+                    )
+                )
+
+        if not started:
+            raise ValueError("No `trace begin` found")
+
+    def age_us(self, timestamp):
+        # Cycle counter wraps, events are only meaningful relative to the dump
+        return ((self.now - timestamp) & 0xFFFFFFFF) * 1000000 / self.cpu_hz
+
+
+def convert(dump):
+    events = []
+    oldest = 0.0
+    for _, _, records in dump.buffers:
+        for record in records:
+            oldest = max(oldest, dump.age_us(record[0]))
+
+    def ts(timestamp):
+        return oldest - dump.age_us(timestamp)
+
+    events.append(
+        {
+            "ph": "M",
+            "name": "process_name",
+            "pid": PID_SCHEDULER,
+            "args": {"name": "scheduler"},
+        }
+    )
+    events.append(
+        {
+            "ph": "M",
+            "name": "process_name",
+            "pid": PID_THREADS,
+            "args": {"name": "threads"},
+        }
+    )
+
+    for owner, name, records in dump.buffers:
+        tid = owner if owner else TID_SYSTEM
+        events.append(
+            {
+                "ph": "M",
+                "name": "thread_name",
+                "pid": PID_THREADS,
+                "tid": tid,
+                "args": {"name": name or "system"},
+            }
+        )
+
+        for timestamp, point, kind, value in records:
+            point_name = dump.points.get(point, f"point{point}")
+
+            if point_name == "thread_run":
+                # Scheduler hooks: one lane showing which task owns the CPU
+                task_name = dump.tasks.get(value, f"0x{value:08x}")
+                events.append(
+                    {
+                        "ph": "B" if kind == EVENT_BEGIN else "E",
+                        "name": task_name,
+                        "pid": PID_SCHEDULER,
+                        "tid": 0,
+                        "ts": ts(timestamp),
+                    }
+                )
+            elif kind in (EVENT_BEGIN, EVENT_END):
+                events.append(
+                    {
+                        "ph": "B" if kind == EVENT_BEGIN else "E",
+                        "name": point_name,
+                        "pid": PID_THREADS,
+                        "tid": tid,
+                        "ts": ts(timestamp),
+                        "args": {"value": f"0x{value:08x}"},
+                    }
+                )
+            elif kind == EVENT_COUNTER:
+                events.append(
+                    {
+                        "ph": "C",
+                        "name": point_name,
+                        "pid": PID_THREADS,
+                        "ts": ts(timestamp),
+                        "args": {"value": value},
+                    }
+                )
+            elif kind == EVENT_INSTANT:
+                events.append(
+                    {
+                        "ph": "i",
+                        "s": "t",
+                        "name": point_name,
+                        "pid": PID_THREADS,
+                        "tid": tid,
+                        "ts": ts(timestamp),
+                        "args": {"value": f"0x{value:08x}"},
+                    }
+                )
+
+    events.sort(key=lambda event: event.get("ts", -1))
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    logging.basicConfig(level=logging.INFO)
+    logger = logging.getLogger()
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("input", nargs="?", help="`trace dump` output file")
+    parser.add_argument(
+        "-p", "--port", help="Capture dump from CDC port ('auto' to detect)"
+    )
+    parser.add_argument(
+        "-o", "--output", help="Output JSON file", default="trace.json"
+    )
+    args = parser.parse_args()
+
+    if args.port:
+        text = capture(logger, args.port)
+        if text is None:
+            return 1
+    elif args.input:
+        with open(args.input, "r") as f:
+            text = f.read()
+    else:
+        parser.error("either input file or --port is required")
+
+    dump = TraceDump()
+    try:
+        dump.parse(text)
+    except ValueError as e:
+        logger.error(e)
+        return 1
+
+    with open(args.output, "w") as f:
+        json.dump(convert(dump), f)
+
+    total = sum(len(records) for _, _, records in dump.buffers)
+    logger.info(f"{total} events from {len(dump.buffers)} buffers: {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
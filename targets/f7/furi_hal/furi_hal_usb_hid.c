@@ -278,7 +278,7 @@ void furi_hal_hid_set_state_callback(HidStateCallback cb, void* ctx) {
     }
 }
 
-bool furi_hal_hid_kb_press(uint16_t button) {
+static void hid_kb_set_pressed(uint16_t button) {
     for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
         if(hid_report.keyboard.boot.btn[key_nb] == 0) {
             hid_report.keyboard.boot.btn[key_nb] = button & 0xFF;
@@ -286,10 +286,9 @@ bool furi_hal_hid_kb_press(uint16_t button) {
         }
     }
     hid_report.keyboard.boot.mods |= (button >> 8);
-    return hid_send_report(ReportIdKeyboard);
 }
 
-bool furi_hal_hid_kb_release(uint16_t button) {
+static void hid_kb_set_released(uint16_t button) {
     for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
         if(hid_report.keyboard.boot.btn[key_nb] == (button & 0xFF)) {
             hid_report.keyboard.boot.btn[key_nb] = 0;
@@ -297,6 +296,31 @@ bool furi_hal_hid_kb_release(uint16_t button) {
         }
     }
     hid_report.keyboard.boot.mods &= ~(button >> 8);
+}
+
+bool furi_hal_hid_kb_press(uint16_t button) {
+    hid_kb_set_pressed(button);
+    return hid_send_report(ReportIdKeyboard);
+}
+
+bool furi_hal_hid_kb_press_multiple(const uint16_t* buttons, size_t count) {
+    furi_check(buttons);
+    for(size_t i = 0; i < count; i++) {
+        hid_kb_set_pressed(buttons[i]);
+    }
+    return hid_send_report(ReportIdKeyboard);
+}
+
+bool furi_hal_hid_kb_release(uint16_t button) {
+    hid_kb_set_released(button);
+    return hid_send_report(ReportIdKeyboard);
+}
+
+bool furi_hal_hid_kb_release_multiple(const uint16_t* buttons, size_t count) {
+    furi_check(buttons);
+    for(size_t i = 0; i < count; i++) {
+        hid_kb_set_released(buttons[i]);
+    }
     return hid_send_report(ReportIdKeyboard);
 }
 
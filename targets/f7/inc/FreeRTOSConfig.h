@@ -138,14 +138,29 @@ standard names. */
 #define vPortSVCHandler    SVC_Handler
 #define xPortPendSVHandler PendSV_Handler
 
+#ifdef FURI_TRACE
+#define traceTASK_SWITCHED_IN_FURI()                     \
+    extern void furi_trace_task_switched_in(void* task); \
+    furi_trace_task_switched_in(pxCurrentTCB);
+#define traceTASK_SWITCHED_OUT_FURI()                     \
+    extern void furi_trace_task_switched_out(void* task); \
+    furi_trace_task_switched_out(pxCurrentTCB);
+#else
+#define traceTASK_SWITCHED_IN_FURI()
+#define traceTASK_SWITCHED_OUT_FURI()
+#endif
+
 #define traceTASK_SWITCHED_IN()                                          \
     extern void furi_hal_mpu_set_stack_protection(uint32_t* stack);      \
     furi_hal_mpu_set_stack_protection((uint32_t*)pxCurrentTCB->pxStack); \
+    traceTASK_SWITCHED_IN_FURI()                                         \
     errno = pxCurrentTCB->iTaskErrno
 //  ^^^^^   acquire errno directly from TCB because FreeRTOS assigns its `FreeRTOS_errno' _after_ our hook is called
 
 // referencing `FreeRTOS_errno' here   vvvvv    because FreeRTOS calls our hook _before_ copying the value into the TCB, hence a manual write to the TCB would get overwritten
-#define traceTASK_SWITCHED_OUT() FreeRTOS_errno = errno
+#define traceTASK_SWITCHED_OUT()  \
+    traceTASK_SWITCHED_OUT_FURI() \
+    FreeRTOS_errno = errno
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
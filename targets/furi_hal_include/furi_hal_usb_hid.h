@@ -222,6 +222,22 @@ bool furi_hal_hid_kb_press(uint16_t button);
  */
 bool furi_hal_hid_kb_release(uint16_t button);
 
+/** Set the following keys to pressed state and send a single HID report
+ *
+ * Keys that do not fit into report are ignored.
+ *
+ * @param      buttons  key codes
+ * @param      count    number of keys
+ */
+bool furi_hal_hid_kb_press_multiple(const uint16_t* buttons, size_t count);
+
+/** Set the following keys to released state and send a single HID report
+ *
+ * @param      buttons  key codes
+ * @param      count    number of keys
+ */
+bool furi_hal_hid_kb_release_multiple(const uint16_t* buttons, size_t count);
+
 /** Clear all pressed keys and send HID report
  *
  */
@@ -0,0 +1,79 @@
+#include <core/check.h>
+#include <core/common_defines.h>
+#include <core/log.h>
+#include <core/memmgr.h>
+
+#include <furi_hal_debug.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+__thread const void* __furi_check_message_host = NULL;
+
+static void __furi_print_name(void) {
+    // Scheduler may not be running yet, name is only valid for tasks
+    const char* name = NULL;
+    if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+        name = pcTaskGetName(NULL);
+    }
+    if(name == NULL) {
+        furi_log_puts("[main] ");
+    } else {
+        furi_log_puts("[");
+        furi_log_puts(name);
+        furi_log_puts("] ");
+    }
+}
+
+static void __furi_print_heap_info(void) {
+    char tmp_str[32];
+    snprintf(tmp_str, sizeof(tmp_str), "%zu", memmgr_get_free_heap());
+    furi_log_puts("\r\n\t      heap free: ");
+    furi_log_puts(tmp_str);
+}
+
+static const char* __furi_check_message_text(const char* fallback) {
+    const void* message = __furi_check_message_host;
+    if(message == NULL) {
+        return fallback;
+    } else if(message == (void*)__FURI_ASSERT_MESSAGE_FLAG) {
+        return "furi_assert failed";
+    } else if(message == (void*)__FURI_CHECK_MESSAGE_FLAG) {
+        return "furi_check failed";
+    }
+    return message;
+}
+
+FURI_NORETURN void __furi_crash_implementation(void) {
+    __disable_irq();
+
+    furi_log_puts("\r\n\033[0;31m[CRASH]");
+    __furi_print_name();
+    furi_log_puts(__furi_check_message_text("Fatal Error"));
+    __furi_print_heap_info();
+    furi_log_puts("\033[0m\r\n");
+    fflush(stdout);
+
+    // Trap into debugger if there is one, otherwise leave core dump for post-mortem
+    if(furi_hal_debug_is_gdb_session_active()) {
+        raise(SIGTRAP);
+    }
+    abort();
+}
+
+FURI_NORETURN void __furi_halt_implementation(void) {
+    __disable_irq();
+
+    furi_log_puts("\r\n\033[0;31m[HALT]");
+    __furi_print_name();
+    furi_log_puts(__furi_check_message_text("System halt requested."));
+    furi_log_puts("\r\nSystem halted. Bye-bye!\r\n");
+    furi_log_puts("\033[0m\r\n");
+    fflush(stdout);
+
+    exit(EXIT_FAILURE);
+}
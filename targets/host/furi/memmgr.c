@@ -0,0 +1,231 @@
+#include <core/memmgr.h>
+#include <core/memmgr_heap.h>
+#include <core/check.h>
+#include <core/core_defines.h>
+#include <core/kernel.h>
+#include <core/thread.h>
+
+#include <FreeRTOS.h>
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Host uses system allocator: sanitizers and valgrind see every allocation,
+ * which is the point of running on host. Heap grows on demand, so free
+ * memory is reported against the nominal configTOTAL_HEAP_SIZE budget. Per
+ * thread accounting is only available to the calling thread: that covers
+ * furi_thread heap trace, which is enabled from inside the thread, and unit
+ * test benchmarks. */
+
+extern void* __real_calloc(size_t count, size_t size);
+extern void* __real_realloc(void* ptr, size_t size);
+extern void __real_free(void* ptr);
+
+static __thread bool memmgr_host_trace_enabled = false;
+static __thread MemmgrHeapThreadStats memmgr_host_trace_stats;
+
+static void memmgr_host_trace_alloc(void* p) {
+    if(!memmgr_host_trace_enabled || !p) return;
+    memmgr_host_trace_stats.current += malloc_usable_size(p);
+    memmgr_host_trace_stats.allocations++;
+    if(memmgr_host_trace_stats.current > memmgr_host_trace_stats.peak) {
+        memmgr_host_trace_stats.peak = memmgr_host_trace_stats.current;
+    }
+}
+
+static void memmgr_host_trace_free(void* p) {
+    if(!memmgr_host_trace_enabled || !p) return;
+    // Block may have been allocated before trace was enabled
+    size_t size = malloc_usable_size(p);
+    memmgr_host_trace_stats.current -= MIN(size, memmgr_host_trace_stats.current);
+}
+
+/* Firmware allocator contract: memory is zeroed and allocation never fails.
+ * Applied to our objects with --wrap, libc internals keep their allocator. */
+
+void* __wrap_malloc(size_t size) {
+    void* p = __real_calloc(1, size ? size : 1);
+    furi_check(p, "out of memory");
+    memmgr_host_trace_alloc(p);
+    return p;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void* p = __real_calloc(count ? count : 1, size ? size : 1);
+    furi_check(p, "out of memory");
+    memmgr_host_trace_alloc(p);
+    return p;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    if(size == 0) {
+        free(ptr);
+        return NULL;
+    }
+
+    memmgr_host_trace_free(ptr);
+    void* p = __real_realloc(ptr, size);
+    furi_check(p, "out of memory");
+    memmgr_host_trace_alloc(p);
+    return p;
+}
+
+void __wrap_free(void* ptr) {
+    memmgr_host_trace_free(ptr);
+    __real_free(ptr);
+}
+
+static size_t memmgr_host_heap_used(void) {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+void* pvPortMalloc(size_t xSize) {
+    return malloc(xSize);
+}
+
+void vPortFree(void* pv) {
+    free(pv);
+}
+
+size_t xPortGetFreeHeapSize(void) {
+    return memmgr_get_free_heap();
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void) {
+    return memmgr_get_minimum_free_heap();
+}
+
+size_t memmgr_get_free_heap(void) {
+    size_t used = memmgr_host_heap_used();
+    return used < configTOTAL_HEAP_SIZE ? configTOTAL_HEAP_SIZE - used : 0;
+}
+
+size_t memmgr_get_total_heap(void) {
+    return configTOTAL_HEAP_SIZE;
+}
+
+size_t memmgr_get_minimum_free_heap(void) {
+    return memmgr_get_free_heap();
+}
+
+void* memmgr_alloc_from_pool(size_t size) {
+    return malloc(size);
+}
+
+size_t memmgr_pool_get_free(void) {
+    return 0;
+}
+
+size_t memmgr_pool_get_max_block(void) {
+    return 0;
+}
+
+void* aligned_malloc(size_t size, size_t alignment) {
+    void* p = NULL;
+    if(alignment < sizeof(void*)) alignment = sizeof(void*);
+    if(posix_memalign(&p, alignment, size) != 0) {
+        return NULL;
+    }
+    memset(p, 0, size);
+    return p;
+}
+
+void aligned_free(void* p) {
+    free(p);
+}
+
+static bool memmgr_host_is_current_thread(FuriThreadId thread_id) {
+    return thread_id && thread_id == furi_thread_get_current_id();
+}
+
+void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
+    if(!memmgr_host_is_current_thread(thread_id)) return;
+    furi_check(!memmgr_host_trace_enabled);
+    memset(&memmgr_host_trace_stats, 0, sizeof(memmgr_host_trace_stats));
+    memmgr_host_trace_enabled = true;
+}
+
+void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
+    if(!memmgr_host_is_current_thread(thread_id)) return;
+    furi_check(memmgr_host_trace_enabled);
+    memmgr_host_trace_enabled = false;
+}
+
+size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
+    if(!memmgr_host_is_current_thread(thread_id) || !memmgr_host_trace_enabled) {
+        return MEMMGR_HEAP_UNKNOWN;
+    }
+    return memmgr_host_trace_stats.current;
+}
+
+bool memmgr_heap_get_thread_stats(FuriThreadId thread_id, MemmgrHeapThreadStats* stats) {
+    furi_check(stats);
+    if(!memmgr_host_is_current_thread(thread_id) || !memmgr_host_trace_enabled) {
+        return false;
+    }
+    *stats = memmgr_host_trace_stats;
+    return true;
+}
+
+void memmgr_heap_reset_thread_stats(FuriThreadId thread_id) {
+    if(!memmgr_host_is_current_thread(thread_id)) return;
+    memmgr_host_trace_stats.peak = memmgr_host_trace_stats.current;
+    memmgr_host_trace_stats.allocations = 0;
+}
+
+void memmgr_heap_trace_attach(void* pointer) {
+    furi_check(pointer);
+    memmgr_host_trace_alloc(pointer);
+}
+
+void memmgr_heap_trace_detach(void* pointer) {
+    furi_check(pointer);
+    // Only blocks of the calling thread can be detached on host
+    memmgr_host_trace_free(pointer);
+}
+
+size_t memmgr_heap_get_max_free_block(void) {
+    return memmgr_get_free_heap();
+}
+
+void memmgr_heap_printf_free_blocks(void) {
+    malloc_stats();
+}
+
+/* System allocator blocks can't be walked, sampling is left to host tools */
+
+bool memmgr_heap_is_owner_trace_available(void) {
+    return false;
+}
+
+size_t memmgr_heap_get_blocks(uint32_t address, MemmgrHeapBlock* blocks, size_t count) {
+    UNUSED(address);
+    UNUSED(count);
+    furi_check(blocks);
+    return 0;
+}
+
+void memmgr_heap_get_sample(MemmgrHeapSample* sample) {
+    furi_check(sample);
+    *sample = (MemmgrHeapSample){
+        .tick = furi_get_tick(),
+        .free = memmgr_get_free_heap(),
+        .max_free_block = memmgr_get_free_heap(),
+    };
+}
+
+void memmgr_heap_sampling_start(uint32_t interval, size_t capacity) {
+    furi_check(interval);
+    furi_check(capacity);
+}
+
+void memmgr_heap_sampling_stop(void) {
+}
+
+bool memmgr_heap_sampling_get(size_t index, MemmgrHeapSample* sample) {
+    UNUSED(index);
+    furi_check(sample);
+    return false;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file furi_hal.h
+ * Furi HAL API, host target
+ *
+ * Subset of the HAL that has meaning on a Linux host: time, RTC registers,
+ * randomness, memory pool and debug. Peripheral APIs are not available.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+template <unsigned int N>
+struct STOP_EXTERNING_ME {};
+#endif
+
+#include <furi_hal_cortex.h>
+#include <furi_hal_debug.h>
+#include <furi_hal_gpio.h>
+#include <furi_hal_interrupt.h>
+#include <furi_hal_memory.h>
+#include <furi_hal_random.h>
+#include <furi_hal_rtc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Early FuriHal init, must be called before furi_init */
+void furi_hal_init_early(void);
+
+/** Early FuriHal deinit */
+void furi_hal_deinit_early(void);
+
+/** Init FuriHal, must be used after `furi_hal_init_early` */
+void furi_hal_init(void);
+
+#ifdef __cplusplus
+}
+#endif
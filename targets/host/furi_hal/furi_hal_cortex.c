@@ -0,0 +1,77 @@
+#include <furi_hal_cortex.h>
+#include <furi.h>
+
+#include <time.h>
+
+// Emulated core clock, keeps cycle based math of target code meaningful
+#define FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND (64U)
+
+__thread uint32_t furi_hal_cortex_host_primask = 0;
+
+static uint64_t furi_hal_cortex_host_epoch_ns;
+
+static uint64_t furi_hal_cortex_host_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t furi_hal_cortex_host_cycles(void) {
+    uint64_t elapsed_ns = furi_hal_cortex_host_now_ns() - furi_hal_cortex_host_epoch_ns;
+    // Wraps like DWT->CYCCNT does
+    return (uint32_t)(elapsed_ns * FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND / 1000U);
+}
+
+void furi_hal_cortex_init_early(void) {
+    furi_hal_cortex_host_epoch_ns = furi_hal_cortex_host_now_ns();
+}
+
+void furi_hal_cortex_delay_us(uint32_t microseconds) {
+    furi_check(microseconds < (UINT32_MAX / FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND));
+
+    uint32_t start = DWT->CYCCNT;
+    uint32_t time_ticks = FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND * microseconds;
+
+    while((DWT->CYCCNT - start) < time_ticks) {
+    };
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void) {
+    return FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND;
+}
+
+FURI_WARN_UNUSED FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
+    furi_check(timeout_us < (UINT32_MAX / FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND));
+
+    FuriHalCortexTimer cortex_timer = {0};
+    cortex_timer.start = DWT->CYCCNT;
+    cortex_timer.value = FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND * timeout_us;
+    return cortex_timer;
+}
+
+bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer) {
+    return !((DWT->CYCCNT - cortex_timer.start) < cortex_timer.value);
+}
+
+void furi_hal_cortex_timer_wait(FuriHalCortexTimer cortex_timer) {
+    while(!furi_hal_cortex_timer_is_expired(cortex_timer))
+        ;
+}
+
+void furi_hal_cortex_comp_enable(
+    FuriHalCortexComp comp,
+    FuriHalCortexCompFunction function,
+    uint32_t value,
+    uint32_t mask,
+    FuriHalCortexCompSize size) {
+    UNUSED(comp);
+    UNUSED(function);
+    UNUSED(value);
+    UNUSED(mask);
+    UNUSED(size);
+    // No watchpoint unit, use debugger watchpoints instead
+}
+
+void furi_hal_cortex_comp_reset(FuriHalCortexComp comp) {
+    UNUSED(comp);
+}
@@ -0,0 +1,27 @@
+#include <furi_hal_debug.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+void furi_hal_debug_enable(void) {
+}
+
+void furi_hal_debug_disable(void) {
+}
+
+bool furi_hal_debug_is_gdb_session_active(void) {
+    // Any ptrace based debugger shows up as tracer of our process.
+    // Plain syscalls: stdio is routed to furi thread stdout on host.
+    char status[1024];
+    int fd = open("/proc/self/status", O_RDONLY | O_CLOEXEC);
+    if(fd < 0) return false;
+    ssize_t size = read(fd, status, sizeof(status) - 1);
+    close(fd);
+    if(size <= 0) return false;
+    status[size] = '\0';
+
+    const char* tracer = strstr(status, "TracerPid:");
+    return tracer && strtoul(tracer + strlen("TracerPid:"), NULL, 10) != 0;
+}
@@ -0,0 +1,17 @@
+#include <furi_hal_gpio.h>
+
+void furi_hal_gpio_init_simple(const GpioPin* gpio, const GpioMode mode) {
+    (void)gpio;
+    (void)mode;
+}
+
+void furi_hal_gpio_init(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed) {
+    (void)gpio;
+    (void)mode;
+    (void)pull;
+    (void)speed;
+}
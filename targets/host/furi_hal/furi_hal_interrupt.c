@@ -0,0 +1,15 @@
+#include <stddef.h>
+
+#include <furi_hal_interrupt.h>
+
+void furi_hal_interrupt_init(void) {
+}
+
+const char* furi_hal_interrupt_get_name(uint8_t exception_number) {
+    (void)exception_number;
+    return NULL;
+}
+
+uint32_t furi_hal_interrupt_get_time_in_isr_total(void) {
+    return 0;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initialize interrupt subsystem */
+void furi_hal_interrupt_init(void);
+
+/** Get interrupt name by exception number
+ *
+ * @param      exception_number  The exception number
+ *
+ * @return     NULL on host, there are no interrupts
+ */
+const char* furi_hal_interrupt_get_name(uint8_t exception_number);
+
+/** Get total time(in CPU clocks) spent in ISR
+ *
+ * @return     always 0 on host
+ */
+uint32_t furi_hal_interrupt_get_time_in_isr_total(void);
+
+#ifdef __cplusplus
+}
+#endif
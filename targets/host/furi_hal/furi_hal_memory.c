@@ -0,0 +1,21 @@
+#include <furi_hal.h>
+#include <furi_hal_memory.h>
+
+/* Host has single flat heap, there is no secondary SRAM pool to hand out:
+ * callers fall back to regular allocation. */
+
+void furi_hal_memory_init(void) {
+}
+
+void* furi_hal_memory_alloc(size_t size) {
+    (void)size;
+    return NULL;
+}
+
+size_t furi_hal_memory_get_free(void) {
+    return 0;
+}
+
+size_t furi_hal_memory_max_pool_block(void) {
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include <furi_hal_random.h>
+#include <furi.h>
+
+#include <sys/random.h>
+
+void furi_hal_random_init(void) {
+}
+
+uint32_t furi_hal_random_get(void) {
+    uint32_t value = 0;
+    furi_hal_random_fill_buf((uint8_t*)&value, sizeof(value));
+    return value;
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    furi_check(buf);
+
+    while(len) {
+        ssize_t ret = getrandom(buf, len, 0);
+        // Only fails when interrupted by signal, POSIX port uses them for ticks
+        if(ret < 0) continue;
+        buf += ret;
+        len -= ret;
+    }
+}
+
+void srand(unsigned seed) {
+    UNUSED(seed);
+}
+
+int rand(void) {
+    return (furi_hal_random_get() & RAND_MAX);
+}
+
+long random(void) {
+    return (furi_hal_random_get() & RAND_MAX);
+}
@@ -0,0 +1,307 @@
+#include <furi_hal_rtc.h>
+#include <furi_hal_debug.h>
+
+#include <furi.h>
+
+#include <string.h>
+#include <time.h>
+
+#define TAG "FuriHalRtc"
+
+#define FURI_HAL_RTC_HEADER_MAGIC   0x10F1
+#define FURI_HAL_RTC_HEADER_VERSION 0
+
+/* Same number of backup registers as STM32WB RTC */
+#define FURI_HAL_RTC_BKP_NUMBER 20
+
+typedef struct {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t unused;
+} FuriHalRtcHeader;
+
+typedef struct {
+    uint8_t log_level    : 4;
+    uint8_t log_reserved : 4;
+    uint8_t flags;
+    FuriHalRtcBootMode boot_mode                 : 4;
+    FuriHalRtcHeapTrackMode heap_track_mode      : 2;
+    FuriHalRtcLocaleUnits locale_units           : 1;
+    FuriHalRtcLocaleTimeFormat locale_timeformat : 1;
+    FuriHalRtcLocaleDateFormat locale_dateformat : 2;
+    FuriHalRtcLogDevice log_device               : 2;
+    FuriHalRtcLogBaudRate log_baud_rate          : 3;
+    uint8_t reserved                             : 1;
+} SystemReg;
+
+_Static_assert(sizeof(SystemReg) == 4, "SystemReg size mismatch");
+
+typedef struct {
+    uint32_t registers[FURI_HAL_RTC_BKP_NUMBER];
+    // Difference between emulated RTC and host wall clock, seconds
+    int64_t offset;
+    DateTime alarm;
+    bool alarm_enabled;
+    FuriHalRtcAlarmCallback alarm_callback;
+    void* alarm_callback_context;
+} FuriHalRtc;
+
+static FuriHalRtc furi_hal_rtc = {};
+
+void furi_hal_rtc_init_early(void) {
+    // Registers do not survive process restart, start from clean state
+    furi_hal_rtc_reset_registers();
+}
+
+void furi_hal_rtc_deinit_early(void) {
+}
+
+void furi_hal_rtc_init(void) {
+    furi_log_set_level(furi_hal_rtc_get_log_level());
+    FURI_LOG_I(TAG, "Init OK");
+}
+
+void furi_hal_rtc_prepare_for_shutdown(void) {
+}
+
+void furi_hal_rtc_sync_shadow(void) {
+}
+
+void furi_hal_rtc_reset_registers(void) {
+    for(size_t i = 0; i < FURI_HAL_RTC_BKP_NUMBER; i++) {
+        furi_hal_rtc_set_register(i, 0);
+    }
+
+    uint32_t data_reg = 0;
+    FuriHalRtcHeader* data = (FuriHalRtcHeader*)&data_reg;
+    data->magic = FURI_HAL_RTC_HEADER_MAGIC;
+    data->version = FURI_HAL_RTC_HEADER_VERSION;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterHeader, data_reg);
+}
+
+uint32_t furi_hal_rtc_get_register(FuriHalRtcRegister reg) {
+    furi_check(reg < FURI_HAL_RTC_BKP_NUMBER);
+    return furi_hal_rtc.registers[reg];
+}
+
+void furi_hal_rtc_set_register(FuriHalRtcRegister reg, uint32_t value) {
+    furi_check(reg < FURI_HAL_RTC_BKP_NUMBER);
+    furi_hal_rtc.registers[reg] = value;
+}
+
+void furi_hal_rtc_set_log_level(uint8_t level) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->log_level = level;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+    furi_log_set_level(level);
+}
+
+uint8_t furi_hal_rtc_get_log_level(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->log_level;
+}
+
+void furi_hal_rtc_set_log_device(FuriHalRtcLogDevice device) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->log_device = device;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+}
+
+FuriHalRtcLogDevice furi_hal_rtc_get_log_device(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->log_device;
+}
+
+void furi_hal_rtc_set_log_baud_rate(FuriHalRtcLogBaudRate baud_rate) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->log_baud_rate = baud_rate;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+}
+
+FuriHalRtcLogBaudRate furi_hal_rtc_get_log_baud_rate(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->log_baud_rate;
+}
+
+void furi_hal_rtc_set_flag(FuriHalRtcFlag flag) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->flags |= flag;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+
+    if(flag & FuriHalRtcFlagDebug) {
+        furi_hal_debug_enable();
+    }
+}
+
+void furi_hal_rtc_reset_flag(FuriHalRtcFlag flag) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->flags &= ~flag;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+
+    if(flag & FuriHalRtcFlagDebug) {
+        furi_hal_debug_disable();
+    }
+}
+
+bool furi_hal_rtc_is_flag_set(FuriHalRtcFlag flag) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->flags & flag;
+}
+
+void furi_hal_rtc_set_boot_mode(FuriHalRtcBootMode mode) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->boot_mode = mode;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+}
+
+FuriHalRtcBootMode furi_hal_rtc_get_boot_mode(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->boot_mode;
+}
+
+void furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackMode mode) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->heap_track_mode = mode;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+}
+
+FuriHalRtcHeapTrackMode furi_hal_rtc_get_heap_track_mode(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->heap_track_mode;
+}
+
+void furi_hal_rtc_set_locale_units(FuriHalRtcLocaleUnits value) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->locale_units = value;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+}
+
+FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->locale_units;
+}
+
+void furi_hal_rtc_set_locale_timeformat(FuriHalRtcLocaleTimeFormat value) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->locale_timeformat = value;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+}
+
+FuriHalRtcLocaleTimeFormat furi_hal_rtc_get_locale_timeformat(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->locale_timeformat;
+}
+
+void furi_hal_rtc_set_locale_dateformat(FuriHalRtcLocaleDateFormat value) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->locale_dateformat = value;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+}
+
+FuriHalRtcLocaleDateFormat furi_hal_rtc_get_locale_dateformat(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->locale_dateformat;
+}
+
+void furi_hal_rtc_set_datetime(DateTime* datetime) {
+    furi_check(datetime);
+
+    int64_t timestamp = datetime_datetime_to_timestamp(datetime);
+    FURI_CRITICAL_ENTER();
+    furi_hal_rtc.offset = timestamp - (int64_t)time(NULL);
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_rtc_get_datetime(DateTime* datetime) {
+    furi_check(datetime);
+
+    FURI_CRITICAL_ENTER();
+    int64_t timestamp = (int64_t)time(NULL) + furi_hal_rtc.offset;
+    FURI_CRITICAL_EXIT();
+
+    datetime_timestamp_to_datetime((uint32_t)timestamp, datetime);
+}
+
+void furi_hal_rtc_set_alarm(const DateTime* datetime, bool enabled) {
+    FURI_CRITICAL_ENTER();
+    if(datetime) {
+        furi_hal_rtc.alarm = *datetime;
+    }
+    furi_hal_rtc.alarm_enabled = enabled;
+    FURI_CRITICAL_EXIT();
+}
+
+bool furi_hal_rtc_get_alarm(DateTime* datetime) {
+    furi_check(datetime);
+
+    memset(datetime, 0, sizeof(DateTime));
+    datetime->hour = furi_hal_rtc.alarm.hour;
+    datetime->minute = furi_hal_rtc.alarm.minute;
+    datetime->second = furi_hal_rtc.alarm.second;
+
+    return furi_hal_rtc.alarm_enabled;
+}
+
+void furi_hal_rtc_set_alarm_callback(FuriHalRtcAlarmCallback callback, void* context) {
+    // Alarm never fires on host, only registration contract is kept
+    FURI_CRITICAL_ENTER();
+    if(callback) {
+        furi_check(!furi_hal_rtc.alarm_callback);
+        furi_hal_rtc.alarm_callback = callback;
+        furi_hal_rtc.alarm_callback_context = context;
+    } else {
+        furi_check(furi_hal_rtc.alarm_callback);
+        furi_hal_rtc.alarm_callback = NULL;
+        furi_hal_rtc.alarm_callback_context = NULL;
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_rtc_set_fault_data(uint32_t value) {
+    furi_hal_rtc_set_register(FuriHalRtcRegisterFaultData, value);
+}
+
+uint32_t furi_hal_rtc_get_fault_data(void) {
+    return furi_hal_rtc_get_register(FuriHalRtcRegisterFaultData);
+}
+
+void furi_hal_rtc_set_pin_fails(uint32_t value) {
+    furi_hal_rtc_set_register(FuriHalRtcRegisterPinFails, value);
+}
+
+uint32_t furi_hal_rtc_get_pin_fails(void) {
+    return furi_hal_rtc_get_register(FuriHalRtcRegisterPinFails);
+}
+
+void furi_hal_rtc_set_pin_value(uint32_t value) {
+    furi_hal_rtc_set_register(FuriHalRtcRegisterPinValue, value);
+}
+
+uint32_t furi_hal_rtc_get_pin_value(void) {
+    return furi_hal_rtc_get_register(FuriHalRtcRegisterPinValue);
+}
+
+uint32_t furi_hal_rtc_get_timestamp(void) {
+    DateTime datetime = {0};
+    furi_hal_rtc_get_datetime(&datetime);
+    return datetime_datetime_to_timestamp(&datetime);
+}
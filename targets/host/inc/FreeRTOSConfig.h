@@ -0,0 +1,107 @@
+#pragma once
+
+/* FreeRTOS configuration for the POSIX (Linux) port.
+ *
+ * Every FreeRTOS task runs on its own pthread, only one of them executes at
+ * a time. Options that change TCB layout mirror targets/f7 so that
+ * task_control_block.h stays valid. */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+
+#define configUSE_PREEMPTION             1
+#define configSUPPORT_STATIC_ALLOCATION  1
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configUSE_MALLOC_FAILED_HOOK     0
+#define configUSE_IDLE_HOOK              0
+#define configUSE_TICK_HOOK              0
+#define configCPU_CLOCK_HZ               (64000000UL)
+#define configTICK_RATE_HZ_RAW           1000
+#define configTICK_RATE_HZ               ((TickType_t)configTICK_RATE_HZ_RAW)
+#define configUSE_16_BIT_TICKS           0
+#define configMAX_PRIORITIES             (32)
+/* errno is per pthread in libc, no switch hooks required */
+#define configUSE_POSIX_ERRNO 1
+
+/* pthread stacks are allocated from FreeRTOS stacks: keep them above PTHREAD_STACK_MIN */
+#define configMINIMAL_STACK_SIZE ((uint16_t)(32 * 1024 / sizeof(StackType_t)))
+
+/* Kernel objects come from libc heap (heap_3), value is informational only */
+#define configTOTAL_HEAP_SIZE   ((size_t)(256 * 1024 * 1024))
+#define configMAX_TASK_NAME_LEN (32)
+
+extern uint32_t furi_hal_cortex_host_cycles(void);
+#define configGENERATE_RUN_TIME_STATS    1
+#define portGET_RUN_TIME_COUNTER_VALUE() (furi_hal_cortex_host_cycles())
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_MUTEXES                       1
+#define configQUEUE_REGISTRY_SIZE               0
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configENABLE_BACKWARD_COMPATIBILITY     0
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_TICKLESS_IDLE                 0
+#define configRECORD_STACK_HIGH_ADDRESS         1
+#define configUSE_NEWLIB_REENTRANT              0
+
+#define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 1
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES 0
+
+/* Software timer definitions. */
+#define configUSE_TIMERS              1
+#define configTIMER_TASK_PRIORITY     (2)
+#define configTIMER_QUEUE_LENGTH      32
+#define configTIMER_TASK_STACK_DEPTH  configMINIMAL_STACK_SIZE
+#define configTIMER_SERVICE_TASK_NAME "TimersSrv"
+
+#define configIDLE_TASK_NAME        "(-_-)"
+#define configIDLE_TASK_STACK_DEPTH configMINIMAL_STACK_SIZE
+
+#define INCLUDE_xTaskGetHandle              1
+#define INCLUDE_eTaskGetState               1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
+#define INCLUDE_uxTaskPriorityGet           1
+#define INCLUDE_vTaskCleanUpResources       0
+#define INCLUDE_vTaskDelay                  1
+#define INCLUDE_vTaskDelayUntil             1
+#define INCLUDE_vTaskDelete                 1
+#define INCLUDE_vTaskPrioritySet            1
+#define INCLUDE_vTaskSuspend                1
+#define INCLUDE_xQueueGetMutexHolder        1
+#define INCLUDE_xTaskGetCurrentTaskHandle   1
+#define INCLUDE_xTaskGetSchedulerState      1
+#define INCLUDE_xTimerPendFunctionCall      1
+#define INCLUDE_xTaskGetIdleTaskHandle      1
+
+/* Same notification layout as on target:
+ * - First one used by system primitives
+ * - Second one by thread event notification
+ * - Third one by FuriEventLoop
+ */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
+
+#ifdef FURI_TRACE
+#define traceTASK_SWITCHED_IN()                          \
+    extern void furi_trace_task_switched_in(void* task); \
+    furi_trace_task_switched_in(pxCurrentTCB)
+#define traceTASK_SWITCHED_OUT()                          \
+    extern void furi_trace_task_switched_out(void* task); \
+    furi_trace_task_switched_out(pxCurrentTCB)
+#endif
+
+#ifdef FURI_DEBUG
+#define configASSERT(x)                \
+    if((x) == 0) {                     \
+        furi_crash("FreeRTOS Assert"); \
+    }
+#endif
+
+// Must be last line of config because of recursion
+#include <core/check.h>
@@ -0,0 +1,101 @@
+#pragma once
+
+/* Host replacement for the CMSIS intrinsics used by furi and libraries.
+ *
+ * There are no interrupts on host: IPSR is always 0 and PRIMASK tracks
+ * interrupt masking requested by the current thread, which maps to blocking
+ * the POSIX port tick signal. DWT cycle counter is emulated with a monotonic
+ * clock scaled to the target core frequency. */
+
+#include <stdint.h>
+
+#ifndef __ASM
+#define __ASM __asm
+#endif
+#ifndef __INLINE
+#define __INLINE inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern __thread uint32_t furi_hal_cortex_host_primask;
+
+extern void vPortDisableInterrupts(void);
+extern void vPortEnableInterrupts(void);
+extern uint32_t furi_hal_cortex_host_cycles(void);
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void) {
+    return 0U;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void) {
+    return furi_hal_cortex_host_primask;
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t primask) {
+    furi_hal_cortex_host_primask = primask;
+    if(primask) {
+        vPortDisableInterrupts();
+    } else {
+        vPortEnableInterrupts();
+    }
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void) {
+    __set_PRIMASK(1U);
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void) {
+    __set_PRIMASK(0U);
+}
+
+__STATIC_FORCEINLINE void __DMB(void) {
+    __sync_synchronize();
+}
+
+__STATIC_FORCEINLINE void __DSB(void) {
+    __sync_synchronize();
+}
+
+__STATIC_FORCEINLINE void __ISB(void) {
+    __sync_synchronize();
+}
+
+__STATIC_FORCEINLINE void __NOP(void) {
+    __asm volatile("nop");
+}
+
+typedef struct {
+    uint32_t CTRL;
+    uint32_t CYCCNT;
+} DWT_Type;
+
+/* Every access yields fresh snapshot, writes are discarded */
+#define DWT (&(DWT_Type){.CYCCNT = furi_hal_cortex_host_cycles()})
+
+#ifdef __cplusplus
+}
+#endif
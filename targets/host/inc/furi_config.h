@@ -0,0 +1,3 @@
+#pragma once
+
+#define FURI_CONFIG_THREAD_MAX_PRIORITIES (32)
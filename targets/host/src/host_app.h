@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Host application entry point, provided by every host executable
+ *
+ * Runs in its own thread once furi and storage are up.
+ *
+ * @param      argc  argument count left after host options
+ * @param      argv  arguments left after host options
+ *
+ * @return     process exit code
+ */
+int32_t host_app_main(int argc, char** argv);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,120 @@
+#include "host_app.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TAG "Main"
+
+#define HOST_STORAGE_DEFAULT "host_storage"
+
+extern int32_t storage_srv(void* p);
+
+typedef struct {
+    int argc;
+    char** argv;
+    int32_t exit_code;
+} HostMain;
+
+static void host_log_tx(const uint8_t* data, size_t size, void* context) {
+    UNUSED(context);
+    while(size) {
+        ssize_t ret = write(STDOUT_FILENO, data, size);
+        if(ret <= 0) break;
+        data += ret;
+        size -= ret;
+    }
+}
+
+static int32_t host_app_task(void* context) {
+    HostMain* host = context;
+    return host_app_main(host->argc, host->argv);
+}
+
+static int32_t host_init_task(void* context) {
+    HostMain* host = context;
+
+    furi_hal_init();
+
+    FuriThread* storage_thread =
+        furi_thread_alloc_service("StorageSrv", 3 * 1024, storage_srv, NULL);
+    furi_thread_start(storage_thread);
+
+    // Applications expect storage record to be present
+    furi_record_open(RECORD_STORAGE);
+    furi_record_close(RECORD_STORAGE);
+
+    FuriThread* app_thread = furi_thread_alloc_ex("HostApp", 8 * 1024, host_app_task, host);
+    furi_thread_start(app_thread);
+    furi_thread_join(app_thread);
+    host->exit_code = furi_thread_get_return_code(app_thread);
+    furi_thread_free(app_thread);
+
+    // Returns control to main() on POSIX port
+    vTaskEndScheduler();
+
+    return 0;
+}
+
+void vApplicationGetIdleTaskMemory(
+    StaticTask_t** tcb_ptr,
+    StackType_t** stack_ptr,
+    uint32_t* stack_size) {
+    *tcb_ptr = memmgr_alloc_from_pool(sizeof(StaticTask_t));
+    *stack_ptr = memmgr_alloc_from_pool(sizeof(StackType_t) * configIDLE_TASK_STACK_DEPTH);
+    *stack_size = configIDLE_TASK_STACK_DEPTH;
+}
+
+void vApplicationGetTimerTaskMemory(
+    StaticTask_t** tcb_ptr,
+    StackType_t** stack_ptr,
+    uint32_t* stack_size) {
+    *tcb_ptr = memmgr_alloc_from_pool(sizeof(StaticTask_t));
+    *stack_ptr = memmgr_alloc_from_pool(sizeof(StackType_t) * configTIMER_TASK_STACK_DEPTH);
+    *stack_size = configTIMER_TASK_STACK_DEPTH;
+}
+
+int main(int argc, char** argv) {
+    HostMain host = {
+        .argc = argc,
+        .argv = argv,
+        .exit_code = EXIT_FAILURE,
+    };
+
+    const char* storage_root = HOST_STORAGE_DEFAULT;
+    // Host options go first, the rest belongs to application
+    while(host.argc > 2 && strcmp(host.argv[1], "--storage") == 0) {
+        storage_root = host.argv[2];
+        // Keep program name in argv[0]
+        host.argv[2] = host.argv[0];
+        host.argc -= 2;
+        host.argv += 2;
+    }
+    storage_host_set_root(storage_root);
+
+    // Initialize FURI layer
+    furi_init();
+
+    FuriLogHandler log_handler = {.callback = host_log_tx, .context = NULL};
+    furi_log_add_handler(log_handler);
+
+    // Emulated HAL
+    furi_hal_init_early();
+
+    FuriThread* main_thread = furi_thread_alloc_ex("InitSrv", 1024, host_init_task, &host);
+    furi_thread_set_priority(main_thread, FuriThreadPriorityInit);
+    furi_thread_start(main_thread);
+
+    // Run Kernel, returns once application is done
+    furi_run();
+
+    return host.exit_code;
+}
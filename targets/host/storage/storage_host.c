@@ -0,0 +1,588 @@
+/* Storage backend for host target.
+ *
+ * /ext is backed by a regular host directory, so test fixtures can be
+ * prepared and inspected with ordinary tools. Message processing and client
+ * API are shared with the firmware, only FatFs and SD card handling are
+ * replaced. */
+
+#include "storage_host.h"
+
+#include <storage/storage_i.h>
+#include <storage/storage_message.h>
+#include <storage/storage_processing.h>
+#include <storage/storages/storage_ext.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#define TAG "StorageHost"
+
+#define STORAGE_TICK 1000
+
+#define STORAGE_HOST_SECTOR_SIZE 512
+
+typedef struct {
+    int fd;
+    bool writable;
+} HostFile;
+
+typedef struct {
+    DIR* dir;
+    FuriString* path;
+} HostDir;
+
+static FuriString* storage_host_root = NULL;
+
+void storage_host_set_root(const char* path) {
+    furi_check(path);
+    if(!storage_host_root) {
+        storage_host_root = furi_string_alloc();
+    }
+    furi_string_set(storage_host_root, path);
+    // Backend paths already start with '/'
+    while(furi_string_end_with(storage_host_root, "/")) {
+        furi_string_left(storage_host_root, furi_string_size(storage_host_root) - 1);
+    }
+}
+
+static FuriString* storage_host_path_alloc(const char* path) {
+    furi_check(storage_host_root);
+    FuriString* host_path = furi_string_alloc_set(storage_host_root);
+    furi_string_cat_str(host_path, path);
+    return host_path;
+}
+
+/******************* Core Functions *******************/
+
+static FS_Error storage_host_parse_error(int error) {
+    FS_Error result;
+    switch(error) {
+    case 0:
+        result = FSE_OK;
+        break;
+    case ENOENT:
+    case ENOTDIR:
+        result = FSE_NOT_EXIST;
+        break;
+    case EEXIST:
+        result = FSE_EXIST;
+        break;
+    case ENAMETOOLONG:
+        result = FSE_INVALID_NAME;
+        break;
+    case EINVAL:
+    case EBADF:
+        result = FSE_INVALID_PARAMETER;
+        break;
+    case EACCES:
+    case EPERM:
+    case EISDIR:
+    case ENOTEMPTY:
+    case EROFS:
+        result = FSE_DENIED;
+        break;
+    default:
+        result = FSE_INTERNAL;
+        break;
+    }
+
+    return result;
+}
+
+static void storage_host_set_file_error(File* file, int error) {
+    file->internal_error_id = error;
+    file->error_id = storage_host_parse_error(error);
+}
+
+FS_Error sd_unmount_card(StorageData* storage) {
+    storage->status = StorageStatusNotReady;
+    storage_data_timestamp(storage);
+    return FSE_OK;
+}
+
+FS_Error sd_mount_card(StorageData* storage, bool notify) {
+    UNUSED(notify);
+    FS_Error error = FSE_OK;
+
+    struct stat st;
+    if(storage_host_root && stat(furi_string_get_cstr(storage_host_root), &st) == 0 &&
+       S_ISDIR(st.st_mode)) {
+        storage->status = StorageStatusOK;
+        FURI_LOG_I(TAG, "mounted %s", furi_string_get_cstr(storage_host_root));
+    } else {
+        storage->status = StorageStatusNotMounted;
+        FURI_LOG_E(TAG, "storage root is not a directory");
+        error = FSE_INTERNAL;
+    }
+
+    storage_data_timestamp(storage);
+    return error;
+}
+
+FS_Error sd_format_card(StorageData* storage) {
+    UNUSED(storage);
+    // Never wipe host directory
+    return FSE_NOT_IMPLEMENTED;
+}
+
+FS_Error sd_card_info(StorageData* storage, SDInfo* sd_info) {
+    UNUSED(storage);
+    memset(sd_info, 0, sizeof(SDInfo));
+
+    struct statvfs st;
+    if(statvfs(furi_string_get_cstr(storage_host_root), &st) != 0) {
+        return storage_host_parse_error(errno);
+    }
+
+    snprintf(sd_info->label, SD_LABEL_LENGTH, "Host");
+    sd_info->fs_type = FST_UNKNOWN;
+    sd_info->kb_total = (uint64_t)st.f_blocks * st.f_frsize / 1024;
+    sd_info->kb_free = (uint64_t)st.f_bavail * st.f_frsize / 1024;
+    sd_info->sector_size = STORAGE_HOST_SECTOR_SIZE;
+    sd_info->cluster_size = MAX(st.f_bsize / STORAGE_HOST_SECTOR_SIZE, 1UL);
+
+    return FSE_OK;
+}
+
+/******************* File Functions *******************/
+
+static bool storage_host_file_open(
+    void* ctx,
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    StorageData* storage = ctx;
+    int flags = 0;
+
+    if((access_mode & FSAM_READ_WRITE) == FSAM_READ_WRITE) {
+        flags |= O_RDWR;
+    } else if(access_mode & FSAM_WRITE) {
+        flags |= O_WRONLY;
+    } else {
+        flags |= O_RDONLY;
+    }
+    if(open_mode & FSOM_OPEN_ALWAYS) flags |= O_CREAT;
+    if(open_mode & FSOM_OPEN_APPEND) flags |= O_CREAT;
+    if(open_mode & FSOM_CREATE_NEW) flags |= O_CREAT | O_EXCL;
+    if(open_mode & FSOM_CREATE_ALWAYS) flags |= O_CREAT | O_TRUNC;
+
+    HostFile* file_data = malloc(sizeof(HostFile));
+    file_data->writable = access_mode & FSAM_WRITE;
+    storage_set_storage_file_data(file, file_data, storage);
+
+    FuriString* host_path = storage_host_path_alloc(path);
+    file_data->fd = open(furi_string_get_cstr(host_path), flags | O_CLOEXEC, 0644);
+    int error = file_data->fd < 0 ? errno : 0;
+    furi_string_free(host_path);
+
+    if(error == 0) {
+        struct stat st;
+        // FatFs refuses to open directories as files
+        if(fstat(file_data->fd, &st) == 0 && S_ISDIR(st.st_mode)) {
+            error = ENOENT;
+        } else if((open_mode & FSOM_OPEN_APPEND) && lseek(file_data->fd, 0, SEEK_END) < 0) {
+            error = errno;
+        }
+    }
+
+    storage_host_set_file_error(file, error);
+    return file->error_id == FSE_OK;
+}
+
+static bool storage_host_file_close(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+    int error = 0;
+    if(file_data->fd >= 0 && close(file_data->fd) != 0) {
+        error = errno;
+    }
+    storage_host_set_file_error(file, error);
+    free(file_data);
+    storage_set_storage_file_data(file, NULL, storage);
+    return file->error_id == FSE_OK;
+}
+
+static uint16_t
+    storage_host_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    uint16_t bytes_read = 0;
+    int error = 0;
+    while(bytes_read < bytes_to_read) {
+        ssize_t ret = read(file_data->fd, (uint8_t*)buff + bytes_read, bytes_to_read - bytes_read);
+        if(ret < 0 && errno == EINTR) continue;
+        if(ret < 0) error = errno;
+        if(ret <= 0) break;
+        bytes_read += ret;
+    }
+
+    storage_host_set_file_error(file, error);
+    return bytes_read;
+}
+
+static uint16_t storage_host_file_write(
+    void* ctx,
+    File* file,
+    const void* buff,
+    uint16_t const bytes_to_write) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    uint16_t bytes_written = 0;
+    int error = 0;
+    while(bytes_written < bytes_to_write) {
+        ssize_t ret = write(
+            file_data->fd, (const uint8_t*)buff + bytes_written, bytes_to_write - bytes_written);
+        if(ret < 0 && errno == EINTR) continue;
+        if(ret < 0) error = errno;
+        if(ret <= 0) break;
+        bytes_written += ret;
+    }
+
+    storage_host_set_file_error(file, error);
+    return bytes_written;
+}
+
+static bool
+    storage_host_file_seek(void* ctx, File* file, const uint32_t offset, const bool from_start) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    int error = 0;
+    struct stat st;
+    off_t position = from_start ? 0 : lseek(file_data->fd, 0, SEEK_CUR);
+    position += offset;
+
+    // Mimic FatFs: clamp in read mode, expand file in write mode
+    if(fstat(file_data->fd, &st) != 0) {
+        error = errno;
+    } else if(position > st.st_size) {
+        if(!file_data->writable) {
+            position = st.st_size;
+        } else if(ftruncate(file_data->fd, position) != 0) {
+            error = errno;
+        }
+    }
+
+    if(error == 0 && lseek(file_data->fd, position, SEEK_SET) < 0) {
+        error = errno;
+    }
+
+    storage_host_set_file_error(file, error);
+    return file->error_id == FSE_OK;
+}
+
+static uint64_t storage_host_file_tell(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    storage_host_set_file_error(file, position < 0 ? errno : 0);
+    return position < 0 ? 0 : position;
+}
+
+static bool storage_host_file_truncate(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    int error = 0;
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    if(position < 0 || ftruncate(file_data->fd, position) != 0) {
+        error = errno;
+    }
+
+    storage_host_set_file_error(file, error);
+    return file->error_id == FSE_OK;
+}
+
+static bool storage_host_file_sync(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    storage_host_set_file_error(file, fsync(file_data->fd) != 0 ? errno : 0);
+    return file->error_id == FSE_OK;
+}
+
+static uint64_t storage_host_file_size(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    struct stat st;
+    if(fstat(file_data->fd, &st) != 0) {
+        storage_host_set_file_error(file, errno);
+        return 0;
+    }
+
+    storage_host_set_file_error(file, 0);
+    return st.st_size;
+}
+
+static bool storage_host_file_eof(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    struct stat st;
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    bool eof = (fstat(file_data->fd, &st) != 0) || (position >= st.st_size);
+    storage_host_set_file_error(file, 0);
+    return eof;
+}
+
+/******************* Dir Functions *******************/
+
+static bool storage_host_dir_open(void* ctx, File* file, const char* path) {
+    StorageData* storage = ctx;
+
+    HostDir* file_data = malloc(sizeof(HostDir));
+    file_data->path = storage_host_path_alloc(path);
+    storage_set_storage_file_data(file, file_data, storage);
+
+    file_data->dir = opendir(furi_string_get_cstr(file_data->path));
+    storage_host_set_file_error(file, file_data->dir ? 0 : errno);
+    return file->error_id == FSE_OK;
+}
+
+static bool storage_host_dir_close(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostDir* file_data = storage_get_storage_file_data(file, storage);
+
+    int error = 0;
+    if(file_data->dir && closedir(file_data->dir) != 0) {
+        error = errno;
+    }
+    storage_host_set_file_error(file, error);
+    furi_string_free(file_data->path);
+    free(file_data);
+    return file->error_id == FSE_OK;
+}
+
+static bool storage_host_dir_read(
+    void* ctx,
+    File* file,
+    FileInfo* fileinfo,
+    char* name,
+    const uint16_t name_length) {
+    StorageData* storage = ctx;
+    HostDir* file_data = storage_get_storage_file_data(file, storage);
+
+    struct dirent* entry;
+    do {
+        errno = 0;
+        entry = readdir(file_data->dir);
+        // FatFs does not report dot entries
+    } while(entry && (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0));
+
+    if(!entry) {
+        storage_host_set_file_error(file, errno);
+        if(file->error_id == FSE_OK) file->error_id = FSE_NOT_EXIST;
+        return false;
+    }
+
+    if(fileinfo != NULL) {
+        struct stat st;
+        FuriString* entry_path =
+            furi_string_alloc_printf("%s/%s", furi_string_get_cstr(file_data->path), entry->d_name);
+        fileinfo->size = 0;
+        fileinfo->flags = 0;
+        if(stat(furi_string_get_cstr(entry_path), &st) == 0) {
+            if(S_ISDIR(st.st_mode)) {
+                fileinfo->flags |= FSF_DIRECTORY;
+            } else {
+                fileinfo->size = st.st_size;
+            }
+        }
+        furi_string_free(entry_path);
+    }
+
+    if(name != NULL) {
+        snprintf(name, name_length, "%s", entry->d_name);
+    }
+
+    storage_host_set_file_error(file, 0);
+    return true;
+}
+
+static bool storage_host_dir_rewind(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostDir* file_data = storage_get_storage_file_data(file, storage);
+
+    rewinddir(file_data->dir);
+    storage_host_set_file_error(file, 0);
+    return true;
+}
+
+/******************* Common FS Functions *******************/
+
+static FS_Error storage_host_common_stat_timestamp(
+    void* ctx,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* timestamp) {
+    UNUSED(ctx);
+    FuriString* host_path = storage_host_path_alloc(path);
+    struct stat st;
+    int error = stat(furi_string_get_cstr(host_path), &st) != 0 ? errno : 0;
+    furi_string_free(host_path);
+
+    if(fileinfo != NULL) {
+        fileinfo->size = 0;
+        fileinfo->flags = 0;
+        if(error == 0) {
+            if(S_ISDIR(st.st_mode)) {
+                fileinfo->flags |= FSF_DIRECTORY;
+            } else {
+                fileinfo->size = st.st_size;
+            }
+        }
+    }
+
+    if(timestamp != NULL) {
+        *timestamp = error == 0 ? (uint32_t)st.st_mtime : 0;
+    }
+
+    return storage_host_parse_error(error);
+}
+
+static FS_Error storage_host_common_stat(void* ctx, const char* path, FileInfo* fileinfo) {
+    return storage_host_common_stat_timestamp(ctx, path, fileinfo, NULL);
+}
+
+static FS_Error storage_host_common_remove(void* ctx, const char* path) {
+    UNUSED(ctx);
+    FuriString* host_path = storage_host_path_alloc(path);
+    const char* host_path_cstr = furi_string_get_cstr(host_path);
+
+    int error = 0;
+    struct stat st;
+    if(stat(host_path_cstr, &st) != 0) {
+        error = errno;
+    } else if(S_ISDIR(st.st_mode) ? rmdir(host_path_cstr) : unlink(host_path_cstr)) {
+        error = errno;
+    }
+    furi_string_free(host_path);
+
+    return storage_host_parse_error(error);
+}
+
+static FS_Error storage_host_common_mkdir(void* ctx, const char* path) {
+    UNUSED(ctx);
+    FuriString* host_path = storage_host_path_alloc(path);
+    int error = mkdir(furi_string_get_cstr(host_path), 0755) != 0 ? errno : 0;
+    furi_string_free(host_path);
+
+    return storage_host_parse_error(error);
+}
+
+static FS_Error storage_host_common_fs_info(
+    void* ctx,
+    const char* fs_path,
+    uint64_t* total_space,
+    uint64_t* free_space) {
+    UNUSED(ctx);
+    UNUSED(fs_path);
+
+    struct statvfs st;
+    if(statvfs(furi_string_get_cstr(storage_host_root), &st) != 0) {
+        return storage_host_parse_error(errno);
+    }
+
+    if(total_space != NULL) {
+        *total_space = (uint64_t)st.f_blocks * st.f_frsize;
+    }
+
+    if(free_space != NULL) {
+        *free_space = (uint64_t)st.f_bavail * st.f_frsize;
+    }
+
+    return FSE_OK;
+}
+
+static bool storage_host_common_equivalent_path(const char* path1, const char* path2) {
+    return strcmp(path1, path2) == 0;
+}
+
+/******************* Init Storage *******************/
+static const FS_Api fs_api = {
+    .file =
+        {
+            .open = storage_host_file_open,
+            .close = storage_host_file_close,
+            .read = storage_host_file_read,
+            .write = storage_host_file_write,
+            .seek = storage_host_file_seek,
+            .tell = storage_host_file_tell,
+            .truncate = storage_host_file_truncate,
+            .size = storage_host_file_size,
+            .sync = storage_host_file_sync,
+            .eof = storage_host_file_eof,
+        },
+    .dir =
+        {
+            .open = storage_host_dir_open,
+            .close = storage_host_dir_close,
+            .read = storage_host_dir_read,
+            .rewind = storage_host_dir_rewind,
+        },
+    .common =
+        {
+            .stat = storage_host_common_stat,
+            .stat_timestamp = storage_host_common_stat_timestamp,
+            .mkdir = storage_host_common_mkdir,
+            .remove = storage_host_common_remove,
+            .fs_info = storage_host_common_fs_info,
+            .equivalent_path = storage_host_common_equivalent_path,
+        },
+};
+
+void storage_ext_init(StorageData* storage) {
+    storage->data = NULL;
+    storage->api.tick = NULL;
+    storage->fs_api = &fs_api;
+
+    sd_mount_card(storage, false);
+}
+
+/******************* Service *******************/
+
+static Storage* storage_app_alloc(void) {
+    Storage* app = malloc(sizeof(Storage));
+    app->message_queue = furi_message_queue_alloc(8, sizeof(StorageMessage));
+    app->pubsub = furi_pubsub_alloc();
+    app->digest_cache = storage_digest_cache_alloc();
+
+    for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
+        storage_data_init(&app->storage[i]);
+        storage_data_timestamp(&app->storage[i]);
+    }
+
+    storage_ext_init(&app->storage[ST_EXT]);
+
+    // No status bar on host
+    app->sd_gui.enabled = false;
+    app->sd_gui.view_port = NULL;
+
+    return app;
+}
+
+int32_t storage_srv(void* p) {
+    UNUSED(p);
+    Storage* app = storage_app_alloc();
+    furi_record_create(RECORD_STORAGE, app);
+
+    StorageMessage message;
+    while(1) {
+        if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
+            storage_process_message(app, &message);
+        } else {
+            storage_digest_cache_save(app->digest_cache, &app->storage[ST_EXT]);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Set host directory that is exposed as /ext
+ *
+ * Must be called before storage service is started.
+ *
+ * @param      path  host directory path, must exist
+ */
+void storage_host_set_root(const char* path);
+
+#ifdef __cplusplus
+}
+#endif